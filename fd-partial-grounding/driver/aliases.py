@@ -104,11 +104,12 @@ def _get_lama(**kwargs):
                          lazy_wastar([hff,hlm],preferred=[hff,hlm],w=1)
                          ],repeat_last=true,continue_on_fail=true)""",
         "--if-non-unit-cost",
+        "--landmarks", "lmg=lm_reasonable_orders_hps(lm_rhw())",
         "--evaluator",
-        "hlm1=lmcount(lm_reasonable_orders_hps(lm_rhw()),transform=adapt_costs(one),pref={pref})".format(**kwargs),
+        "hlm1=lmcount(lmg,transform=adapt_costs(one),pref={pref})".format(**kwargs),
         "--evaluator", "hff1=ff(transform=adapt_costs(one))",
         "--evaluator",
-        "hlm2=lmcount(lm_reasonable_orders_hps(lm_rhw()),transform=adapt_costs(plusone),pref={pref})".format(**kwargs),
+        "hlm2=lmcount(lmg,transform=adapt_costs(plusone),pref={pref})".format(**kwargs),
         "--evaluator", "hff2=ff(transform=adapt_costs(plusone))",
         "--search", """iterated([
                          lazy_greedy([hff1,hlm1],preferred=[hff1,hlm1],
@@ -375,6 +375,18 @@ def parse_args():
     grounding.add_argument("--incremental-grounding-increment", default=None, type=int, help="increment in number of actions")
     grounding.add_argument("--incremental-grounding-minimum", default=None, type=int, help="minimum number of actions to ground in first iteration")
     grounding.add_argument("--incremental-grounding-increment-percentage", default=None, type=int, help="increment in percentage of actions")
+    grounding.add_argument("--incremental-grounding-persistent-search", action="store_true",
+                           help="keep the search process alive between iterations and continue "
+                           "the previous search on the new task instead of starting from scratch")
+
+    grounding.add_argument("--powerlifted-partial-grounding", action="store_true",
+                           help="select the actions to ground with the partial grounding of powerlifted "
+                           "(using the translator options --termination-condition, --trained-model-folder "
+                           "and --ignore-bad-actions) and let the translator instantiate only these "
+                           "actions instead of computing the relaxed reachable model itself")
+    grounding.add_argument("--grounded-actions-file", metavar="FILE", default="grounded_actions",
+                           help="file for the actions grounded with --powerlifted-partial-grounding "
+                           "(default: %(default)s)")
 
     # HACK to support how plans should be saved for IPC23
     grounding.add_argument("--keep-first-plan-file", action="store_true",
@@ -38,6 +38,8 @@ def do_incremental_grounding(args):
     
     if args.incremental_grounding_increment_percentage:
         args.incremental_grounding_increment_percentage = args.incremental_grounding_increment_percentage / 100 + 1
+
+    persistent_search = None
         
     while True:
         if args.overall_time_limit and args.overall_time_limit - util.get_elapsed_time() <= 0:
@@ -93,7 +95,14 @@ def do_incremental_grounding(args):
         
         args.search_options = list(old_search_options)
         
-        (exitcode, _) = run_components.run_search(args)
+        if args.incremental_grounding_persistent_search:
+            if persistent_search is None:
+                persistent_search = run_components.PersistentSearch(args)
+            (exitcode, waiting) = persistent_search.run(args)
+            if not waiting:
+                persistent_search = None
+        else:
+            (exitcode, _) = run_components.run_search(args)
         
         print()
         print("search exit code: {exitcode}".format(**locals()))
@@ -104,6 +113,8 @@ def do_incremental_grounding(args):
         elif exitcode in [rc.SEARCH_INPUT_ERROR, rc.SEARCH_UNSUPPORTED]:
             print("Driver aborting after search")
             sys.exit(exitcode)
+    if persistent_search is not None:
+        persistent_search.close()
     if "validate" in args.components:
         (exitcode, _) = run_components.run_validate(args)
         print()
@@ -8,6 +8,7 @@ from . import cleanup
 from . import get_relaxed_info
 from . import limits
 from . import incremental_grounding
+from . import partial_grounding
 from . import run_components
 from . import util
 from . import __version__
@@ -35,6 +36,12 @@ def main():
     if args.compute_relaxed_info:
         get_relaxed_info.compute(args)
     
+    if args.powerlifted_partial_grounding:
+        if args.incremental_grounding:
+            sys.exit("ERROR: --powerlifted-partial-grounding does not support --incremental-grounding.")
+        if "translate" in args.components:
+            partial_grounding.run(args)
+
     if (args.incremental_grounding):
         incremental_grounding.do_incremental_grounding(args) # function never returns
     elif (args.incremental_grounding_search_time_limit or args.incremental_grounding_increment):
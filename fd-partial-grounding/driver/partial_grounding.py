@@ -0,0 +1,70 @@
+import argparse
+import logging
+import os
+import subprocess
+import sys
+
+from . import call
+from . import limits
+from . import returncodes
+from . import util
+
+
+def _split_grounding_options(translate_options):
+    """Split off the translator options that select the actions to ground.
+    They are passed to powerlifted, and the translator grounds the actions of
+    the grounded-actions file instead."""
+    parser = argparse.ArgumentParser(add_help=False)
+    parser.add_argument("--grounding-action-queue-ordering")
+    parser.add_argument("--termination-condition", nargs="+", default=["default"])
+    parser.add_argument("--trained-model-folder")
+    parser.add_argument("--ignore-bad-actions", action="store_true")
+    return parser.parse_known_args(translate_options)
+
+
+def run(args):
+    """Ground the actions with the partial grounding of powerlifted, in C++,
+    and let the translator instantiate only these actions, without computing
+    the relaxed reachable model itself."""
+    logging.info("Running partial grounding (powerlifted).")
+    time_limit = limits.get_time_limit(None, args.overall_time_limit)
+    memory_limit = limits.get_memory_limit(None, args.overall_memory_limit)
+
+    powerlifted = os.path.join(util.REPO_ROOT_DIR, "powerlifted.py")
+    if not os.path.exists(powerlifted):
+        returncodes.exit_with_driver_input_error(
+            "Could not find '{powerlifted}'. "
+            "Please run './build.py powerlifted'.".format(**locals()))
+
+    grounding_options, translate_options = _split_grounding_options(
+        args.translate_options)
+    cmd = [sys.executable, powerlifted,
+           "-d", args.translate_inputs[0], "-i", args.translate_inputs[1],
+           "--partial-grounding",
+           "--grounded-actions-file", args.grounded_actions_file,
+           "--termination-condition"] + grounding_options.termination_condition
+    if grounding_options.trained_model_folder:
+        cmd += ["--trained-model-folder", grounding_options.trained_model_folder]
+    if grounding_options.ignore_bad_actions:
+        cmd += ["--ignore-bad-actions"]
+
+    try:
+        call.check_call(
+            "partial-grounding", cmd,
+            time_limit=time_limit, memory_limit=memory_limit)
+    except subprocess.CalledProcessError as err:
+        # If the goal is not relaxed reachable, the translator generates an
+        # unsolvable task from the grounded actions.
+        if err.returncode != returncodes.SEARCH_UNSOLVABLE:
+            returncodes.print_stderr(
+                "Partial grounding returned exit status {}".format(err.returncode))
+            sys.exit(err.returncode)
+    except OSError as err:
+        returncodes.exit_with_driver_critical_error(err)
+
+    args.translate_options = translate_options + [
+        "--grounding-action-queue-ordering", "actionsfromfile",
+        "--actions-file", args.grounded_actions_file,
+        "--skip-exploration"]
+    logging.info(f"Grounded actions written to {args.grounded_actions_file}. "
+                 f"[{util.get_elapsed_time()}s]")
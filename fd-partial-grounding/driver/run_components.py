@@ -202,6 +202,60 @@ def run_search(args):
             return (0, True)
 
 
+class PersistentSearch:
+    """
+    Search process that is kept alive across the iterations of incremental
+    grounding. Every call to run() sends the current task (args.search_input)
+    to the process, which continues the previous search on it if possible.
+    """
+    WAITING_MARKER = "Persistent search: no plan found, waiting for the next task."
+
+    def __init__(self, args):
+        logging.info("Running persistent search (%s)." % args.build)
+        time_limit = limits.get_time_limit(None, args.overall_time_limit)
+        memory_limit = limits.get_memory_limit(
+            args.search_memory_limit, args.overall_memory_limit)
+        executable = get_executable(args.build, REL_SEARCH_PATH)
+        if not args.search_options or args.portfolio:
+            returncodes.exit_with_driver_input_error(
+                "persistent search needs --alias or search options")
+        cmd = [executable] + args.search_options + [
+            "--internal-plan-file", args.plan_file,
+            "--internal-persistent-search", str(args.search_time_limit)]
+        call.print_call_settings("search", cmd, None, time_limit, memory_limit)
+        sys.stdout.flush()
+        self.process = subprocess.Popen(
+            cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True,
+            preexec_fn=call._get_preexec_function(time_limit, memory_limit))
+
+    def run(self, args):
+        """
+        Return (exitcode, continue), where continue is True if the search
+        ended without a plan and waits for the next task.
+        """
+        PlanManager(args.plan_file).delete_existing_plans(args.keep_first_plan_file)
+        try:
+            with open(args.search_input) as task_file:
+                shutil.copyfileobj(task_file, self.process.stdin)
+            self.process.stdin.flush()
+        except BrokenPipeError:
+            pass
+        for line in self.process.stdout:
+            sys.stdout.write(line)
+            if line.rstrip("\n").endswith(self.WAITING_MARKER):
+                sys.stdout.flush()
+                return (returncodes.SEARCH_UNSOLVED_INCOMPLETE, True)
+        sys.stdout.flush()
+        return (self.process.wait(), False)
+
+    def close(self):
+        if self.process.poll() is None:
+            self.process.stdin.close()
+            for line in self.process.stdout:
+                sys.stdout.write(line)
+            self.process.wait()
+
+
 def run_validate(args):
     logging.info("Running validate.")
 
@@ -0,0 +1,100 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import os
+import re
+import subprocess
+
+"""
+This benchmark compares the FF heuristic with and without the incremental
+computation of the h^add costs (option "incremental" of add() and ff(), see
+src/search/heuristics/additive_heuristic.h).
+
+Every task is solved with the first iteration of LAMA 2011 (lazy greedy
+search with the FF and landmark heuristics and preferred operators) once
+with incremental=false and once with incremental=true. The script reports
+the search time, the evaluated states per second, the expansions and the
+plan cost of both runs. The expansions and plan costs can differ because the
+incremental computation breaks ties between achievers differently.
+
+"""
+
+BASEDIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+DEFAULT_BIN = os.path.join(BASEDIR, "builds", "release", "bin")
+
+LAMA_FIRST = [
+    "--evaluator",
+    "hlm=lmcount(lm_factory=lm_reasonable_orders_hps(lm_rhw()),"
+    "transform=adapt_costs(one),pref=false)",
+    "--evaluator", "hff=ff(transform=adapt_costs(one),incremental={incremental})",
+    "--search",
+    "lazy_greedy([hff,hlm],preferred=[hff,hlm],cost_type=one,"
+    "reopen_closed=false,batch_size={batch_size})"]
+
+PATTERNS = {
+    "search_time": r"Search time: ([0-9.e-]+)s",
+    "per_second": r"Evaluated states per second: ([0-9.e-]+)",
+    "expansions": r"Expanded (\d+) state\(s\)\.",
+    "cost": r"Plan cost: (\d+)",
+}
+
+
+def run_search(bindir, task, incremental, batch_size, timeout):
+    config = [arg.format(incremental=incremental, batch_size=batch_size)
+              for arg in LAMA_FIRST]
+    with open(task) as stdin:
+        try:
+            output = subprocess.run(
+                [os.path.join(bindir, "downward")] + config +
+                ["--internal-plan-file", os.devnull],
+                stdin=stdin, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                text=True, timeout=timeout).stdout
+        except subprocess.TimeoutExpired:
+            return {}
+    result = {}
+    for name, pattern in PATTERNS.items():
+        matches = re.findall(pattern, output)
+        if matches:
+            result[name] = float(matches[-1])
+    return result
+
+
+def print_result(name, full, incremental):
+    if "search_time" not in full or "search_time" not in incremental:
+        print("{}: no result [full: {}, incremental: {}]".format(
+            name, full, incremental))
+        return
+    print("{}: search time {:.3f}s / {:.3f}s (speedup {:.2f}x), "
+          "evaluated states per second {:.0f} / {:.0f}, "
+          "expansions {:.0f} / {:.0f}, plan cost {:.0f} / {:.0f}".format(
+              name, full["search_time"], incremental["search_time"],
+              full["search_time"] / max(incremental["search_time"], 1e-6),
+              full.get("per_second", 0), incremental.get("per_second", 0),
+              full["expansions"], incremental["expansions"],
+              full["cost"], incremental["cost"]))
+
+
+def parse_options():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("tasks", nargs="+",
+                        help="Translated tasks (output.sas files).")
+    parser.add_argument("--bin", default=DEFAULT_BIN,
+                        help="Directory with the downward binary.")
+    parser.add_argument("--batch-size", type=int, default=1,
+                        help="batch_size option of the lazy search. Larger "
+                        "batches evaluate siblings one after the other, "
+                        "which keeps the differences between consecutively "
+                        "evaluated states small.")
+    parser.add_argument("--timeout", type=float, default=1800,
+                        help="Time limit per run in seconds.")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    args = parse_options()
+    for task in args.tasks:
+        results = [run_search(args.bin, task, incremental, args.batch_size,
+                              args.timeout)
+                   for incremental in ["false", "true"]]
+        print_result(os.path.basename(task), *results)
@@ -0,0 +1,87 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import os
+import re
+import subprocess
+
+"""
+This benchmark compares the two layouts of the successor generator (option
+successor_generator of the search engines, see
+src/search/task_utils/successor_generator_internals.h): the decision tree
+of polymorphic nodes (TREE) and its encoding in a single array (FLAT).
+
+Every task is searched with blind A* for a fixed time with both layouts, so
+that successor generation is a large part of the work per expansion. The
+script reports the time and peak memory difference for building the
+successor generator and the expanded and generated states per second. Both
+layouts generate the same operators in the same order, so the searches
+expand the same states.
+
+"""
+
+BASEDIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+DEFAULT_BIN = os.path.join(BASEDIR, "builds", "release", "bin")
+
+SEARCH = "astar(blind(),successor_generator={layout},max_time={max_time})"
+
+PATTERNS = {
+    "creation_time": r"time for successor generation creation: ([0-9.e-]+)s",
+    "creation_memory": r"peak memory difference for successor generator creation: (\d+) KB",
+    "expansions": r"Expanded (\d+) state\(s\)\.",
+    "generated": r"Generated (\d+) state\(s\)\.",
+    "search_time": r"Search time: ([0-9.e-]+)s",
+}
+
+
+def run_search(bindir, task, layout, max_time):
+    search = SEARCH.format(layout=layout, max_time=max_time)
+    with open(task) as stdin:
+        output = subprocess.run([os.path.join(bindir, "downward"), "--search", search,
+                                 "--internal-plan-file", os.devnull],
+                                stdin=stdin, stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL, text=True).stdout
+    result = {}
+    for name, pattern in PATTERNS.items():
+        matches = re.findall(pattern, output)
+        if matches:
+            result[name] = float(matches[-1])
+    return result
+
+
+def per_second(result, key):
+    return result[key] / max(result["search_time"], 1e-6)
+
+
+def print_result(name, tree, flat):
+    if "search_time" not in tree or "search_time" not in flat:
+        print("{}: no result [tree: {}, flat: {}]".format(name, tree, flat))
+        return
+    print("{}: creation {:.3f}s / {:.3f}s, {:.0f} KB / {:.0f} KB, "
+          "expansions per second {:.0f} / {:.0f} (speedup {:.2f}x), "
+          "generated per second {:.0f} / {:.0f}".format(
+              name, tree["creation_time"], flat["creation_time"],
+              tree["creation_memory"], flat["creation_memory"],
+              per_second(tree, "expansions"), per_second(flat, "expansions"),
+              per_second(flat, "expansions") / max(per_second(tree, "expansions"), 1e-6),
+              per_second(tree, "generated"), per_second(flat, "generated")))
+
+
+def parse_options():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("tasks", nargs="+",
+                        help="Translated tasks (output.sas files).")
+    parser.add_argument("--bin", default=DEFAULT_BIN,
+                        help="Directory with the downward binary.")
+    parser.add_argument("--max-time", type=float, default=60,
+                        help="Search time per run in seconds.")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    args = parse_options()
+    for task in args.tasks:
+        results = [run_search(args.bin, task, layout, args.max_time)
+                   for layout in ["TREE", "FLAT"]]
+        print_result(os.path.basename(task), *results)
@@ -0,0 +1,92 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import os
+import re
+import subprocess
+import tempfile
+import time
+
+"""
+This benchmark compares the time to load translated tasks in the text format
+(output.sas) and in the binary format (see
+src/search/tasks/binary_task_format.h).
+
+Every task is converted with sas-converter. Then the search is run on both
+files with a search that stops right after the initialization, and
+preprocess-h2 is run on both files without computing h2 mutexes. The script
+reports the time until the search has read the task, the total time of the
+search, and the time of preprocess-h2.
+
+"""
+
+BASEDIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+DEFAULT_BIN = os.path.join(BASEDIR, "builds", "release", "bin")
+
+# A search that only initializes: no state is within the bound.
+SEARCH = "astar(blind(), bound=0)"
+
+
+def run_search(bindir, task):
+    with open(task) as stdin:
+        output = subprocess.run([os.path.join(bindir, "downward"), "--search", SEARCH,
+                                 "--internal-plan-file", os.devnull],
+                                stdin=stdin, stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL, text=True).stdout
+    result = {}
+    for line in output.splitlines():
+        match = re.match(r"\[t=([0-9.e-]+)s.*\] (.*)", line)
+        if not match:
+            continue
+        if match.group(2) == "done reading input!":
+            result["load"] = float(match.group(1))
+        elif match.group(2).startswith("Total time:"):
+            result["total"] = float(match.group(1))
+    return result
+
+
+def run_preprocess(bindir, task):
+    with tempfile.TemporaryDirectory() as tmpdir, open(task) as stdin:
+        start = time.perf_counter()
+        subprocess.run([os.path.join(bindir, "preprocess-h2"), "--no_h2"],
+                       stdin=stdin, stdout=subprocess.DEVNULL,
+                       stderr=subprocess.DEVNULL, cwd=tmpdir, check=True)
+        return time.perf_counter() - start
+
+
+def print_result(name, text, binary):
+    if "load" not in text or "load" not in binary:
+        print("{}: no result [text: {}, binary: {}]".format(name, text, binary))
+        return
+    print("{}: search load {:.3f}s / {:.3f}s (speedup {:.1f}x), "
+          "search total {:.3f}s / {:.3f}s, preprocess-h2 {:.3f}s / {:.3f}s".format(
+              name, text["load"], binary["load"],
+              text["load"] / max(binary["load"], 1e-6),
+              text.get("total", 0), binary.get("total", 0),
+              text["preprocess"], binary["preprocess"]))
+
+
+def parse_options():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("tasks", nargs="+",
+                        help="Translated tasks (output.sas files).")
+    parser.add_argument("--bin", default=DEFAULT_BIN,
+                        help="Directory with the downward, preprocess-h2 and "
+                        "sas-converter binaries.")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    args = parse_options()
+    for task in args.tasks:
+        with tempfile.TemporaryDirectory() as tmpdir:
+            binary_task = os.path.join(tmpdir, "output.bin")
+            subprocess.run([os.path.join(args.bin, "sas-converter"), task, binary_task],
+                           check=True)
+            results = []
+            for filename in [task, binary_task]:
+                result = run_search(args.bin, filename)
+                result["preprocess"] = run_preprocess(args.bin, filename)
+                results.append(result)
+            print_result(os.path.basename(task), *results)
@@ -56,9 +56,14 @@ def parse_options():
                         default='yannakakis', help='Successor generator method',
                         choices=('yannakakis',
                                  'join',
+                                 'flat_join',
+                                 'delta_join',
+                                 'adaptive_join',
                                  'random_join',
                                  'ordered_join',
-                                 'full_reducer'))
+                                 'full_reducer',
+                                 'yannakakis_indexed',
+                                 'full_reducer_indexed'))
     parser.add_argument('--state', action='store', help='Successor generator method',
                         default="sparse", choices=("sparse", "extensional"))
     parser.add_argument('--seed', action='store', help='Random seed.',
@@ -83,8 +88,29 @@ def parse_options():
                         help="flag if the novelty evaluation of a state should stop as soon as the w-value is defined")
     parser.add_argument("--unit-cost", action="store_true",
                            help="flag if the actions should be treated as unit-cost actions")
+    parser.add_argument("--incremental-grounding", action="store_true",
+                        help="flag if the delete-relaxation heuristics should keep the ground Datalog program between evaluations")
+    parser.add_argument("--threads", type=int, default=1,
+                        help="number of threads used to expand and evaluate nodes (gbfs and astar only)")
+    parser.add_argument("--batch-size", type=int, default=1,
+                        help="number of open nodes expanded together in each parallel step (gbfs and astar only)")
+    parser.add_argument("--deterministic", action="store_true",
+                        help="flag if the parallel search should assign nodes to threads round robin, "
+                             "so that its results are reproducible")
     parser.add_argument("--validate", action="store_true",
                         help="flag if VAL should be called to validate the plan found")
+    parser.add_argument("--partial-grounding", action="store_true",
+                        help="flag if the actions should only be grounded and written to --grounded-actions-file "
+                             "instead of searching for a plan")
+    parser.add_argument("--grounded-actions-file", default="grounded_actions",
+                        help="file the partial grounding writes the grounded actions to. The translator grounds "
+                             "them with '--actions-file FILE --skip-exploration' (see fast-downward.py --powerlifted-partial-grounding)")
+    parser.add_argument("--trained-model-folder",
+                        help="folder with good_rules.rules and bad_rules.rules to prioritize actions in the partial grounding")
+    parser.add_argument("--termination-condition", type=str, default=["default"], nargs="+",
+                        help="termination condition of the partial grounding, with the same arguments as in the translator")
+    parser.add_argument("--ignore-bad-actions", action="store_true",
+                        help="flag if the partial grounding should never ground actions evaluated as bad by the rules")
     args = parser.parse_args()
     if args.domain is None:
         args.domain = find_domain_filename(args.instance)
@@ -179,6 +205,12 @@ def main():
         CPP_EXTRA_OPTIONS += ['--novelty-early-stop', str(1)]
 
 
+    if options.incremental_grounding:
+        CPP_EXTRA_OPTIONS += ['--incremental-grounding', str(1)]
+
+    if options.deterministic:
+        CPP_EXTRA_OPTIONS += ['--deterministic', str(1)]
+
     # Checks if unit-cost flag is true
     if options.unit_cost:
         PYTHON_EXTRA_OPTIONS += ["--unit-cost"]
@@ -186,6 +218,15 @@ def main():
     if options.useful_facts_file:
         CPP_EXTRA_OPTIONS += ['--useful-facts-file', options.useful_facts_file]
 
+    if options.partial_grounding:
+        CPP_EXTRA_OPTIONS += ['--partial-grounding', str(1),
+                              '--grounded-actions-file', options.grounded_actions_file,
+                              '--termination-condition', ' '.join(options.termination_condition)]
+        if options.trained_model_folder:
+            CPP_EXTRA_OPTIONS += ['--trained-model-folder', options.trained_model_folder]
+        if options.ignore_bad_actions:
+            CPP_EXTRA_OPTIONS += ['--ignore-bad-actions', str(1)]
+
     # Invoke the Python preprocessor
     translator = subprocess.Popen([os.path.join(build_dir, 'translator', 'translate.py'),
                                    options.domain, options.instance, '--output-file', options.translator_file] + PYTHON_EXTRA_OPTIONS)
@@ -202,7 +243,9 @@ def main():
            '-e', options.heuristic,
            '-g', options.generator,
            '-r', options.state,
-           '--seed', str(options.seed)] + \
+           '--seed', str(options.seed),
+           '--threads', str(options.threads),
+           '--batch-size', str(options.batch_size)] + \
            CPP_EXTRA_OPTIONS
 
     print(f'Executing "{" ".join(cmd)}"')
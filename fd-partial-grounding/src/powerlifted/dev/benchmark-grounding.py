@@ -0,0 +1,89 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import argparse
+import os
+import subprocess
+
+from itertools import product
+
+"""
+This benchmark compares the incremental grounding of the delete-relaxation
+heuristics (--incremental-grounding 1) against the full recomputation of the
+Datalog program in every evaluation.
+
+It runs the search component directly on translated tasks (.lifted files) and
+reports, for every task and heuristic, the search time of both versions and
+whether they expanded the same number of states and found plans of the same
+length.
+
+"""
+
+BASEDIR = os.path.abspath(os.path.join(os.path.dirname(__file__), ".."))
+DEFAULT_SEARCH = os.path.join(BASEDIR, '..', '..', 'builds', 'powerlifted-release', 'bin', 'search', 'search')
+
+HEURISTIC_CONFIGS = ['add', 'hmax', 'ff', 'rff']
+
+
+def run(search, task, heuristic, args, incremental):
+    cmd = [search,
+           '-f', task,
+           '-s', args.search,
+           '-e', heuristic,
+           '-g', args.generator,
+           '--incremental-grounding', str(int(incremental))]
+    try:
+        output = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                                timeout=args.time_limit).stdout
+    except subprocess.TimeoutExpired:
+        return None
+
+    result = {}
+    for line in output.splitlines():
+        if line.startswith(b'Total time:'):
+            result['time'] = float(line.split()[2])
+        if line.startswith(b'Expanded ') and b'until last jump' not in line:
+            result['expanded'] = int(line.split()[1])
+        if line.startswith(b'Plan length:'):
+            result['length'] = int(line.split()[2])
+    return result
+
+
+def print_result(task, heuristic, full, incremental):
+    name = "{} with {}".format(os.path.basename(task), heuristic)
+    if full is None or incremental is None or 'time' not in full or 'time' not in incremental:
+        print("{}: no result [full: {}, incremental: {}]".format(name, full, incremental))
+        return
+    same = full.get('expanded') == incremental.get('expanded') and \
+        full.get('length') == incremental.get('length')
+    print("{}: full {:.2f}s, incremental {:.2f}s (speedup {:.1f}x), expanded {} / {}{}".format(
+        name, full['time'], incremental['time'],
+        full['time'] / max(incremental['time'], 1e-6),
+        full.get('expanded'), incremental.get('expanded'),
+        "" if same else " DIFFERENT"))
+
+
+def parse_options():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('tasks', nargs='+',
+                        help='Translated tasks (.lifted files).')
+    parser.add_argument('--search-binary', default=DEFAULT_SEARCH,
+                        help='Path to the search component.')
+    parser.add_argument('-s', '--search', default='gbfs',
+                        help='Search algorithm.')
+    parser.add_argument('-g', '--generator', default='yannakakis',
+                        help='Successor generator method.')
+    parser.add_argument('-e', '--heuristic', action='append', dest='heuristics',
+                        help='Heuristic to compare (can be repeated).')
+    parser.add_argument('--time-limit', type=int, default=300,
+                        help='Time limit for each run (in seconds).')
+    return parser.parse_args()
+
+
+if __name__ == '__main__':
+    args = parse_options()
+    heuristics = args.heuristics if args.heuristics else HEURISTIC_CONFIGS
+    for task, heuristic in product(args.tasks, heuristics):
+        full = run(args.search_binary, task, heuristic, args, False)
+        incremental = run(args.search_binary, task, heuristic, args, True)
+        print_result(task, heuristic, full, incremental)
@@ -44,6 +44,11 @@ class DynamicBitset {
         return Block(1) << bit_index(pos);
     }
 
+    static std::size_t lowest_bit(Block block) {
+        assert(block != zeros);
+        return __builtin_ctzll(static_cast<unsigned long long>(block));
+    }
+
     int count_bits_in_last_block() const {
         return bit_index(num_bits);
     }
@@ -109,6 +114,30 @@ public:
         return test(pos);
     }
 
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    //! Position of the first set bit at position pos or later, or npos.
+    std::size_t find_from(std::size_t pos) const {
+        if (pos >= num_bits)
+            return npos;
+        std::size_t i = block_index(pos);
+        Block block = blocks[i] & (ones << bit_index(pos));
+        while (block == zeros) {
+            if (++i == blocks.size())
+                return npos;
+            block = blocks[i];
+        }
+        return i * bits_per_block + lowest_bit(block);
+    }
+
+    std::size_t find_first() const {
+        return find_from(0);
+    }
+
+    std::size_t find_next(std::size_t pos) const {
+        return find_from(pos + 1);
+    }
+
     bool intersects(const DynamicBitset &other) const {
         assert(size() == other.size());
         for (std::size_t i = 0; i < blocks.size(); ++i) {
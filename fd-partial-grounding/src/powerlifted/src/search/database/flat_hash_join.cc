@@ -0,0 +1,152 @@
+#include "flat_hash_join.h"
+#include "table.h"
+#include "utils.h"
+
+#include "../utils/hash.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+JoinArena::JoinArena(unsigned num_objects) : bits_per_value(1) {
+    while (bits_per_value < 32 && (1u << bits_per_value) <= num_objects)
+        ++bits_per_value;
+}
+
+static inline uint64_t compute_key(const int *row,
+                                   const vector<int> &columns,
+                                   bool exact_key,
+                                   unsigned bits_per_value)
+{
+    if (exact_key) {
+        uint64_t key = 0;
+        for (int c : columns) {
+            assert(row[c] >= 0);
+            key = (key << bits_per_value) | static_cast<uint64_t>(row[c]);
+        }
+        return key;
+    }
+    utils::HashState hash_state;
+    for (int c : columns) {
+        utils::feed(hash_state, row[c]);
+    }
+    return hash_state.get_hash64();
+}
+
+static inline bool same_key(const int *row1, const vector<int> &columns1,
+                            const int *row2, const vector<int> &columns2)
+{
+    for (size_t i = 0; i < columns1.size(); ++i) {
+        if (row1[columns1[i]] != row2[columns2[i]])
+            return false;
+    }
+    return true;
+}
+
+static inline bool violates_inequality(const int *row,
+                                       const vector<pair<int, int>> &inequality_columns)
+{
+    for (const auto &ineq : inequality_columns) {
+        if (row[ineq.first] == row[ineq.second])
+            return true;
+    }
+    return false;
+}
+
+void flat_hash_join(FlatTable &t1, const FlatTable &t2, JoinArena &arena,
+                    const vector<pair<int, int>> &inequality_columns)
+{
+    /*
+     * Same algorithm as hash_join (see hash_join.cc), but over flat tables:
+     *
+     * 1. Check which indexes have the same argument
+     * 2. If there is no match, we perform a cartesian product
+     * 3. Otherwise, build a hash table over t1 and probe it with the tuples of t2
+     */
+    auto &matches1 = arena.matches1;
+    auto &matches2 = arena.matches2;
+    matches1.clear();
+    matches2.clear();
+    compute_matching_columns(t1.tuple_index, t2.tuple_index, matches1, matches2);
+    assert(matches1.size() == matches2.size());
+
+    const size_t arity1 = t1.arity();
+    const size_t arity2 = t2.arity();
+    const size_t n1 = t1.size();
+    const size_t n2 = t2.size();
+
+    auto &output = arena.output;
+    output.clear();
+
+    // Note that t1.row() cannot be used once t1.tuple_index has been extended,
+    // so we compute row offsets with the original arity.
+    const int *data1 = t1.tuples.data();
+
+    if (matches1.empty()) {
+        output.reserve(n1 * n2 * (arity1 + arity2));
+        for (size_t i = 0; i < n1; ++i) {
+            const int *r1 = data1 + i * arity1;
+            for (size_t j = 0; j < n2; ++j) {
+                const int *r2 = t2.row(j);
+                size_t start = output.size();
+                output.insert(output.end(), r1, r1 + arity1);
+                output.insert(output.end(), r2, r2 + arity2);
+                if (violates_inequality(output.data() + start, inequality_columns))
+                    output.resize(start);
+            }
+        }
+        t1.tuple_index.insert(t1.tuple_index.end(), t2.tuple_index.begin(), t2.tuple_index.end());
+        t1.tuples.swap(output);
+        return;
+    }
+
+    assert(n1 < JoinArena::NO_ROW);
+    const bool exact_key = matches1.size() * arena.bits_per_value <= 64;
+
+    // Build phase. Rows are inserted in reverse order so that each chain lists
+    // them in the original order, which keeps the output identical to hash_join.
+    auto &heads = arena.heads;
+    auto &next = arena.next;
+    heads.clear();
+    heads.reserve(n1);
+    next.assign(n1, JoinArena::NO_ROW);
+    for (size_t i = n1; i-- > 0;) {
+        uint64_t key = compute_key(data1 + i * arity1, matches1, exact_key, arena.bits_per_value);
+        auto res = heads.emplace(key, static_cast<uint32_t>(i));
+        if (!res.second) {
+            next[i] = res.first->second;
+            res.first->second = static_cast<uint32_t>(i);
+        }
+    }
+
+    auto &to_keep = arena.to_keep;
+    to_keep.clear();
+    for (size_t j = 0; j < arity2; ++j) {
+        if (find(matches2.begin(), matches2.end(), int(j)) == matches2.end()) {
+            to_keep.push_back(j);
+        }
+    }
+
+    // Probe phase
+    for (size_t j = 0; j < n2; ++j) {
+        const int *r2 = t2.row(j);
+        auto it = heads.find(compute_key(r2, matches2, exact_key, arena.bits_per_value));
+        if (it == heads.end())
+            continue;
+        for (uint32_t i = it->second; i != JoinArena::NO_ROW; i = next[i]) {
+            const int *r1 = data1 + i * arity1;
+            if (!exact_key && !same_key(r1, matches1, r2, matches2))
+                continue;
+            size_t start = output.size();
+            output.insert(output.end(), r1, r1 + arity1);
+            for (int c : to_keep)
+                output.push_back(r2[c]);
+            if (violates_inequality(output.data() + start, inequality_columns))
+                output.resize(start);
+        }
+    }
+    for (int c : to_keep)
+        t1.tuple_index.push_back(t2.tuple_index[c]);
+    t1.tuples.swap(output);
+}
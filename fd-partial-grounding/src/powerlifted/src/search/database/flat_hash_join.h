@@ -0,0 +1,61 @@
+#ifndef SEARCH_FLAT_HASH_JOIN_H
+#define SEARCH_FLAT_HASH_JOIN_H
+
+#include "../parallel_hashmap/phmap.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class FlatTable;
+
+/**
+ * @brief Scratch memory reused across calls to flat_hash_join.
+ *
+ * @details All buffers keep their capacity between joins, so once the arena has
+ * warmed up, a join only allocates when some intermediate result is larger than
+ * everything seen so far. One arena must not be shared between threads.
+ *
+ * @var bits_per_value: Number of bits needed to represent any object index. Keys
+ * with k join columns are packed into a single 64-bit integer if k*bits_per_value <= 64,
+ * otherwise they are hashed and candidates are verified column by column.
+ */
+class JoinArena {
+public:
+    explicit JoinArena(unsigned num_objects);
+
+    unsigned bits_per_value;
+
+    //! Head of the chain of build-side rows for each key
+    phmap::flat_hash_map<std::uint64_t, std::uint32_t> heads;
+    //! Next row in the chain of each build-side row
+    std::vector<std::uint32_t> next;
+    //! Output buffer; swapped with the tuples of the working table after each join
+    std::vector<int> output;
+    //! Columns of the join matching the first and second table, respectively
+    std::vector<int> matches1, matches2;
+    //! Columns of the second table that are appended to the output
+    std::vector<int> to_keep;
+
+    static constexpr std::uint32_t NO_ROW = UINT32_MAX;
+};
+
+/**
+ * @brief Hash join two flat tables. The result is written to t1.
+ *
+ * @details Same semantics and output order as hash_join: build a hash table over
+ * t1 keyed by the join columns, then probe it with each tuple of t2. Join keys are
+ * projected into fixed-width 64-bit integers instead of freshly allocated
+ * vectors, build-side rows are chained by index, and output rows are written
+ * into the arena, so no allocation happens per tuple.
+ *
+ * Output rows for which some pair of columns in `inequality_columns` (indexes
+ * of the resulting table) hold the same value are dropped right away, so
+ * inequalities are checked without an extra pass over the result.
+ *
+ * @see hash_join.h
+ */
+void flat_hash_join(FlatTable &t1, const FlatTable &t2, JoinArena &arena,
+                    const std::vector<std::pair<int, int>> &inequality_columns = {});
+
+#endif //SEARCH_FLAT_HASH_JOIN_H
@@ -1,6 +1,7 @@
 #ifndef SEARCH_TABLE_H
 #define SEARCH_TABLE_H
 
+#include <cassert>
 #include <vector>
 
 /**
@@ -31,4 +32,57 @@ public:
 };
 
 
+/**
+ * @brief Table whose tuples are stored row-major in a single contiguous array.
+ *
+ * @details Same semantics as Table, but a table with n tuples of arity k needs
+ * a single buffer of n*k integers instead of n separately allocated vectors.
+ * Used by the allocation-free join kernel.
+ *
+ * @see flat_hash_join.h
+ */
+class FlatTable {
+public:
+    /// @var tuples: Row-major array with all tuples of the table
+    std::vector<int> tuples;
+    /// @var tuple_index: Indices of each variable in order
+    std::vector<int> tuple_index;
+
+    FlatTable() = default;
+
+    FlatTable(std::vector<int> &&tuples, std::vector<int> &&tuple_index) :
+        tuples(std::move(tuples)),
+        tuple_index(std::move(tuple_index))
+    {}
+
+    explicit FlatTable(const Table &table) : tuple_index(table.tuple_index) {
+        tuples.reserve(table.tuples.size() * table.tuple_index.size());
+        for (const auto &t : table.tuples) {
+            assert(t.size() == table.tuple_index.size());
+            tuples.insert(tuples.end(), t.begin(), t.end());
+        }
+    }
+
+    std::size_t arity() const {
+        return tuple_index.size();
+    }
+
+    std::size_t size() const {
+        return tuple_index.empty() ? 0 : tuples.size() / tuple_index.size();
+    }
+
+    bool empty() const {
+        return tuples.empty();
+    }
+
+    const int *row(std::size_t i) const {
+        return tuples.data() + i * tuple_index.size();
+    }
+
+    bool index_is_variable(std::size_t i) const {
+        return tuple_index[i] >= 0;
+    }
+};
+
+
 #endif //SEARCH_TABLE_H
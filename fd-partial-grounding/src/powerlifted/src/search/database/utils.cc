@@ -19,16 +19,21 @@ std::vector<std::pair<int, int>> compute_matching_columns(const Table &t1, const
 }
 
 void compute_matching_columns(const Table &t1, const Table &t2, std::vector<int>& matches1, std::vector<int>& matches2) {
-    vector<pair<int, int>> matches;
-    auto sz1 = t1.tuple_index.size();
-    auto sz2 = t2.tuple_index.size();
+    compute_matching_columns(t1.tuple_index, t2.tuple_index, matches1, matches2);
+}
+
+void compute_matching_columns(const std::vector<int> &tuple_index1,
+                              const std::vector<int> &tuple_index2,
+                              std::vector<int>& matches1,
+                              std::vector<int>& matches2) {
+    auto sz1 = tuple_index1.size();
+    auto sz2 = tuple_index2.size();
     for (size_t i = 0; i < sz1; ++i) {
         for (size_t j = 0; j < sz2; ++j) {
-            if (t1.tuple_index[i] == t2.tuple_index[j]) {
+            if (tuple_index1[i] == tuple_index2[j]) {
                 matches1.push_back(i);
                 matches2.push_back(j);
             }
         }
     }
 }
-
@@ -11,4 +11,9 @@ std::vector<std::pair<int, int>> compute_matching_columns(const Table &t1, const
 
 void compute_matching_columns(const Table &t1, const Table &t2, std::vector<int>& matches1, std::vector<int>& matches2);
 
+void compute_matching_columns(const std::vector<int> &tuple_index1,
+                              const std::vector<int> &tuple_index2,
+                              std::vector<int>& matches1,
+                              std::vector<int>& matches2);
+
 #endif //SEARCH_SEMI_JOIN_H
@@ -10,6 +10,7 @@
 #include "transformations/remove_equivalent_rules.h"
 #include "transformations/variable_renaming.h"
 
+#include <cassert>
 #include <iostream>
 #include <memory>
 #include <stack>
@@ -83,6 +84,12 @@ void Datalog::generate_action_effect_rules(const ActionSchema &schema, Annotatio
     }
 }
 
+int Datalog::get_action_predicate_idx(const ActionSchema &schema) const {
+    auto it = map_new_predicates_to_idx.find("action-" + schema.get_name());
+    assert(it != map_new_predicates_to_idx.end());
+    return it->second;
+}
+
 vector<DatalogAtom> Datalog::get_action_effect_rule_body(const ActionSchema &schema) {
     vector<DatalogAtom> body(1);
     string action_predicate = "action-" + schema.get_name();
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace datalog {
@@ -116,6 +117,9 @@ public:
         return goal_atom_idx;
     }
 
+    // Index of the predicate "action-<schema>" in the head of the action rule of the schema
+    int get_action_predicate_idx(const ActionSchema &schema) const;
+
     const std::vector<Fact> &get_permanent_edb();
 
     const std::vector<Fact> &get_facts();
@@ -136,6 +140,10 @@ public:
         facts[fact].set_cost(cost);
     }
 
+    void update_fact_achievers(int fact, Achievers achievers) {
+        facts[fact].update_achievers(std::move(achievers));
+    }
+
     void update_rule_indices() {
         for (size_t i = 0; i < rules.size(); ++i) {
             rules[i]->update_index(int(i));
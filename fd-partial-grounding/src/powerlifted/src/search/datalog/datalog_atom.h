@@ -22,7 +22,8 @@ class DatalogAtom {
     int predicate_index;
     int index;
     bool new_pred_symbol; // If atom has a predicate symbol that is not an atom in the task
-    static int next_index;
+    // Thread-local, so that heuristics can be evaluated concurrently
+    static thread_local int next_index;
 
 public:
     DatalogAtom(Arguments arguments, int predicate_index, bool new_pred_symbol) :
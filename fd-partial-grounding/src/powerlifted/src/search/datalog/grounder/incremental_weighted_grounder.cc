@@ -0,0 +1,256 @@
+#include "incremental_weighted_grounder.h"
+
+#include "../datalog.h"
+
+#include "../rules/join.h"
+#include "../rules/product.h"
+#include "../rules/project.h"
+
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+namespace datalog {
+
+IncrementalWeightedGrounder::IncrementalWeightedGrounder(const Datalog &lp, int h, size_t max_ground_rules)
+    : WeightedGrounder(lp, h), max_ground_rules(max_ground_rules), evaluation(0), number_of_resets(0) {
+    ground_product_of_rule.assign(lp.get_rules().size(), -1);
+}
+
+void IncrementalWeightedGrounder::reset(Datalog &datalog) {
+    WeightedGrounder::clean_up(datalog);
+    known_facts.clear();
+    expanded.clear();
+    rules_of_fact.clear();
+    products_of_fact.clear();
+    ground_rules.clear();
+    ground_products.clear();
+    fill(ground_product_of_rule.begin(), ground_product_of_rule.end(), -1);
+    reached_stamp.clear();
+    closed_stamp.clear();
+    fact_cost.clear();
+    rule_stamp.clear();
+    unsatisfied_conditions.clear();
+    product_stamp.clear();
+    satisfied_conditions.clear();
+    cheapest_facts.clear();
+    ++number_of_resets;
+}
+
+/*
+ * Return the index of the fact in the ground program, adding it if it was never
+ * reached before.
+ */
+int IncrementalWeightedGrounder::get_fact_index(Datalog &datalog, Fact &fact) {
+    const auto it = known_facts.find(fact);
+    if (it != known_facts.end())
+        return it->get_fact_index();
+
+    int index = expanded.size();
+    fact.update_fact_index(index);
+    known_facts.insert(fact);
+    datalog.insert_fact(fact);
+    expanded.push_back(false);
+    rules_of_fact.emplace_back();
+    products_of_fact.emplace_back();
+    reached_stamp.push_back(0);
+    closed_stamp.push_back(0);
+    fact_cost.push_back(0);
+    return index;
+}
+
+int IncrementalWeightedGrounder::get_ground_product(const RuleBase &rule) {
+    int &product = ground_product_of_rule[rule.get_index()];
+    if (product == -1) {
+        product = ground_products.size();
+        ground_products.emplace_back(rule.get_index(), rule.get_weight(), rule.get_conditions().size());
+        product_stamp.push_back(0);
+        satisfied_conditions.push_back(0);
+        cheapest_facts.emplace_back(rule.get_conditions().size(), -1);
+    }
+    return product;
+}
+
+int IncrementalWeightedGrounder::ground(Datalog &datalog, std::vector<Fact> &state_facts, int goal_predicate) {
+    if (ground_rules.size() > max_ground_rules)
+        reset(datalog);
+
+    ++evaluation;
+    q.clear();
+    initial_facts.clear();
+
+    auto add_initial_fact = [&](Fact &f) {
+        int index = get_fact_index(datalog, f);
+        initial_facts.insert(index);
+        if (reached_stamp[index] == evaluation and fact_cost[index] <= f.get_cost())
+            return;
+        reached_stamp[index] = evaluation;
+        fact_cost[index] = f.get_cost();
+        datalog.update_fact_cost(index, f.get_cost());
+        datalog.update_fact_achievers(index, f.get_achievers());
+        q.push(f.get_cost(), index);
+    };
+
+    for (const Fact &f : datalog.get_permanent_edb()) {
+        Fact f2 = f;
+        add_initial_fact(f2);
+    }
+    for (Fact &f : state_facts) {
+        add_initial_fact(f);
+    }
+
+    while (!q.empty()) {
+        pair<int, int> queue_top = q.pop();
+        int cost = queue_top.first;
+        int fact_index = queue_top.second;
+        if (is_closed(fact_index) or fact_cost[fact_index] < cost) {
+            continue;
+        }
+        closed_stamp[fact_index] = evaluation;
+
+        if (datalog.get_fact_by_index(fact_index).get_predicate_index() == goal_predicate) {
+            datalog.backchain_from_goal(datalog.get_fact_by_index(fact_index), initial_facts);
+            return cost;
+        }
+
+        // Ground rules found while expanding the fact are initialized with the
+        // facts closed so far (including this one), so they are not counted below.
+        size_t num_known_rules = rules_of_fact[fact_index].size();
+        if (!expanded[fact_index]) {
+            expand(datalog, fact_index);
+        }
+
+        for (size_t i = 0; i < num_known_rules; ++i) {
+            int r = rules_of_fact[fact_index][i];
+            if (rule_stamp[r] != evaluation) {
+                rule_stamp[r] = evaluation;
+                unsatisfied_conditions[r] = ground_rules[r].body.size();
+            }
+            if (--unsatisfied_conditions[r] == 0) {
+                fire(datalog, ground_rules[r]);
+            }
+        }
+
+        // Firing a product might add its head to products_of_fact, so we use indices
+        for (size_t i = 0; i < products_of_fact[fact_index].size(); ++i) {
+            auto [product, position] = products_of_fact[fact_index][i];
+            if (product_stamp[product] != evaluation) {
+                product_stamp[product] = evaluation;
+                satisfied_conditions[product] = 0;
+                fill(cheapest_facts[product].begin(), cheapest_facts[product].end(), -1);
+            }
+            // Facts are closed in order of cost, so the first one is the cheapest
+            if (cheapest_facts[product][position] != -1)
+                continue;
+            cheapest_facts[product][position] = fact_index;
+            if (++satisfied_conditions[product] == ground_products[product].num_conditions) {
+                fire_product(datalog, product);
+            }
+        }
+    }
+    return std::numeric_limits<int>::max();
+}
+
+/*
+ * Match a fact reached for the first time against the rules, as the
+ * WeightedGrounder does, and store the ground rules produced.
+ */
+void IncrementalWeightedGrounder::expand(Datalog &datalog, int fact_index) {
+    expanded[fact_index] = true;
+    const Fact fact = datalog.get_fact_by_index(fact_index);
+    for (const auto &m : rule_matcher.get_matched_rules(fact.get_predicate_index())) {
+        int position_in_the_body = m.get_position();
+        RuleBase &rule = datalog.get_rule_by_index(m.get_rule());
+
+        newfacts.clear();
+        if (rule.get_type() == PROJECT) {
+            project(rule, fact, newfacts);
+        } else if (rule.get_type() == JOIN) {
+            join(rule, fact, position_in_the_body, newfacts);
+        } else if (rule.head_is_ground()) {
+            // Only keep track of the conditions matched by the fact
+            int c = 0;
+            bool matches = true;
+            for (const auto &term : rule.get_condition_arguments(position_in_the_body)) {
+                if (term.is_object() and term.get_index() != fact.argument(c).get_index()) {
+                    matches = false;
+                    break;
+                }
+                ++c;
+            }
+            if (matches) {
+                products_of_fact[fact_index].emplace_back(get_ground_product(rule), position_in_the_body);
+            }
+        } else {
+            product(rule, fact, position_in_the_body, newfacts);
+        }
+
+        for (Fact &new_fact : newfacts) {
+            add_ground_rule(datalog, new_fact);
+        }
+    }
+}
+
+void IncrementalWeightedGrounder::add_ground_rule(Datalog &datalog, Fact &new_fact) {
+    int head = get_fact_index(datalog, new_fact);
+    const Achievers &achievers = new_fact.get_achievers();
+    int r = ground_rules.size();
+    ground_rules.emplace_back(head,
+                              achievers.get_achiever_rule_index(),
+                              achievers.get_achiever_rule_cost(),
+                              vector<int>(achievers.begin(), achievers.end()));
+
+    int unsatisfied = 0;
+    for (int b : ground_rules[r].body) {
+        rules_of_fact[b].push_back(r);
+        if (!is_closed(b))
+            ++unsatisfied;
+    }
+    rule_stamp.push_back(evaluation);
+    unsatisfied_conditions.push_back(unsatisfied);
+    if (unsatisfied == 0) {
+        fire(datalog, ground_rules[r]);
+    }
+}
+
+void IncrementalWeightedGrounder::fire(Datalog &datalog, const GroundRule &rule) {
+    int cost = 0;
+    for (int b : rule.body) {
+        cost = aggregation_function(cost, fact_cost[b]);
+    }
+    relax(datalog, rule.head, cost + rule.weight, rule.rule_index, rule.weight, rule.body);
+}
+
+void IncrementalWeightedGrounder::fire_product(Datalog &datalog, int product) {
+    GroundProduct &p = ground_products[product];
+    if (p.head == -1) {
+        const RuleBase &rule = datalog.get_rule_by_index(p.rule_index);
+        Fact head(rule.get_effect_arguments(),
+                  rule.get_effect().get_predicate_index(),
+                  rule.get_effect().is_pred_symbol_new());
+        p.head = get_fact_index(datalog, head);
+    }
+    int cost = 0;
+    for (int f : cheapest_facts[product]) {
+        cost = aggregation_function(cost, fact_cost[f]);
+    }
+    relax(datalog, p.head, cost + p.weight, p.rule_index, p.weight, cheapest_facts[product]);
+}
+
+void IncrementalWeightedGrounder::relax(Datalog &datalog,
+                                        int fact_index,
+                                        int cost,
+                                        int rule_index,
+                                        int weight,
+                                        const vector<int> &body) {
+    if (reached_stamp[fact_index] == evaluation and fact_cost[fact_index] <= cost)
+        return;
+    reached_stamp[fact_index] = evaluation;
+    fact_cost[fact_index] = cost;
+    datalog.update_fact_cost(fact_index, cost);
+    datalog.update_fact_achievers(fact_index, Achievers(body, rule_index, weight));
+    q.push(cost, fact_index);
+}
+
+}
@@ -0,0 +1,131 @@
+#ifndef GROUNDER_GROUNDERS_INCREMENTAL_WEIGHTED_GROUNDER_H_
+#define GROUNDER_GROUNDERS_INCREMENTAL_WEIGHTED_GROUNDER_H_
+
+#include "weighted_grounder.h"
+
+#include "../datalog_fact.h"
+
+#include "../../algorithms/priority_queues.h"
+#include "../../parallel_hashmap/phmap.h"
+
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace datalog {
+
+/*
+ * Weighted grounder that keeps the ground program between calls.
+ *
+ * Consecutive heuristic evaluations differ in a handful of state facts, but the
+ * WeightedGrounder rediscovers the whole ground program from scratch every
+ * time: every fact is inserted in the hash tables of the join rules again and
+ * every join is recomputed. This grounder materializes the program instead.
+ * The first time a fact is expanded (in any call), it is matched against the
+ * rules exactly as in the WeightedGrounder, and every ground rule found this way
+ * is stored together with the facts of its body. The rule hash tables are never
+ * cleaned, so each ground rule is found only once, when the last fact of its
+ * body is expanded for the first time.
+ *
+ * Each call to ground() then is a Knuth-Dijkstra pass over the stored ground
+ * rules: a ground rule fires when all facts of its body have been expanded in
+ * the current call. Only the facts that are reached for the first time require
+ * new joins. Ground rules with a ground head produced by product rules are
+ * handled separately: they fire with the cheapest fact of each condition.
+ *
+ * The costs (h_add or h_max) are exactly the ones of the WeightedGrounder. The
+ * best achievers are the ones of the current call, so that backchain_from_goal
+ * (and hence FF and RFF) works as before, although ties between achievers of
+ * equal cost might be broken differently.
+ *
+ * If the ground program grows beyond max_ground_rules, it is dropped and
+ * rebuilt from the next state on.
+ */
+class IncrementalWeightedGrounder : public WeightedGrounder {
+    struct GroundRule {
+        int head;
+        int rule_index;
+        int weight;
+        std::vector<int> body;
+
+        GroundRule(int head, int rule_index, int weight, std::vector<int> body)
+            : head(head), rule_index(rule_index), weight(weight), body(std::move(body)) {}
+    };
+
+    // Product rule with ground head: fires with the cheapest fact of each condition
+    struct GroundProduct {
+        int rule_index;
+        int weight;
+        int head;
+        int num_conditions;
+
+        GroundProduct(int rule_index, int weight, int num_conditions)
+            : rule_index(rule_index), weight(weight), head(-1), num_conditions(num_conditions) {}
+    };
+
+    std::size_t max_ground_rules;
+
+    // Persistent part: all facts and ground rules found so far
+    phmap::flat_hash_set<Fact> known_facts;
+    std::vector<bool> expanded;
+    std::vector<std::vector<int>> rules_of_fact;
+    std::vector<std::vector<std::pair<int, int>>> products_of_fact;
+    std::vector<GroundRule> ground_rules;
+    std::vector<GroundProduct> ground_products;
+    std::vector<int> ground_product_of_rule;
+
+    // Per-call part, only valid if the stamp matches the current evaluation
+    unsigned evaluation;
+    std::vector<unsigned> reached_stamp;
+    std::vector<unsigned> closed_stamp;
+    std::vector<int> fact_cost;
+    std::vector<unsigned> rule_stamp;
+    std::vector<int> unsatisfied_conditions;
+    std::vector<unsigned> product_stamp;
+    std::vector<int> satisfied_conditions;
+    std::vector<std::vector<int>> cheapest_facts;
+
+    priority_queues::AdaptiveQueue<int> q;
+    phmap::flat_hash_set<int> initial_facts;
+    std::vector<Fact> newfacts;
+
+    int number_of_resets;
+
+    void reset(Datalog &datalog);
+
+    int get_fact_index(Datalog &datalog, Fact &fact);
+    int get_ground_product(const RuleBase &rule);
+
+    void expand(Datalog &datalog, int fact_index);
+    void add_ground_rule(Datalog &datalog, Fact &new_fact);
+
+    bool is_closed(int fact_index) const {
+        return closed_stamp[fact_index] == evaluation;
+    }
+
+    void fire(Datalog &datalog, const GroundRule &rule);
+    void fire_product(Datalog &datalog, int product);
+    void relax(Datalog &datalog, int fact_index, int cost, int rule_index, int weight,
+               const std::vector<int> &body);
+
+public:
+    IncrementalWeightedGrounder(const Datalog &lp, int h, std::size_t max_ground_rules = 10000000);
+
+    ~IncrementalWeightedGrounder() override = default;
+
+    int ground(Datalog &datalog, std::vector<Fact> &state_facts, int goal_predicate) override;
+
+    // The ground program is kept for the next call
+    void clean_up(Datalog &) override {}
+
+    void print_statistics(const Datalog &lp) override {
+        std::cout << lp.get_number_of_facts() << " facts in the ground program" << std::endl;
+        std::cout << ground_rules.size() << " ground rules" << std::endl;
+        std::cout << number_of_resets << " resets of the ground program" << std::endl;
+    }
+};
+
+}
+
+#endif //GROUNDER_GROUNDERS_INCREMENTAL_WEIGHTED_GROUNDER_H_
@@ -100,6 +100,12 @@ int WeightedGrounder::ground(Datalog &datalog, std::vector<Fact> &state_facts, i
     return std::numeric_limits<int>::max();
 }
 
+void WeightedGrounder::clean_up(Datalog &datalog) {
+    datalog.reset_facts();
+    for (const auto &r : datalog.get_rules())
+        r->clean_up();
+}
+
 int WeightedGrounder::is_cheapest_path_to_achieve_fact(Fact &new_fact,
                                                        phmap::flat_hash_set<Fact> &reached_facts,
                                                        Datalog &lp) {
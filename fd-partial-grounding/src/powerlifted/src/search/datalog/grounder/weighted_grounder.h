@@ -64,6 +64,9 @@ public:
 
     int ground(Datalog &datalog, std::vector<Fact> &state_facts, int goal_predicate) override;
 
+    // Drop the facts reached in the last call to ground() and the rule hash tables
+    virtual void clean_up(Datalog &datalog);
+
     void print_statistics(const Datalog &lp) override {
         std::cout << lp.get_number_of_facts() << " final number of facts" << std::endl;
         std::cout << atoms_produced << " total atoms produced" << std::endl;
@@ -2,6 +2,6 @@
 
 namespace datalog {
 
-int Object::next_index = 0;
+thread_local int Object::next_index = 0;
 
 }
\ No newline at end of file
@@ -13,7 +13,8 @@ namespace datalog {
  *
  */
 class Object {
-    static int next_index;
+    // Thread-local, like the indices of atoms and facts
+    static thread_local int next_index;
     int index = -1;
     std::string name;
 
@@ -0,0 +1,297 @@
+#ifndef SEARCH_FLAT_TUPLE_SET_H
+#define SEARCH_FLAT_TUPLE_SET_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Read-only view of a tuple stored contiguously somewhere else (e.g.,
+ * inside a FlatTupleSet or a std::vector<int>).
+ *
+ * @details Views are cheap to copy and never own memory. They implicitly convert
+ * to std::vector<int> so that code expecting a GroundAtom keeps working, but
+ * that conversion allocates and should be avoided in hot loops.
+ */
+class TupleView {
+    const int *first;
+    std::size_t length;
+
+public:
+    TupleView() : first(nullptr), length(0) {}
+    TupleView(const int *first, std::size_t length) : first(first), length(length) {}
+    TupleView(const std::vector<int> &v) : first(v.data()), length(v.size()) {}
+
+    const int *begin() const { return first; }
+    const int *end() const { return first + length; }
+    const int *data() const { return first; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    int operator[](std::size_t i) const {
+        assert(i < length);
+        return first[i];
+    }
+
+    std::vector<int> to_vector() const {
+        return std::vector<int>(first, first + length);
+    }
+
+    operator std::vector<int>() const {
+        return to_vector();
+    }
+
+    bool operator==(const TupleView &other) const {
+        return length == other.length && std::equal(first, first + length, other.first);
+    }
+
+    bool operator!=(const TupleView &other) const {
+        return !(*this == other);
+    }
+};
+
+
+/**
+ * @brief Set of tuples of a fixed arity stored as one contiguous, lexicographically
+ * sorted array of integers.
+ *
+ * @details The i-th tuple occupies positions [i*arity, (i+1)*arity) of the array.
+ * Compared to an unordered_set<vector<int>>, this needs a single allocation per
+ * relation, copies are a memcpy, and iteration is a linear scan. Membership tests
+ * use binary search. Insertions and deletions shift the tail of the array, which
+ * is cheap for the handful of effects applied per successor.
+ *
+ * The arity is fixed by the first inserted tuple (or explicitly by set_arity).
+ * Nullary sets are supported: they contain at most the empty tuple.
+ *
+ * Bulk construction should use push_back_unsorted() followed by a single call
+ * to sort_and_remove_duplicates().
+ */
+class FlatTupleSet {
+    int tuple_arity;
+    std::size_t num_tuples;
+    std::vector<int> data;
+
+    static int compare(const int *a, const int *b, int arity) {
+        // Arity-specialised comparisons; most predicates have arity 1 or 2.
+        switch (arity) {
+        case 1:
+            return (a[0] < b[0]) ? -1 : (a[0] > b[0]);
+        case 2:
+            if (a[0] != b[0]) return (a[0] < b[0]) ? -1 : 1;
+            return (a[1] < b[1]) ? -1 : (a[1] > b[1]);
+        default:
+            for (int i = 0; i < arity; ++i) {
+                if (a[i] != b[i]) return (a[i] < b[i]) ? -1 : 1;
+            }
+            return 0;
+        }
+    }
+
+    /*
+     * Index of the first tuple whose first `len` positions are not smaller than
+     * `key`. With len == arity this is the usual lower bound.
+     */
+    std::size_t lower_bound(const int *key, int len) const {
+        std::size_t lo = 0, hi = num_tuples;
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (compare(row_ptr(mid), key, len) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    std::size_t upper_bound(const int *key, int len) const {
+        std::size_t lo = 0, hi = num_tuples;
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (compare(row_ptr(mid), key, len) <= 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    const int *row_ptr(std::size_t i) const {
+        return data.data() + i * tuple_arity;
+    }
+
+public:
+    class const_iterator {
+        const int *base;
+        std::size_t index;
+        int arity;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = TupleView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TupleView;
+
+        const_iterator(const int *base, std::size_t index, int arity)
+            : base(base), index(index), arity(arity) {}
+
+        TupleView operator*() const {
+            return TupleView(base + index * arity, arity);
+        }
+
+        const_iterator &operator++() {
+            ++index;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator tmp(*this);
+            ++index;
+            return tmp;
+        }
+
+        difference_type operator-(const const_iterator &other) const {
+            return difference_type(index) - difference_type(other.index);
+        }
+
+        std::size_t position() const { return index; }
+
+        bool operator==(const const_iterator &other) const { return index == other.index; }
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+    };
+
+    FlatTupleSet() : tuple_arity(-1), num_tuples(0) {}
+    explicit FlatTupleSet(int arity) : tuple_arity(arity), num_tuples(0) {}
+
+    int arity() const { return tuple_arity; }
+
+    void set_arity(int arity) {
+        assert(num_tuples == 0 || tuple_arity == arity);
+        tuple_arity = arity;
+    }
+
+    std::size_t size() const { return num_tuples; }
+    bool empty() const { return num_tuples == 0; }
+
+    void clear() {
+        data.clear();
+        num_tuples = 0;
+    }
+
+    void reserve(std::size_t n) {
+        if (tuple_arity > 0) data.reserve(n * tuple_arity);
+    }
+
+    //! Raw access to the underlying row-major array
+    const std::vector<int> &get_data() const { return data; }
+
+    TupleView operator[](std::size_t i) const {
+        assert(i < num_tuples);
+        return TupleView(row_ptr(i), tuple_arity);
+    }
+
+    const_iterator begin() const { return const_iterator(data.data(), 0, tuple_arity); }
+    const_iterator end() const { return const_iterator(data.data(), num_tuples, tuple_arity); }
+
+    const_iterator find(TupleView t) const {
+        if (num_tuples == 0 || int(t.size()) != tuple_arity) return end();
+        std::size_t i = lower_bound(t.data(), tuple_arity);
+        if (i < num_tuples && compare(row_ptr(i), t.data(), tuple_arity) == 0)
+            return const_iterator(data.data(), i, tuple_arity);
+        return end();
+    }
+
+    std::size_t count(TupleView t) const {
+        return find(t) != end();
+    }
+
+    /**
+     * @brief Range [first, last) of the tuples whose first prefix.size() positions
+     * are equal to prefix.
+     */
+    std::pair<std::size_t, std::size_t> prefix_range(TupleView prefix) const {
+        assert(int(prefix.size()) <= tuple_arity || num_tuples == 0);
+        if (num_tuples == 0) return {0, 0};
+        int len = prefix.size();
+        return {lower_bound(prefix.data(), len), upper_bound(prefix.data(), len)};
+    }
+
+    //! Insert a tuple keeping the set sorted. Returns true iff the tuple was new.
+    bool insert(TupleView t) {
+        if (tuple_arity < 0) tuple_arity = t.size();
+        assert(int(t.size()) == tuple_arity);
+        std::size_t i = lower_bound(t.data(), tuple_arity);
+        if (i < num_tuples && compare(row_ptr(i), t.data(), tuple_arity) == 0)
+            return false;
+        data.insert(data.begin() + i * tuple_arity, t.begin(), t.end());
+        ++num_tuples;
+        return true;
+    }
+
+    //! Remove a tuple if present. Returns the number of removed tuples.
+    std::size_t erase(TupleView t) {
+        auto it = find(t);
+        if (it == end()) return 0;
+        auto first = data.begin() + it.position() * tuple_arity;
+        data.erase(first, first + tuple_arity);
+        --num_tuples;
+        return 1;
+    }
+
+    //! Append a tuple without restoring the order. Call sort_and_remove_duplicates() afterwards.
+    void push_back_unsorted(TupleView t) {
+        if (tuple_arity < 0) tuple_arity = t.size();
+        assert(int(t.size()) == tuple_arity);
+        data.insert(data.end(), t.begin(), t.end());
+        ++num_tuples;
+    }
+
+    void sort_and_remove_duplicates() {
+        if (num_tuples <= 1) return;
+        if (tuple_arity == 0) {
+            num_tuples = 1;
+            return;
+        }
+        bool sorted = true;
+        for (std::size_t i = 1; i < num_tuples && sorted; ++i) {
+            sorted = compare(row_ptr(i - 1), row_ptr(i), tuple_arity) < 0;
+        }
+        if (sorted) return;
+
+        if (tuple_arity == 1) {
+            std::sort(data.begin(), data.end());
+            data.erase(std::unique(data.begin(), data.end()), data.end());
+            num_tuples = data.size();
+            return;
+        }
+
+        std::vector<std::size_t> perm(num_tuples);
+        std::iota(perm.begin(), perm.end(), 0);
+        std::sort(perm.begin(), perm.end(), [this](std::size_t a, std::size_t b) {
+            return compare(row_ptr(a), row_ptr(b), tuple_arity) < 0;
+        });
+        std::vector<int> sorted_data;
+        sorted_data.reserve(data.size());
+        const int *last = nullptr;
+        for (std::size_t i : perm) {
+            const int *r = row_ptr(i);
+            if (last && compare(last, r, tuple_arity) == 0) continue;
+            sorted_data.insert(sorted_data.end(), r, r + tuple_arity);
+            last = r;
+        }
+        data = std::move(sorted_data);
+        num_tuples = data.size() / tuple_arity;
+    }
+
+    bool operator==(const FlatTupleSet &other) const {
+        if (num_tuples != other.num_tuples) return false;
+        if (num_tuples == 0) return true;
+        return tuple_arity == other.tuple_arity && data == other.data;
+    }
+};
+
+#endif //SEARCH_FLAT_TUPLE_SET_H
@@ -9,17 +9,19 @@
 
 #include "../datalog/grounder/weighted_grounder.h"
 
+#include <memory>
+
 class AdditiveHeuristic : public Heuristic{
 
     datalog::Datalog datalog;
-    datalog::WeightedGrounder grounder;
+    std::unique_ptr<datalog::WeightedGrounder> grounder;
 
     datalog::AnnotationGenerator get_annotation_generator();
 
 public:
     AdditiveHeuristic(const Task &task) : AdditiveHeuristic(task, DatalogTransformationOptions()){};
 
-    AdditiveHeuristic(const Task &task, DatalogTransformationOptions opts);
+    AdditiveHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding = false);
 
     int compute_heuristic(const DBState &s, const Task &task) override;
 };
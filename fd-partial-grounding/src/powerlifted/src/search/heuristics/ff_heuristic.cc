@@ -34,9 +34,9 @@ public:
 
 
 
-FFHeuristic::FFHeuristic(const Task &task, DatalogTransformationOptions opts) :
+FFHeuristic::FFHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding) :
     datalog(initialize_datalog(task, get_annotation_generator(), opts)),
-    grounder(datalog, datalog::H_ADD) {}
+    grounder(create_weighted_grounder(datalog, datalog::H_ADD, incremental_grounding)) {}
 
 int FFHeuristic::compute_heuristic(const DBState &s, const Task &task) {
     pi_ff.clear();
@@ -44,9 +44,9 @@ int FFHeuristic::compute_heuristic(const DBState &s, const Task &task) {
 
     std::vector<datalog::Fact> state_facts = get_datalog_facts_from_state(s, task);
 
-    int h_add = grounder.ground(datalog, state_facts, datalog.get_goal_atom_idx());
+    int h_add = grounder->ground(datalog, state_facts, datalog.get_goal_atom_idx());
 
-    //grounder.print_statistics(datalog);
+    //grounder->print_statistics(datalog);
 
     int ff_cost = 0;
 
@@ -57,9 +57,7 @@ int FFHeuristic::compute_heuristic(const DBState &s, const Task &task) {
         ff_cost += task.get_action_schema_by_index(action.first).get_cost();
     }
 
-    datalog.reset_facts();
-    for (const auto &r : datalog.get_rules())
-        r->clean_up();
+    grounder->clean_up(datalog);
     if (h_add == std::numeric_limits<int>::max())
         return UNSOLVABLE_STATE;
 
@@ -9,13 +9,15 @@
 
 #include "../datalog/grounder/weighted_grounder.h"
 
+#include <memory>
+
 typedef std::pair<int, std::vector<int>> GroundAction;
 
 
 class FFHeuristic : public Heuristic{
 
     datalog::Datalog datalog;
-    datalog::WeightedGrounder grounder;
+    std::unique_ptr<datalog::WeightedGrounder> grounder;
 
     std::vector<GroundAction> pi_ff;
 
@@ -24,7 +26,7 @@ class FFHeuristic : public Heuristic{
 public:
     FFHeuristic(const Task &task) : FFHeuristic(task, DatalogTransformationOptions()) {}
 
-    FFHeuristic(const Task &task, DatalogTransformationOptions opts);
+    FFHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding = false);
 
     int compute_heuristic(const DBState &s, const Task &task) override;
 };
@@ -25,19 +25,19 @@ Heuristic *HeuristicFactory::create(const Options &opt, const Task &task)
         return new BlindHeuristic();
     }
     else if (boost::iequals(method, "add")) {
-        return new AdditiveHeuristic(task, DatalogTransformationOptions());
+        return new AdditiveHeuristic(task, DatalogTransformationOptions(), opt.get_incremental_grounding());
     }
     else if (boost::iequals(method, "ff")) {
-        return new FFHeuristic(task, DatalogTransformationOptions());
+        return new FFHeuristic(task, DatalogTransformationOptions(), opt.get_incremental_grounding());
     }
     else if (boost::iequals(method, "goalcount")) {
         return new Goalcount();
     }
     else if (boost::iequals(method, "hmax")) {
-        return new HMaxHeuristic(task, DatalogTransformationOptions());
+        return new HMaxHeuristic(task, DatalogTransformationOptions(), opt.get_incremental_grounding());
     }
     else if (boost::iequals(method, "rff")) {
-        return new RFFHeuristic(task, DatalogTransformationOptions());
+        return new RFFHeuristic(task, DatalogTransformationOptions(), opt.get_incremental_grounding());
     }
     else if (boost::iequals(method, "print-useful-facts")) {
         return new UsefulFactsWriter(task, DatalogTransformationOptions(), useful_facts_filename);
@@ -4,9 +4,9 @@
 
 using namespace std;
 
-HMaxHeuristic::HMaxHeuristic(const Task &task, DatalogTransformationOptions opts) :
+HMaxHeuristic::HMaxHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding) :
     datalog(initialize_datalog(task, get_annotation_generator(), opts)),
-    grounder(datalog, datalog::H_MAX) {}
+    grounder(create_weighted_grounder(datalog, datalog::H_MAX, incremental_grounding)) {}
 
 datalog::AnnotationGenerator HMaxHeuristic::get_annotation_generator() {
     return [&](int action_schema_id, const Task &task) -> unique_ptr<datalog::Annotation> {
@@ -20,12 +20,9 @@ int HMaxHeuristic::compute_heuristic(const DBState &s, const Task &task) {
 
     std::vector<datalog::Fact> state_facts = get_datalog_facts_from_state(s, task);
 
-    int h = grounder.ground(datalog, state_facts, datalog.get_goal_atom_idx());
-    //grounder.print_statistics(datalog);
-    datalog.reset_facts();
-
-    for (const auto &r : datalog.get_rules())
-        r->clean_up();
+    int h = grounder->ground(datalog, state_facts, datalog.get_goal_atom_idx());
+    //grounder->print_statistics(datalog);
+    grounder->clean_up(datalog);
     if (h == std::numeric_limits<int>::max())
         return UNSOLVABLE_STATE;
 
@@ -9,18 +9,20 @@
 
 #include "../datalog/grounder/weighted_grounder.h"
 
+#include <memory>
+
 class HMaxHeuristic : public Heuristic{
 
 protected:
     datalog::Datalog datalog;
-    datalog::WeightedGrounder grounder;
+    std::unique_ptr<datalog::WeightedGrounder> grounder;
 
     datalog::AnnotationGenerator get_annotation_generator();
 
 public:
     HMaxHeuristic(const Task &task) : HMaxHeuristic(task, DatalogTransformationOptions()){};
 
-    HMaxHeuristic(const Task &task, DatalogTransformationOptions opts);
+    HMaxHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding = false);
 
     virtual int compute_heuristic(const DBState &s, const Task &task) override;
 };
@@ -28,9 +28,9 @@ public:
 };
 
 
-RFFHeuristic::RFFHeuristic(const Task &task, DatalogTransformationOptions opts) :
+RFFHeuristic::RFFHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding) :
     datalog(initialize_datalog(task, get_annotation_generator(), opts)),
-    grounder(datalog, datalog::H_ADD) {}
+    grounder(create_weighted_grounder(datalog, datalog::H_ADD, incremental_grounding)) {}
 
 int RFFHeuristic::compute_heuristic(const DBState &s, const Task &task) {
     if (task.is_goal((s))) return 0;
@@ -39,11 +39,9 @@ int RFFHeuristic::compute_heuristic(const DBState &s, const Task &task) {
 
     std::vector<datalog::Fact> state_facts = get_datalog_facts_from_state(s, task);
 
-    int h_add = grounder.ground(datalog, state_facts, datalog.get_goal_atom_idx());
+    int h_add = grounder->ground(datalog, state_facts, datalog.get_goal_atom_idx());
 
-    datalog.reset_facts();
-    for (const auto &r : datalog.get_rules())
-        r->clean_up();
+    grounder->clean_up(datalog);
     if (h_add == std::numeric_limits<int>::max())
         return UNSOLVABLE_STATE;
 
@@ -6,11 +6,13 @@
 
 #include "../datalog/grounder/weighted_grounder.h"
 
+#include <memory>
+
 
 class RFFHeuristic : public Heuristic {
 
     datalog::Datalog datalog;
-    datalog::WeightedGrounder grounder;
+    std::unique_ptr<datalog::WeightedGrounder> grounder;
 
     int rff_cost;
 
@@ -20,7 +22,7 @@ class RFFHeuristic : public Heuristic {
 public:
     RFFHeuristic(const Task &task) : RFFHeuristic(task, DatalogTransformationOptions()){};
 
-    RFFHeuristic(const Task &task, DatalogTransformationOptions opts);
+    RFFHeuristic(const Task &task, DatalogTransformationOptions opts, bool incremental_grounding = false);
 
     int compute_heuristic(const DBState &s, const Task &task) override;
 };
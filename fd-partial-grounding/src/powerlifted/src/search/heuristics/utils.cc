@@ -1,5 +1,7 @@
 #include "utils.h"
 
+#include "../datalog/grounder/incremental_weighted_grounder.h"
+
 datalog::Datalog initialize_datalog(const Task &task,
                                     datalog::AnnotationGenerator annotation_generator,
                                     const DatalogTransformationOptions &opts) {
@@ -45,3 +47,11 @@ std::vector<datalog::Fact> get_datalog_facts_from_state(const DBState &s, const
     }
     return facts;
 }
+
+std::unique_ptr<datalog::WeightedGrounder> create_weighted_grounder(const datalog::Datalog &datalog,
+                                                                    int heuristic_type,
+                                                                    bool incremental) {
+    if (incremental)
+        return std::make_unique<datalog::IncrementalWeightedGrounder>(datalog, heuristic_type);
+    return std::make_unique<datalog::WeightedGrounder>(datalog, heuristic_type);
+}
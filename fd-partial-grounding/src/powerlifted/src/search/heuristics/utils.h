@@ -7,10 +7,16 @@
 
 #include "../datalog/grounder/weighted_grounder.h"
 
+#include <memory>
+
 datalog::Datalog initialize_datalog(const Task &task,
                                     datalog::AnnotationGenerator annotation_generator,
                                     const DatalogTransformationOptions &opts);
 
 std::vector<datalog::Fact> get_datalog_facts_from_state(const DBState &s, const Task &task);
 
+std::unique_ptr<datalog::WeightedGrounder> create_weighted_grounder(const datalog::Datalog &datalog,
+                                                                    int heuristic_type,
+                                                                    bool incremental);
+
 #endif //SEARCH_HEURISTICS_UTILS_H_
@@ -4,8 +4,10 @@
 
 #include "heuristics/heuristic.h"
 #include "heuristics/heuristic_factory.h"
+#include "partial_grounding/partial_grounding.h"
 #include "search_engines/search.h"
 #include "search_engines/search_factory.h"
+#include "successor_generators/generator_benchmark.h"
 #include "successor_generators/successor_generator.h"
 #include "successor_generators/successor_generator_factory.h"
 
@@ -47,12 +49,23 @@ int main(int argc, char *argv[]) {
     cout << "IMPORTANT: Assuming that negative effects are always listed first. "
             "(This is guaranteed by the default translator.)" << endl;
 
+    if (opt.get_partial_grounding()) {
+        return static_cast<int>(partial_grounding::run_partial_grounding(task, opt));
+    }
+
+    if (!opt.get_benchmark_generators().empty()) {
+        return static_cast<int>(run_generator_benchmark(task, opt));
+    }
+
     // Let's create a couple unique_ptr's that deal with mem allocation themselves
     std::unique_ptr<SearchBase> search(SearchFactory::create(opt, opt.get_search_engine(), opt.get_state_representation()));
     std::unique_ptr<Heuristic> heuristic(HeuristicFactory::create(opt, task));
     std::unique_ptr<SuccessorGenerator> sgen(SuccessorGeneratorFactory::create(opt.get_successor_generator(),
-                                                                               opt.get_seed(),
+                                                                               opt,
                                                                                task));
+    if (opt.get_dump_join_plans()) {
+        sgen->dump_join_plans(task, cout);
+    }
 
     // Start search
     if (task.is_trivially_unsolvable()) {
@@ -63,6 +76,7 @@ int main(int argc, char *argv[]) {
     try {
         auto exitcode = search->search(task, *sgen, *heuristic);
         search->print_statistics();
+        sgen->print_statistics();
         utils::report_exit_code_reentrant(exitcode);
         return static_cast<int>(exitcode);
     }
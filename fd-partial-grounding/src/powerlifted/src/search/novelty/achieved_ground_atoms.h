@@ -12,7 +12,7 @@ class AchievedGroundAtoms {
     /* TODO Check also ArrayPool class (Scorpion).
      * Use ArrayPool to store vectors and each entry could have only the index to it.
      */
-    std::vector<phmap::flat_hash_set<int>> ground_atoms_k1;
+    std::vector<phmap::flat_hash_set<long>> ground_atoms_k1;
 
     std::vector<phmap::flat_hash_set<std::pair<int, int>>> ground_atoms_k2;
 
@@ -26,7 +26,7 @@ public:
         ground_atoms_k2.resize(number_combinations);
     }
 
-    bool try_to_insert_atom_in_k1(int i, int idx) {
+    bool try_to_insert_atom_in_k1(int i, long idx) {
         auto it = ground_atoms_k1[i].insert(idx);
         return it.second;
     }
@@ -1,6 +1,7 @@
 #ifndef SEARCH_NOVELTY_STANDARD_NOVELTY_H_
 #define SEARCH_NOVELTY_STANDARD_NOVELTY_H_
 
+#include <cassert>
 #include <utility>
 
 #include <boost/functional/hash.hpp>
@@ -75,6 +76,52 @@ class StandardNovelty {
                              int pred_symbol_idx2,
                              int t2_idx);
 
+    /*
+     * Width 1 only. The atoms are read from the packed state and identified by
+     * their key in the state packer instead of atom_mapping, so an evaluator
+     * must use either these functions or the ones on DBState for k=1.
+     */
+    template<class PackedStateT>
+    int compute_novelty_k1_of_packed_state(const typename PackedStateT::StatePackerT &packer,
+                                           const PackedStateT &packed_state,
+                                           int number_unsatisfied_goals,
+                                           int number_unsatisfied_relevant_atoms) {
+        assert(width == 1);
+        if (number_unsatisfied_goals == 0) {
+            return GOAL_STATE;
+        }
+        int idx = compute_position_of_r_g_tuple(number_unsatisfied_goals, number_unsatisfied_relevant_atoms);
+        auto &achieved_atoms_in_layer = achieved_atoms[idx];
+
+        bool has_novel_atom = false;
+        packer.for_each_atom(packed_state, [&](int pred_symbol_idx, long key) {
+            if (achieved_atoms_in_layer.try_to_insert_atom_in_k1(pred_symbol_idx, key))
+                has_novel_atom = true;
+        });
+        return has_novel_atom ? 1 : NOVELTY_GREATER_THAN_TWO;
+    }
+
+    template<class StatePackerT>
+    int compute_k1_novelty_of_packed_operator(const StatePackerT &packer,
+                                              int number_unsatisfied_goals,
+                                              int number_unsatisfied_relevant_atoms,
+                                              const std::vector<std::pair<int, GroundAtom>> &added_atoms) {
+        assert(width == 1);
+        if (number_unsatisfied_goals == 0) {
+            return GOAL_STATE;
+        }
+        int idx = compute_position_of_r_g_tuple(number_unsatisfied_goals, number_unsatisfied_relevant_atoms);
+        auto &achieved_atoms_in_layer = achieved_atoms[idx];
+
+        int novelty = NOVELTY_GREATER_THAN_TWO;
+        for (const std::pair<int, GroundAtom> &atom : added_atoms) {
+            long key = packer.get_atom_key(atom.first, atom.second);
+            if (achieved_atoms_in_layer.try_to_insert_atom_in_k1(atom.first, key))
+                novelty = 1;
+        }
+        return novelty;
+    }
+
 
 public:
 
@@ -116,6 +163,37 @@ public:
                                       int number_unsatisfied_relevant_atoms,
                                       const std::vector<std::pair<int, std::vector<int>>> &added_atoms);
 
+    /*
+     * Same as the functions above, but with width 1 the novelty is computed on
+     * the packed state, without looking at `state`.
+     */
+    template<class PackedStateT>
+    int compute_novelty(const Task &task,
+                        const DBState &state,
+                        const typename PackedStateT::StatePackerT &packer,
+                        const PackedStateT &packed_state,
+                        int number_unsatisfied_goals,
+                        int number_unsatisfied_relevant_atoms) {
+        if (width == 1)
+            return compute_novelty_k1_of_packed_state(packer, packed_state, number_unsatisfied_goals,
+                                                      number_unsatisfied_relevant_atoms);
+        return compute_novelty(task, state, number_unsatisfied_goals, number_unsatisfied_relevant_atoms);
+    }
+
+    template<class StatePackerT>
+    int compute_novelty_from_operator(const Task &task,
+                                      const DBState &state,
+                                      const StatePackerT &packer,
+                                      int number_unsatisfied_goals,
+                                      int number_unsatisfied_relevant_atoms,
+                                      const std::vector<std::pair<int, std::vector<int>>> &added_atoms) {
+        if (width == 1)
+            return compute_k1_novelty_of_packed_operator(packer, number_unsatisfied_goals,
+                                                         number_unsatisfied_relevant_atoms, added_atoms);
+        return compute_novelty_from_operator(task, state, number_unsatisfied_goals,
+                                             number_unsatisfied_relevant_atoms, added_atoms);
+    }
+
     int get_number_relevant_atoms() const {
         return number_relevant_atoms;
     }
@@ -15,8 +15,21 @@ class Options {
     std::string state_representation;
     std::string datalog_file;
     std::string useful_facts_file;
+    std::string grounded_actions_file;
+    std::string trained_model_folder;
+    std::string termination_condition;
+    std::string benchmark_generators;
     bool only_effects_opt;
     bool novelty_early_stop;
+    bool dump_join_plans;
+    bool incremental_grounding;
+    bool partial_grounding;
+    bool ignore_bad_actions;
+    int threads;
+    int batch_size;
+    bool deterministic;
+    int benchmark_states;
+    int delta_join_cache_size;
     unsigned seed;
 
 public:
@@ -34,6 +47,19 @@ public:
             ("useful-facts-file", po::value<std::string>()->default_value("FilePathUndefined"), "Useful facts file.")
             ("only-effects-novelty-check", po::value<bool>()->default_value(false), "Check only effects of applied actions when evaluation novelty of a state.")
             ("novelty-early-stop", po::value<bool>()->default_value(false), "Stop evaluating novelty as soon as w-value is defined.")
+            ("threads", po::value<int>()->default_value(1), "Number of threads used to expand and evaluate nodes (gbfs and astar only).")
+            ("batch-size", po::value<int>()->default_value(1), "Number of open nodes expanded together in each parallel step (gbfs and astar only).")
+            ("deterministic", po::value<bool>()->default_value(false), "Assign nodes and successors to the threads round robin instead of dynamically, so that parallel searches are reproducible.")
+            ("incremental-grounding", po::value<bool>()->default_value(false), "Keep the ground Datalog program of the delete-relaxation heuristics between evaluations.")
+            ("dump-join-plans", po::value<bool>()->default_value(false), "Print the precompiled join program of each action schema.")
+            ("partial-grounding", po::value<bool>()->default_value(false), "Only ground the actions of the task and write them to the grounded-actions file instead of searching.")
+            ("grounded-actions-file", po::value<std::string>()->default_value("grounded_actions"), "File the partial grounding writes the grounded actions to.")
+            ("trained-model-folder", po::value<std::string>()->default_value("FilePathUndefined"), "Folder with the good and bad rules used to prioritize actions in the partial grounding.")
+            ("termination-condition", po::value<std::string>()->default_value("default"), "Termination condition of the partial grounding, with the arguments of the translator option, e.g. \"goal-relaxed-reachable percentage 10\".")
+            ("ignore-bad-actions", po::value<bool>()->default_value(false), "Never ground actions evaluated as bad by the rules in the partial grounding.")
+            ("benchmark-generators", po::value<std::string>()->default_value(""), "Comma-separated successor generators to time on a fixed sample of states instead of searching.")
+            ("benchmark-states", po::value<int>()->default_value(1000), "Number of states sampled by random walks for --benchmark-generators.")
+            ("delta-join-cache-size", po::value<int>()->default_value(512), "Memory bound (in MB) of the instantiations cached by the delta_join successor generator.")
             ;
 
         po::variables_map vm;
@@ -61,6 +87,19 @@ public:
         useful_facts_file = vm["useful-facts-file"].as<std::string>();
         only_effects_opt = vm["only-effects-novelty-check"].as<bool>();
         novelty_early_stop = vm["novelty-early-stop"].as<bool>();
+        dump_join_plans = vm["dump-join-plans"].as<bool>();
+        incremental_grounding = vm["incremental-grounding"].as<bool>();
+        partial_grounding = vm["partial-grounding"].as<bool>();
+        grounded_actions_file = vm["grounded-actions-file"].as<std::string>();
+        trained_model_folder = vm["trained-model-folder"].as<std::string>();
+        termination_condition = vm["termination-condition"].as<std::string>();
+        ignore_bad_actions = vm["ignore-bad-actions"].as<bool>();
+        benchmark_generators = vm["benchmark-generators"].as<std::string>();
+        benchmark_states = vm["benchmark-states"].as<int>();
+        delta_join_cache_size = vm["delta-join-cache-size"].as<int>();
+        threads = vm["threads"].as<int>();
+        batch_size = vm["batch-size"].as<int>();
+        deterministic = vm["deterministic"].as<bool>();
         seed = vm["seed"].as<unsigned>();
 
     }
@@ -101,6 +140,58 @@ public:
         return novelty_early_stop;
     }
 
+    bool get_dump_join_plans() const {
+        return dump_join_plans;
+    }
+
+    bool get_incremental_grounding() const {
+        return incremental_grounding;
+    }
+
+    bool get_partial_grounding() const {
+        return partial_grounding;
+    }
+
+    const std::string &get_grounded_actions_file() const {
+        return grounded_actions_file;
+    }
+
+    const std::string &get_trained_model_folder() const {
+        return trained_model_folder;
+    }
+
+    const std::string &get_termination_condition() const {
+        return termination_condition;
+    }
+
+    bool get_ignore_bad_actions() const {
+        return ignore_bad_actions;
+    }
+
+    const std::string &get_benchmark_generators() const {
+        return benchmark_generators;
+    }
+
+    int get_benchmark_states() const {
+        return benchmark_states;
+    }
+
+    int get_delta_join_cache_size() const {
+        return delta_join_cache_size;
+    }
+
+    int get_threads() const {
+        return threads;
+    }
+
+    int get_batch_size() const {
+        return batch_size;
+    }
+
+    bool get_deterministic() const {
+        return deterministic;
+    }
+
     unsigned get_seed() const {
         return seed;
     }
@@ -0,0 +1,114 @@
+#include "action_priority.h"
+
+#include "../options.h"
+#include "../task.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace partial_grounding {
+
+void FIFOActionPriority::print_info() const {
+    cout << "Grounding actions in FIFO order." << endl;
+}
+
+static void add_facts_of_state(const DBState &state, RuleFactBase &facts) {
+    for (const Relation &r : state.get_relations()) {
+        for (const auto &tuple : r.tuples) {
+            facts.add_fact(RuleFactBase::INIT, r.predicate_symbol, tuple.to_vector());
+        }
+    }
+    const vector<bool> &nullary_atoms = state.get_nullary_atoms();
+    for (size_t i = 0; i < nullary_atoms.size(); ++i) {
+        if (nullary_atoms[i])
+            facts.add_fact(RuleFactBase::INIT, i, vector<int>());
+    }
+}
+
+static void add_facts_of_task(const Task &task, RuleFactBase &facts) {
+    // Predicates and objects are added in order, so their ids are those of the task
+    for (const Predicate &p : task.predicates)
+        facts.add_predicate(p.get_name());
+    for (const Object &o : task.objects)
+        facts.add_object(o.get_name());
+
+    add_facts_of_state(task.get_initial_state(), facts);
+    add_facts_of_state(task.get_static_info(), facts);
+
+    const GoalCondition &goal = task.get_goal();
+    for (const AtomicGoal &atom : goal.goal) {
+        if (!atom.is_negated())
+            facts.add_fact(RuleFactBase::GOAL, atom.get_predicate_index(), atom.get_arguments());
+    }
+    for (int predicate : goal.positive_nullary_goals) {
+        facts.add_fact(RuleFactBase::GOAL, predicate, vector<int>());
+    }
+}
+
+static vector<pair<string, int>> get_schemas(const Task &task) {
+    vector<pair<string, int>> schemas;
+    for (const ActionSchema &schema : task.get_action_schemas()) {
+        schemas.emplace_back(schema.get_name(), schema.get_parameters().size());
+    }
+    return schemas;
+}
+
+GoodBadRulesActionPriority::GoodBadRulesActionPriority(const Task &task,
+                                                       const string &trained_model_folder,
+                                                       bool ignore_bad_actions)
+    : good_rules(get_schemas(task)),
+      bad_rules(get_schemas(task)),
+      ignore_bad_actions(ignore_bad_actions),
+      num_good_actions(task.get_number_action_schemas(), 0),
+      num_bad_actions(task.get_number_action_schemas(), 0) {
+    RuleFactBase facts;
+    add_facts_of_task(task, facts);
+    good_rules.load_rules_file(trained_model_folder + "/good_rules.rules", facts);
+    bad_rules.load_rules_file(trained_model_folder + "/bad_rules.rules", facts);
+}
+
+int GoodBadRulesActionPriority::get_priority(int schema, const vector<int> &arguments) {
+    if (good_rules.has_rules(schema) && good_rules.evaluate(schema, arguments)) {
+        ++num_good_actions[schema];
+        return GOOD;
+    }
+    if (bad_rules.has_rules(schema) && bad_rules.evaluate(schema, arguments)) {
+        ++num_bad_actions[schema];
+        return ignore_bad_actions ? IGNORE_ACTION : BAD;
+    }
+    return NEUTRAL;
+}
+
+void GoodBadRulesActionPriority::print_info() const {
+    cout << "Grounding actions in FIFO order, good actions first and bad actions ";
+    if (ignore_bad_actions)
+        cout << "never." << endl;
+    else
+        cout << "last." << endl;
+    cout << "Loaded " << good_rules.get_num_rules() << " good rules and "
+         << bad_rules.get_num_rules() << " bad rules." << endl;
+}
+
+void GoodBadRulesActionPriority::print_statistics(const Task &task) const {
+    for (size_t i = 0; i < num_good_actions.size(); ++i) {
+        if (num_good_actions[i] > 0)
+            cout << "Detected " << num_good_actions[i] << " good operators of action schema "
+                 << task.get_action_schema_by_index(i).get_name() << "." << endl;
+    }
+    for (size_t i = 0; i < num_bad_actions.size(); ++i) {
+        if (num_bad_actions[i] > 0)
+            cout << "Detected " << num_bad_actions[i] << " bad operators of action schema "
+                 << task.get_action_schema_by_index(i).get_name() << "." << endl;
+    }
+}
+
+unique_ptr<ActionPriority> create_action_priority(const Options &opt, const Task &task) {
+    const string &folder = opt.get_trained_model_folder();
+    if (folder == "FilePathUndefined") {
+        return make_unique<FIFOActionPriority>();
+    }
+    return make_unique<GoodBadRulesActionPriority>(task, folder, opt.get_ignore_bad_actions());
+}
+
+}
@@ -0,0 +1,85 @@
+#ifndef SEARCH_PARTIAL_GROUNDING_ACTION_PRIORITY_H_
+#define SEARCH_PARTIAL_GROUNDING_ACTION_PRIORITY_H_
+
+#include "rule_evaluator.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Options;
+class Task;
+
+namespace partial_grounding {
+
+const int IGNORE_ACTION = -1;
+
+/*
+ * Assigns to every reached action a priority class in [0, get_num_priorities()).
+ * The partial grounder keeps one FIFO queue per class and always pops from the
+ * lowest non-empty one. Actions with priority IGNORE_ACTION are never grounded.
+ */
+class ActionPriority {
+public:
+    virtual ~ActionPriority() = default;
+
+    virtual int get_num_priorities() const = 0;
+
+    virtual int get_priority(int schema, const std::vector<int> &arguments) = 0;
+
+    virtual void print_info() const = 0;
+
+    virtual void print_statistics(const Task &) const {}
+};
+
+/*
+ * All actions in order of reachability.
+ */
+class FIFOActionPriority : public ActionPriority {
+public:
+    int get_num_priorities() const override {
+        return 1;
+    }
+
+    int get_priority(int, const std::vector<int> &) override {
+        return 0;
+    }
+
+    void print_info() const override;
+};
+
+/*
+ * Actions satisfying some good rule first and actions satisfying some bad rule
+ * last (or never), as in the good/bad rule evaluation of the IPC23 queues of the
+ * translator. Rules are read from "good_rules.rules" and "bad_rules.rules" in
+ * the trained model folder; both files are optional.
+ */
+class GoodBadRulesActionPriority : public ActionPriority {
+    enum {GOOD, NEUTRAL, BAD};
+
+    RulesEvaluator good_rules;
+    RulesEvaluator bad_rules;
+    bool ignore_bad_actions;
+
+    std::vector<int> num_good_actions;
+    std::vector<int> num_bad_actions;
+
+public:
+    GoodBadRulesActionPriority(const Task &task, const std::string &trained_model_folder, bool ignore_bad_actions);
+
+    int get_num_priorities() const override {
+        return 3;
+    }
+
+    int get_priority(int schema, const std::vector<int> &arguments) override;
+
+    void print_info() const override;
+
+    void print_statistics(const Task &task) const override;
+};
+
+std::unique_ptr<ActionPriority> create_action_priority(const Options &opt, const Task &task);
+
+}
+
+#endif //SEARCH_PARTIAL_GROUNDING_ACTION_PRIORITY_H_
@@ -0,0 +1,156 @@
+#include "partial_grounder.h"
+
+#include "../task.h"
+
+#include "../datalog/datalog.h"
+
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace partial_grounding {
+
+PartialGrounder::PartialGrounder(const datalog::Datalog &lp,
+                                 const Task &task,
+                                 ActionPriority &priority,
+                                 TerminationCondition &termination)
+    : WeightedGrounder(lp, datalog::H_MAX),
+      task(task),
+      priority(priority),
+      termination(termination),
+      action_queues(priority.get_num_priorities()),
+      num_reached_actions(0),
+      num_ignored_actions(0),
+      num_violating_inequalities(0) {
+    for (const ActionSchema &schema : task.get_action_schemas()) {
+        int predicate = lp.get_action_predicate_idx(schema);
+        if (predicate >= int(schema_of_predicate.size()))
+            schema_of_predicate.resize(predicate + 1, -1);
+        schema_of_predicate[predicate] = schema.get_index();
+    }
+}
+
+bool PartialGrounder::violates_inequalities(int schema, const vector<int> &arguments) const {
+    for (const pair<int, int> &inequality : task.get_action_schema_by_index(schema).get_inequalities()) {
+        if (arguments[inequality.first] == arguments[inequality.second])
+            return true;
+    }
+    return false;
+}
+
+void PartialGrounder::enqueue(const datalog::Fact &fact) {
+    int schema = get_schema_of_predicate(fact.get_predicate_index());
+    if (schema == -1) {
+        fact_queue.push_back(fact.get_fact_index());
+        return;
+    }
+
+    ++num_reached_actions;
+    vector<int> arguments;
+    arguments.reserve(fact.get_arguments().size());
+    for (const datalog::Term &term : fact.get_arguments()) {
+        arguments.push_back(term.get_index());
+    }
+    if (violates_inequalities(schema, arguments)) {
+        ++num_violating_inequalities;
+        return;
+    }
+    int p = priority.get_priority(schema, arguments);
+    if (p == IGNORE_ACTION) {
+        ++num_ignored_actions;
+        return;
+    }
+    action_queues[p].push_back(fact.get_fact_index());
+}
+
+bool PartialGrounder::pop_action(int &fact_index) {
+    for (deque<int> &queue : action_queues) {
+        if (!queue.empty()) {
+            fact_index = queue.front();
+            queue.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+int PartialGrounder::ground(datalog::Datalog &datalog, vector<datalog::Fact> &state_facts, int goal_predicate) {
+    phmap::flat_hash_set<datalog::Fact> reached_facts;
+    vector<datalog::Fact> newfacts;
+
+    datalog::Fact::next_fact_index = 0;
+    fact_queue.clear();
+    for (deque<int> &queue : action_queues)
+        queue.clear();
+    grounded_actions.clear();
+
+    auto reach_fact = [&](datalog::Fact &f) {
+        if (reached_facts.count(f))
+            return;
+        f.set_fact_index();
+        datalog.insert_fact(f);
+        reached_facts.insert(f);
+        enqueue(f);
+    };
+
+    for (const datalog::Fact &f : datalog.get_permanent_edb()) {
+        datalog::Fact f2 = f;
+        reach_fact(f2);
+    }
+    for (datalog::Fact &f : state_facts) {
+        reach_fact(f);
+    }
+
+    bool goal_reached = false;
+    while (true) {
+        int fact_index;
+        if (!fact_queue.empty()) {
+            fact_index = fact_queue.front();
+            fact_queue.pop_front();
+        } else if (!termination.terminate() && pop_action(fact_index)) {
+            grounded_actions.push_back(fact_index);
+            termination.notify_action_grounded();
+        } else {
+            break;
+        }
+
+        // Copy, because new facts are appended to the vector of facts of the program
+        const datalog::Fact current_fact = datalog.get_fact_by_index(fact_index);
+        int predicate_index = current_fact.get_predicate_index();
+        if (predicate_index == goal_predicate) {
+            if (!goal_reached)
+                termination.notify_goal_reached();
+            goal_reached = true;
+            continue;
+        }
+
+        for (const auto &m : rule_matcher.get_matched_rules(predicate_index)) {
+            datalog::RuleBase &rule = datalog.get_rule_by_index(m.get_rule());
+            int position_in_the_body = m.get_position();
+            newfacts.clear();
+            if (rule.get_type() == datalog::PROJECT) {
+                project(rule, current_fact, newfacts);
+            } else if (rule.get_type() == datalog::JOIN) {
+                join(rule, current_fact, position_in_the_body, newfacts);
+            } else {
+                product(rule, current_fact, position_in_the_body, newfacts);
+            }
+            for (datalog::Fact &new_fact : newfacts) {
+                reach_fact(new_fact);
+            }
+        }
+    }
+    return goal_reached ? 0 : numeric_limits<int>::max();
+}
+
+void PartialGrounder::print_statistics(const datalog::Datalog &lp) {
+    cout << lp.get_number_of_facts() << " final number of facts" << endl;
+    cout << num_reached_actions << " reached actions" << endl;
+    cout << num_violating_inequalities << " reached actions violating inequalities" << endl;
+    cout << num_ignored_actions << " reached actions ignored by the action priority" << endl;
+    cout << grounded_actions.size() << " grounded actions" << endl;
+    priority.print_statistics(task);
+}
+
+}
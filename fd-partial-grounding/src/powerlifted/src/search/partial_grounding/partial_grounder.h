@@ -0,0 +1,77 @@
+#ifndef SEARCH_PARTIAL_GROUNDING_PARTIAL_GROUNDER_H_
+#define SEARCH_PARTIAL_GROUNDING_PARTIAL_GROUNDER_H_
+
+#include "action_priority.h"
+#include "termination_condition.h"
+
+#include "../datalog/grounder/weighted_grounder.h"
+
+#include <deque>
+#include <vector>
+
+class Task;
+
+namespace partial_grounding {
+
+/*
+ * Relaxed reachability analysis that grounds actions one at a time, like
+ * compute_model in the translator (src/translate/build_model.py).
+ *
+ * The Datalog program must keep the action predicates. Facts that are not
+ * actions are processed in FIFO order and always before the next action. Each
+ * reached action is assigned a priority class when it is reached and is only
+ * processed ("grounded") when it is popped from the queue of its class, which
+ * happens until the termination condition holds. Actions violating the
+ * inequalities of their schema are neither grounded nor processed.
+ *
+ * The rule bodies are matched with the projection, join and product of the
+ * WeightedGrounder; costs are computed but not used.
+ */
+class PartialGrounder : public datalog::WeightedGrounder {
+    const Task &task;
+    ActionPriority &priority;
+    TerminationCondition &termination;
+
+    // Action schema of each predicate "action-<schema>", or -1
+    std::vector<int> schema_of_predicate;
+
+    std::deque<int> fact_queue;
+    std::vector<std::deque<int>> action_queues;
+
+    std::vector<int> grounded_actions;
+    int num_reached_actions;
+    int num_ignored_actions;
+    int num_violating_inequalities;
+
+    int get_schema_of_predicate(int predicate) const {
+        if (predicate >= int(schema_of_predicate.size()))
+            return -1;
+        return schema_of_predicate[predicate];
+    }
+
+    bool violates_inequalities(int schema, const std::vector<int> &arguments) const;
+
+    void enqueue(const datalog::Fact &fact);
+
+    bool pop_action(int &fact_index);
+
+public:
+    PartialGrounder(const datalog::Datalog &lp,
+                    const Task &task,
+                    ActionPriority &priority,
+                    TerminationCondition &termination);
+
+    // Returns 0 if the goal became relaxed reachable and max int otherwise
+    int ground(datalog::Datalog &datalog, std::vector<datalog::Fact> &state_facts, int goal_predicate) override;
+
+    // Fact indices of the grounded actions in the order they were grounded
+    const std::vector<int> &get_grounded_actions() const {
+        return grounded_actions;
+    }
+
+    void print_statistics(const datalog::Datalog &lp) override;
+};
+
+}
+
+#endif //SEARCH_PARTIAL_GROUNDING_PARTIAL_GROUNDER_H_
@@ -0,0 +1,81 @@
+#include "partial_grounding.h"
+
+#include "action_priority.h"
+#include "partial_grounder.h"
+#include "termination_condition.h"
+
+#include "../options.h"
+#include "../task.h"
+
+#include "../heuristics/utils.h"
+#include "../utils/timer.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace partial_grounding {
+
+static void write_grounded_actions(const Task &task,
+                                   const datalog::Datalog &datalog,
+                                   const PartialGrounder &grounder,
+                                   const string &filename) {
+    // Map the action predicates back to their schemas
+    vector<const ActionSchema *> schema_of_predicate;
+    for (const ActionSchema &schema : task.get_action_schemas()) {
+        size_t predicate = datalog.get_action_predicate_idx(schema);
+        if (predicate >= schema_of_predicate.size())
+            schema_of_predicate.resize(predicate + 1, nullptr);
+        schema_of_predicate[predicate] = &schema;
+    }
+
+    ofstream actions_file(filename);
+    for (int fact_index : grounder.get_grounded_actions()) {
+        const datalog::Fact &fact = datalog.get_fact_by_index(fact_index);
+        actions_file << "(" << schema_of_predicate[fact.get_predicate_index()]->get_name();
+        for (const datalog::Term &term : fact.get_arguments()) {
+            actions_file << " " << task.get_object_name(term.get_index());
+        }
+        actions_file << ")" << endl;
+    }
+}
+
+utils::ExitCode run_partial_grounding(const Task &task, const Options &opt) {
+    utils::Timer timer;
+
+    vector<string> args;
+    string termination_condition = boost::algorithm::trim_copy(opt.get_termination_condition());
+    boost::split(args, termination_condition, boost::is_any_of(" "), boost::token_compress_on);
+    unique_ptr<TerminationCondition> termination = create_termination_condition(args);
+    unique_ptr<ActionPriority> priority = create_action_priority(opt, task);
+    termination->print_info();
+    priority->print_info();
+
+    // Action predicates are the actions we ground, and merging equivalent rules
+    // could merge the action rules of two schemas, so both are kept.
+    datalog::Datalog datalog = initialize_datalog(
+        task,
+        [](int, const Task &) -> unique_ptr<datalog::Annotation> { return nullptr; },
+        DatalogTransformationOptions(true, false, false));
+
+    PartialGrounder grounder(datalog, task, *priority, *termination);
+    vector<datalog::Fact> state_facts = get_datalog_facts_from_state(task.get_initial_state(), task);
+    int result = grounder.ground(datalog, state_facts, datalog.get_goal_atom_idx());
+    grounder.print_statistics(datalog);
+    cout << "Partial grounding time: " << timer << endl;
+
+    write_grounded_actions(task, datalog, grounder, opt.get_grounded_actions_file());
+    cout << "Grounded actions written to " << opt.get_grounded_actions_file() << endl;
+
+    if (result == numeric_limits<int>::max()) {
+        cout << "Goal is not relaxed reachable." << endl;
+        return utils::ExitCode::SEARCH_UNSOLVABLE;
+    }
+    return utils::ExitCode::SUCCESS;
+}
+
+}
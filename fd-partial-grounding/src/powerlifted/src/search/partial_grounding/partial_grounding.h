@@ -0,0 +1,23 @@
+#ifndef SEARCH_PARTIAL_GROUNDING_PARTIAL_GROUNDING_H_
+#define SEARCH_PARTIAL_GROUNDING_PARTIAL_GROUNDING_H_
+
+#include "../utils/system.h"
+
+class Options;
+class Task;
+
+namespace partial_grounding {
+
+/*
+ * Grounds the actions of the task with the PartialGrounder, using the action
+ * priority and termination condition given in the options, and writes them in
+ * the order they were grounded to the grounded-actions file. The file has one
+ * action "(schema obj1 ... objn)" per line, which is the format that the
+ * translator reads with "--grounding-action-queue-ordering actionsfromfile
+ * --actions-file FILE" to produce the (partially) grounded task.
+ */
+utils::ExitCode run_partial_grounding(const Task &task, const Options &opt);
+
+}
+
+#endif //SEARCH_PARTIAL_GROUNDING_PARTIAL_GROUNDING_H_
@@ -0,0 +1,343 @@
+#include "rule_evaluator.h"
+
+#include "../database/hash_join.h"
+#include "../database/table.h"
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+using namespace std;
+
+namespace partial_grounding {
+
+int RuleFactBase::add_predicate(const string &name) {
+    auto it = predicate_ids.emplace(name, predicate_ids.size());
+    if (it.second) {
+        for (vector<Tuples> &t : tuples)
+            t.emplace_back();
+    }
+    return it.first->second;
+}
+
+int RuleFactBase::add_object(const string &name) {
+    return object_ids.emplace(name, object_ids.size()).first->second;
+}
+
+int RuleFactBase::get_predicate(const string &name) const {
+    auto it = predicate_ids.find(name);
+    return (it == predicate_ids.end()) ? -1 : it->second;
+}
+
+int RuleFactBase::get_object(const string &name) const {
+    auto it = object_ids.find(name);
+    return (it == object_ids.end()) ? -1 : it->second;
+}
+
+bool RuleResultIndex::matches(const int *arguments) const {
+    for (const pair<int, int> &p : equal_positions) {
+        if (arguments[p.first] != arguments[p.second])
+            return false;
+    }
+    vector<int> key(key_positions.size());
+    for (size_t i = 0; i < key_positions.size(); ++i) {
+        key[i] = arguments[key_positions[i]];
+    }
+    return keys.count(key) > 0;
+}
+
+static vector<string> split_arguments(const string &s) {
+    string inside = s.substr(0, s.find(')'));
+    boost::algorithm::erase_all(inside, " ");
+    boost::algorithm::erase_all(inside, ".");
+    vector<string> args;
+    if (inside.empty())
+        return args;
+    boost::split(args, inside, boost::is_any_of(","));
+    return args;
+}
+
+static int find_predicate(const RuleFactBase &facts, const string &name) {
+    // The translator of powerlifted turns types into predicates "type@<type>"
+    int predicate = facts.get_predicate(name);
+    if (predicate == -1)
+        predicate = facts.get_predicate("type@" + name);
+    return predicate;
+}
+
+static int find_representative(vector<int> &parent, int v) {
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+namespace {
+const int WILDCARD = -1;
+
+struct BodyAtom {
+    RuleFactBase::Source source;
+    int predicate;
+    // Variable number, or WILDCARD, or -(object + 2) for constants
+    vector<int> terms;
+};
+}
+
+/*
+ * Table with the assignments to the (representatives of the) variables of the
+ * atom that match some tuple of its relation.
+ */
+static Table create_table(const BodyAtom &atom, vector<int> &parent, const RuleFactBase &facts) {
+    vector<int> columns;
+    vector<int> column_of_position(atom.terms.size(), -1);
+    for (size_t pos = 0; pos < atom.terms.size(); ++pos) {
+        if (atom.terms[pos] < 0)
+            continue;
+        int v = find_representative(parent, atom.terms[pos]);
+        auto it = find(columns.begin(), columns.end(), v);
+        column_of_position[pos] = distance(columns.begin(), it);
+        if (it == columns.end())
+            columns.push_back(v);
+    }
+
+    unordered_set<vector<int>, TupleHash> rows;
+    vector<vector<int>> tuples;
+    for (const vector<int> &tuple : facts.get_tuples(atom.source, atom.predicate)) {
+        if (tuple.size() != atom.terms.size())
+            continue;
+        vector<int> row(columns.size(), -1);
+        bool consistent = true;
+        for (size_t pos = 0; pos < atom.terms.size() && consistent; ++pos) {
+            int term = atom.terms[pos];
+            if (term == WILDCARD)
+                continue;
+            if (term < WILDCARD) {
+                consistent = (tuple[pos] == -(term + 2));
+            } else {
+                int &value = row[column_of_position[pos]];
+                if (value == -1)
+                    value = tuple[pos];
+                else
+                    consistent = (value == tuple[pos]);
+            }
+        }
+        if (consistent && rows.insert(row).second)
+            tuples.push_back(std::move(row));
+    }
+    return Table(std::move(tuples), std::move(columns));
+}
+
+/*
+ * Join the tables, always continuing with the smallest table that shares a
+ * variable with the result so far, if there is one, to avoid products.
+ */
+static Table join_tables(const vector<Table> &tables) {
+    Table result({vector<int>()}, vector<int>());
+    vector<bool> joined(tables.size(), false);
+    for (size_t step = 0; step < tables.size() && !result.tuples.empty(); ++step) {
+        int next = -1;
+        bool next_connected = false;
+        for (size_t i = 0; i < tables.size(); ++i) {
+            if (joined[i])
+                continue;
+            bool connected = false;
+            for (int v : tables[i].tuple_index) {
+                if (find(result.tuple_index.begin(), result.tuple_index.end(), v) != result.tuple_index.end())
+                    connected = true;
+            }
+            if (next == -1 || (connected && !next_connected) ||
+                (connected == next_connected && tables[i].tuples.size() < tables[next].tuples.size())) {
+                next = i;
+                next_connected = connected;
+            }
+        }
+        joined[next] = true;
+        hash_join(result, tables[next]);
+    }
+    return result;
+}
+
+RulesEvaluator::RulesEvaluator(const vector<pair<string, int>> &schemas)
+    : indices_by_schema(schemas.size()), num_rules(0) {
+    for (const auto &schema : schemas) {
+        schema_names.push_back(schema.first);
+        schema_arities.push_back(schema.second);
+    }
+}
+
+void RulesEvaluator::add_result_index(int schema, RuleResultIndex &&index) {
+    for (RuleResultIndex &other : indices_by_schema[schema]) {
+        if (other.key_positions == index.key_positions && other.equal_positions == index.equal_positions) {
+            other.keys.insert(index.keys.begin(), index.keys.end());
+            return;
+        }
+    }
+    indices_by_schema[schema].push_back(std::move(index));
+}
+
+void RulesEvaluator::add_rule(const string &rule_text, const RuleFactBase &facts) {
+    string text = boost::algorithm::trim_copy(rule_text);
+    size_t separator = text.find(":-");
+    size_t head_paren = text.find('(');
+    if (separator == string::npos || head_paren == string::npos || head_paren > separator) {
+        cerr << "Error: cannot parse rule \"" << text << "\"" << endl;
+        exit(-1);
+    }
+
+    string schema_name = boost::algorithm::trim_copy(text.substr(0, head_paren));
+    auto schema_it = find(schema_names.begin(), schema_names.end(), schema_name);
+    if (schema_it == schema_names.end()) {
+        cout << "Ignoring rule for unknown action schema: " << text << endl;
+        return;
+    }
+    int schema = distance(schema_names.begin(), schema_it);
+    ++num_rules;
+
+    unordered_map<string, int> variables;
+    for (const string &arg : split_arguments(text.substr(head_paren + 1))) {
+        variables.emplace(arg, variables.size());
+    }
+    int arity = schema_arities[schema];
+    if (int(variables.size()) != arity) {
+        cerr << "Error: wrong number of arguments for action schema " << schema_name
+             << " in rule \"" << text << "\"" << endl;
+        exit(-1);
+    }
+    auto get_variable = [&](const string &name) {
+        return variables.emplace(name, variables.size()).first->second;
+    };
+
+    vector<BodyAtom> body;
+    vector<vector<int>> equalities;
+    vector<string> conditions;
+    string body_text = text.substr(separator + 2);
+    boost::split(conditions, body_text, boost::is_any_of(";"));
+    for (const string &c : conditions) {
+        string condition = boost::algorithm::trim_copy(c);
+        if (condition.empty())
+            continue;
+        size_t colon = condition.find(':');
+        string type = boost::algorithm::trim_copy(condition.substr(0, colon));
+        string atom = colon == string::npos ? "" : condition.substr(colon + 1);
+        size_t paren = atom.find('(');
+
+        if (type == "true") {
+            continue;
+        } else if (type == "equal") {
+            vector<int> group;
+            for (const string &arg : split_arguments(atom.substr(paren + 1))) {
+                if (!arg.empty() && arg[0] == '?')
+                    group.push_back(get_variable(arg));
+            }
+            equalities.push_back(std::move(group));
+        } else if (type == "ini" || type == "goal") {
+            BodyAtom body_atom;
+            body_atom.source = (type == "ini") ? RuleFactBase::INIT : RuleFactBase::GOAL;
+            body_atom.predicate = find_predicate(facts, boost::algorithm::trim_copy(atom.substr(0, paren)));
+            if (body_atom.predicate == -1 || paren == string::npos) {
+                // Predicate that does not exist in this task: the atom never holds
+                return;
+            }
+            for (const string &arg : split_arguments(atom.substr(paren + 1))) {
+                if (arg == "_") {
+                    body_atom.terms.push_back(WILDCARD);
+                } else if (arg[0] == '?') {
+                    body_atom.terms.push_back(get_variable(arg));
+                } else {
+                    int object = facts.get_object(arg);
+                    if (object == -1)
+                        return;
+                    body_atom.terms.push_back(-(object + 2));
+                }
+            }
+            body.push_back(std::move(body_atom));
+        } else {
+            cerr << "Warning: rules of type \"" << type << "\" are not supported. "
+                 << "Rule \"" << text << "\" will never fire." << endl;
+            return;
+        }
+    }
+
+    // Variables that must be equal are replaced by a representative
+    vector<int> parent(variables.size());
+    iota(parent.begin(), parent.end(), 0);
+    for (const vector<int> &group : equalities) {
+        for (size_t i = 1; i < group.size(); ++i) {
+            parent[find_representative(parent, group[i])] = find_representative(parent, group[0]);
+        }
+    }
+
+    vector<Table> tables;
+    for (const BodyAtom &atom : body) {
+        tables.push_back(create_table(atom, parent, facts));
+        if (tables.back().tuples.empty())
+            return;
+    }
+    Table result = join_tables(tables);
+    if (result.tuples.empty())
+        return;
+
+    RuleResultIndex index;
+    vector<int> key_columns;
+    unordered_map<int, int> first_position;
+    for (int pos = 0; pos < arity; ++pos) {
+        int v = find_representative(parent, pos);
+        auto it = first_position.find(v);
+        if (it != first_position.end()) {
+            index.equal_positions.emplace_back(it->second, pos);
+            continue;
+        }
+        first_position[v] = pos;
+        auto column = find(result.tuple_index.begin(), result.tuple_index.end(), v);
+        if (column != result.tuple_index.end()) {
+            index.key_positions.push_back(pos);
+            key_columns.push_back(distance(result.tuple_index.begin(), column));
+        }
+    }
+    for (const vector<int> &row : result.tuples) {
+        vector<int> key(key_columns.size());
+        for (size_t i = 0; i < key_columns.size(); ++i) {
+            key[i] = row[key_columns[i]];
+        }
+        index.keys.insert(std::move(key));
+    }
+    add_result_index(schema, std::move(index));
+}
+
+void RulesEvaluator::load_rules(const vector<string> &rules, const RuleFactBase &facts) {
+    for (const string &rule : rules) {
+        if (!boost::algorithm::trim_copy(rule).empty())
+            add_rule(rule, facts);
+    }
+}
+
+void RulesEvaluator::load_rules_file(const string &filename, const RuleFactBase &facts) {
+    ifstream rules_file(filename);
+    vector<string> rules;
+    string line;
+    while (getline(rules_file, line)) {
+        rules.push_back(line);
+    }
+    load_rules(rules, facts);
+}
+
+bool RulesEvaluator::evaluate(int schema, const int *arguments) const {
+    for (const RuleResultIndex &index : indices_by_schema[schema]) {
+        if (index.matches(arguments))
+            return true;
+    }
+    return false;
+}
+
+void RulesEvaluator::evaluate_batch(int schema, const int *arguments, int num_actions, int *result) const {
+    int arity = schema_arities[schema];
+    for (int i = 0; i < num_actions; ++i) {
+        result[i] = evaluate(schema, arguments + i * arity) ? 1 : 0;
+    }
+}
+
+}
@@ -0,0 +1,132 @@
+#ifndef SEARCH_PARTIAL_GROUNDING_RULE_EVALUATOR_H_
+#define SEARCH_PARTIAL_GROUNDING_RULE_EVALUATOR_H_
+
+#include "../hash_structures.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace partial_grounding {
+
+/*
+ * Ground atoms of the initial state (including static atoms) and of the goal,
+ * grouped by predicate. Rules refer to them with the "ini:" and "goal:" prefixes.
+ *
+ * Predicates and objects are referred to by name in the rules and are
+ * numbered in the order they are added. This class does not depend on the
+ * Task, so that the translator can use the evaluator as well (see
+ * rule_evaluator_c_api.h).
+ */
+class RuleFactBase {
+public:
+    enum Source {INIT, GOAL};
+
+    typedef std::vector<std::vector<int>> Tuples;
+
+private:
+    std::unordered_map<std::string, int> predicate_ids;
+    std::unordered_map<std::string, int> object_ids;
+
+    // tuples[source][predicate]
+    std::vector<std::vector<Tuples>> tuples;
+
+public:
+    RuleFactBase() : tuples(2) {}
+
+    int add_predicate(const std::string &name);
+    int add_object(const std::string &name);
+
+    // Return -1 if there is no predicate or object with that name
+    int get_predicate(const std::string &name) const;
+    int get_object(const std::string &name) const;
+
+    void add_fact(Source source, int predicate, std::vector<int> arguments) {
+        tuples[source][predicate].push_back(std::move(arguments));
+    }
+
+    const Tuples &get_tuples(Source source, int predicate) const {
+        return tuples[source][predicate];
+    }
+};
+
+/*
+ * Action arguments satisfying some rule, for rules whose head uses the same
+ * argument positions.
+ *
+ * An action matches if its arguments at the positions of each pair in
+ * equal_positions are the same object and its arguments at key_positions are
+ * in keys. Positions in neither are not constrained by the rule.
+ */
+struct RuleResultIndex {
+    std::vector<int> key_positions;
+    std::vector<std::pair<int, int>> equal_positions;
+    std::unordered_set<std::vector<int>, TupleHash> keys;
+
+    bool matches(const int *arguments) const;
+};
+
+/*
+ * Evaluator for learned rules of the form
+ *
+ *   schema (?a, ?b) :- ini:pred(?a, ?c); goal:pred(?c, _); equal:(?a, ?b); true:
+ *
+ * as written by the rule learner and read by rule_evaluator.py. An action of the
+ * schema satisfies the rule if there is an assignment to the variables that
+ * do not occur in the head (?c) such that all atoms in the body hold in the
+ * initial state or in the goal, respectively. "_" matches any object and
+ * non-variable arguments are object names. Rules on the relaxed plan
+ * ("split:" and "relaxed_fact:") cannot be evaluated here and never fire.
+ *
+ * Rules are evaluated once, when they are loaded: each rule body is compiled
+ * into a table per atom (after merging variables that must be equal and
+ * selecting constants) that are hash-joined, smallest and connected tables
+ * first, and the result is projected onto the head variables. The projections
+ * of all rules of a schema are merged into RuleResultIndex objects, so
+ * evaluating an action only needs one hash lookup per distinct head pattern.
+ */
+class RulesEvaluator {
+    std::vector<std::string> schema_names;
+    std::vector<int> schema_arities;
+    std::vector<std::vector<RuleResultIndex>> indices_by_schema;
+    int num_rules;
+
+    void add_rule(const std::string &text, const RuleFactBase &facts);
+    void add_result_index(int schema, RuleResultIndex &&index);
+
+public:
+    // Schema i has the name and arity in schemas[i]
+    explicit RulesEvaluator(const std::vector<std::pair<std::string, int>> &schemas);
+
+    // Compile all rules in the file. A missing file contains no rules.
+    void load_rules_file(const std::string &filename, const RuleFactBase &facts);
+
+    void load_rules(const std::vector<std::string> &rules, const RuleFactBase &facts);
+
+    bool has_rules(int schema) const {
+        return !indices_by_schema[schema].empty();
+    }
+
+    int get_num_rules() const {
+        return num_rules;
+    }
+
+    // True if some rule of the schema fires for the given action arguments
+    bool evaluate(int schema, const int *arguments) const;
+
+    bool evaluate(int schema, const std::vector<int> &arguments) const {
+        return evaluate(schema, arguments.data());
+    }
+
+    /*
+      Evaluate num_actions actions of the schema whose arguments are stored
+      one after the other in arguments, and write 1 (fires) or 0 to result.
+    */
+    void evaluate_batch(int schema, const int *arguments, int num_actions, int *result) const;
+};
+
+}
+
+#endif //SEARCH_PARTIAL_GROUNDING_RULE_EVALUATOR_H_
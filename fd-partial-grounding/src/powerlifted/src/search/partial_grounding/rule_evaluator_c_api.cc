@@ -0,0 +1,56 @@
+#include "rule_evaluator_c_api.h"
+
+#include "rule_evaluator.h"
+
+using namespace std;
+using namespace partial_grounding;
+
+void *rule_evaluator_create_fact_base() {
+    return new RuleFactBase();
+}
+
+void rule_evaluator_destroy_fact_base(void *fact_base) {
+    delete static_cast<RuleFactBase *>(fact_base);
+}
+
+int rule_evaluator_add_object(void *fact_base, const char *name) {
+    return static_cast<RuleFactBase *>(fact_base)->add_object(name);
+}
+
+int rule_evaluator_add_predicate(void *fact_base, const char *name) {
+    return static_cast<RuleFactBase *>(fact_base)->add_predicate(name);
+}
+
+void rule_evaluator_add_fact(void *fact_base, int source, int predicate,
+                             const int *arguments, int num_arguments) {
+    static_cast<RuleFactBase *>(fact_base)->add_fact(
+        RuleFactBase::Source(source), predicate, vector<int>(arguments, arguments + num_arguments));
+}
+
+void *rule_evaluator_create(const char **schema_names, const int *arities, int num_schemas) {
+    vector<pair<string, int>> schemas;
+    for (int i = 0; i < num_schemas; ++i) {
+        schemas.emplace_back(schema_names[i], arities[i]);
+    }
+    return new RulesEvaluator(schemas);
+}
+
+void rule_evaluator_destroy(void *evaluator) {
+    delete static_cast<RulesEvaluator *>(evaluator);
+}
+
+int rule_evaluator_load_rules(void *evaluator, const void *fact_base,
+                              const char **rules, int num_rules) {
+    RulesEvaluator *e = static_cast<RulesEvaluator *>(evaluator);
+    e->load_rules(vector<string>(rules, rules + num_rules), *static_cast<const RuleFactBase *>(fact_base));
+    return e->get_num_rules();
+}
+
+int rule_evaluator_has_rules(const void *evaluator, int schema) {
+    return static_cast<const RulesEvaluator *>(evaluator)->has_rules(schema);
+}
+
+void rule_evaluator_evaluate_batch(const void *evaluator, int schema,
+                                   const int *arguments, int num_actions, int *result) {
+    static_cast<const RulesEvaluator *>(evaluator)->evaluate_batch(schema, arguments, num_actions, result);
+}
@@ -0,0 +1,49 @@
+#ifndef SEARCH_PARTIAL_GROUNDING_RULE_EVALUATOR_C_API_H_
+#define SEARCH_PARTIAL_GROUNDING_RULE_EVALUATOR_C_API_H_
+
+/*
+ * C interface of the rule evaluator, compiled into the shared library
+ * librule_evaluator.so next to the search binary. The translator loads it
+ * with ctypes to evaluate the learned rules with --batch-evaluation (see
+ * translate/subdominization/compiled_rule_evaluator.py).
+ *
+ * Objects, predicates and schemas are referred to by the ids returned when
+ * they are added, in the order they were added. Facts must be added before
+ * the rules are loaded, because rules are evaluated when they are loaded.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum RuleEvaluatorFactSource {RULE_EVALUATOR_INIT = 0, RULE_EVALUATOR_GOAL = 1};
+
+void *rule_evaluator_create_fact_base();
+void rule_evaluator_destroy_fact_base(void *fact_base);
+
+int rule_evaluator_add_object(void *fact_base, const char *name);
+int rule_evaluator_add_predicate(void *fact_base, const char *name);
+void rule_evaluator_add_fact(void *fact_base, int source, int predicate,
+                             const int *arguments, int num_arguments);
+
+void *rule_evaluator_create(const char **schema_names, const int *arities, int num_schemas);
+void rule_evaluator_destroy(void *evaluator);
+
+// Returns the number of rules for known schemas
+int rule_evaluator_load_rules(void *evaluator, const void *fact_base,
+                              const char **rules, int num_rules);
+
+int rule_evaluator_has_rules(const void *evaluator, int schema);
+
+/*
+ * Arguments of the num_actions actions one after the other; result[i] is set
+ * to 1 if some rule fires for action i and to 0 otherwise.
+ */
+void rule_evaluator_evaluate_batch(const void *evaluator, int schema,
+                                   const int *arguments, int num_actions, int *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SEARCH_PARTIAL_GROUNDING_RULE_EVALUATOR_C_API_H_
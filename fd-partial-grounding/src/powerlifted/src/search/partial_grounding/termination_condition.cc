@@ -0,0 +1,137 @@
+#include "termination_condition.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace partial_grounding {
+
+void DefaultCondition::print_info() const {
+    cout << "Using default termination condition, i.e. grounding all actions." << endl;
+}
+
+void GoalRelaxedReachableCondition::print_info() const {
+    cout << "Grounding stopped if goal is relaxed reachable." << endl;
+}
+
+void GoalRelaxedReachableCondition::notify_goal_reached() {
+    if (goal_reached)
+        return;
+    goal_reached = true;
+    num_additional_actions = compute_additional_actions(num_grounded_actions);
+}
+
+void GoalRelaxedReachableCondition::notify_action_grounded() {
+    if (goal_reached)
+        num_additional_actions -= 1;
+    else
+        ++num_grounded_actions;
+}
+
+double GoalRelaxedReachablePlusNumberCondition::compute_additional_actions(int) const {
+    return number;
+}
+
+void GoalRelaxedReachablePlusNumberCondition::print_info() const {
+    cout << "Grounding stopped if goal is relaxed reachable + " << number << " additional actions." << endl;
+}
+
+double GoalRelaxedReachableMinNumberCondition::compute_additional_actions(int grounded_before_goal) const {
+    return min_number - grounded_before_goal;
+}
+
+void GoalRelaxedReachableMinNumberCondition::print_info() const {
+    cout << "Grounding stopped if goal is relaxed reachable and at least "
+         << min_number << " actions have been grounded." << endl;
+}
+
+double GoalRelaxedReachablePlusPercentageCondition::compute_additional_actions(int grounded_before_goal) const {
+    return max(grounded_before_goal * percentage / 100.0, double(min_increment));
+}
+
+void GoalRelaxedReachablePlusPercentageCondition::print_info() const {
+    cout << "Grounding stopped if goal is relaxed reachable + at least "
+         << "max(#RS * " << (100 + percentage) / 100.0 << ", " << min_increment << ") + #RS actions "
+         << "have been grounded, where \"#RS\" is the number of actions grounded "
+         << "when the goal becomes relaxed reachable." << endl;
+}
+
+double GoalRelaxedReachableMinNumberPlusPercentageCondition::compute_additional_actions(int grounded_before_goal) const {
+    return max(double(min_number - grounded_before_goal),
+               min(grounded_before_goal * percentage / 100.0, double(max_increment)));
+}
+
+void GoalRelaxedReachableMinNumberPlusPercentageCondition::print_info() const {
+    cout << "Grounding stopped if goal is relaxed reachable + at least "
+         << "max(" << min_number << ", min(#RS * " << (100 + percentage) / 100.0
+         << ", " << max_increment << ") + #RS) actions "
+         << "have been grounded, where \"#RS\" is the number of actions grounded "
+         << "when the goal becomes relaxed reachable." << endl;
+}
+
+static int parse_non_negative(const string &option, const string &value) {
+    int n = -1;
+    try {
+        n = stoi(value);
+    } catch (const exception &) {
+    }
+    if (n < 0) {
+        cerr << "ERROR: " << option << " of the termination condition must be an integer >=0" << endl;
+        exit(-1);
+    }
+    return n;
+}
+
+unique_ptr<TerminationCondition> create_termination_condition(const vector<string> &args) {
+    if (args.size() == 1 && args[0] == "default") {
+        return make_unique<DefaultCondition>();
+    }
+    if (args.empty() || args[0] != "goal-relaxed-reachable" || args.size() % 2 == 0) {
+        cerr << "ERROR: unknown termination condition:";
+        for (const string &arg : args)
+            cerr << " " << arg;
+        cerr << endl;
+        exit(-1);
+    }
+    if (args.size() == 1) {
+        return make_unique<GoalRelaxedReachableCondition>();
+    }
+
+    int number = -1, min_number = -1, percentage = -1, min_increment = -1, max_increment = -1;
+    for (size_t i = 1; i < args.size(); i += 2) {
+        const string &option = args[i];
+        int value = parse_non_negative(option, args[i + 1]);
+        if (option == "number")
+            number = value;
+        else if (option == "min-number")
+            min_number = value;
+        else if (option == "percentage")
+            percentage = value;
+        else if (option == "min-increment")
+            min_increment = value;
+        else if (option == "max-increment")
+            max_increment = value;
+        else {
+            cerr << "ERROR: unknown option for termination condition " << option << endl;
+            exit(-1);
+        }
+    }
+
+    // Same combinations of options as accepted by the translator
+    if (args.size() == 3 && number != -1)
+        return make_unique<GoalRelaxedReachablePlusNumberCondition>(number);
+    if (args.size() == 3 && min_number != -1)
+        return make_unique<GoalRelaxedReachableMinNumberCondition>(min_number);
+    if (args.size() == 3 && percentage != -1)
+        return make_unique<GoalRelaxedReachablePlusPercentageCondition>(percentage, 0);
+    if (args.size() == 5 && percentage != -1 && min_increment != -1)
+        return make_unique<GoalRelaxedReachablePlusPercentageCondition>(percentage, min_increment);
+    if (args.size() == 7 && min_number != -1 && percentage != -1 && max_increment != -1)
+        return make_unique<GoalRelaxedReachableMinNumberPlusPercentageCondition>(min_number, percentage, max_increment);
+
+    cerr << "ERROR: unrecognized combination of options for the termination condition" << endl;
+    exit(-1);
+}
+
+}
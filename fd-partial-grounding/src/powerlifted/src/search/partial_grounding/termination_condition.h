@@ -0,0 +1,128 @@
+#ifndef SEARCH_PARTIAL_GROUNDING_TERMINATION_CONDITION_H_
+#define SEARCH_PARTIAL_GROUNDING_TERMINATION_CONDITION_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace partial_grounding {
+
+/*
+ * Decides when the partial grounder stops popping actions from its queue.
+ *
+ * These are the same conditions as in the translator
+ * (src/translate/subdominization/termination_condition.py), and they are
+ * selected with the same arguments, e.g. "goal-relaxed-reachable percentage 10".
+ * Facts that are not actions are always processed before the next action is
+ * popped, so a condition can only trigger in between two actions.
+ */
+class TerminationCondition {
+public:
+    virtual ~TerminationCondition() = default;
+
+    virtual void print_info() const = 0;
+
+    virtual bool terminate() const = 0;
+
+    virtual void notify_goal_reached() {}
+
+    virtual void notify_action_grounded() {}
+};
+
+class DefaultCondition : public TerminationCondition {
+public:
+    void print_info() const override;
+
+    bool terminate() const override {
+        return false;
+    }
+};
+
+/*
+ * Stops as soon as the goal is relaxed reachable and some additional actions
+ * have been grounded. The subclasses only differ in how many additional actions
+ * they ground, which depends on the number of actions grounded before the goal
+ * became relaxed reachable.
+ */
+class GoalRelaxedReachableCondition : public TerminationCondition {
+    bool goal_reached;
+    int num_grounded_actions;
+    double num_additional_actions;
+
+protected:
+    virtual double compute_additional_actions(int /*grounded_before_goal*/) const {
+        return 0;
+    }
+
+public:
+    GoalRelaxedReachableCondition() : goal_reached(false), num_grounded_actions(0), num_additional_actions(0) {}
+
+    void print_info() const override;
+
+    bool terminate() const override {
+        return goal_reached && num_additional_actions <= 0;
+    }
+
+    void notify_goal_reached() override;
+
+    void notify_action_grounded() override;
+};
+
+class GoalRelaxedReachablePlusNumberCondition : public GoalRelaxedReachableCondition {
+    int number;
+
+protected:
+    double compute_additional_actions(int grounded_before_goal) const override;
+
+public:
+    explicit GoalRelaxedReachablePlusNumberCondition(int number) : number(number) {}
+
+    void print_info() const override;
+};
+
+class GoalRelaxedReachableMinNumberCondition : public GoalRelaxedReachableCondition {
+    int min_number;
+
+protected:
+    double compute_additional_actions(int grounded_before_goal) const override;
+
+public:
+    explicit GoalRelaxedReachableMinNumberCondition(int min_number) : min_number(min_number) {}
+
+    void print_info() const override;
+};
+
+class GoalRelaxedReachablePlusPercentageCondition : public GoalRelaxedReachableCondition {
+    int percentage;
+    int min_increment;
+
+protected:
+    double compute_additional_actions(int grounded_before_goal) const override;
+
+public:
+    GoalRelaxedReachablePlusPercentageCondition(int percentage, int min_increment)
+        : percentage(percentage), min_increment(min_increment) {}
+
+    void print_info() const override;
+};
+
+class GoalRelaxedReachableMinNumberPlusPercentageCondition : public GoalRelaxedReachableCondition {
+    int min_number;
+    int percentage;
+    int max_increment;
+
+protected:
+    double compute_additional_actions(int grounded_before_goal) const override;
+
+public:
+    GoalRelaxedReachableMinNumberPlusPercentageCondition(int min_number, int percentage, int max_increment)
+        : min_number(min_number), percentage(percentage), max_increment(max_increment) {}
+
+    void print_info() const override;
+};
+
+std::unique_ptr<TerminationCondition> create_termination_condition(const std::vector<std::string> &args);
+
+}
+
+#endif //SEARCH_PARTIAL_GROUNDING_TERMINATION_CONDITION_H_
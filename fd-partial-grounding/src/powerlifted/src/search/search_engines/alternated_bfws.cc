@@ -85,8 +85,6 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
     clock_t timer_start = clock();
     StatePackerT packer(task);
 
-    Goalcount gc;
-
     size_t number_goal_conditions = task.get_goal().goal.size() + task.get_goal().positive_nullary_goals.size() + task.get_goal().negative_nullary_goals.size();
     size_t number_relevant_atoms;
 
@@ -105,10 +103,13 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
 
     StandardNovelty novelty_evaluator(task, number_goal_conditions, number_relevant_atoms, width);
 
-    int gc_h0 = gc.compute_heuristic(task.initial_state, task);
+    // Goalcount and the novelty of width 1 are computed on the packed states
+    const PackedStateT &packed_root = space.get_state(root_node.state_id);
+    int gc_h0 = packer.count_unsatisfied_goals(packed_root);
 
     int unachieved_atoms_s0 = 0;
-    int novelty_value = novelty_evaluator.compute_novelty(task, task.initial_state, gc_h0, unachieved_atoms_s0);
+    int novelty_value = novelty_evaluator.compute_novelty(task, task.initial_state, packer, packed_root,
+                                                          gc_h0, unachieved_atoms_s0);
 
     statistics.inc_evaluations();
     cout << "Initial heuristic value " << heuristic_layer << endl;
@@ -125,7 +126,7 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
 
     map_state_to_evaluators.insert({root_node.state_id.id(), NodeNovelty(gc_h0, unachieved_atoms_s0)});
 
-    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+    if (check_goal(task, generator, timer_start, packer, packed_root, root_node, space)) return utils::ExitCode::SUCCESS;
 
     int heuristic_layer = initial_h;
     while (not open_list.empty()) {
@@ -164,10 +165,12 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
 
             for (const LiftedOperatorId& op_id:applicable) {
                 DBState s = generator.generate_successor(op_id, action, state);
+                auto& child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, node.state_id);
+                const PackedStateT &packed_s = space.get_state(child_node.state_id);
 
                 bool is_preferred = is_useful_operator(task, s, delete_free_h->get_useful_atoms());
                 int dist = g + action.get_cost();
-                int unsatisfied_goals = gc.compute_heuristic(s, task);
+                int unsatisfied_goals = packer.count_unsatisfied_goals(packed_s);
                 int unsatisfied_relevant_atoms = 0;
 
                 unsatisfied_relevant_atoms = atom_counter.count_unachieved_atoms(s, task);
@@ -175,6 +178,7 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
                 if (only_effects_opt and (unsatisfied_goals == unsatisfied_goal_parent) and (unsatisfied_relevant_atoms == unsatisfied_relevant_atoms_parent)) {
                     novelty_value = novelty_evaluator.compute_novelty_from_operator(task,
                                                                                     s,
+                                                                                    packer,
                                                                                     unsatisfied_goals,
                                                                                     unsatisfied_relevant_atoms,
                                                                                     generator.get_added_atoms());
@@ -182,6 +186,8 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
                 else {
                     novelty_value = novelty_evaluator.compute_novelty(task,
                                                                       s,
+                                                                      packer,
+                                                                      packed_s,
                                                                       unsatisfied_goals,
                                                                       unsatisfied_relevant_atoms);
 
@@ -190,11 +196,10 @@ utils::ExitCode AlternatedBFWS<PackedStateT>::search(const Task &task,
                 statistics.inc_evaluations();
                 statistics.inc_evaluated_states();
 
-                auto& child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, node.state_id);
                 if (child_node.status==SearchNode::Status::NEW) {
                     // Inserted for the first time in the map
                     child_node.open(dist, h);
-                    if (check_goal(task, generator, timer_start, s, child_node, space))
+                    if (check_goal(task, generator, timer_start, packer, packed_s, child_node, space))
                         return utils::ExitCode::SUCCESS;
                     open_list.do_insertion(child_node.state_id,
                                            h,
@@ -46,8 +46,6 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
     clock_t timer_start = clock();
     StatePackerT packer(task);
 
-    Goalcount gc;
-
     size_t number_goal_conditions = task.get_goal().goal.size() + task.get_goal().positive_nullary_goals.size() + task.get_goal().negative_nullary_goals.size();
     size_t number_relevant_atoms;
 
@@ -72,13 +70,16 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
 
     StandardNovelty novelty_evaluator(task, number_goal_conditions, number_relevant_atoms, width);
 
-    int gc_h0 = gc.compute_heuristic(task.initial_state, task);
+    // Goalcount and the novelty of width 1 are computed on the packed states
+    const PackedStateT &packed_root = space.get_state(root_node.state_id);
+    int gc_h0 = packer.count_unsatisfied_goals(packed_root);
 
     int unachieved_atoms_s0 = 0;
     if (method == StandardNovelty::R_X)
         unachieved_atoms_s0 = atom_counter.count_unachieved_atoms(task.initial_state, task);
 
-    int novelty_value = novelty_evaluator.compute_novelty(task, task.initial_state, gc_h0, unachieved_atoms_s0);
+    int novelty_value = novelty_evaluator.compute_novelty(task, task.initial_state, packer, packed_root,
+                                                          gc_h0, unachieved_atoms_s0);
 
     root_node.open(0, novelty_value);
 
@@ -91,7 +92,7 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
 
     map_state_to_evaluators.insert({root_node.state_id.id(), NodeNovelty(gc_h0, unachieved_atoms_s0)});
 
-    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+    if (check_goal(task, generator, timer_start, packer, packed_root, root_node, space)) return utils::ExitCode::SUCCESS;
 
     while (not queue.empty()) {
         StateID sid = queue.remove_min();
@@ -122,8 +123,9 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
                 if (child_node.status != SearchNode::Status::NEW)
                     continue;
 
+                const PackedStateT &packed_s = space.get_state(child_node.state_id);
                 int dist = g + action.get_cost();
-                int unsatisfied_goals = gc.compute_heuristic(s, task);
+                int unsatisfied_goals = packer.count_unsatisfied_goals(packed_s);
                 int unsatisfied_relevant_atoms = 0;
 
                 if (method == StandardNovelty::IW) {
@@ -138,6 +140,7 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
                 if (only_effects_opt and (unsatisfied_goals == unsatisfied_goal_parent) and (unsatisfied_relevant_atoms == unsatisfied_relevant_atoms_parent)) {
                     novelty_value = novelty_evaluator.compute_novelty_from_operator(task,
                                                                                     s,
+                                                                                    packer,
                                                                                     unsatisfied_goals,
                                                                                     unsatisfied_relevant_atoms,
                                                                                     generator.get_added_atoms());
@@ -145,6 +148,8 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
                 else {
                     novelty_value = novelty_evaluator.compute_novelty(task,
                                                                       s,
+                                                                      packer,
+                                                                      packed_s,
                                                                       unsatisfied_goals,
                                                                       unsatisfied_relevant_atoms);
 
@@ -157,7 +162,7 @@ utils::ExitCode BreadthFirstWidthSearch<PackedStateT>::search(const Task &task,
                     continue;
 
                 child_node.open(dist, novelty_value);
-                if (check_goal(task, generator, timer_start, s, child_node, space)) return utils::ExitCode::SUCCESS;
+                if (check_goal(task, generator, timer_start, packer, packed_s, child_node, space)) return utils::ExitCode::SUCCESS;
                 queue.do_insertion(child_node.state_id, {novelty_value, unsatisfied_goals, dist});
                 map_state_to_evaluators.insert({child_node.state_id.id(), NodeNovelty(unsatisfied_goals, unsatisfied_relevant_atoms)});
             }
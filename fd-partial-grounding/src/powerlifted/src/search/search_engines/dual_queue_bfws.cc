@@ -22,8 +22,6 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
     clock_t timer_start = clock();
     StatePackerT packer(task);
 
-    Goalcount gc;
-
     size_t number_goal_conditions = task.get_goal().goal.size() + task.get_goal().positive_nullary_goals.size() + task.get_goal().negative_nullary_goals.size();
     size_t number_relevant_atoms;
 
@@ -45,10 +43,13 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
 
     StandardNovelty novelty_evaluator(task, number_goal_conditions, number_relevant_atoms, width);
 
-    int gc_h0 = gc.compute_heuristic(task.initial_state, task);
+    // Goalcount and the novelty of width 1 are computed on the packed states
+    const PackedStateT &packed_root = space.get_state(root_node.state_id);
+    int gc_h0 = packer.count_unsatisfied_goals(packed_root);
 
     int unachieved_atoms_s0 = 0;
-    int novelty_value = novelty_evaluator.compute_novelty(task, task.initial_state, gc_h0, unachieved_atoms_s0);
+    int novelty_value = novelty_evaluator.compute_novelty(task, task.initial_state, packer, packed_root,
+                                                          gc_h0, unachieved_atoms_s0);
 
     root_node.open(0, novelty_value);
 
@@ -61,7 +62,7 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
 
     map_state_to_evaluators.insert({root_node.state_id.id(), NodeNovelty(gc_h0, unachieved_atoms_s0)});
 
-    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+    if (check_goal(task, generator, timer_start, packer, packed_root, root_node, space)) return utils::ExitCode::SUCCESS;
 
     int goalcount_layer = gc_h0;
     while ((not regular_open_list.empty()) or (not preferred_open_list.empty())) {
@@ -96,9 +97,10 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
                 auto& child_node = space.insert_or_get_previous_node(packer.pack(s), op_id, node.state_id);
                 if (child_node.status != SearchNode::Status::NEW)
                     continue;
+                const PackedStateT &packed_s = space.get_state(child_node.state_id);
                 bool is_preferred = is_useful_operator(task, s, delete_free_h.get_useful_atoms());
                 int dist = g + action.get_cost();
-                int unsatisfied_goals = gc.compute_heuristic(s, task);
+                int unsatisfied_goals = packer.count_unsatisfied_goals(packed_s);
                 int unsatisfied_relevant_atoms = 0;
 
                 unsatisfied_relevant_atoms = atom_counter.count_unachieved_atoms(s, task);
@@ -106,6 +108,7 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
                 if (only_effects_opt and (unsatisfied_goals == unsatisfied_goal_parent) and (unsatisfied_relevant_atoms == unsatisfied_relevant_atoms_parent)) {
                     novelty_value = novelty_evaluator.compute_novelty_from_operator(task,
                                                                                     s,
+                                                                                    packer,
                                                                                     unsatisfied_goals,
                                                                                     unsatisfied_relevant_atoms,
                                                                                     generator.get_added_atoms());
@@ -113,6 +116,8 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
                 else {
                     novelty_value = novelty_evaluator.compute_novelty(task,
                                                                       s,
+                                                                      packer,
+                                                                      packed_s,
                                                                       unsatisfied_goals,
                                                                       unsatisfied_relevant_atoms);
 
@@ -122,7 +127,7 @@ utils::ExitCode DualQueueBFWS<PackedStateT>::search(const Task &task,
                 statistics.inc_evaluated_states();
 
                 child_node.open(dist, novelty_value);
-                if (check_goal(task, generator, timer_start, s, child_node, space)) return utils::ExitCode::SUCCESS;
+                if (check_goal(task, generator, timer_start, packer, packed_s, child_node, space)) return utils::ExitCode::SUCCESS;
                 if (is_preferred) {
                     preferred_open_list.do_insertion(child_node.state_id,
                                                      {novelty_value, unsatisfied_goals, dist});
@@ -68,8 +68,11 @@ utils::ExitCode GreedyBestFirstSearch<PackedStateT>::search(const Task &task,
         }
         assert(sid.id() >= 0 && (unsigned) sid.id() < space.size());
 
+        if (check_goal(task, generator, timer_start, packer, space.get_state(sid), node, space))
+            return utils::ExitCode::SUCCESS;
+
+        // Only unpack the state once we know that it is going to be expanded
         DBState state = packer.unpack(space.get_state(sid));
-        if (check_goal(task, generator, timer_start, state, node, space)) return utils::ExitCode::SUCCESS;
 
         // Let's expand the state, one schema at a time. If necessary, i.e. if it really helps
         // performance, we could implement some form of std iterator
@@ -53,11 +53,15 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
     while ((not regular_open_list.empty()) or (not preferred_open_list.empty())) {
         StateID sid = get_top_node(preferred_open_list, regular_open_list); //regular_open_list.remove_min();
         SearchNode &node = space.get_node(sid);
-        DBState state = packer.unpack(space.get_state(sid));
         if (node.status == SearchNode::Status::CLOSED) {
             continue;
         }
         node.close();
+        if (check_goal(task, generator, timer_start, packer, space.get_state(sid), node, space))
+            return utils::ExitCode::SUCCESS;
+
+        // Only unpack the state once we know that it is going to be evaluated and expanded
+        DBState state = packer.unpack(space.get_state(sid));
         int h = heuristic.compute_heuristic(state, task);
         statistics.inc_evaluations();
         statistics.inc_evaluated_states();
@@ -83,8 +87,6 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
         }
         assert(sid.id() >= 0 && (unsigned) sid.id() < space.size());
 
-        if (check_goal(task, generator, timer_start, state, node, space)) return utils::ExitCode::SUCCESS;
-
         // Let's expand the state, one schema at a time. If necessary, i.e. if it really helps
         // performance, we could implement some form of std iterator
         for (const auto& action:task.get_action_schemas()) {
@@ -100,7 +102,7 @@ utils::ExitCode LazySearch<PackedStateT>::search(const Task &task,
                 if (child_node.status==SearchNode::Status::NEW) {
                     // Inserted for the first time in the map
                     child_node.open(dist, h);
-                    if (check_goal(task, generator, timer_start, state, node, space))
+                    if (check_goal(task, generator, timer_start, packer, space.get_state(sid), node, space))
                         return utils::ExitCode::SUCCESS;
 
                     if (all_operators_preferred or is_preferred) {
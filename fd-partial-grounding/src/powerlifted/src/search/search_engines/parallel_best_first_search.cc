@@ -0,0 +1,242 @@
+#include "parallel_best_first_search.h"
+#include "search.h"
+#include "utils.h"
+
+#include "../action.h"
+
+#include "../heuristics/heuristic.h"
+#include "../heuristics/heuristic_factory.h"
+#include "../open_lists/greedy_open_list.h"
+#include "../states/extensional_states.h"
+#include "../states/sparse_states.h"
+#include "../successor_generators/successor_generator.h"
+#include "../successor_generators/successor_generator_factory.h"
+#include "../utils/thread_pool.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace std;
+
+template <class PackedStateT>
+ParallelBestFirstSearch<PackedStateT>::ParallelBestFirstSearch(const Options &opt, bool astar)
+    : opt(opt), astar(astar),
+      num_threads(max(1, opt.get_threads())),
+      batch_size(max(1, opt.get_batch_size())),
+      deterministic(opt.get_deterministic())
+{
+}
+
+namespace {
+template <class PackedStateT>
+struct Successor {
+    LiftedOperatorId op_id;
+    int cost;
+    DBState state;
+    //! Set in the evaluation step (packed states need not be default-constructible)
+    std::optional<PackedStateT> packed_state;
+    int h;
+
+    Successor(const LiftedOperatorId &op_id, int cost, DBState &&state)
+        : op_id(op_id), cost(cost), state(std::move(state)), packed_state(), h(0) {}
+};
+
+template <class PackedStateT>
+struct Expansion {
+    StateID sid;
+    bool is_goal;
+    DBState state;
+    size_t num_generated;
+    std::vector<Successor<PackedStateT>> successors;
+
+    explicit Expansion(StateID sid)
+        : sid(sid), is_goal(false), num_generated(0) {}
+};
+}
+
+template <class PackedStateT>
+utils::ExitCode ParallelBestFirstSearch<PackedStateT>::search(const Task &task,
+                                                              SuccessorGenerator &generator,
+                                                              Heuristic &heuristic)
+{
+    cout << "Starting parallel " << (astar ? "A*" : "greedy best first") << " search with "
+         << num_threads << " thread(s) and batches of " << batch_size << " node(s)"
+         << (deterministic ? " (deterministic)" : "") << endl;
+    clock_t timer_start = clock();
+
+    // Worker 0 uses the heuristic and generator created in main
+    vector<unique_ptr<Heuristic>> owned_heuristics;
+    vector<unique_ptr<SuccessorGenerator>> owned_generators;
+    vector<Heuristic *> heuristics = {&heuristic};
+    vector<SuccessorGenerator *> generators = {&generator};
+    vector<StatePackerT> packers;
+    packers.emplace_back(task);
+    for (int i = 1; i < num_threads; ++i) {
+        owned_heuristics.emplace_back(HeuristicFactory::create(opt, task));
+        owned_generators.emplace_back(SuccessorGeneratorFactory::create(
+            opt.get_successor_generator(), opt, task));
+        heuristics.push_back(owned_heuristics.back().get());
+        generators.push_back(owned_generators.back().get());
+        packers.emplace_back(task);
+    }
+    utils::ThreadPool pool(num_threads);
+    auto run_parallel = [&](size_t n, const function<void(int, size_t)> &f) {
+        if (deterministic)
+            pool.run_round_robin(n, f);
+        else
+            pool.run(n, f);
+    };
+
+    GreedyOpenList queue;
+
+    SearchNode& root_node = space.insert_or_get_previous_node(packers[0].pack(task.initial_state), LiftedOperatorId::no_operator, StateID::no_state);
+    utils::Timer t;
+    heuristic_layer = heuristic.compute_heuristic(task.initial_state, task);
+    t.stop();
+    cout << "Time to evaluate initial state: " << t() << endl;
+    root_node.open(0, heuristic_layer);
+    if (heuristic_layer == numeric_limits<int>::max()) {
+        cerr << "Initial state is unsolvable!" << endl;
+        exit(1);
+    }
+    statistics.inc_evaluations();
+    cout << "Initial heuristic value " << heuristic_layer << endl;
+    statistics.report_f_value_progress(heuristic_layer);
+    queue.do_insertion(root_node.state_id, get_key(0, heuristic_layer));
+
+    if (check_goal(task, generator, timer_start, task.initial_state, root_node, space)) return utils::ExitCode::SUCCESS;
+
+    vector<Expansion<PackedStateT>> batch;
+    vector<pair<size_t, size_t>> successor_index;
+
+    while (not queue.empty()) {
+        // Pop the nodes of the batch
+        batch.clear();
+        while (not queue.empty() and batch.size() < size_t(batch_size)) {
+            StateID sid = queue.remove_min();
+            SearchNode &node = space.get_node(sid);
+            int h = node.h;
+            if (node.status == SearchNode::Status::CLOSED) {
+                continue;
+            }
+            node.close();
+            statistics.report_f_value_progress(h); // In GBFS f = h.
+            statistics.inc_expanded();
+
+            if (h < heuristic_layer) {
+                heuristic_layer = h;
+                cout << "New heuristic value expanded: h=" << h
+                     << " [expansions: " << statistics.get_expanded()
+                     << ", evaluations: " << statistics.get_evaluations()
+                     << ", generations: " << statistics.get_generated()
+                     << ", time: " << double(clock() - timer_start) / CLOCKS_PER_SEC << "]" << '\n';
+            }
+            assert(sid.id() >= 0 && (unsigned) sid.id() < space.size());
+            batch.emplace_back(sid);
+        }
+
+        // 1. Expand the nodes in parallel. The search space is not modified until step 3.
+        run_parallel(batch.size(), [&](int worker, size_t k) {
+            Expansion<PackedStateT> &expansion = batch[k];
+            expansion.state = packers[worker].unpack(space.get_state(expansion.sid));
+            if (task.is_goal(expansion.state)) {
+                expansion.is_goal = true;
+                return;
+            }
+            SuccessorGenerator &worker_generator = *generators[worker];
+            for (const auto& action:task.get_action_schemas()) {
+                auto applicable = worker_generator.get_applicable_actions(action, expansion.state);
+                expansion.num_generated += applicable.size();
+                for (const LiftedOperatorId& op_id:applicable) {
+                    expansion.successors.emplace_back(
+                        op_id, action.get_cost(),
+                        worker_generator.generate_successor(op_id, action, expansion.state));
+                }
+            }
+        });
+
+        // 2. Evaluate and pack all successors of the batch in parallel
+        successor_index.clear();
+        for (size_t k = 0; k < batch.size(); ++k) {
+            for (size_t i = 0; i < batch[k].successors.size(); ++i)
+                successor_index.emplace_back(k, i);
+        }
+        run_parallel(successor_index.size(), [&](int worker, size_t j) {
+            auto &successor = batch[successor_index[j].first].successors[successor_index[j].second];
+            successor.h = heuristics[worker]->compute_heuristic(successor.state, task);
+            successor.packed_state.emplace(packers[worker].pack(successor.state));
+            successor.state = DBState();
+        });
+
+        // 3. Merge the results sequentially, in a fixed order
+        for (Expansion<PackedStateT> &expansion : batch) {
+            SearchNode &node = space.get_node(expansion.sid);
+            if (expansion.is_goal) {
+                check_goal(task, generator, timer_start, expansion.state, node, space);
+                return utils::ExitCode::SUCCESS;
+            }
+            int g = node.g;
+            StateID parent_id = node.state_id;
+            statistics.inc_generated(expansion.num_generated);
+
+            for (Successor<PackedStateT> &successor : expansion.successors) {
+                int dist = g + successor.cost;
+                int new_h = successor.h;
+                statistics.inc_evaluations();
+
+                if (new_h == UNSOLVABLE_STATE) {
+                    if (astar) {
+                        statistics.inc_dead_ends();
+                        statistics.inc_pruned_states();
+                        continue;
+                    }
+                    // GBFS registers dead ends in the search space
+                    auto& child_node = space.insert_or_get_previous_node(
+                        std::move(*successor.packed_state), successor.op_id, parent_id);
+                    if (child_node.status == SearchNode::Status::NEW) {
+                        // Only increase statistics for new dead-ends
+                        child_node.open(dist, new_h);
+                        statistics.inc_dead_ends();
+                        statistics.inc_pruned_states();
+                    }
+                    continue;
+                }
+
+                auto& child_node = space.insert_or_get_previous_node(
+                    std::move(*successor.packed_state), successor.op_id, parent_id);
+                if (child_node.status == SearchNode::Status::NEW) {
+                    // Inserted for the first time in the map
+                    child_node.open(dist, new_h);
+                    statistics.inc_evaluated_states();
+                    queue.do_insertion(child_node.state_id, get_key(dist, new_h));
+                }
+                else {
+                    if (dist < child_node.g) {
+                        child_node.open(dist, new_h); // Reopening
+                        statistics.inc_reopened();
+                        queue.do_insertion(child_node.state_id, get_key(dist, new_h));
+                    }
+                }
+            }
+        }
+    }
+
+    print_no_solution_found(timer_start);
+
+    return utils::ExitCode::SEARCH_UNSOLVABLE;
+}
+
+template <class PackedStateT>
+void ParallelBestFirstSearch<PackedStateT>::print_statistics() const {
+    statistics.print_detailed_statistics();
+    space.print_statistics();
+}
+
+// explicit template instantiations
+template class ParallelBestFirstSearch<SparsePackedState>;
+template class ParallelBestFirstSearch<ExtensionalPackedState>;
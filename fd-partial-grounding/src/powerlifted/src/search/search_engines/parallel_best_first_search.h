@@ -0,0 +1,68 @@
+#ifndef SEARCH_PARALLEL_BEST_FIRST_SEARCH_H
+#define SEARCH_PARALLEL_BEST_FIRST_SEARCH_H
+
+#include "search.h"
+#include "search_space.h"
+
+#include "../options.h"
+
+/**
+ * @brief GBFS and A* with parallel node expansion and evaluation.
+ *
+ * @details The search proceeds in batches. In each batch, we pop up to
+ * `batch_size` open nodes and then:
+ *
+ *   1. Expand them in parallel: unpack, check the goal, compute the applicable
+ *      actions and generate the successors.
+ *   2. Evaluate and pack all successors of the batch in parallel.
+ *   3. Insert the successors into the search space and the open list
+ *      sequentially, in the order of the batch and of the successors, with
+ *      exactly the same rules as GreedyBestFirstSearch (or AStarSearch).
+ *
+ * Each worker owns its heuristic, successor generator and state packer, so the
+ * datalog programs of the heuristics are never shared. The search space is only
+ * written in step 3, when no worker is running, so it needs no locking.
+ *
+ * By default, idle workers take the next unclaimed node (or successor) of the
+ * step, so workers that get cheap nodes take over work from the slow ones. With
+ * --deterministic, nodes and successors are assigned to the workers round
+ * robin instead, so each worker sees the same sequence of states in every run
+ * and the result never depends on how the threads are scheduled. This matters
+ * for generators and heuristics that keep state between calls (e.g., the random
+ * number generator of random_join, the learned join orders of adaptive_join, or
+ * --incremental-grounding): they may order the successors differently depending
+ * on the states they saw before, which changes the tie-breaking. The result can
+ * still depend on the number of threads. With stateless ones, such as join, the
+ * result only depends on the batch size in both modes. With a batch size of 1,
+ * the search expands exactly the same nodes as the sequential engine, up to
+ * these tie-breaking differences, and only the evaluation of the successors
+ * runs in parallel.
+ */
+template <class PackedStateT>
+class ParallelBestFirstSearch : public SearchBase {
+protected:
+    SearchSpace<PackedStateT> space;
+
+    const Options &opt;
+    bool astar;
+    int num_threads;
+    int batch_size;
+    bool deterministic;
+
+    int heuristic_layer{};
+
+    std::pair<int, int> get_key(int g, int h) const {
+        return astar ? std::make_pair(h + g, h) : std::make_pair(h, g);
+    }
+
+public:
+    using StatePackerT = typename PackedStateT::StatePackerT;
+
+    ParallelBestFirstSearch(const Options &opt, bool astar);
+
+    utils::ExitCode search(const Task &task, SuccessorGenerator &generator, Heuristic &heuristic) override;
+
+    void print_statistics() const override;
+};
+
+#endif //SEARCH_PARALLEL_BEST_FIRST_SEARCH_H
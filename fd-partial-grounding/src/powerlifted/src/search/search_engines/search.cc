@@ -47,6 +47,22 @@ bool SearchBase::check_goal(const Task &task,
     return true;
 }
 
+template<class PackedStateT>
+bool SearchBase::check_goal(const Task &task,
+                            const SuccessorGenerator &generator,
+                            clock_t timer_start,
+                            const typename PackedStateT::StatePackerT &packer,
+                            const PackedStateT &state,
+                            const SearchNode &node,
+                            const SearchSpace<PackedStateT> &space) const {
+    if (!packer.is_goal(state)) return false;
+
+    print_goal_found(generator, timer_start);
+    auto plan = space.extract_plan(node);
+    print_plan(plan, task);
+    return true;
+}
+
 // explicit instantiations
 template bool SearchBase::check_goal<SparsePackedState>(
         const Task &task, const SuccessorGenerator &generator, clock_t timer_start,
@@ -56,3 +72,12 @@ template bool SearchBase::check_goal<ExtensionalPackedState>(
         const Task &task, const SuccessorGenerator &generator, clock_t timer_start,
         const DBState &state, const SearchNode &node, const SearchSpace<ExtensionalPackedState> &space) const;
 
+template bool SearchBase::check_goal<SparsePackedState>(
+        const Task &task, const SuccessorGenerator &generator, clock_t timer_start,
+        const SparseStatePacker &packer, const SparsePackedState &state,
+        const SearchNode &node, const SearchSpace<SparsePackedState> &space) const;
+
+template bool SearchBase::check_goal<ExtensionalPackedState>(
+        const Task &task, const SuccessorGenerator &generator, clock_t timer_start,
+        const ExtensionalStatePacker &packer, const ExtensionalPackedState &state,
+        const SearchNode &node, const SearchSpace<ExtensionalPackedState> &space) const;
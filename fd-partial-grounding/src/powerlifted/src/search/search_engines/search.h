@@ -36,6 +36,16 @@ public:
                     const SearchNode &node,
                     const SearchSpace<PackedStateT> &space) const;
 
+    //! Same as above, but checks the goal directly on the packed state
+    template <class PackedStateT>
+    bool check_goal(const Task &task,
+                    const SuccessorGenerator &generator,
+                    clock_t timer_start,
+                    const typename PackedStateT::StatePackerT &packer,
+                    const PackedStateT &state,
+                    const SearchNode &node,
+                    const SearchSpace<PackedStateT> &space) const;
+
 protected:
 
     SearchStatistics statistics;
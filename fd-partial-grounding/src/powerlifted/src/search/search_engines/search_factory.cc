@@ -8,6 +8,7 @@
 #include "dual_queue_bfws.h"
 #include "greedy_best_first_search.h"
 #include "lazy_search.h"
+#include "parallel_best_first_search.h"
 #include "search.h"
 
 #include "../states/extensional_states.h"
@@ -19,12 +20,17 @@ SearchBase*
 SearchFactory::create(const Options &opt, const std::string& method, const std::string& state_type) {
     std::cout << "Creating search factory for method " << method << "..." << std::endl;
     bool using_ext_state = boost::iequals(state_type, "extensional");
+    bool parallel = opt.get_threads() > 1 or opt.get_batch_size() > 1;
 
     if (boost::iequals(method, "naive")) {
         std::cerr << "WARNING: The \"naive\" keyword for search engines "
           "has been replaced with \"bfs\"" << std::endl;
         exit(-1);
     }
+    else if (boost::iequals(method, "astar") and parallel) {
+        if (using_ext_state) return new ParallelBestFirstSearch<ExtensionalPackedState>(opt, true);
+        else return new ParallelBestFirstSearch<SparsePackedState>(opt, true);
+    }
     else if (boost::iequals(method, "astar")) {
         if (using_ext_state) return new AStarSearch<ExtensionalPackedState>();
         else return new AStarSearch<SparsePackedState>();
@@ -81,6 +87,10 @@ SearchFactory::create(const Options &opt, const std::string& method, const std::
         if (using_ext_state) return new AlternatedBFWS<ExtensionalPackedState>(2, opt);
         else return new AlternatedBFWS<SparsePackedState>(2, opt);
     }
+    else if (boost::iequals(method, "gbfs") and parallel) {
+        if (using_ext_state) return new ParallelBestFirstSearch<ExtensionalPackedState>(opt, false);
+        else return new ParallelBestFirstSearch<SparsePackedState>(opt, false);
+    }
     else if (boost::iequals(method, "gbfs")) {
         if (using_ext_state) return new GreedyBestFirstSearch<ExtensionalPackedState>();
         else return new GreedyBestFirstSearch<SparsePackedState>();
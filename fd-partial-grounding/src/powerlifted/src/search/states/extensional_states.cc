@@ -1,14 +1,23 @@
 
 #include "extensional_states.h"
-#include "../algorithms/cartesian_iterator.h"
 #include "../task.h"
 #include "../utils.h"
 #include "../utils/hash.h"
 
+#include "../heuristics/utils.h"
+
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
+using namespace std;
+
+// The dense table of a predicate may have this many entries per reachable atom
+static const uint64_t MAX_DENSE_ENTRIES_PER_ATOM = 8;
+static const uint64_t MIN_DENSE_ENTRIES = 1 << 16;
+
 
 unsigned ExtensionalPackedState::Hash::operator() (const ExtensionalPackedState &s) const {
 
@@ -27,46 +36,141 @@ unsigned ExtensionalPackedState::Hash::operator() (const ExtensionalPackedState
 }
 
 
-ExtensionalStatePacker::ExtensionalStatePacker(const Task &task) :
-    task(task), npreds(task.predicates.size()), args_to_index(), index_to_args(), blank_state(npreds)
-{
-    auto objects_per_type = task.compute_object_index();
-    args_to_index.reserve(npreds);
-
-    for (std::size_t pid = 0; pid < npreds; ++pid) {
-        const auto& pred = task.predicates[pid];
+/*
+ * Atoms of each predicate that are reachable in the delete relaxation of the
+ * task from the initial state, sorted and without duplicates. The grounder is
+ * given no goal predicate, so it only stops at the fixpoint.
+ */
+static vector<vector<vector<int>>> compute_reachable_atoms(const Task &task) {
+    datalog::Datalog datalog = initialize_datalog(
+        task,
+        [](int, const Task &) -> unique_ptr<datalog::Annotation> { return nullptr; },
+        DatalogTransformationOptions(true, false, true));
+    datalog::WeightedGrounder grounder(datalog, datalog::H_MAX);
+    vector<datalog::Fact> state_facts = get_datalog_facts_from_state(task.get_initial_state(), task);
+    grounder.ground(datalog, state_facts, -1);
+
+    vector<vector<vector<int>>> reachable_atoms(task.predicates.size());
+    for (int i = 0; i < datalog.get_number_of_facts(); ++i) {
+        const datalog::Fact &fact = datalog.get_fact_by_index(i);
+        int predicate = fact.get_predicate_index();
+        if (fact.is_pred_symbol_new() or predicate >= int(task.predicates.size()))
+            continue;
+        vector<int> args;
+        for (const datalog::Term &term : fact.get_arguments())
+            args.push_back(term.get_index());
+        reachable_atoms[predicate].push_back(std::move(args));
+    }
+    for (auto &atoms : reachable_atoms) {
+        sort(atoms.begin(), atoms.end());
+        atoms.erase(unique(atoms.begin(), atoms.end()), atoms.end());
+    }
+    return reachable_atoms;
+}
 
-        args_to_index.emplace_back();  // emplace back an empty map
-        auto& ati_map = args_to_index.back();
+unsigned ExtensionalStatePacker::PredicateIndex::get_atom(const int *args) const {
+    uint64_t number = 0;
+    for (int i = 0; i < arity; ++i) {
+        int rank = ranks[i][args[i]];
+        if (rank < 0) return NO_ATOM;
+        number += rank * strides[i];
+    }
+    if (is_dense) return dense_atoms[number];
+    auto it = sparse_atoms.find(number);
+    return (it == sparse_atoms.end()) ? NO_ATOM : it->second;
+}
 
-        const auto& types = pred.getTypes();
-        if (types.empty()) { // A nullary predicate - special treatment
-            ati_map.emplace(args_t(), index_to_args.size());
-            index_to_args.push_back({static_cast<int>(pid), {}});
-            continue;
+ExtensionalStatePacker::ExtensionalStatePacker(const Task &task) :
+    task(task), npreds(task.predicates.size()), predicate_indexes(npreds), blank_state(npreds)
+{
+    vector<vector<vector<int>>> reachable_atoms = compute_reachable_atoms(task);
+    size_t num_objects = task.objects.size();
+    unsigned next_atom = 0;
+    int num_sparse_predicates = 0;
+
+    for (size_t pid = 0; pid < npreds; ++pid) {
+        PredicateIndex &index = predicate_indexes[pid];
+        const vector<vector<int>> &atoms = reachable_atoms[pid];
+        int arity = task.predicates[pid].getArity();
+        index.arity = arity;
+        index.ranks.assign(arity, vector<int>(num_objects, -1));
+        index.strides.assign(arity, 0);
+
+        // Ranks increase with the object index, so the mixed-radix numbers
+        // (and the bits) follow the lexicographic order of the arguments.
+        uint64_t num_numbers = 1;
+        for (int i = arity - 1; i >= 0; --i) {
+            vector<int> &ranks = index.ranks[i];
+            for (const vector<int> &args : atoms)
+                ranks[args[i]] = 0;
+            uint64_t radix = 0;
+            for (int &rank : ranks) {
+                if (rank == 0) rank = radix++;
+            }
+            index.strides[i] = num_numbers;
+            if (radix > 0 and num_numbers > numeric_limits<uint64_t>::max() / radix)
+                throw runtime_error("Too many reachable atoms of predicate " + task.predicates[pid].get_name());
+            num_numbers *= radix;
         }
 
-        std::vector<std::vector<int>> objects_per_arg;
-        for (const auto& type:types) {
-            objects_per_arg.push_back(objects_per_type[type]);
+        index.is_dense = num_numbers <= max(MIN_DENSE_ENTRIES, MAX_DENSE_ENTRIES_PER_ATOM * atoms.size());
+        if (index.is_dense)
+            index.dense_atoms.assign(num_numbers, NO_ATOM);
+        else
+            ++num_sparse_predicates;
+
+        index.first_atom = next_atom;
+        index.arguments.reserve(atoms.size() * arity);
+        for (const vector<int> &args : atoms) {
+            uint64_t number = 0;
+            for (int i = 0; i < arity; ++i)
+                number += index.ranks[i][args[i]] * index.strides[i];
+            if (index.is_dense)
+                index.dense_atoms[number] = next_atom;
+            else
+                index.sparse_atoms.emplace(number, next_atom);
+            index.arguments.insert(index.arguments.end(), args.begin(), args.end());
+            ++next_atom;
         }
+        index.end_atom = next_atom;
 
-        for (auto it = utils::cartesian_iterator<int>(objects_per_arg); !it.ended(); ++it) {
-            const std::vector<int>& args = *it;
-            ati_map.emplace(args, index_to_args.size());
-            index_to_args.emplace_back(pid, args);
+        if (arity > 0) {
+            // Looks a bit redundant, but that's the way it is:
+            blank_state.set_relation_predicate_symbol(pid, pid);
         }
-
-        // Looks a bit redundant, but that's the way it is:
-        blank_state.set_relation_predicate_symbol(pid, pid);
     }
 
-    std::cout << "Indexed a total of " << num_atoms() << " atoms" << std::endl;
+    cout << "Indexed a total of " << num_atoms() << " atoms" << " ("
+         << num_sparse_predicates << " predicates with a sparse index)" << endl;
+
+    compute_goal_atoms();
+}
+
+void ExtensionalStatePacker::compute_goal_atoms() {
+    const GoalCondition &goal = task.get_goal();
+    num_unreachable_goal_atoms = 0;
+    auto add_goal_atom = [this](int predicate, const vector<int> &arguments, bool negated) {
+        unsigned atom = to_index(predicate, arguments);
+        if (atom == NO_ATOM) {
+            // Negated goal atoms that are not reachable are always satisfied
+            if (!negated) ++num_unreachable_goal_atoms;
+        }
+        else {
+            (negated ? negative_goal_atoms : positive_goal_atoms).push_back(atom);
+        }
+    };
+    for (int predicate : goal.positive_nullary_goals)
+        add_goal_atom(predicate, {}, false);
+    for (int predicate : goal.negative_nullary_goals)
+        add_goal_atom(predicate, {}, true);
+    for (const AtomicGoal &atomic_goal : goal.goal)
+        add_goal_atom(atomic_goal.get_predicate_index(), atomic_goal.get_arguments(), atomic_goal.is_negated());
 }
 
-unsigned ExtensionalStatePacker::to_index(int predicate, const std::vector<int>& arguments) const {
-    assert(0 <= predicate && (unsigned) predicate <= args_to_index.size());
-    return args_to_index[predicate].at(arguments);
+unsigned ExtensionalStatePacker::to_index(int predicate, const vector<int>& arguments) const {
+    assert(0 <= predicate && (unsigned) predicate < predicate_indexes.size());
+    assert(int(arguments.size()) == predicate_indexes[predicate].arity);
+    return predicate_indexes[predicate].get_atom(arguments.data());
 }
 
 
@@ -76,42 +180,69 @@ ExtensionalPackedState ExtensionalStatePacker::pack(const DBState &state) const
     // state.nullary_atoms contains one element per predicate index, regardless of whether
     // the predicate is nullary or not
     const auto& nullary_atoms = state.get_nullary_atoms();
-    for (std::size_t i = 0, sz = nullary_atoms.size(); i < sz; ++i) {
+    for (size_t i = 0, sz = nullary_atoms.size(); i < sz; ++i) {
         if (nullary_atoms[i]) {
-//            packed.atoms[to_index(i, {})] = true;
-            packed.atoms.set(to_index(i, {}));
+            unsigned atom = predicate_indexes[i].get_atom(nullptr);
+            if (atom == NO_ATOM)
+                throw runtime_error("Packing an atom that is not relaxed reachable");
+            packed.atoms.set(atom);
         }
     }
 
-    for (const Relation &relation:state.get_relations()) {
-        int pid = relation.predicate_symbol;
-        for (const auto &tuple:relation.tuples) {
-//            packed.atoms[to_index(pid, tuple)] = true;
-            packed.atoms.set(to_index(pid, tuple));
+    for (const Relation &relation : state.get_relations()) {
+        if (relation.tuples.empty()) continue;
+        const PredicateIndex &index = predicate_indexes[relation.predicate_symbol];
+        for (TupleView tuple : relation.tuples) {
+            unsigned atom = index.get_atom(tuple.data());
+            if (atom == NO_ATOM)
+                throw runtime_error("Packing an atom that is not relaxed reachable");
+            packed.atoms.set(atom);
         }
     }
     return packed;
 }
 
+bool ExtensionalStatePacker::is_goal(const ExtensionalPackedState &packed) const {
+    if (num_unreachable_goal_atoms > 0) return false;
+    for (unsigned atom : positive_goal_atoms) {
+        if (!packed.atoms.test(atom)) return false;
+    }
+    for (unsigned atom : negative_goal_atoms) {
+        if (packed.atoms.test(atom)) return false;
+    }
+    return true;
+}
+
+int ExtensionalStatePacker::count_unsatisfied_goals(const ExtensionalPackedState &packed) const {
+    int h = num_unreachable_goal_atoms;
+    for (unsigned atom : positive_goal_atoms)
+        h += !packed.atoms.test(atom);
+    for (unsigned atom : negative_goal_atoms)
+        h += packed.atoms.test(atom);
+    return h;
+}
+
 DBState ExtensionalStatePacker::unpack(const ExtensionalPackedState &packed) const {
     DBState result(blank_state);  // Let's start off with the precomputed state
 
-    auto natoms = packed.atoms.size();
-    assert(natoms == num_atoms());
-    for (std::size_t aid = 0; aid < natoms; ++aid) {
-        if (!packed.atoms[aid]) continue;
+    assert(packed.atoms.size() == num_atoms());
+    // The atoms of each predicate are consecutive and sorted, so the tuples
+    // are appended in order and sort_relations() only checks that.
+    size_t pid = 0;
+    for (size_t aid = packed.atoms.find_first(); aid != packed.atoms.npos; aid = packed.atoms.find_next(aid)) {
+        while (aid >= predicate_indexes[pid].end_atom) ++pid;
+        const PredicateIndex &index = predicate_indexes[pid];
 
-        const auto& x = index_to_args[aid];
-        int pid = x.first;
-        const args_t& args = x.second;
-        if (args.empty()) {  // A nullary predicate
+        if (index.arity == 0) {  // A nullary predicate
             // Make true the position corresponding to *the predicate*
             result.set_nullary_atom(pid, true);
 
         } else {  // An arity > 0 predicate
-            result.insert_tuple_in_relation(args, pid);
+            const int *args = index.arguments.data() + (aid - index.first_atom) * index.arity;
+            result.append_tuple_unsorted(pid, TupleView(args, index.arity));
         }
     }
+    result.sort_relations();
 
     return result;
 }
@@ -3,8 +3,10 @@
 
 #include "state.h"
 #include "../algorithms/dynamic_bitset.h"
+#include "../parallel_hashmap/phmap.h"
 
-#include <unordered_map>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 //#include <boost/dynamic_bitset.hpp>
@@ -49,31 +51,99 @@ public:
 
 /**
  * @brief Pack and unpack states into a more compact representation
+ *
+ * @details The bits of the packed states are the relaxed reachable atoms of the
+ * task, computed once with the Datalog program of the task. The atoms of each
+ * predicate get consecutive bits, in lexicographic order of their arguments.
+ *
+ * An atom is mapped to its bit with a mixed-radix number: each argument is
+ * replaced by its rank among the objects appearing at that position in the
+ * reachable atoms of the predicate, and the ranks are the digits of the
+ * number. The number then indexes a dense table of bits, or a hash map if the
+ * table would be much larger than the number of reachable atoms. Hence,
+ * packing a state is a loop over the flat tuples of its relations without any
+ * allocation, and unpacking visits only the set bits and produces tuples that
+ * are already sorted.
  */
 class ExtensionalStatePacker {
+public:
+    static constexpr unsigned NO_ATOM = std::numeric_limits<unsigned>::max();
+
 protected:
+    struct PredicateIndex {
+        int arity = 0;
+        //! Rank of each object at each argument position, or -1 if no reachable atom has it there
+        std::vector<std::vector<int>> ranks;
+        //! Weight of each argument position in the mixed-radix number
+        std::vector<uint64_t> strides;
+        //! Bit of each mixed-radix number, or NO_ATOM (dense encoding)
+        std::vector<unsigned> dense_atoms;
+        //! Bit of each mixed-radix number of a reachable atom (sparse encoding)
+        phmap::flat_hash_map<uint64_t, unsigned> sparse_atoms;
+        bool is_dense = true;
+        //! Bits of the predicate are [first_atom, end_atom)
+        unsigned first_atom = 0;
+        unsigned end_atom = 0;
+        //! Arguments of the atoms of the predicate, concatenated in order
+        std::vector<int> arguments;
+
+        unsigned get_atom(const int *args) const;
+    };
+
     const Task &task;
 
     std::size_t npreds;
 
-    using args_t = std::vector<int>;
-    std::vector<std::unordered_map<args_t, unsigned, boost::hash<args_t>>> args_to_index;
-    std::vector<std::pair<int, args_t>> index_to_args;
+    std::vector<PredicateIndex> predicate_indexes;
 
     //! A state placeholder for faster creation of states in ExtensionalStatePacker::pack
     DBState blank_state;
 
+    //! Bits of the goal atoms, including the nullary ones
+    std::vector<unsigned> positive_goal_atoms;
+    std::vector<unsigned> negative_goal_atoms;
+    //! Positive goal atoms that are not relaxed reachable, so they are never satisfied
+    int num_unreachable_goal_atoms;
+
+    void compute_goal_atoms();
 
 public:
     explicit ExtensionalStatePacker(const Task &task);
 
-    std::size_t num_atoms() const { return index_to_args.size(); }
+    std::size_t num_atoms() const {
+        return predicate_indexes.empty() ? 0 : predicate_indexes.back().end_atom;
+    }
 
+    //! Bit of the atom, or NO_ATOM if the atom is not relaxed reachable
     unsigned to_index(int predicate, const std::vector<int>& arguments) const;
 
     ExtensionalPackedState pack(const DBState &state) const;
 
     DBState unpack(const ExtensionalPackedState &packed) const;
+
+    bool is_goal(const ExtensionalPackedState &packed) const;
+
+    //! Same as Goalcount::compute_heuristic on the unpacked state
+    int count_unsatisfied_goals(const ExtensionalPackedState &packed) const;
+
+    //! Identifier of the atom among the atoms of its predicate, as in for_each_atom
+    long get_atom_key(int predicate, const std::vector<int> &arguments) const {
+        return to_index(predicate, arguments);
+    }
+
+    /**
+     * Call f(predicate, key) for each atom that is true in the packed state,
+     * where key identifies the atom among the atoms of its predicate. Nullary
+     * atoms are included.
+     */
+    template<typename F>
+    void for_each_atom(const ExtensionalPackedState &packed, F f) const {
+        std::size_t pid = 0;
+        for (std::size_t aid = packed.atoms.find_first(); aid != packed.atoms.npos; aid = packed.atoms.find_next(aid)) {
+            while (aid >= predicate_indexes[pid].end_atom) ++pid;
+            f(int(pid), long(aid));
+        }
+    }
 };
 
 #endif // EXTENSIONAL_SEARCH_STATE_PACKER_H
@@ -85,6 +85,15 @@ SparseStatePacker::SparseStatePacker(const Task &task) {
             }
         }
     }
+
+    const GoalCondition &goal = task.get_goal();
+    positive_nullary_goals.assign(goal.positive_nullary_goals.begin(), goal.positive_nullary_goals.end());
+    negative_nullary_goals.assign(goal.negative_nullary_goals.begin(), goal.negative_nullary_goals.end());
+    for (const AtomicGoal &atomic_goal : goal.goal) {
+        int predicate = atomic_goal.get_predicate_index();
+        goal_atoms.push_back({predicate, pack_tuple(atomic_goal.get_arguments(), predicate),
+                              atomic_goal.is_negated()});
+    }
 }
 
 SparsePackedState SparseStatePacker::pack(const DBState &state) const {
@@ -98,11 +107,11 @@ SparsePackedState SparseStatePacker::pack(const DBState &state) const {
         packed_relation.reserve(r.tuples.size());
         int predicate_index = r.predicate_symbol;
         packed_state.predicate_symbols.push_back(predicate_index);
-        for (const auto &tuple : r.tuples) {
+        for (TupleView tuple : r.tuples) {
             packed_relation.push_back(pack_tuple(tuple, predicate_index));
         }
         sort(packed_relation.begin(), packed_relation.end());
-        packed_state.packed_relations.push_back(packed_relation);
+        packed_state.packed_relations.push_back(std::move(packed_relation));
     }
     return packed_state;
 }
@@ -111,17 +120,53 @@ DBState SparseStatePacker::unpack(const SparsePackedState &packed_state) const {
     std::vector<Relation> relations;
     std::vector<bool> nullary_atoms = packed_state.nullary_atoms;
     relations.reserve(packed_state.packed_relations.size());
+    std::vector<int> values;
     for (size_t i = 0; i < packed_state.packed_relations.size(); ++i) {
-        std::unordered_set<GroundAtom, TupleHash> tuples;
+        int predicate_index = packed_state.predicate_symbols[i];
+        FlatTupleSet tuples(hash_multipliers[predicate_index].size());
+        tuples.reserve(packed_state.packed_relations[i].size());
         for (const auto &r : packed_state.packed_relations[i]) {
-            tuples.insert(unpack_tuple(r, packed_state.predicate_symbols[i]));
+            unpack_tuple(r, predicate_index, values);
+            tuples.push_back_unsorted(values);
         }
-        relations.emplace_back(packed_state.predicate_symbols[i], std::move(tuples));
+        tuples.sort_and_remove_duplicates();
+        relations.emplace_back(predicate_index, std::move(tuples));
     }
     return DBState(std::move(relations), std::move(nullary_atoms));
 }
 
-long SparseStatePacker::pack_tuple(const std::vector<int> &tuple, int predicate_index) const {
+bool SparseStatePacker::is_satisfied(const SparsePackedState &packed_state, const PackedGoal &goal) const {
+    // Relations are stored in the order of their predicate symbols, as in DBState
+    assert(packed_state.predicate_symbols[goal.predicate] == goal.predicate);
+    const std::vector<long> &keys = packed_state.packed_relations[goal.predicate];
+    return std::binary_search(keys.begin(), keys.end(), goal.key) != goal.negated;
+}
+
+bool SparseStatePacker::is_goal(const SparsePackedState &packed_state) const {
+    for (int predicate : positive_nullary_goals) {
+        if (!packed_state.nullary_atoms[predicate]) return false;
+    }
+    for (int predicate : negative_nullary_goals) {
+        if (packed_state.nullary_atoms[predicate]) return false;
+    }
+    for (const PackedGoal &goal : goal_atoms) {
+        if (!is_satisfied(packed_state, goal)) return false;
+    }
+    return true;
+}
+
+int SparseStatePacker::count_unsatisfied_goals(const SparsePackedState &packed_state) const {
+    int h = 0;
+    for (int predicate : positive_nullary_goals)
+        h += !packed_state.nullary_atoms[predicate];
+    for (int predicate : negative_nullary_goals)
+        h += packed_state.nullary_atoms[predicate];
+    for (const PackedGoal &goal : goal_atoms)
+        h += !is_satisfied(packed_state, goal);
+    return h;
+}
+
+long SparseStatePacker::pack_tuple(TupleView tuple, int predicate_index) const {
     long index = 0;
     for (size_t i = 0; i < tuple.size(); ++i) {
         index += hash_multipliers[predicate_index][i] *
@@ -130,8 +175,8 @@ long SparseStatePacker::pack_tuple(const std::vector<int> &tuple, int predicate_
     return index;
 }
 
-GroundAtom SparseStatePacker::unpack_tuple(long tuple, int predicate_index) const {
-    std::vector<int> values(hash_multipliers[predicate_index].size());
+void SparseStatePacker::unpack_tuple(long tuple, int predicate_index, std::vector<int> &values) const {
+    values.resize(hash_multipliers[predicate_index].size());
     int aux;
     for (int i = hash_multipliers[predicate_index].size() - 1; i >= 0; --i) {
         aux = tuple / hash_multipliers[predicate_index][i];
@@ -139,7 +184,6 @@ GroundAtom SparseStatePacker::unpack_tuple(long tuple, int predicate_index) cons
         tuple -= aux * hash_multipliers[predicate_index][i];
     }
     assert(tuple == 0);
-    return values;
 }
 
 int SparseStatePacker::get_index_given_predicate_and_param(int pred, int param, int element) const {
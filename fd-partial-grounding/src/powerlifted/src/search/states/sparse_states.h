@@ -1,6 +1,8 @@
 #ifndef SEARCH_SPARSE_STATES_H
 #define SEARCH_SPARSE_STATES_H
 
+#include "../flat_tuple_set.h"
+
 #include <algorithm>
 #include <cstdint>
 #include <iostream>
@@ -65,10 +67,43 @@ public:
 
     DBState unpack(const SparsePackedState &packed_state) const;
 
+    bool is_goal(const SparsePackedState &packed_state) const;
+
+    //! Same as Goalcount::compute_heuristic on the unpacked state
+    int count_unsatisfied_goals(const SparsePackedState &packed_state) const;
+
+    //! Identifier of the atom among the atoms of its predicate, as in for_each_atom
+    long get_atom_key(int predicate, const std::vector<int> &arguments) const {
+        return pack_tuple(arguments, predicate);
+    }
+
+    /**
+     * Call f(predicate, key) for each atom that is true in the packed state,
+     * where key identifies the atom among the atoms of its predicate. Nullary
+     * atoms are included with key 0.
+     */
+    template<typename F>
+    void for_each_atom(const SparsePackedState &packed_state, F f) const {
+        for (std::size_t i = 0; i < packed_state.nullary_atoms.size(); ++i) {
+            if (packed_state.nullary_atoms[i]) f(int(i), 0L);
+        }
+        for (std::size_t i = 0; i < packed_state.packed_relations.size(); ++i) {
+            for (long key : packed_state.packed_relations[i]) f(packed_state.predicate_symbols[i], key);
+        }
+    }
+
 private:
-    long pack_tuple(const std::vector<int> &tuple, int predicate_index) const;
+    struct PackedGoal {
+        int predicate;
+        long key;
+        bool negated;
+    };
+
+    bool is_satisfied(const SparsePackedState &packed_state, const PackedGoal &goal) const;
 
-    std::vector<int> unpack_tuple(long tuple, int predicate_index) const;
+    long pack_tuple(TupleView tuple, int predicate_index) const;
+
+    void unpack_tuple(long tuple, int predicate_index, std::vector<int> &values) const;
 
     int get_index_given_predicate_and_param(int pred, int param, int element) const;
 
@@ -78,6 +113,10 @@ private:
     std::vector<std::vector<long>> hash_multipliers;
     std::vector<std::vector<std::unordered_map<int, int>>> obj_to_hash_index;
     std::vector<std::vector<std::unordered_map<int, int>>> hash_index_to_obj;
+
+    std::vector<PackedGoal> goal_atoms;
+    std::vector<int> positive_nullary_goals;
+    std::vector<int> negative_nullary_goals;
 };
 
 
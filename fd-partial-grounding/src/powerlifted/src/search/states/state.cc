@@ -15,19 +15,10 @@ std::size_t hash_value(const DBState &s) {
     for (bool b : s.nullary_atoms) {
         boost::hash_combine(seed, b);
     }
+    // Tuples are kept sorted, so hashing the flat array directly is order-independent.
     for (const Relation &r : s.relations) {
-        std::vector<std::size_t> x;
-        for (const GroundAtom &vga : r.tuples) {
-            std::size_t aux_seed = vga.size();
-            for (auto &i : vga)
-                aux_seed ^= i + 0x9e3779b9 + (aux_seed << 6) + (aux_seed >> 2);
-            x.push_back(aux_seed);
-            //boost::hash_combine(seed, vga);
-        }
-        std::sort(x.begin(), x.end());
-        for (std::size_t e : x) {
-            boost::hash_combine(seed, e);
-        }
+        boost::hash_combine(seed, r.tuples.size());
+        boost::hash_range(seed, r.tuples.get_data().begin(), r.tuples.get_data().end());
     }
     return seed;
 }
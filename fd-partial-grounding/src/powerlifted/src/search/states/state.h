@@ -5,7 +5,6 @@
 
 #include <algorithm>
 #include <tuple>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -48,7 +47,7 @@ public:
         return nullary_atoms;
     }
 
-    const std::unordered_set<GroundAtom, TupleHash>& get_tuples_of_relation(size_t i) const {
+    const FlatTupleSet& get_tuples_of_relation(size_t i) const {
         return relations[i].tuples;
     }
 
@@ -60,12 +59,27 @@ public:
         relations[i].predicate_symbol = id;
     }
 
-    void insert_tuple_in_relation(GroundAtom ga, int id) {
+    void insert_tuple_in_relation(TupleView ga, int id) {
         relations[id].tuples.insert(ga);
     }
 
     void add_tuple(int relation, const GroundAtom &args);
 
+    /**
+     * Append a tuple to a relation without keeping it sorted. Used by the state
+     * packers to build states in bulk. Must be followed by a call to
+     * sort_relations() before the state is used.
+     */
+    void append_tuple_unsorted(int relation, TupleView args) {
+        relations[relation].tuples.push_back_unsorted(args);
+    }
+
+    void sort_relations() {
+        for (Relation &r : relations) {
+            r.tuples.sort_and_remove_duplicates();
+        }
+    }
+
     bool operator==(const DBState &other) const {
         return nullary_atoms==other.nullary_atoms && relations==other.relations;
     }
@@ -1,11 +1,11 @@
 #ifndef SEARCH_STRUCTURES_H
 #define SEARCH_STRUCTURES_H
 
+#include "flat_tuple_set.h"
 #include "hash_structures.h"
 
 #include <string>
 #include <utility>
-#include <unordered_set>
 #include <vector>
 
 /**
@@ -67,25 +67,28 @@ public:
  * predicate in a state.
  *
  * @var predicate_symbol: Indicates its corresponding predicate.
- * @var tuples: Set of tuples (vectors) corresponding to the ground atoms in this relation.
+ * @var tuples: Set of tuples corresponding to the ground atoms in this relation,
+ * stored contiguously and sorted.
  *
+ * @see flat_tuple_set.h
  */
 struct Relation {
     Relation() = default;
-    Relation(int predicate_symbol,
-        std::unordered_set<GroundAtom, TupleHash> &&tuples)
+    Relation(int predicate_symbol, FlatTupleSet &&tuples)
             : predicate_symbol(predicate_symbol),
               tuples (std::move(tuples)) {}
 
     Relation(const Relation &) = default;
-
+    Relation(Relation &&) = default;
+    Relation &operator=(const Relation &) = default;
+    Relation &operator=(Relation &&) = default;
 
     bool operator==(const Relation &other) const {
         return predicate_symbol == other.predicate_symbol && tuples == other.tuples;
     }
 
     int predicate_symbol{};
-    std::unordered_set<GroundAtom, TupleHash> tuples;
+    FlatTupleSet tuples;
 };
 
 #endif //SEARCH_STRUCTURES_H
@@ -0,0 +1,175 @@
+#include "adaptive_join_successor.h"
+
+#include "../action_schema.h"
+#include "../task.h"
+
+#include "../database/hash_join.h"
+#include "../database/table.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+// Weight of the last observation in the moving average of each selectivity
+static const double LEARNING_RATE = 0.2;
+
+AdaptiveJoinSuccessorGenerator::AdaptiveJoinSuccessorGenerator(const Task &task)
+    : GenericJoinSuccessor(task), num_plans(0)
+{
+    selectivities.resize(action_data.size());
+    plans.resize(action_data.size());
+    for (size_t i = 0; i < action_data.size(); ++i) {
+        selectivities[i].resize(action_data[i].relevant_precondition_atoms.size());
+    }
+}
+
+double AdaptiveJoinSuccessorGenerator::get_selectivity(int schema,
+                                                       int table,
+                                                       uint64_t columns,
+                                                       size_t table_size) const
+{
+    const auto &learned = selectivities[schema][table];
+    auto it = learned.find(columns);
+    if (it != learned.end())
+        return it->second;
+    return 1.0 / max<size_t>(table_size, 1);
+}
+
+void AdaptiveJoinSuccessorGenerator::update_selectivity(int schema,
+                                                        int table,
+                                                        uint64_t columns,
+                                                        double observed)
+{
+    auto res = selectivities[schema][table].emplace(columns, observed);
+    if (!res.second) {
+        double &s = res.first->second;
+        s += LEARNING_RATE * (observed - s);
+    }
+}
+
+/*
+ * Greedy left-deep order. join_columns[i] is the bitmask of the columns of the
+ * i-th table of the order that are joined with the working table.
+ */
+void AdaptiveJoinSuccessorGenerator::compute_order(int schema, const vector<Table> &tables) {
+    size_t n = tables.size();
+    order.clear();
+    join_columns.clear();
+
+    vector<bool> used(n, false);
+    size_t first = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (tables[i].tuples.size() < tables[first].tuples.size())
+            first = i;
+    }
+    order.push_back(first);
+    join_columns.push_back(0);
+    used[first] = true;
+
+    vector<int> variables(tables[first].tuple_index);
+    double estimated_size = tables[first].tuples.size();
+
+    while (order.size() < n) {
+        int best = -1;
+        uint64_t best_columns = 0;
+        bool best_connected = false;
+        double best_estimate = numeric_limits<double>::infinity();
+        for (size_t j = 0; j < n; ++j) {
+            if (used[j]) continue;
+            const Table &t = tables[j];
+            uint64_t columns = 0;
+            for (size_t c = 0; c < t.tuple_index.size(); ++c) {
+                // Wider tables only learn coarser selectivities
+                if (find(variables.begin(), variables.end(), t.tuple_index[c]) != variables.end())
+                    columns |= uint64_t(1) << min<size_t>(c, 63);
+            }
+            bool connected = (columns != 0);
+            double estimate = estimated_size * t.tuples.size();
+            if (connected)
+                estimate *= get_selectivity(schema, j, columns, t.tuples.size());
+            // Cartesian products are only chosen if no connected table is left
+            if (best == -1 or (connected and !best_connected) or
+                (connected == best_connected and estimate < best_estimate)) {
+                best = j;
+                best_columns = columns;
+                best_connected = connected;
+                best_estimate = estimate;
+            }
+        }
+        order.push_back(best);
+        join_columns.push_back(best_columns);
+        used[best] = true;
+        for (int v : tables[best].tuple_index) {
+            if (find(variables.begin(), variables.end(), v) == variables.end())
+                variables.push_back(v);
+        }
+        estimated_size = best_estimate;
+    }
+}
+
+const JoinPlan &AdaptiveJoinSuccessorGenerator::get_plan(const ActionSchema &action) {
+    auto &schema_plans = plans[action.get_index()];
+    auto it = schema_plans.find(order);
+    if (it == schema_plans.end()) {
+        const PrecompiledActionData &adata = action_data[action.get_index()];
+        it = schema_plans.emplace(order, JoinPlan(action, adata.precondition_indices, order)).first;
+        ++num_plans;
+    }
+    return it->second;
+}
+
+Table AdaptiveJoinSuccessorGenerator::instantiate(const ActionSchema &action, const DBState &state)
+{
+    if (action.is_ground()) {
+        throw std::runtime_error("Shouldn't be calling instantiate() on a ground action");
+    }
+
+    int schema = action.get_index();
+    const auto& actiondata = action_data[schema];
+
+    vector<Table> tables(0);
+    auto res = parse_precond_into_join_program(actiondata, state, tables);
+
+    if (!res) return Table::EMPTY_TABLE();
+
+    assert(!tables.empty());
+    assert(tables.size() == actiondata.relevant_precondition_atoms.size());
+
+    compute_order(schema, tables);
+    const JoinPlan &plan = get_plan(action);
+
+    Table &working_table = tables[plan.steps[0].table];
+    for (size_t i = 1; i < plan.steps.size(); ++i) {
+        const JoinStep &step = plan.steps[i];
+        const Table &t = tables[step.table];
+        double input_size = double(working_table.tuples.size()) * t.tuples.size();
+        hash_join(working_table, t);
+        // The estimates of compute_order do not account for inequalities, so the
+        // selectivity is measured on the output of the join before filtering them
+        if (join_columns[i] != 0) {
+            update_selectivity(schema, step.table, join_columns[i],
+                               working_table.tuples.size() / input_size);
+        }
+        // Filter out equalities
+        filter_inequality_columns(working_table, step.inequality_columns);
+        if (working_table.tuples.empty()) {
+            return working_table;
+        }
+    }
+
+    return working_table;
+}
+
+const JoinPlan &AdaptiveJoinSuccessorGenerator::get_join_plan(int) const
+{
+    // The plan depends on the state; print_statistics reports how many were compiled
+    static const JoinPlan no_plan;
+    return no_plan;
+}
+
+void AdaptiveJoinSuccessorGenerator::print_statistics() const {
+    cout << "Join orders compiled by the adaptive join: " << num_plans << endl;
+}
@@ -0,0 +1,61 @@
+#ifndef SEARCH_ADAPTIVE_JOIN_SUCCESSOR_H
+#define SEARCH_ADAPTIVE_JOIN_SUCCESSOR_H
+
+#include "generic_join_successor.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * This class implements a successor generator that chooses the join order of
+ * each action schema in each state, based on the actual size of the tables.
+ *
+ * @details Before joining, we build a left-deep plan greedily: start with the
+ * smallest table and repeatedly add the table that minimizes the estimated size
+ * of the next intermediate result, avoiding cartesian products whenever possible.
+ * The size of joining a working table W with a table T is estimated as
+ * |W| * |T| * s, where the selectivity s is learned from the output sizes
+ * observed in previous joins of T on the same set of join columns (exponential
+ * moving average). Until something has been observed, we assume that each tuple
+ * of W matches a single tuple of T.
+ *
+ * Join plans are cached per schema and order, so inequalities are still resolved
+ * at preprocessing time (see JoinPlan).
+ */
+class AdaptiveJoinSuccessorGenerator : public GenericJoinSuccessor {
+    /**
+     * selectivities[schema][table]: learned selectivity per bitmask of join
+     * columns of the table. Columns from the 64th on share the last bit.
+     */
+    std::vector<std::vector<std::unordered_map<std::uint64_t, double>>> selectivities;
+
+    //! Join plans already compiled, per schema
+    std::vector<std::map<std::vector<int>, JoinPlan>> plans;
+
+    //! Order chosen for the last instantiated schema
+    std::vector<int> order;
+    std::vector<std::uint64_t> join_columns;
+
+    std::size_t num_plans;
+
+    void compute_order(int schema, const std::vector<Table> &tables);
+
+    const JoinPlan &get_plan(const ActionSchema &action);
+
+    double get_selectivity(int schema, int table, std::uint64_t columns, std::size_t table_size) const;
+
+    void update_selectivity(int schema, int table, std::uint64_t columns, double observed);
+
+public:
+    explicit AdaptiveJoinSuccessorGenerator(const Task &task);
+
+    Table instantiate(const ActionSchema &action, const DBState &state) override;
+
+    const JoinPlan &get_join_plan(int action_schema) const override;
+
+    void print_statistics() const override;
+};
+
+#endif //SEARCH_ADAPTIVE_JOIN_SUCCESSOR_H
@@ -0,0 +1,342 @@
+#include "delta_join_successor.h"
+
+#include "../action.h"
+#include "../action_schema.h"
+#include "../task.h"
+
+#include "../database/hash_join.h"
+#include "../database/table.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <iterator>
+
+using namespace std;
+
+// Rough memory footprint of one entry of `parent_of`
+static const size_t LINK_BYTES = 4 * sizeof(size_t);
+
+static size_t estimate_bytes(const DBState &state) {
+    size_t bytes = sizeof(DBState);
+    for (const Relation &r : state.get_relations()) {
+        bytes += sizeof(Relation) + r.tuples.get_data().size() * sizeof(int);
+    }
+    return bytes;
+}
+
+template <typename T>
+static size_t estimate_bytes(const vector<vector<T>> &tuples) {
+    size_t bytes = 0;
+    for (const auto &t : tuples) {
+        bytes += sizeof(t) + t.size() * sizeof(T);
+    }
+    return bytes;
+}
+
+DeltaJoinSuccessorGenerator::CachedState::CachedState(const DBState &state, size_t num_schemas)
+    : state(state), computed(num_schemas, false), instantiations(num_schemas),
+      bytes(estimate_bytes(state))
+{
+}
+
+DeltaJoinSuccessorGenerator::DeltaJoinSuccessorGenerator(const Task &task, size_t max_cached_bytes)
+    : GenericJoinSuccessor(task),
+      max_cached_bytes(max_cached_bytes),
+      cached_bytes(0),
+      current(nullptr),
+      parent(nullptr),
+      last_state(nullptr),
+      last_schema(-1),
+      added(task.predicates.size()),
+      deleted(task.predicates.size()),
+      num_delta_joins(0),
+      num_full_joins(0),
+      num_cache_hits(0)
+{
+    // For each fluent precondition, precompile a join plan that starts from its delta
+    // and then follows the order of the preconditions in the PDDL file
+    delta_plans.resize(action_data.size());
+    for (const ActionSchema &action : task.get_action_schemas()) {
+        const PrecompiledActionData &adata = action_data[action.get_index()];
+        if (adata.is_ground or adata.statically_inapplicable) continue;
+        size_t num_tables = adata.relevant_precondition_atoms.size();
+        auto &plans = delta_plans[action.get_index()];
+        plans.resize(num_tables);
+        for (unsigned i : adata.fluent_tables) {
+            vector<int> order = {int(i)};
+            for (size_t j = 0; j < num_tables; ++j) {
+                if (j != i) order.push_back(j);
+            }
+            plans[i] = JoinPlan(action, adata.precondition_indices, order);
+        }
+    }
+}
+
+void DeltaJoinSuccessorGenerator::evict() {
+    while (cached_bytes > max_cached_bytes) {
+        if (!cache_order.empty()) {
+            auto it = cache.find(cache_order.front());
+            cache_order.pop_front();
+            if (it != cache.end()) {
+                cached_bytes -= it->second.bytes;
+                cache.erase(it);
+            }
+        }
+        else if (!parent_order.empty()) {
+            if (parent_of.erase(parent_order.front()))
+                cached_bytes -= LINK_BYTES;
+            parent_order.pop_front();
+        }
+        else {
+            break;
+        }
+    }
+}
+
+void DeltaJoinSuccessorGenerator::set_current_state(const DBState &state, size_t hash) {
+    current = nullptr;
+    parent = nullptr;
+
+    auto it = cache.find(hash);
+    if (it != cache.end()) {
+        if (it->second.state == state) {
+            // State expanded again (e.g., reopened); everything is already computed
+            current = &it->second;
+            return;
+        }
+        // Hash collision: the new state takes over the entry
+        cached_bytes -= it->second.bytes;
+        cache.erase(it);
+    }
+
+    // Pointers to elements of an unordered_map stay valid until they are erased, so
+    // we only evict before inserting the current state and looking up its parent
+    evict();
+    it = cache.emplace(hash, CachedState(state, action_data.size())).first;
+    cache_order.push_back(hash);
+    cached_bytes += it->second.bytes;
+    current = &it->second;
+
+    auto link = parent_of.find(hash);
+    if (link == parent_of.end())
+        return;
+    auto parent_it = cache.find(link->second);
+    parent_of.erase(link);
+    cached_bytes -= LINK_BYTES;
+    if (parent_it == cache.end() or &parent_it->second == current)
+        return;
+    parent = &parent_it->second;
+    if (!compute_delta(state))
+        parent = nullptr;
+}
+
+/*
+ * Compute the atoms added and deleted in `state` w.r.t. the parent. Both
+ * relations are sorted, so this is a merge of the two lists. Returns false if the
+ * delta is too large to be worth it, in which case we recompute from scratch.
+ */
+bool DeltaJoinSuccessorGenerator::compute_delta(const DBState &state) {
+    const auto &old_relations = parent->state.get_relations();
+    const auto &new_relations = state.get_relations();
+    assert(old_relations.size() == new_relations.size());
+
+    size_t delta_size = 0, state_size = 0;
+    for (size_t r = 0; r < new_relations.size(); ++r) {
+        const FlatTupleSet &old_tuples = old_relations[r].tuples;
+        const FlatTupleSet &new_tuples = new_relations[r].tuples;
+        added[r].clear();
+        deleted[r].clear();
+        state_size += new_tuples.size();
+
+        size_t i = 0, j = 0;
+        while (i < old_tuples.size() or j < new_tuples.size()) {
+            if (j == new_tuples.size()) {
+                deleted[r].push_back(old_tuples[i++].to_vector());
+                continue;
+            }
+            if (i == old_tuples.size()) {
+                added[r].push_back(new_tuples[j++].to_vector());
+                continue;
+            }
+            TupleView t1 = old_tuples[i], t2 = new_tuples[j];
+            if (t1 == t2) {
+                ++i;
+                ++j;
+            }
+            else if (lexicographical_compare(t1.begin(), t1.end(), t2.begin(), t2.end())) {
+                deleted[r].push_back(t1.to_vector());
+                ++i;
+            }
+            else {
+                added[r].push_back(t2.to_vector());
+                ++j;
+            }
+        }
+        delta_size += added[r].size() + deleted[r].size();
+    }
+    return delta_size <= state_size;
+}
+
+/*
+ * Append the instantiations in `table` to `result`, with the arguments in the
+ * order of the parameters of the action schema.
+ */
+void DeltaJoinSuccessorGenerator::add_instantiations(const Table &table, InstantiationSet &result) {
+    vector<int> free_var_indices;
+    vector<int> map_indices_to_position;
+    compute_map_indices_to_table_positions(table, free_var_indices, map_indices_to_position);
+    for (const vector<int> &tuple_with_const : table.tuples) {
+        vector<int> ordered_tuple(free_var_indices.size());
+        order_tuple_by_free_variable_order(
+            free_var_indices, map_indices_to_position, tuple_with_const, ordered_tuple);
+        result.push_back(std::move(ordered_tuple));
+    }
+}
+
+void DeltaJoinSuccessorGenerator::compute_full(const ActionSchema &action,
+                                               const DBState &state,
+                                               InstantiationSet &result)
+{
+    Table instantiations = instantiate(action, state);
+    add_instantiations(instantiations, result);
+    sort(result.begin(), result.end());
+}
+
+void DeltaJoinSuccessorGenerator::compute_from_parent(const ActionSchema &action,
+                                                      const DBState &state,
+                                                      const InstantiationSet &parent_instantiations,
+                                                      InstantiationSet &result)
+{
+    const PrecompiledActionData &adata = action_data[action.get_index()];
+
+    vector<Table> tables;
+    if (!parse_precond_into_join_program(adata, state, tables))
+        return;
+
+    // 1. Keep the instantiations of the parent that do not use any deleted atom
+    InstantiationSet kept;
+    kept.reserve(parent_instantiations.size());
+    for (const vector<int> &instantiation : parent_instantiations) {
+        bool still_applicable = true;
+        for (unsigned i : adata.fluent_tables) {
+            const Atom &atom = adata.relevant_precondition_atoms[i];
+            const auto &deleted_atoms = deleted[atom.get_predicate_symbol_idx()];
+            if (deleted_atoms.empty()) continue;
+            GroundAtom ga = tuple_to_atom(instantiation, atom);
+            if (binary_search(deleted_atoms.begin(), deleted_atoms.end(), ga)) {
+                still_applicable = false;
+                break;
+            }
+        }
+        if (still_applicable) kept.push_back(instantiation);
+    }
+
+    // 2. Semi-naive delta joins: each new instantiation uses some added atom
+    InstantiationSet fresh;
+    for (unsigned i : adata.fluent_tables) {
+        const Atom &atom = adata.relevant_precondition_atoms[i];
+        const auto &added_atoms = added[atom.get_predicate_symbol_idx()];
+        if (added_atoms.empty()) continue;
+
+        const vector<int> &constants = adata.precondition_constants[i];
+        vector<GroundAtom> tuples;
+        for (const GroundAtom &ga : added_atoms) {
+            bool match_constants = true;
+            for (int c : constants) {
+                if (ga[c] != atom.get_arguments()[c].get_index()) {
+                    match_constants = false;
+                    break;
+                }
+            }
+            if (match_constants) tuples.push_back(ga);
+        }
+        Table working_table(std::move(tuples), vector<int>(adata.precondition_indices[i]));
+        filter_inequality_columns(working_table, adata.base_table_inequalities[i]);
+
+        const JoinPlan &plan = delta_plans[action.get_index()][i];
+        for (size_t j = 1; j < plan.steps.size() and !working_table.tuples.empty(); ++j) {
+            const JoinStep &step = plan.steps[j];
+            hash_join(working_table, tables[step.table]);
+            filter_inequality_columns(working_table, step.inequality_columns);
+        }
+        add_instantiations(working_table, fresh);
+    }
+    sort(fresh.begin(), fresh.end());
+    fresh.erase(unique(fresh.begin(), fresh.end()), fresh.end());
+
+    result.reserve(kept.size() + fresh.size());
+    set_union(kept.begin(), kept.end(), fresh.begin(), fresh.end(), back_inserter(result));
+}
+
+std::vector<LiftedOperatorId> DeltaJoinSuccessorGenerator::get_applicable_actions(
+        const ActionSchema &action, const DBState &state)
+{
+    int schema = action.get_index();
+    if (&state != last_state or schema <= last_schema) {
+        // New expansion: identify the state the next time we need its cache entry
+        current = nullptr;
+        parent = nullptr;
+    }
+    last_state = &state;
+    last_schema = schema;
+
+    // Nullary preconditions are not part of the cached instantiations, so trivially
+    // inapplicable schemas are left uncomputed and their children use a full join
+    if (action.is_ground() or is_trivially_inapplicable(state, action)) {
+        return GenericJoinSuccessor::get_applicable_actions(action, state);
+    }
+
+    if (!current) {
+        set_current_state(state, hash_value(state));
+    }
+
+    InstantiationSet &instantiations = current->instantiations[schema];
+    if (current->computed[schema]) {
+        ++num_cache_hits;
+    }
+    else {
+        if (parent and parent->computed[schema]) {
+            compute_from_parent(action, state, parent->instantiations[schema], instantiations);
+            ++num_delta_joins;
+        }
+        else {
+            compute_full(action, state, instantiations);
+            ++num_full_joins;
+        }
+        current->computed[schema] = true;
+        size_t bytes = estimate_bytes(instantiations);
+        current->bytes += bytes;
+        cached_bytes += bytes;
+    }
+
+    std::vector<LiftedOperatorId> applicable;
+    applicable.reserve(instantiations.size());
+    for (const vector<int> &instantiation : instantiations) {
+        applicable.emplace_back(schema, vector<int>(instantiation));
+    }
+    return applicable;
+}
+
+DBState DeltaJoinSuccessorGenerator::generate_successor(const LiftedOperatorId &op,
+                                                        const ActionSchema &action,
+                                                        const DBState &state)
+{
+    DBState successor = GenericJoinSuccessor::generate_successor(op, action, state);
+
+    // We do not assume that `state` is the one being expanded: e.g., lazy search
+    // generates successors only when they are popped from the open list
+    size_t successor_hash = hash_value(successor);
+    if (parent_of.emplace(successor_hash, hash_value(state)).second) {
+        parent_order.push_back(successor_hash);
+        cached_bytes += LINK_BYTES;
+    }
+    return successor;
+}
+
+void DeltaJoinSuccessorGenerator::print_statistics() const {
+    cout << "Delta joins: " << num_delta_joins << endl;
+    cout << "Full joins: " << num_full_joins << endl;
+    cout << "Cached instantiation sets reused: " << num_cache_hits << endl;
+    cout << "Delta join cache size: " << cached_bytes / 1024 << " KB" << endl;
+}
@@ -0,0 +1,114 @@
+#ifndef SEARCH_DELTA_JOIN_SUCCESSOR_H
+#define SEARCH_DELTA_JOIN_SUCCESSOR_H
+
+#include "generic_join_successor.h"
+
+#include "../states/state.h"
+
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * This class implements a successor generator that derives the applicable
+ * instantiations of a state from those of its parent, instead of running the
+ * whole join program for every expanded state.
+ *
+ * @details A successor differs from its parent only in a few atoms. If I is the
+ * set of instantiations of a schema in the parent, D the atoms deleted and A the
+ * atoms added, the instantiations of the child are
+ *
+ *    (I minus the instantiations with some precondition in D) union
+ *    (union over each fluent precondition p of join(A_p, other preconditions))
+ *
+ * where each join on the right-hand side is a semi-naive delta join: the table of
+ * p contains only the added atoms, and all other tables are the ones of the
+ * child. Each delta join follows a JoinPlan that starts from the delta table.
+ *
+ * The instantiations of each expanded state are cached together with a copy of
+ * the state. Every call to generate_successor records the parent of the
+ * successor, and the delta is obtained by comparing both states relation by
+ * relation, so the result does not depend on which parent we record.
+ *
+ * The state is identified (hashed and compared with the cache) once per
+ * expansion: search engines ask for the schemas of an expanded state in
+ * increasing order, so a call on the same object with a larger schema index than
+ * the previous call belongs to the same expansion.
+ *
+ * The cache is bounded by `max_cached_bytes` and evicted in FIFO order. If the
+ * parent of a state is not in the cache, or the delta is larger than the state
+ * itself, we fall back to the full join program of GenericJoinSuccessor.
+ *
+ * Instantiations are kept sorted, so the order of the applicable actions does not
+ * depend on whether they were obtained by a delta join or by a full recomputation.
+ */
+class DeltaJoinSuccessorGenerator : public GenericJoinSuccessor {
+    typedef std::vector<std::vector<int>> InstantiationSet;
+
+    struct CachedState {
+        DBState state;
+        //! Whether the instantiations of each schema have been computed
+        std::vector<bool> computed;
+        //! Sorted instantiations of each schema (in the order of the parameters)
+        std::vector<InstantiationSet> instantiations;
+        std::size_t bytes;
+
+        CachedState(const DBState &state, std::size_t num_schemas);
+    };
+
+    std::unordered_map<std::size_t, CachedState> cache;
+    std::deque<std::size_t> cache_order;
+
+    //! Parent recorded for each generated state, keyed by state hash
+    std::unordered_map<std::size_t, std::size_t> parent_of;
+    std::deque<std::size_t> parent_order;
+
+    std::size_t max_cached_bytes;
+    std::size_t cached_bytes;
+
+    //! State currently being expanded and its parent in the cache, if any
+    CachedState *current;
+    CachedState *parent;
+
+    //! Object and schema of the last call to get_applicable_actions
+    const DBState *last_state;
+    int last_schema;
+
+    //! Atoms added and deleted w.r.t. the parent, per predicate (sorted)
+    std::vector<InstantiationSet> added;
+    std::vector<InstantiationSet> deleted;
+
+    //! delta_plans[schema][i]: join plan starting from the delta of table i
+    std::vector<std::vector<JoinPlan>> delta_plans;
+
+    std::size_t num_delta_joins;
+    std::size_t num_full_joins;
+    std::size_t num_cache_hits;
+
+    void set_current_state(const DBState &state, std::size_t hash);
+    bool compute_delta(const DBState &state);
+    void evict();
+
+    void compute_full(const ActionSchema &action, const DBState &state, InstantiationSet &result);
+    void compute_from_parent(const ActionSchema &action,
+                             const DBState &state,
+                             const InstantiationSet &parent_instantiations,
+                             InstantiationSet &result);
+
+    static void add_instantiations(const Table &table, InstantiationSet &result);
+
+public:
+    DeltaJoinSuccessorGenerator(const Task &task, std::size_t max_cached_bytes);
+
+    std::vector<LiftedOperatorId> get_applicable_actions(
+            const ActionSchema &action, const DBState &state) override;
+
+    DBState generate_successor(const LiftedOperatorId &op,
+                               const ActionSchema& action,
+                               const DBState &state) override;
+
+    void print_statistics() const override;
+};
+
+#endif //SEARCH_DELTA_JOIN_SUCCESSOR_H
@@ -0,0 +1,109 @@
+#include "flat_join_successor.h"
+
+#include "../action.h"
+#include "../action_schema.h"
+#include "../states/state.h"
+#include "../task.h"
+
+#include <cassert>
+
+using namespace std;
+
+FlatJoinSuccessorGenerator::FlatJoinSuccessorGenerator(const Task &task)
+    : GenericJoinSuccessor(task), arena(task.objects.size())
+{
+    flat_precompiled_db.resize(action_data.size());
+    for (size_t i = 0; i < action_data.size(); ++i) {
+        for (const Table &t : action_data[i].precompiled_db) {
+            flat_precompiled_db[i].emplace_back(t);
+        }
+    }
+}
+
+/*
+ * Same join program as GenericJoinSuccessor::instantiate. Returns false if there
+ * is no instantiation; otherwise `result` points to the working table with all
+ * instantiations.
+ */
+bool FlatJoinSuccessorGenerator::instantiate(const ActionSchema &action,
+                                             const DBState &state,
+                                             FlatTable *&result)
+{
+    int schema = action.get_index();
+    const PrecompiledActionData &adata = action_data[schema];
+    if (adata.statically_inapplicable) return false;
+
+    const auto &precompiled = flat_precompiled_db[schema];
+    tables.resize(precompiled.size());
+    size_t k = 0;
+    for (size_t i = 0; i < precompiled.size(); ++i) {
+        FlatTable &t = tables[i];
+        if (k < adata.fluent_tables.size() && adata.fluent_tables[k] == i) {
+            t.tuples.clear();
+            t.tuple_index = adata.precondition_indices[i];
+            select_tuples(state, adata.relevant_precondition_atoms[i], t.tuples,
+                          adata.precondition_constants[i]);
+            filter_inequality_columns(t, adata.base_table_inequalities[i]);
+            if (t.tuples.empty()) return false;
+            ++k;
+        }
+        else {
+            // Assignment reuses the capacity of the working table
+            t.tuples = precompiled[i].tuples;
+            t.tuple_index = precompiled[i].tuple_index;
+        }
+    }
+
+    assert(!tables.empty());
+    const JoinPlan &plan = adata.join_plan;
+    FlatTable &working_table = tables[plan.steps[0].table];
+    for (size_t i = 1; i < plan.steps.size(); ++i) {
+        const JoinStep &step = plan.steps[i];
+        flat_hash_join(working_table, tables[step.table], arena, step.inequality_columns);
+        if (working_table.empty()) return false;
+    }
+    result = &working_table;
+    return true;
+}
+
+std::vector<LiftedOperatorId> FlatJoinSuccessorGenerator::get_applicable_actions(
+        const ActionSchema &action, const DBState &state)
+{
+    std::vector<LiftedOperatorId> applicable;
+    if (is_trivially_inapplicable(state, action)) {
+        return applicable;
+    }
+
+    if (action.is_ground()) {
+        if (is_ground_action_applicable(action, state)) {
+            applicable.emplace_back(action.get_index(), vector<int>());
+        }
+        return applicable;
+    }
+
+    FlatTable *instantiations = nullptr;
+    if (!instantiate(action, state, instantiations)) {
+        return applicable;
+    }
+
+    vector<int> free_var_indices;
+    vector<int> map_indices_to_position;
+    for (size_t j = 0; j < instantiations->tuple_index.size(); ++j) {
+        if (instantiations->index_is_variable(j)) {
+            free_var_indices.push_back(instantiations->tuple_index[j]);
+            map_indices_to_position.push_back(j);
+        }
+    }
+
+    size_t n = instantiations->size();
+    applicable.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        const int *tuple_with_const = instantiations->row(i);
+        vector<int> ordered_tuple(free_var_indices.size());
+        for (size_t j = 0; j < free_var_indices.size(); ++j) {
+            ordered_tuple[free_var_indices[j]] = tuple_with_const[map_indices_to_position[j]];
+        }
+        applicable.emplace_back(action.get_index(), std::move(ordered_tuple));
+    }
+    return applicable;
+}
@@ -0,0 +1,43 @@
+#ifndef SEARCH_FLAT_JOIN_SUCCESSOR_H
+#define SEARCH_FLAT_JOIN_SUCCESSOR_H
+
+#include "generic_join_successor.h"
+
+#include "../database/flat_hash_join.h"
+#include "../database/table.h"
+
+#include <vector>
+
+/**
+ * This class implements the same join program as GenericJoinSuccessor (i.e., the
+ * "join" successor generator), but on flat tables joined with the allocation-free
+ * kernel in database/flat_hash_join.h.
+ *
+ * @details Static tables are precompiled as flat tables, fluent tables are
+ * filled straight from the state relations, and all intermediate results live in
+ * a JoinArena that is reused across calls. The inequalities of each join step of
+ * the precompiled JoinPlan are checked inside the join itself. The instantiations produced, and their
+ * order, are the same as the ones of GenericJoinSuccessor, so the two generators
+ * can be compared directly.
+ *
+ * @see database/flat_hash_join.h
+ */
+class FlatJoinSuccessorGenerator : public GenericJoinSuccessor {
+    //! Flat copy of PrecompiledActionData::precompiled_db for each action schema
+    std::vector<std::vector<FlatTable>> flat_precompiled_db;
+
+    //! Working tables, reused across calls
+    std::vector<FlatTable> tables;
+
+    JoinArena arena;
+
+    bool instantiate(const ActionSchema &action, const DBState &state, FlatTable *&result);
+
+public:
+    explicit FlatJoinSuccessorGenerator(const Task &task);
+
+    std::vector<LiftedOperatorId> get_applicable_actions(
+            const ActionSchema &action, const DBState &state) override;
+};
+
+#endif //SEARCH_FLAT_JOIN_SUCCESSOR_H
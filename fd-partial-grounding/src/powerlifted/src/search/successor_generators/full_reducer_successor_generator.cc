@@ -20,7 +20,8 @@ using namespace std;
  *
  * @param task: planning task
  */
-FullReducerSuccessorGenerator::FullReducerSuccessorGenerator(const Task &task)
+FullReducerSuccessorGenerator::FullReducerSuccessorGenerator(const Task &task,
+                                                             bool use_semi_join_indexes)
     : GenericJoinSuccessor(task) {
     /*
      * Apply GYO algorithm for every action schema to check whether it
@@ -147,6 +148,10 @@ FullReducerSuccessorGenerator::FullReducerSuccessorGenerator(const Task &task)
             // cout << "Action " << action.get_name() << " is cyclic.\n";
         }
     }
+
+    if (use_semi_join_indexes) {
+        semi_join_indexes = make_unique<SemiJoinIndexes>(task, action_data, full_reducer_order);
+    }
 }
 
 /**
@@ -188,12 +193,19 @@ Table FullReducerSuccessorGenerator::instantiate(const ActionSchema &action, con
     assert(tables.size()==fjr.size());
     assert(!tables.empty());
 
-    for (const pair<int, int> &sj : full_reducer_order[action.get_index()]) {
-        size_t s = semi_join(tables[sj.second], tables[sj.first]);
-        if (s==0) {
+    if (semi_join_indexes) {
+        if (!semi_join_indexes->full_reduce(action.get_index(), state, tables)) {
             return Table::EMPTY_TABLE();
         }
     }
+    else {
+        for (const pair<int, int> &sj : full_reducer_order[action.get_index()]) {
+            size_t s = semi_join(tables[sj.second], tables[sj.first]);
+            if (s==0) {
+                return Table::EMPTY_TABLE();
+            }
+        }
+    }
 
     Table &working_table = tables[fjr[0]];
     for (size_t i = 1; i < fjr.size(); ++i) {
@@ -206,3 +218,14 @@ Table FullReducerSuccessorGenerator::instantiate(const ActionSchema &action, con
 
     return working_table;
 }
+
+const JoinPlan &FullReducerSuccessorGenerator::get_join_plan(int) const
+{
+    // The full reducer runs before the joins, so no left-deep plan describes it
+    static const JoinPlan no_plan;
+    return no_plan;
+}
+
+void FullReducerSuccessorGenerator::print_statistics() const {
+    if (semi_join_indexes) semi_join_indexes->print_statistics();
+}
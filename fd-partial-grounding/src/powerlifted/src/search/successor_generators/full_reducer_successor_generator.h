@@ -2,20 +2,31 @@
 #define SEARCH_FULL_REDUCER_SUCCESSOR_GENERATOR_H
 
 #include "generic_join_successor.h"
+#include "semi_join_indexes.h"
+
+#include <memory>
 
 class FullReducerSuccessorGenerator : public GenericJoinSuccessor {
 public:
   /**
    * @see full_reducer_successor_generator.cc
    * @param task
+   * @param use_semi_join_indexes Run the full reducer with persistent
+   * SemiJoinIndexes instead of semi-joins computed from scratch
    */
-    explicit FullReducerSuccessorGenerator(const Task &task);
+    explicit FullReducerSuccessorGenerator(const Task &task, bool use_semi_join_indexes = false);
 
     Table instantiate(const ActionSchema &action, const DBState &state) override;
 
+    const JoinPlan &get_join_plan(int action_schema) const override;
+
+    void print_statistics() const override;
+
 private:
     std::vector<std::vector<std::pair<int, int>>> full_reducer_order;
     std::vector<std::vector<int>> full_join_order;
+
+    std::unique_ptr<SemiJoinIndexes> semi_join_indexes;
 };
 
 
@@ -0,0 +1,107 @@
+#include "generator_benchmark.h"
+
+#include "successor_generator.h"
+#include "successor_generator_factory.h"
+
+#include "../action.h"
+#include "../options.h"
+#include "../task.h"
+
+#include "../states/state.h"
+#include "../utils/timer.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <iostream>
+#include <memory>
+#include <random>
+
+using namespace std;
+
+static const int MAX_WALK_LENGTH = 50;
+
+static vector<LiftedOperatorId> get_all_applicable_actions(const Task &task,
+                                                           SuccessorGenerator &generator,
+                                                           const DBState &state) {
+    vector<LiftedOperatorId> applicable;
+    for (const ActionSchema &action : task.get_action_schemas()) {
+        for (LiftedOperatorId &op : generator.get_applicable_actions(action, state)) {
+            applicable.push_back(std::move(op));
+        }
+    }
+    return applicable;
+}
+
+static vector<DBState> sample_states(const Task &task, SuccessorGenerator &generator,
+                                     int num_states, unsigned seed) {
+    mt19937 rng(seed);
+    vector<DBState> states;
+    states.reserve(num_states);
+    DBState state = task.get_initial_state();
+    int walk_length = 0;
+    while (int(states.size()) < num_states) {
+        states.push_back(state);
+        vector<LiftedOperatorId> applicable = get_all_applicable_actions(task, generator, state);
+        if (applicable.empty() or ++walk_length == MAX_WALK_LENGTH) {
+            state = task.get_initial_state();
+            walk_length = 0;
+            continue;
+        }
+        const LiftedOperatorId &op = applicable[uniform_int_distribution<size_t>(0, applicable.size() - 1)(rng)];
+        state = generator.generate_successor(op, task.get_action_schema_by_index(op.get_index()), state);
+    }
+    return states;
+}
+
+utils::ExitCode run_generator_benchmark(const Task &task, const Options &opt) {
+    vector<string> methods;
+    boost::split(methods, opt.get_benchmark_generators(), boost::is_any_of(","), boost::token_compress_on);
+
+    vector<DBState> states;
+    {
+        unique_ptr<SuccessorGenerator> generator(
+            SuccessorGeneratorFactory::create(methods[0], opt, task));
+        states = sample_states(task, *generator, opt.get_benchmark_states(), opt.get_seed());
+    }
+    cout << "Sampled " << states.size() << " states." << endl;
+
+    bool all_equal = true;
+    size_t reference_count = 0, reference_checksum = 0;
+    for (size_t i = 0; i < methods.size(); ++i) {
+        utils::Timer creation_timer;
+        unique_ptr<SuccessorGenerator> generator(
+            SuccessorGeneratorFactory::create(methods[i], opt, task));
+        creation_timer.stop();
+
+        // The checksum does not depend on the order of the applicable actions
+        size_t count = 0, checksum = 0;
+        utils::Timer timer;
+        for (const DBState &state : states) {
+            for (const ActionSchema &action : task.get_action_schemas()) {
+                for (const LiftedOperatorId &op : generator->get_applicable_actions(action, state)) {
+                    size_t h = op.get_index();
+                    boost::hash_range(h, op.get_instantiation().begin(), op.get_instantiation().end());
+                    checksum += h;
+                    ++count;
+                }
+            }
+        }
+        timer.stop();
+
+        cout << "Generator " << methods[i] << ": " << timer << " for " << states.size()
+             << " states (creation " << creation_timer << "), "
+             << count << " applicable actions" << endl;
+        if (i == 0) {
+            reference_count = count;
+            reference_checksum = checksum;
+        }
+        else if (count != reference_count or checksum != reference_checksum) {
+            cout << "Generator " << methods[i] << " found different applicable actions than "
+                 << methods[0] << endl;
+            all_equal = false;
+        }
+        generator->print_statistics();
+    }
+    return all_equal ? utils::ExitCode::SUCCESS : utils::ExitCode::SEARCH_CRITICAL_ERROR;
+}
@@ -0,0 +1,22 @@
+#ifndef SEARCH_GENERATOR_BENCHMARK_H
+#define SEARCH_GENERATOR_BENCHMARK_H
+
+#include "../utils/system.h"
+
+class Options;
+class Task;
+
+/**
+ * Microbenchmark for the successor generators in --benchmark-generators.
+ *
+ * @details We sample --benchmark-states states with random walks from the
+ * initial state (seeded with --seed), restarting after 50 steps or at dead
+ * ends. The sample is computed once with the first generator of the list. Then
+ * we create each generator and time the computation of the applicable actions of
+ * every action schema in every sampled state, in the order of the sample, so
+ * all generators see exactly the same sequence of states. We also check that
+ * all generators find the same set of applicable actions.
+ */
+utils::ExitCode run_generator_benchmark(const Task &task, const Options &opt);
+
+#endif //SEARCH_GENERATOR_BENCHMARK_H
@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <ostream>
+#include <tuple>
 #include <vector>
 
 using namespace std;
@@ -43,11 +45,16 @@ Table GenericJoinSuccessor::instantiate(const ActionSchema &action,
     assert(!tables.empty());
     assert(tables.size() == actiondata.relevant_precondition_atoms.size());
 
-    Table &working_table = tables[0];
-    for (size_t i = 1; i < tables.size(); ++i) {
-        hash_join(working_table, tables[i]);
+    const JoinPlan &plan = actiondata.join_plan;
+    assert(plan.steps.size() == tables.size());
+
+    Table &working_table = tables[plan.steps[0].table];
+    for (size_t i = 1; i < plan.steps.size(); ++i) {
+        const JoinStep &step = plan.steps[i];
+        hash_join(working_table, tables[step.table]);
+        assert(working_table.tuple_index == step.tuple_index);
         // Filter out equalities
-        filter_inequalities(action, working_table);
+        filter_inequality_columns(working_table, step.inequality_columns);
         if (working_table.tuples.empty()) {
             return working_table;
         }
@@ -56,31 +63,117 @@ Table GenericJoinSuccessor::instantiate(const ActionSchema &action,
     return working_table;
 }
 
+const JoinPlan &GenericJoinSuccessor::get_join_plan(int action_schema) const {
+    return action_data[action_schema].join_plan;
+}
+
+void GenericJoinSuccessor::dump_join_plans(const Task &task, std::ostream &os) const {
+    for (const ActionSchema &action : task.get_action_schemas()) {
+        const PrecompiledActionData &adata = action_data[action.get_index()];
+        if (adata.is_ground) continue;
+        if (adata.statically_inapplicable) {
+            os << "Action schema " << action.get_name() << " is statically inapplicable" << endl;
+            continue;
+        }
+        const JoinPlan &plan = get_join_plan(action.get_index());
+        if (plan.empty()) continue;
+        plan.dump(os, action, adata.relevant_precondition_atoms);
+        for (size_t i = 0; i < adata.base_table_inequalities.size(); ++i) {
+            for (const auto &ineq : adata.base_table_inequalities[i]) {
+                os << "  select " << adata.relevant_precondition_atoms[i].get_name()
+                   << " #" << ineq.first << " != #" << ineq.second << endl;
+            }
+        }
+    }
+}
+
 void GenericJoinSuccessor::filter_inequalities(const ActionSchema &action,
                                                Table &working_table)
 {
     const auto& tup_idx = working_table.tuple_index;
 
     // Loop over inequalities and remove those not consistent with the current instantiation
+    // Generators with a fixed join order use the precompiled JoinPlan instead, see
+    // filter_inequality_columns. This is only needed when the order is decided at runtime.
+    for (const pair<int, int>& ineq : action.get_inequalities()) {
+        auto it_1 = find(tup_idx.begin(), tup_idx.end(), ineq.first);
+        auto it_2 = find(tup_idx.begin(), tup_idx.end(), ineq.second);
+
+        if (it_1 != tup_idx.end() and it_2 != tup_idx.end()) {
+            int index1 = distance(tup_idx.begin(), it_1);
+            int index2 = distance(tup_idx.begin(), it_2);
+            filter_inequality_columns(working_table, {{index1, index2}});
+        }
+    }
+}
+
+void GenericJoinSuccessor::filter_inequalities(const ActionSchema &action,
+                                               FlatTable &working_table)
+{
+    const auto& tup_idx = working_table.tuple_index;
+
     for (const pair<int, int>& ineq : action.get_inequalities()) {
-        // TODO Revise this, looks that some work could be offloaded to preprocessing so that we
-        //      do not need to do all this linear-time finds at runtime?
         auto it_1 = find(tup_idx.begin(), tup_idx.end(), ineq.first);
         auto it_2 = find(tup_idx.begin(), tup_idx.end(), ineq.second);
 
         if (it_1 != tup_idx.end() and it_2 != tup_idx.end()) {
             int index1 = distance(tup_idx.begin(), it_1);
             int index2 = distance(tup_idx.begin(), it_2);
+            filter_inequality_columns(working_table, {{index1, index2}});
+        }
+    }
+}
+
+void GenericJoinSuccessor::filter_inequality_columns(Table &table,
+                                                     const vector<pair<int, int>> &columns)
+{
+    if (columns.empty()) return;
+
+    // Compact the table in place, keeping the relative order of the tuples
+    auto &tuples = table.tuples;
+    size_t kept = 0;
+    for (size_t i = 0; i < tuples.size(); ++i) {
+        const vector<int> &t = tuples[i];
+        bool consistent = true;
+        for (const auto &ineq : columns) {
+            if (t[ineq.first] == t[ineq.second]) {
+                consistent = false;
+                break;
+            }
+        }
+        if (consistent) {
+            if (kept != i)
+                tuples[kept] = std::move(tuples[i]);
+            ++kept;
+        }
+    }
+    tuples.resize(kept);
+}
 
-            vector<vector<int>> newtuples;
-            for (const auto &t : working_table.tuples) {
-                if (t[index1] != t[index2]) {
-                    newtuples.push_back(t);
-                }
+void GenericJoinSuccessor::filter_inequality_columns(FlatTable &table,
+                                                     const vector<pair<int, int>> &columns)
+{
+    if (columns.empty()) return;
+
+    auto &tuples = table.tuples;
+    const size_t arity = table.arity();
+    size_t kept = 0;
+    for (size_t i = 0, n = table.size(); i < n; ++i) {
+        const int *t = table.row(i);
+        bool consistent = true;
+        for (const auto &ineq : columns) {
+            if (t[ineq.first] == t[ineq.second]) {
+                consistent = false;
+                break;
             }
-            working_table.tuples = std::move(newtuples);
+        }
+        if (consistent) {
+            if (kept != i)
+                copy(t, t + arity, tuples.begin() + kept * arity);
+            ++kept;
         }
     }
+    tuples.resize(kept * arity);
 }
 
 void GenericJoinSuccessor::get_indices_and_constants_in_preconditions(vector<int> &indices,
@@ -100,27 +193,74 @@ void GenericJoinSuccessor::get_indices_and_constants_in_preconditions(vector<int
 }
 
 /*
- * Select only those tuples matching the constants of a partially grounded
- * precondition.
+ * Call f on each tuple of the relation of `a` in `s` that matches the constants
+ * of a partially grounded precondition.
+ *
+ * Relations are sorted, so if the constants form a prefix of the atom
+ * arguments, we only need to scan the range of tuples sharing that prefix.
  */
-void GenericJoinSuccessor::select_tuples(const DBState &s,
-                                         const Atom &a,
-                                         std::vector<GroundAtom> &tuples,
-                                         const std::vector<int> &constants)
+template <typename F>
+static void for_each_tuple_matching_constants(const DBState &s,
+                                              const Atom &a,
+                                              const std::vector<int> &constants,
+                                              F f)
 {
-    for (const GroundAtom &atom : s.get_relations()[a.get_predicate_symbol_idx()].tuples) {
+    const FlatTupleSet &relation = s.get_relations()[a.get_predicate_symbol_idx()].tuples;
+    const auto &args = a.get_arguments();
+
+    size_t prefix_length = 0;
+    while (prefix_length < constants.size() && constants[prefix_length] == int(prefix_length))
+        ++prefix_length;
+
+    size_t first = 0, last = relation.size();
+    if (prefix_length > 0) {
+        vector<int> prefix(prefix_length);
+        for (size_t i = 0; i < prefix_length; ++i) {
+            assert(args[i].is_constant());
+            prefix[i] = args[i].get_index();
+        }
+        tie(first, last) = relation.prefix_range(prefix);
+    }
+
+    for (size_t i = first; i < last; ++i) {
+        TupleView atom = relation[i];
         bool match_constants = true;
-        for (int c : constants) {
-            assert(a.get_arguments()[c].is_constant());
-            if (atom[c] != a.get_arguments()[c].get_index()) {
+        for (size_t j = prefix_length; j < constants.size(); ++j) {
+            int c = constants[j];
+            assert(args[c].is_constant());
+            if (atom[c] != args[c].get_index()) {
                 match_constants = false;
                 break;
             }
         }
-        if (match_constants) tuples.push_back(atom);
+        if (match_constants) f(atom);
     }
 }
 
+/*
+ * Select only those tuples matching the constants of a partially grounded
+ * precondition.
+ */
+void GenericJoinSuccessor::select_tuples(const DBState &s,
+                                         const Atom &a,
+                                         std::vector<GroundAtom> &tuples,
+                                         const std::vector<int> &constants)
+{
+    for_each_tuple_matching_constants(s, a, constants, [&tuples](TupleView atom) {
+        tuples.emplace_back(atom.begin(), atom.end());
+    });
+}
+
+void GenericJoinSuccessor::select_tuples(const DBState &s,
+                                         const Atom &a,
+                                         std::vector<int> &flat_tuples,
+                                         const std::vector<int> &constants)
+{
+    for_each_tuple_matching_constants(s, a, constants, [&flat_tuples](TupleView atom) {
+        flat_tuples.insert(flat_tuples.end(), atom.begin(), atom.end());
+    });
+}
+
 std::vector<PrecompiledActionData>
 GenericJoinSuccessor::precompile_action_data(const std::vector<ActionSchema>& actions) {
     std::vector<PrecompiledActionData> result;
@@ -154,9 +294,26 @@ PrecompiledActionData GenericJoinSuccessor::precompile_action_data(const ActionS
     assert(!data.relevant_precondition_atoms.empty());
 
     // Create N empty tables
-    data.precompiled_db.resize(data.relevant_precondition_atoms.size());
+    std::size_t num_tables = data.relevant_precondition_atoms.size();
+    data.precompiled_db.resize(num_tables);
+    data.precondition_indices.resize(num_tables);
+    data.precondition_constants.resize(num_tables);
+    data.base_table_inequalities.resize(num_tables);
+
+    // Column layout and constants of each table do not depend on the state
+    for (std::size_t i = 0; i < num_tables; ++i) {
+        get_indices_and_constants_in_preconditions(data.precondition_indices[i],
+                                                   data.precondition_constants[i],
+                                                   data.relevant_precondition_atoms[i]);
+        data.base_table_inequalities[i] =
+            compute_inequality_columns(action, data.precondition_indices[i]);
+    }
+
+    vector<int> pddl_order(num_tables);
+    for (std::size_t i = 0; i < num_tables; ++i) pddl_order[i] = i;
+    data.join_plan = JoinPlan(action, data.precondition_indices, pddl_order);
 
-    for (std::size_t i = 0; i < data.relevant_precondition_atoms.size(); ++i) {
+    for (std::size_t i = 0; i < num_tables; ++i) {
         const Atom &atom = data.relevant_precondition_atoms[i];
 
         if (!is_static(atom.get_predicate_symbol_idx())) {
@@ -168,18 +325,17 @@ PrecompiledActionData GenericJoinSuccessor::precompile_action_data(const ActionS
 
         // Otherwise the atom is static, so we precompile the table corresponding to it
         vector<GroundAtom> tuples;
-        vector<int> constants, indices;
+        select_tuples(static_information, atom, tuples, data.precondition_constants[i]);
 
-        get_indices_and_constants_in_preconditions(indices, constants, atom);
+        Table table(std::move(tuples), vector<int>(data.precondition_indices[i]));
+        filter_inequality_columns(table, data.base_table_inequalities[i]);
 
-        select_tuples(static_information, atom, tuples, constants);
-
-        if (tuples.empty()) {
+        if (table.tuples.empty()) {
             data.statically_inapplicable = true;
             return data;
         }
 
-        data.precompiled_db[i] = Table(std::move(tuples), std::move(indices));
+        data.precompiled_db[i] = std::move(table);
     }
 
     return data;
@@ -212,16 +368,12 @@ bool GenericJoinSuccessor::parse_precond_into_join_program(
         assert(!is_static(atom.get_predicate_symbol_idx()));
 
         vector<GroundAtom> tuples;
-        vector<int> constants, indices;
-
-        // TODO the call next line should be performed at preprocessing as well. We should keep in
-        //      adata the vector of constants and indices *for each precondition atom*
-        get_indices_and_constants_in_preconditions(indices, constants, atom);
-        select_tuples(state, atom, tuples, constants);
+        select_tuples(state, atom, tuples, adata.precondition_constants[i]);
 
-        if (tuples.empty()) return false;
+        tables[i] = Table(std::move(tuples), vector<int>(adata.precondition_indices[i]));
+        filter_inequality_columns(tables[i], adata.base_table_inequalities[i]);
 
-        tables[i] = Table(std::move(tuples), std::move(indices));
+        if (tables[i].tuples.empty()) return false;
     }
 
     return true;
@@ -390,15 +542,9 @@ void GenericJoinSuccessor::apply_lifted_action_effects(const ActionSchema &actio
             new_relation[eff.get_predicate_symbol_idx()].tuples.erase(ga);
         }
         else {
-            int predicate_symbol_idx = eff.get_predicate_symbol_idx();
-            if (find(new_relation[predicate_symbol_idx].tuples.begin(),
-                     new_relation[predicate_symbol_idx].tuples.end(),
-                     ga) == new_relation[predicate_symbol_idx].tuples.end()) {
-                // If ground atom is not in the state, we add it
-
-                new_relation[eff.get_predicate_symbol_idx()].tuples.insert(ga);
+            // If ground atom is not in the state, we add it
+            if (new_relation[eff.get_predicate_symbol_idx()].tuples.insert(ga)) {
                 add_to_added_atoms(eff.get_predicate_symbol_idx(), ga);
-
             }
         }
     }
@@ -527,7 +673,7 @@ bool GenericJoinSuccessor::is_ground_action_applicable(const ActionSchema &actio
     }
     return true;
 }
-const unordered_set<GroundAtom, TupleHash> &
+const FlatTupleSet &
 GenericJoinSuccessor::get_tuples_from_static_relation(size_t i) const
 {
     return static_information.get_tuples_of_relation(i);
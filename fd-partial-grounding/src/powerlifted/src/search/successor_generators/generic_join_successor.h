@@ -1,6 +1,7 @@
 #ifndef SEARCH_GENERIC_JOIN_SUCCESSOR_H
 #define SEARCH_GENERIC_JOIN_SUCCESSOR_H
 
+#include "join_plan.h"
 #include "successor_generator.h"
 
 #include "../atom.h"
@@ -8,12 +9,12 @@
 
 #include <map>
 #include <set>
-#include <unordered_set>
 #include <vector>
 
 class PrecompiledActionData;
 class Task;
 class Table;
+class FlatTable;
 
 /**
  * This class is not a successor generator per se. It just contain most of the common functions
@@ -66,13 +67,20 @@ public:
 
     const GroundAtom tuple_to_atom(const std::vector<int> &tuple, const Atom &eff);
 
-    const std::unordered_set<GroundAtom, TupleHash>
-    &get_tuples_from_static_relation(size_t i) const;
+    const FlatTupleSet &get_tuples_from_static_relation(size_t i) const;
 
     const std::vector<std::pair<int, GroundAtom>> &get_added_atoms() const override {
         return added_atoms;
     }
 
+    /**
+     * Join plan used to instantiate the given action schema. Generators that
+     * do not follow a fixed left-deep join order return an empty plan.
+     */
+    virtual const JoinPlan &get_join_plan(int action_schema) const;
+
+    void dump_join_plans(const Task &task, std::ostream &os) const override;
+
 protected:
     const StaticInformation& static_information;
 
@@ -92,8 +100,26 @@ protected:
                               std::vector<GroundAtom> &tuples,
                               const std::vector<int> &constants);
 
+    static void select_tuples(const DBState &s,
+                              const Atom &a,
+                              std::vector<int> &flat_tuples,
+                              const std::vector<int> &constants);
+
     static void filter_inequalities(const ActionSchema &action,
                              Table &working_table) ;
+
+    static void filter_inequalities(const ActionSchema &action,
+                                    FlatTable &working_table);
+
+    /**
+     * Remove the tuples for which some pair of columns in `columns` hold the same
+     * value. This is the precompiled counterpart of filter_inequalities.
+     */
+    static void filter_inequality_columns(Table &table,
+                                          const std::vector<std::pair<int, int>> &columns);
+
+    static void filter_inequality_columns(FlatTable &table,
+                                          const std::vector<std::pair<int, int>> &columns);
     static void create_hypergraph(
         const ActionSchema &action,
         std::vector<int> &hypernodes,
@@ -137,8 +163,9 @@ class PrecompiledActionData {
 public:
     PrecompiledActionData() :
         is_ground(false), statically_inapplicable(false),
-        relevant_precondition_atoms(), fluent_tables(),
-        precompiled_db()
+        relevant_precondition_atoms(), precondition_indices(),
+        precondition_constants(), base_table_inequalities(), fluent_tables(),
+        precompiled_db(), join_plan()
     {}
 
     //! Whether the action has no parameters
@@ -149,12 +176,26 @@ public:
 
     std::vector<Atom> relevant_precondition_atoms;
 
+    //! Tuple index of the table of each atom in `relevant_precondition_atoms`
+    //! (constants are encoded as negative numbers)
+    std::vector<std::vector<int>> precondition_indices;
+
+    //! Positions of the constant arguments of each atom in `relevant_precondition_atoms`
+    std::vector<std::vector<int>> precondition_constants;
+
+    //! Inequalities between two variables of the same atom, as column pairs of its table.
+    //! They are applied as selections when the table is created.
+    std::vector<std::vector<std::pair<int, int>>> base_table_inequalities;
+
     //! A list of the indices in `relevant_precondition_atoms` that correspond to fluent atoms,
     //! and hence their tables need to be created for each state.
     std::vector<unsigned> fluent_tables;
 
     //! A set of tables with all static info precompiled for faster access at runtime
     std::vector<Table> precompiled_db;
+
+    //! Join program following the order of the preconditions in the PDDL file
+    JoinPlan join_plan;
 };
 
 #endif //SEARCH_GENERIC_JOIN_SUCCESSOR_H
@@ -0,0 +1,116 @@
+#include "join_plan.h"
+
+#include "../action_schema.h"
+#include "../database/utils.h"
+
+#include <algorithm>
+
+using namespace std;
+
+static int find_column(const vector<int> &tuple_index, int variable) {
+    auto it = find(tuple_index.begin(), tuple_index.end(), variable);
+    if (it == tuple_index.end()) return -1;
+    return distance(tuple_index.begin(), it);
+}
+
+vector<pair<int, int>> compute_inequality_columns(const ActionSchema &action,
+                                                  const vector<int> &tuple_index)
+{
+    vector<pair<int, int>> columns;
+    for (const pair<int, int> &ineq : action.get_inequalities()) {
+        int c1 = find_column(tuple_index, ineq.first);
+        int c2 = find_column(tuple_index, ineq.second);
+        if (c1 != -1 and c2 != -1) {
+            columns.emplace_back(c1, c2);
+        }
+    }
+    return columns;
+}
+
+/*
+ * Tuple index of the result of hash_join(t1, t2). Must be kept in sync with
+ * database/hash_join.cc and database/flat_hash_join.cc.
+ */
+static vector<int> joined_tuple_index(const vector<int> &index1, const vector<int> &index2) {
+    vector<int> matches1, matches2;
+    compute_matching_columns(index1, index2, matches1, matches2);
+    vector<int> result(index1);
+    for (size_t j = 0; j < index2.size(); ++j) {
+        if (find(matches2.begin(), matches2.end(), int(j)) == matches2.end()) {
+            result.push_back(index2[j]);
+        }
+    }
+    return result;
+}
+
+JoinPlan::JoinPlan(const ActionSchema &action,
+                   const vector<vector<int>> &precondition_indices,
+                   const vector<int> &order)
+{
+    const auto &inequalities = action.get_inequalities();
+    vector<bool> enforced(inequalities.size(), false);
+
+    // Inequalities within a single table are enforced when the base table is created
+    for (const vector<int> &idx : precondition_indices) {
+        for (size_t k = 0; k < inequalities.size(); ++k) {
+            if (find_column(idx, inequalities[k].first) != -1 and
+                find_column(idx, inequalities[k].second) != -1) {
+                enforced[k] = true;
+            }
+        }
+    }
+
+    vector<int> tuple_index;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const vector<int> &idx = precondition_indices[order[i]];
+        tuple_index = (i == 0) ? idx : joined_tuple_index(tuple_index, idx);
+
+        JoinStep step;
+        step.table = order[i];
+        step.tuple_index = tuple_index;
+        for (size_t k = 0; k < inequalities.size(); ++k) {
+            if (enforced[k]) continue;
+            int c1 = find_column(tuple_index, inequalities[k].first);
+            int c2 = find_column(tuple_index, inequalities[k].second);
+            if (c1 != -1 and c2 != -1) {
+                step.inequality_columns.emplace_back(c1, c2);
+                enforced[k] = true;
+            }
+        }
+        steps.push_back(std::move(step));
+    }
+}
+
+static void dump_variable(ostream &os, const ActionSchema &action, int v) {
+    if (v >= 0)
+        os << action.get_parameters()[v].name;
+    else
+        os << "obj#" << (-v - 1);  // Constants are encoded as -(index + 1)
+}
+
+void JoinPlan::dump(ostream &os,
+                    const ActionSchema &action,
+                    const vector<Atom> &relevant_precondition_atoms) const
+{
+    os << "Join plan for action schema " << action.get_name() << ":" << endl;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const JoinStep &step = steps[i];
+        const Atom &atom = relevant_precondition_atoms[step.table];
+        os << "  " << ((i == 0) ? "load " : "join ") << atom.get_name() << "(";
+        for (size_t j = 0; j < atom.get_arguments().size(); ++j) {
+            const Argument &arg = atom.get_arguments()[j];
+            if (j > 0) os << ", ";
+            dump_variable(os, action, arg.is_constant() ? -(arg.get_index() + 1) : arg.get_index());
+        }
+        os << ") -> [";
+        for (size_t j = 0; j < step.tuple_index.size(); ++j) {
+            if (j > 0) os << ", ";
+            dump_variable(os, action, step.tuple_index[j]);
+        }
+        os << "]";
+        for (const auto &ineq : step.inequality_columns) {
+            os << " filter #" << ineq.first << " != #" << ineq.second;
+        }
+        os << endl;
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef SEARCH_JOIN_PLAN_H
+#define SEARCH_JOIN_PLAN_H
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+class ActionSchema;
+class Atom;
+
+/**
+ * @brief One step of a left-deep join program: the table joined into the
+ * working table and the inequalities that can be checked right after it.
+ *
+ * @var table: Index (in PrecompiledActionData::relevant_precondition_atoms) of
+ * the table joined at this step. The first step just loads the table.
+ * @var tuple_index: Variables of the working table after this step.
+ * @var inequality_columns: Pairs of columns of the working table, after this
+ * step, that must hold different values. Each inequality of the schema is checked
+ * at the first step where both of its variables are available, and only there.
+ */
+struct JoinStep {
+    int table;
+    std::vector<int> tuple_index;
+    std::vector<std::pair<int, int>> inequality_columns;
+};
+
+/**
+ * @brief Join program of an action schema compiled for a fixed join order.
+ *
+ * @details All column positions are resolved once at construction time, so that
+ * at search time we neither look up variables in the tuple index of the working
+ * table nor re-check inequalities that were already enforced by an earlier step.
+ * Inequalities between two variables of the same precondition atom are not part
+ * of the plan: they are applied as selections when the base table is created.
+ *
+ * @see GenericJoinSuccessor::filter_inequality_columns
+ */
+class JoinPlan {
+public:
+    std::vector<JoinStep> steps;
+
+    JoinPlan() = default;
+
+    /**
+     * @param action: action schema
+     * @param precondition_indices: tuple index of each relevant precondition table
+     * @param order: order in which the tables are joined
+     */
+    JoinPlan(const ActionSchema &action,
+             const std::vector<std::vector<int>> &precondition_indices,
+             const std::vector<int> &order);
+
+    bool empty() const {
+        return steps.empty();
+    }
+
+    void dump(std::ostream &os,
+              const ActionSchema &action,
+              const std::vector<Atom> &relevant_precondition_atoms) const;
+};
+
+/**
+ * Column pairs of a table with the given tuple index that must differ because of
+ * the inequalities of the schema. Used to apply inequalities as selections on the
+ * base tables.
+ */
+std::vector<std::pair<int, int>> compute_inequality_columns(
+    const ActionSchema &action, const std::vector<int> &tuple_index);
+
+#endif //SEARCH_JOIN_PLAN_H
@@ -31,6 +31,12 @@ OrderedJoinSuccessorGenerator<OrderT>::OrderedJoinSuccessorGenerator(const Task
             int idx = p.second;
             precondition_to_order[a_idx].push_back(idx);
         }
+        join_plans.emplace_back();
+        if (!a.is_ground) {
+            join_plans.back() = JoinPlan(task.get_action_schemas()[a_idx],
+                                         a.precondition_indices,
+                                         precondition_to_order[a_idx]);
+        }
         ++a_idx;
     }
 }
@@ -47,8 +53,6 @@ template<typename OrderT>
 Table OrderedJoinSuccessorGenerator<OrderT>::instantiate(const ActionSchema &action,
                                                          const DBState &state) {
 
-    vector<int> order = precondition_to_order[action.get_index()];
-
     if (action.is_ground()) {
         throw std::runtime_error("Shouldn't be calling instantiate() on a ground action");
     }
@@ -63,11 +67,15 @@ Table OrderedJoinSuccessorGenerator<OrderT>::instantiate(const ActionSchema &act
     assert(!tables.empty());
     assert(tables.size() == actiondata.relevant_precondition_atoms.size());
 
-    Table &working_table = tables[order[0]];
-    for (size_t i = 1; i < tables.size(); ++i) {
-        hash_join(working_table, tables[order[i]]);
+    const JoinPlan &plan = join_plans[action.get_index()];
+    assert(plan.steps.size() == tables.size());
+
+    Table &working_table = tables[plan.steps[0].table];
+    for (size_t i = 1; i < plan.steps.size(); ++i) {
+        const JoinStep &step = plan.steps[i];
+        hash_join(working_table, tables[step.table]);
         // Filter out equalities
-        filter_inequalities(action, working_table);
+        filter_inequality_columns(working_table, step.inequality_columns);
         if (working_table.tuples.empty()) {
             return working_table;
         }
@@ -76,6 +84,11 @@ Table OrderedJoinSuccessorGenerator<OrderT>::instantiate(const ActionSchema &act
     return working_table;
 }
 
+template<typename OrderT>
+const JoinPlan &OrderedJoinSuccessorGenerator<OrderT>::get_join_plan(int action_schema) const {
+    return join_plans[action_schema];
+}
+
 // explicit template instantiations
 template class OrderedJoinSuccessorGenerator<OrderTable>;
 template class OrderedJoinSuccessorGenerator<InverseOrderTable>;
\ No newline at end of file
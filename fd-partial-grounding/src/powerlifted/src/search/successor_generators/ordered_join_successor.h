@@ -14,6 +14,8 @@
 template <typename OrderT>
 class OrderedJoinSuccessorGenerator : public GenericJoinSuccessor {
     std::vector<std::vector<int>> precondition_to_order;
+    //! Join program of each action schema compiled for the order above
+    std::vector<JoinPlan> join_plans;
 
 public:
     explicit OrderedJoinSuccessorGenerator(const Task &task);
@@ -25,6 +27,8 @@ public:
 
     Table instantiate(const ActionSchema &action, const DBState &state) override;
 
+    const JoinPlan &get_join_plan(int action_schema) const override;
+
 };
 
 struct OrderTable {
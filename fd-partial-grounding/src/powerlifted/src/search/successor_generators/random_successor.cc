@@ -1,8 +1,13 @@
 #include "random_successor.h"
 
+#include "../action_schema.h"
+
+#include "../database/hash_join.h"
 #include "../database/table.h"
 
 #include <algorithm>
+#include <cassert>
+#include <stdexcept>
 #include <vector>
 
 using namespace std;
@@ -21,4 +26,36 @@ bool RandomSuccessorGenerator::parse_precond_into_join_program(
 
     shuffle(tables.begin(), tables.end(), rng);
     return true;
-}
\ No newline at end of file
+}
+
+Table RandomSuccessorGenerator::instantiate(const ActionSchema &action, const DBState &state)
+{
+    if (action.is_ground()) {
+        throw std::runtime_error("Shouldn't be calling instantiate() on a ground action");
+    }
+
+    vector<Table> tables(0);
+    auto res = parse_precond_into_join_program(action_data[action.get_index()], state, tables);
+
+    if (!res) return Table::EMPTY_TABLE();
+
+    assert(!tables.empty());
+
+    Table &working_table = tables[0];
+    for (size_t i = 1; i < tables.size(); ++i) {
+        hash_join(working_table, tables[i]);
+        // Filter out equalities
+        filter_inequalities(action, working_table);
+        if (working_table.tuples.empty()) {
+            return working_table;
+        }
+    }
+
+    return working_table;
+}
+
+const JoinPlan &RandomSuccessorGenerator::get_join_plan(int) const
+{
+    static const JoinPlan no_plan;
+    return no_plan;
+}
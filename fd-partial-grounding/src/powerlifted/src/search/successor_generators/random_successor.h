@@ -19,6 +19,14 @@ public:
     bool parse_precond_into_join_program(const PrecompiledActionData &adata,
                                          const DBState &state,
                                          std::vector<Table>& tables) override;
+
+    /**
+     * Join the tables in the order in which they are shuffled. As the order
+     * changes at every call, inequalities are checked dynamically.
+     */
+    Table instantiate(const ActionSchema &action, const DBState &state) override;
+
+    const JoinPlan &get_join_plan(int action_schema) const override;
 };
 
 
@@ -0,0 +1,208 @@
+#include "semi_join_indexes.h"
+
+#include "generic_join_successor.h"
+
+#include "../task.h"
+
+#include "../database/semi_join.h"
+#include "../database/table.h"
+#include "../database/utils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+bool SemiJoinIndexes::Index::selects(TupleView tuple) const {
+    for (const auto &c : constants) {
+        if (tuple[c.first] != c.second) return false;
+    }
+    for (const auto &ineq : inequalities) {
+        if (tuple[ineq.first] == tuple[ineq.second]) return false;
+    }
+    return true;
+}
+
+void SemiJoinIndexes::Index::add(TupleView tuple, vector<int> &key) {
+    if (!selects(tuple)) return;
+    key.resize(key_positions.size());
+    for (size_t i = 0; i < key_positions.size(); ++i) key[i] = tuple[key_positions[i]];
+    ++counts[key];
+}
+
+void SemiJoinIndexes::Index::remove(TupleView tuple, vector<int> &key) {
+    if (!selects(tuple)) return;
+    key.resize(key_positions.size());
+    for (size_t i = 0; i < key_positions.size(); ++i) key[i] = tuple[key_positions[i]];
+    auto it = counts.find(key);
+    assert(it != counts.end());
+    if (--it->second == 0) counts.erase(it);
+}
+
+SemiJoinIndexes::SemiJoinIndexes(const Task &task,
+                                 const vector<PrecompiledActionData> &action_data,
+                                 const vector<vector<pair<int, int>>> &full_reducer_order)
+    : steps(action_data.size()),
+      fluent_predicates(action_data.size()),
+      fluent_indexes(task.predicates.size()),
+      indexed_tuples(task.predicates.size()),
+      num_probed_semi_joins(0),
+      num_computed_semi_joins(0),
+      num_index_updates(0)
+{
+    for (size_t schema = 0; schema < action_data.size(); ++schema) {
+        const PrecompiledActionData &adata = action_data[schema];
+        if (adata.is_ground or adata.statically_inapplicable) continue;
+
+        for (const pair<int, int> &sj : full_reducer_order[schema]) {
+            int source = sj.first, target = sj.second;
+            vector<int> source_columns, target_columns;
+            compute_matching_columns(adata.precondition_indices[source],
+                                     adata.precondition_indices[target],
+                                     source_columns, target_columns);
+            if (source_columns.empty()) {
+                steps[schema].push_back({source, target, -1, {}});
+                continue;
+            }
+
+            const Atom &atom = adata.relevant_precondition_atoms[source];
+            Index index;
+            index.predicate = atom.get_predicate_symbol_idx();
+            for (int c : adata.precondition_constants[source])
+                index.constants.emplace_back(c, atom.get_arguments()[c].get_index());
+            index.inequalities = adata.base_table_inequalities[source];
+            index.key_positions = source_columns;
+
+            bool is_fluent = find(adata.fluent_tables.begin(), adata.fluent_tables.end(),
+                                  unsigned(source)) != adata.fluent_tables.end();
+            if (!is_fluent) {
+                // The precompiled table already contains exactly the selected atoms
+                for (const vector<int> &tuple : adata.precompiled_db[source].tuples)
+                    index.add(tuple, key_buffer);
+            }
+            int predicate = index.predicate;
+            int i = get_index(std::move(index));
+            if (is_fluent) {
+                vector<int> &on_predicate = fluent_indexes[predicate];
+                if (find(on_predicate.begin(), on_predicate.end(), i) == on_predicate.end())
+                    on_predicate.push_back(i);
+                vector<int> &of_schema = fluent_predicates[schema];
+                if (find(of_schema.begin(), of_schema.end(), predicate) == of_schema.end())
+                    of_schema.push_back(predicate);
+            }
+            steps[schema].push_back({source, target, i, std::move(target_columns)});
+        }
+    }
+}
+
+int SemiJoinIndexes::get_index(Index &&index) {
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        const Index &other = indexes[i];
+        if (other.predicate == index.predicate and other.constants == index.constants and
+            other.inequalities == index.inequalities and other.key_positions == index.key_positions)
+            return i;
+    }
+    indexes.push_back(std::move(index));
+    return indexes.size() - 1;
+}
+
+/*
+ * Bring the indexes on the predicate from indexed_tuples[predicate] to
+ * `tuples`. Both are sorted, so the added and deleted atoms are obtained by
+ * merging them.
+ */
+void SemiJoinIndexes::update(int predicate, const FlatTupleSet &tuples) {
+    const FlatTupleSet &old_tuples = indexed_tuples[predicate];
+    auto apply = [&](TupleView tuple, bool added) {
+        for (int i : fluent_indexes[predicate]) {
+            if (added)
+                indexes[i].add(tuple, key_buffer);
+            else
+                indexes[i].remove(tuple, key_buffer);
+        }
+        ++num_index_updates;
+    };
+
+    size_t i = 0, j = 0;
+    while (i < old_tuples.size() or j < tuples.size()) {
+        if (j == tuples.size()) {
+            apply(old_tuples[i++], false);
+            continue;
+        }
+        if (i == old_tuples.size()) {
+            apply(tuples[j++], true);
+            continue;
+        }
+        TupleView t1 = old_tuples[i], t2 = tuples[j];
+        if (t1 == t2) {
+            ++i;
+            ++j;
+        }
+        else if (lexicographical_compare(t1.begin(), t1.end(), t2.begin(), t2.end())) {
+            apply(t1, false);
+            ++i;
+        }
+        else {
+            apply(t2, true);
+            ++j;
+        }
+    }
+    indexed_tuples[predicate] = tuples;
+}
+
+/*
+ * Keep the tuples of `table` whose values at `columns` are a key of the index,
+ * in their original order (as semi_join does).
+ */
+size_t SemiJoinIndexes::probe(const Index &index, const vector<int> &columns, Table &table) {
+    auto &tuples = table.tuples;
+    key_buffer.resize(columns.size());
+    size_t kept = 0;
+    for (size_t i = 0; i < tuples.size(); ++i) {
+        for (size_t k = 0; k < columns.size(); ++k) key_buffer[k] = tuples[i][columns[k]];
+        if (index.counts.find(key_buffer) != index.counts.end()) {
+            if (kept != i)
+                tuples[kept] = std::move(tuples[i]);
+            ++kept;
+        }
+    }
+    tuples.resize(kept);
+    return kept;
+}
+
+bool SemiJoinIndexes::full_reduce(int schema, const DBState &state, vector<Table> &tables) {
+    const auto &relations = state.get_relations();
+    for (int predicate : fluent_predicates[schema]) {
+        if (!(relations[predicate].tuples == indexed_tuples[predicate]))
+            update(predicate, relations[predicate].tuples);
+    }
+
+    vector<bool> reduced(tables.size(), false);
+    for (const Step &step : steps[schema]) {
+        if (step.index == -1) continue;
+        int source = step.source, target = step.target;
+        size_t size_before = tables[target].tuples.size();
+        size_t size_after;
+        if (!reduced[source]) {
+            size_after = probe(indexes[step.index], step.probe_columns, tables[target]);
+            ++num_probed_semi_joins;
+        }
+        else {
+            size_after = semi_join(tables[target], tables[source]);
+            ++num_computed_semi_joins;
+        }
+        if (size_after == 0) return false;
+        if (size_after != size_before) reduced[target] = true;
+    }
+    return true;
+}
+
+void SemiJoinIndexes::print_statistics() const {
+    size_t num_keys = 0;
+    for (const Index &index : indexes) num_keys += index.counts.size();
+    cout << "Semi-join indexes: " << indexes.size() << " (" << num_keys << " keys)" << endl;
+    cout << "Semi-joins answered by an index: " << num_probed_semi_joins << endl;
+    cout << "Semi-joins computed from the tables: " << num_computed_semi_joins << endl;
+    cout << "Atoms added to or deleted from the indexed relations: " << num_index_updates << endl;
+}
@@ -0,0 +1,109 @@
+#ifndef SEARCH_SEMI_JOIN_INDEXES_H
+#define SEARCH_SEMI_JOIN_INDEXES_H
+
+#include "../flat_tuple_set.h"
+#include "../hash_structures.h"
+
+#include "../parallel_hashmap/phmap.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class DBState;
+class PrecompiledActionData;
+class Table;
+class Task;
+
+/**
+ * @brief Persistent hash indexes for the semi-joins of the full reducer.
+ *
+ * @details In the full reducer program, a step (s, t) removes from table t the
+ * tuples that have no partner in table s. As long as table s has not been
+ * reduced by an earlier step, it contains exactly the atoms of its relation that
+ * match the constants and the inequalities within the precondition. This class
+ * keeps, for each such step, a hash index that counts those atoms by their values
+ * at the columns shared with t. The index then replaces the semi-join with
+ * one probe per tuple of t, without reading table s.
+ *
+ * Indexes on static relations are built once. Indexes on fluent relations
+ * describe the last state seen. When a new state arrives, we diff each
+ * indexed relation against that copy. Both are sorted, so this is a single
+ * merge, and only the added and deleted atoms update the counts. Successive
+ * calls usually come from closely related states (e.g., the children of the
+ * same parent), so these updates are small. Steps with the same relation,
+ * selection and key columns share an index.
+ *
+ * If table s has already been reduced, we compute the semi-join from the tables
+ * as usual. The result of full_reduce is always exactly that of the
+ * original full reducer program.
+ *
+ * @see yannakakis.cc
+ * @see full_reducer_successor_generator.cc
+ */
+class SemiJoinIndexes {
+    struct Index {
+        int predicate;
+        //! (position, object) of the constant arguments of the precondition
+        std::vector<std::pair<int, int>> constants;
+        //! Positions that must hold different objects
+        std::vector<std::pair<int, int>> inequalities;
+        //! Positions of the key in the tuples of the relation
+        std::vector<int> key_positions;
+        //! Number of atoms of the relation with each key
+        phmap::flat_hash_map<std::vector<int>, int, TupleHash> counts;
+
+        bool selects(TupleView tuple) const;
+        void add(TupleView tuple, std::vector<int> &key);
+        void remove(TupleView tuple, std::vector<int> &key);
+    };
+
+    struct Step {
+        int source;
+        int target;
+        //! Index of the source table, or -1 if the tables share no columns
+        int index;
+        //! Columns of the target table matching the key of the index
+        std::vector<int> probe_columns;
+    };
+
+    std::vector<Index> indexes;
+    //! steps[schema][i]: i-th step of the full reducer program of the schema
+    std::vector<std::vector<Step>> steps;
+
+    //! Fluent predicates with some index used by each schema
+    std::vector<std::vector<int>> fluent_predicates;
+
+    //! Indexes on each fluent predicate and the tuples they describe
+    std::vector<std::vector<int>> fluent_indexes;
+    std::vector<FlatTupleSet> indexed_tuples;
+
+    std::vector<int> key_buffer;
+
+    std::size_t num_probed_semi_joins;
+    std::size_t num_computed_semi_joins;
+    std::size_t num_index_updates;
+
+    int get_index(Index &&index);
+    void update(int predicate, const FlatTupleSet &tuples);
+    std::size_t probe(const Index &index, const std::vector<int> &columns, Table &table);
+
+public:
+    /**
+     * @param full_reducer_order Semi-join steps of each schema as (source, target) pairs
+     */
+    SemiJoinIndexes(const Task &task,
+                    const std::vector<PrecompiledActionData> &action_data,
+                    const std::vector<std::vector<std::pair<int, int>>> &full_reducer_order);
+
+    /**
+     * Run the full reducer program of the schema on the tables of the state.
+     *
+     * @return false if some table becomes empty.
+     */
+    bool full_reduce(int schema, const DBState &state, std::vector<Table> &tables);
+
+    void print_statistics() const;
+};
+
+#endif //SEARCH_SEMI_JOIN_INDEXES_H
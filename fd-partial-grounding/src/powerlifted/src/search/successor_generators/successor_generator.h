@@ -1,12 +1,14 @@
 #ifndef SEARCH_SUCCESSOR_GENERATOR_H
 #define SEARCH_SUCCESSOR_GENERATOR_H
 
+#include <ostream>
 #include <vector>
 
 // A few forward declarations :-)
 class ActionSchema;
 class DBState;
 class LiftedOperatorId;
+class Task;
 
 typedef DBState StaticInformation;
 
@@ -52,6 +54,13 @@ public:
         return added_atoms;
     }
 
+    /**
+     * Print the precompiled join program of each action schema, if any. For debugging.
+     */
+    virtual void dump_join_plans(const Task &, std::ostream &) const {}
+
+    virtual void print_statistics() const {}
+
 };
 
 #endif //SEARCH_SUCCESSOR_GENERATOR_H
@@ -1,12 +1,17 @@
 
 #include "successor_generator_factory.h"
 
+#include "adaptive_join_successor.h"
+#include "delta_join_successor.h"
+#include "flat_join_successor.h"
 #include "full_reducer_successor_generator.h"
 #include "naive_successor.h"
 #include "ordered_join_successor.h"
 #include "random_successor.h"
 #include "yannakakis.h"
 
+#include "../options.h"
+
 #include "../database/table.h"
 
 #include <iostream>
@@ -14,16 +19,29 @@
 #include <boost/algorithm/string.hpp>
 
 SuccessorGenerator *SuccessorGeneratorFactory::create(const std::string &method,
-                                                      unsigned seed,
-                                                      Task &task)
+                                                      const Options &opt,
+                                                      const Task &task)
 {
     std::cout << "Creating successor generator factory..." << std::endl;
     if (boost::iequals(method, "join")) {
         return new NaiveSuccessorGenerator(task);
     }
+    else if (boost::iequals(method, "adaptive_join")) {
+        return new AdaptiveJoinSuccessorGenerator(task);
+    }
+    else if (boost::iequals(method, "delta_join")) {
+        return new DeltaJoinSuccessorGenerator(
+            task, std::size_t(opt.get_delta_join_cache_size()) * 1024 * 1024);
+    }
+    else if (boost::iequals(method, "flat_join")) {
+        return new FlatJoinSuccessorGenerator(task);
+    }
     else if (boost::iequals(method, "full_reducer")) {
         return new FullReducerSuccessorGenerator(task);
     }
+    else if (boost::iequals(method, "full_reducer_indexed")) {
+        return new FullReducerSuccessorGenerator(task, true);
+    }
     else if (boost::iequals(method, "inverse_ordered_join")) {
         return new OrderedJoinSuccessorGenerator<InverseOrderTable>(task);
     }
@@ -31,11 +49,14 @@ SuccessorGenerator *SuccessorGeneratorFactory::create(const std::string &method,
         return new OrderedJoinSuccessorGenerator<OrderTable>(task);
     }
     else if (boost::iequals(method, "random_join")) {
-        return new RandomSuccessorGenerator(task, seed);
+        return new RandomSuccessorGenerator(task, opt.get_seed());
     }
     else if (boost::iequals(method, "yannakakis")) {
         return new YannakakisSuccessorGenerator(task);
     }
+    else if (boost::iequals(method, "yannakakis_indexed")) {
+        return new YannakakisSuccessorGenerator(task, true);
+    }
     else {
         std::cerr << "Invalid successor generator method \"" << method << "\"" << std::endl;
         exit(-1);
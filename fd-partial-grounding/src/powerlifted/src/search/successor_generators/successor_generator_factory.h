@@ -3,14 +3,15 @@
 
 #include <string>
 
+class Options;
 class Task;
 class SuccessorGenerator;
 
 class SuccessorGeneratorFactory {
 public:
     static SuccessorGenerator *create(const std::string &method,
-                                      unsigned seed,
-                                      Task &task);
+                                      const Options &opt,
+                                      const Task &task);
 };
 
 
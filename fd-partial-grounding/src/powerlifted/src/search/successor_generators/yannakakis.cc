@@ -26,7 +26,8 @@ using namespace std;
  *
  * @param task
  */
-YannakakisSuccessorGenerator::YannakakisSuccessorGenerator(const Task &task)
+YannakakisSuccessorGenerator::YannakakisSuccessorGenerator(const Task &task,
+                                                           bool use_semi_join_indexes)
     : GenericJoinSuccessor(task) {
     /*
       * Apply GYO algorithm for every action schema to check whether it has acyclic precondition/
@@ -163,6 +164,9 @@ YannakakisSuccessorGenerator::YannakakisSuccessorGenerator(const Task &task)
         }
     }
 
+    if (use_semi_join_indexes) {
+        semi_join_indexes = make_unique<SemiJoinIndexes>(task, action_data, full_reducer_order);
+    }
 }
 
 void YannakakisSuccessorGenerator::get_distinguished_variables(const ActionSchema &action) {
@@ -217,12 +221,19 @@ Table YannakakisSuccessorGenerator::instantiate(const ActionSchema &action,
     assert (!tables.empty());
     assert(tables.size() == actiondata.relevant_precondition_atoms.size());
 
-    for (const pair<int, int> &sj : full_reducer_order[action.get_index()]) {
-        size_t s = semi_join(tables[sj.second], tables[sj.first]);
-        if (s==0) {
+    if (semi_join_indexes) {
+        if (!semi_join_indexes->full_reduce(action.get_index(), state, tables)) {
             return Table::EMPTY_TABLE();
         }
     }
+    else {
+        for (const pair<int, int> &sj : full_reducer_order[action.get_index()]) {
+            size_t s = semi_join(tables[sj.second], tables[sj.first]);
+            if (s==0) {
+                return Table::EMPTY_TABLE();
+            }
+        }
+    }
 
     const JoinTree &jt = join_trees[action.get_index()];
 
@@ -260,3 +271,14 @@ Table YannakakisSuccessorGenerator::instantiate(const ActionSchema &action,
     project(working_table, distinguished_variables[action.get_index()]);
     return working_table;
 }
+
+const JoinPlan &YannakakisSuccessorGenerator::get_join_plan(int) const
+{
+    // The joins follow the join tree, not a left-deep plan
+    static const JoinPlan no_plan;
+    return no_plan;
+}
+
+void YannakakisSuccessorGenerator::print_statistics() const {
+    if (semi_join_indexes) semi_join_indexes->print_statistics();
+}
@@ -2,6 +2,10 @@
 #define SEARCH_YANNAKAKIS_H
 
 #include "generic_join_successor.h"
+#include "semi_join_indexes.h"
+
+#include <memory>
+#include <unordered_set>
 
 class JoinTree;
 
@@ -10,11 +14,17 @@ class YannakakisSuccessorGenerator : public GenericJoinSuccessor {
   /**
  * @see yannakakis.cc
  * @param task
+ * @param use_semi_join_indexes Run the full reducer with persistent
+ * SemiJoinIndexes instead of semi-joins computed from scratch
  */
-  explicit YannakakisSuccessorGenerator(const Task &task);
+  explicit YannakakisSuccessorGenerator(const Task &task, bool use_semi_join_indexes = false);
   Table instantiate(const ActionSchema &action,
                     const DBState &state) final;
 
+  const JoinPlan &get_join_plan(int action_schema) const override;
+
+  void print_statistics() const override;
+
  private:
   std::vector<std::vector<std::pair<int, int>>> full_reducer_order;
 
@@ -24,6 +34,8 @@ class YannakakisSuccessorGenerator : public GenericJoinSuccessor {
 
   std::vector<JoinTree> join_trees;
 
+  std::unique_ptr<SemiJoinIndexes> semi_join_indexes;
+
   void get_distinguished_variables(const ActionSchema &action);
 };
 
@@ -51,8 +51,7 @@ void Task::dump_state(DBState s) const
     const auto& relations = s.get_relations();
     for (size_t i = 0; i < relations.size(); ++i) {
         string relation_name = predicates[i].get_name();
-        unordered_set<GroundAtom, TupleHash> tuples = relations[i].tuples;
-        for (auto &tuple : tuples) {
+        for (TupleView tuple : relations[i].tuples) {
             cout << relation_name << "(";
             for (auto obj : tuple) {
                 cout << objects[obj].get_name() << ",";
@@ -136,7 +135,7 @@ bool Task::is_trivially_unsolvable() const
      */
     for (const AtomicGoal &atomicGoal : goal.goal) {
         int goal_predicate = atomicGoal.get_predicate_index();
-        Relation relation_at_goal_predicate = static_info.get_relations()[goal_predicate];
+        const Relation &relation_at_goal_predicate = static_info.get_relations()[goal_predicate];
         if (!predicates[relation_at_goal_predicate.predicate_symbol].isStaticPredicate())
             continue;
         assert(goal_predicate == relation_at_goal_predicate.predicate_symbol);
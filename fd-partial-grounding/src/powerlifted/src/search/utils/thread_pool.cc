@@ -0,0 +1,87 @@
+#include "thread_pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : task(nullptr), num_tasks(0), next_task(0), batch_id(0),
+      running_workers(0), round_robin(false), shutting_down(false)
+{
+    assert(num_threads >= 1);
+    for (int i = 1; i < num_threads; ++i) {
+        threads.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        shutting_down = true;
+    }
+    start_batch.notify_all();
+    for (thread &t : threads) {
+        t.join();
+    }
+}
+
+void ThreadPool::work(int worker) {
+    if (round_robin) {
+        for (size_t i = worker; i < num_tasks; i += threads.size() + 1) {
+            (*task)(worker, i);
+        }
+        return;
+    }
+    for (size_t i = next_task++; i < num_tasks; i = next_task++) {
+        (*task)(worker, i);
+    }
+}
+
+void ThreadPool::worker_loop(int worker) {
+    size_t last_batch = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(pool_mutex);
+            start_batch.wait(lock, [&] { return shutting_down or batch_id != last_batch; });
+            if (shutting_down) return;
+            last_batch = batch_id;
+        }
+        work(worker);
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            if (--running_workers == 0)
+                batch_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run(size_t n, const function<void(int, size_t)> &f) {
+    run_batch(n, f, false);
+}
+
+void ThreadPool::run_round_robin(size_t n, const function<void(int, size_t)> &f) {
+    run_batch(n, f, true);
+}
+
+void ThreadPool::run_batch(size_t n, const function<void(int, size_t)> &f, bool round_robin) {
+    if (threads.empty() or n <= 1) {
+        for (size_t i = 0; i < n; ++i) f(0, i);
+        return;
+    }
+    {
+        lock_guard<mutex> lock(pool_mutex);
+        task = &f;
+        num_tasks = n;
+        next_task = 0;
+        this->round_robin = round_robin;
+        running_workers = threads.size();
+        ++batch_id;
+    }
+    start_batch.notify_all();
+    work(0);
+    unique_lock<mutex> lock(pool_mutex);
+    batch_done.wait(lock, [&] { return running_workers == 0; });
+    task = nullptr;
+}
+}
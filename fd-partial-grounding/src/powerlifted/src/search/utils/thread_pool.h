@@ -0,0 +1,65 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/**
+ * @brief Fixed set of worker threads that run batches of independent tasks.
+ *
+ * @details run(n, f) calls f(worker, i) once for every i in [0, n) and returns
+ * when all calls have finished. The calling thread takes part as worker 0, so a
+ * pool with a single thread spawns no threads at all. Idle workers grab the next
+ * unclaimed task from a shared atomic counter, so workers that get cheap tasks
+ * keep taking work from the slow ones until the batch is exhausted.
+ *
+ * run_round_robin(n, f) gives task i to worker i mod T instead, where T is the
+ * number of threads, and every worker runs its tasks in increasing order. Which
+ * worker runs each task, and in which order, then depends only on n and T, so
+ * callers with stateful per-worker objects get reproducible results.
+ *
+ * The worker index lets callers keep per-worker state (heuristics, successor
+ * generators, scratch memory) without any locking.
+ */
+class ThreadPool {
+    std::vector<std::thread> threads;
+
+    std::mutex pool_mutex;
+    std::condition_variable start_batch;
+    std::condition_variable batch_done;
+
+    const std::function<void(int, std::size_t)> *task;
+    std::size_t num_tasks;
+    std::atomic<std::size_t> next_task;
+    std::size_t batch_id;
+    int running_workers;
+    bool round_robin;
+    bool shutting_down;
+
+    void work(int worker);
+    void worker_loop(int worker);
+    void run_batch(std::size_t n, const std::function<void(int, std::size_t)> &f, bool round_robin);
+
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const {
+        return threads.size() + 1;
+    }
+
+    void run(std::size_t n, const std::function<void(int, std::size_t)> &f);
+    void run_round_robin(std::size_t n, const std::function<void(int, std::size_t)> &f);
+};
+}
+
+#endif
@@ -1,7 +1,10 @@
+#include "binary_task_writer.h"
 #include "helper_functions.h"
 #include "axiom.h"
 #include "variable.h"
 
+#include "../search/tasks/binary_task_format.h"
+
 #include <iostream>
 #include <fstream>
 #include <cassert>
@@ -24,6 +27,21 @@ Axiom::Axiom(istream &in, const vector<Variable *> &variables) {
     check_magic(in, "end_rule");
 }
 
+Axiom::Axiom(const binary_task_format::TaskView &task, int index,
+             const vector<Variable *> &variables) {
+    // Axioms have a single effect, whose conditions are the conditions of the rule.
+    int eff = task.get_effect_offsets()[index];
+    const int32_t *effect = task.get_effects() + 3 * eff;
+    const int32_t *condition_offsets = task.get_effect_condition_offsets();
+    const int32_t *effect_conditions = task.get_effect_conditions();
+    for (int i = condition_offsets[eff]; i < condition_offsets[eff + 1]; ++i)
+        conditions.push_back(Condition(variables[effect_conditions[2 * i]],
+                                       effect_conditions[2 * i + 1]));
+    effect_var = variables[effect[0]];
+    old_val = effect[1];
+    effect_val = effect[2];
+}
+
 bool Axiom::is_redundant() const {
     return effect_var->get_level() == -1;
 }
@@ -53,7 +71,7 @@ int Axiom::get_encoding_size() const {
     return 1 + conditions.size();
 }
 
-void Axiom::generate_cpp_input(ofstream &outfile) const {
+void Axiom::generate_cpp_input(ostream &outfile) const {
     assert(effect_var->get_level() != -1);
     outfile << "begin_rule" << endl;
     outfile << conditions.size() << endl;
@@ -64,3 +82,13 @@ void Axiom::generate_cpp_input(ofstream &outfile) const {
     outfile << effect_var->get_level() << " " << old_val << " " << effect_val << endl;
     outfile << "end_rule" << endl;
 }
+
+void Axiom::generate_binary_input(BinaryTaskWriter &writer) const {
+    assert(effect_var->get_level() != -1);
+    for (const Condition &condition : conditions) {
+        assert(condition.var->get_level() != -1);
+        writer.add_effect_condition(condition.var->get_level(), condition.cond);
+    }
+    writer.add_effect(effect_var->get_level(), old_val, effect_val);
+    writer.finish_axiom();
+}
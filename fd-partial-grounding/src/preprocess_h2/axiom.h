@@ -7,7 +7,11 @@
 #include <vector>
 using namespace std;
 
+class BinaryTaskWriter;
 class Variable;
+namespace binary_task_format {
+class TaskView;
+}
 
 class Axiom {
 public:
@@ -23,11 +27,15 @@ private:
     vector<Condition> conditions;    // var, val
 public:
     Axiom(istream &in, const vector<Variable *> &variables);
+    // The index of the first axiom is the number of operators.
+    Axiom(const binary_task_format::TaskView &task, int index,
+          const vector<Variable *> &variables);
 
     bool is_redundant() const;
     void dump() const;
     int get_encoding_size() const;
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(ostream &outfile) const;
+    void generate_binary_input(BinaryTaskWriter &writer) const;
     const vector<Condition> &get_conditions() const {return conditions; }
     Variable *get_effect_var() const {return effect_var; }
     int get_old_val() const {return old_val; }
@@ -0,0 +1,308 @@
+#include "binary_task_writer.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+using namespace binary_task_format;
+
+namespace {
+struct InputError {
+    string message;
+};
+
+class TextTaskReader {
+    istream &in;
+public:
+    explicit TextTaskReader(istream &in) : in(in) {}
+
+    void check_magic(const string &magic) {
+        string word;
+        in >> word;
+        if (word != magic)
+            throw InputError {"expected '" + magic + "', got '" + word + "'"};
+    }
+
+    int read_int() {
+        int value;
+        if (!(in >> value))
+            throw InputError {"expected a number"};
+        return value;
+    }
+
+    string read_line() {
+        string line;
+        in >> ws;
+        getline(in, line);
+        return line;
+    }
+
+    string read_word() {
+        string word;
+        in >> word;
+        return word;
+    }
+};
+
+int32_t check_size(size_t size) {
+    if (size > static_cast<size_t>(numeric_limits<int32_t>::max()))
+        throw length_error("task too large for the binary format");
+    return size;
+}
+
+struct SectionData {
+    const char *data;
+    size_t size;
+};
+
+template<typename T>
+SectionData get_data(const vector<T> &elements) {
+    return {reinterpret_cast<const char *>(elements.data()), elements.size() * sizeof(T)};
+}
+
+// Conditions, var, pre, post as in the text format.
+void read_effect(TextTaskReader &reader, BinaryTaskWriter &writer) {
+    int num_conditions = reader.read_int();
+    for (int i = 0; i < num_conditions; ++i) {
+        int var = reader.read_int();
+        int value = reader.read_int();
+        writer.add_effect_condition(var, value);
+    }
+    int var = reader.read_int();
+    int pre = reader.read_int();
+    int post = reader.read_int();
+    writer.add_effect(var, pre, post);
+}
+
+void read_text_task(istream &in, BinaryTaskWriter &writer) {
+    TextTaskReader reader(in);
+    reader.check_magic("begin_version");
+    int version = reader.read_int();
+    if (version != SAS_FILE_VERSION)
+        throw InputError {"expected translator file version " +
+                          to_string(SAS_FILE_VERSION) + ", got " + to_string(version)};
+    reader.check_magic("end_version");
+    reader.check_magic("begin_metric");
+    writer.set_metric(reader.read_int());
+    reader.check_magic("end_metric");
+
+    int num_variables = reader.read_int();
+    for (int var = 0; var < num_variables; ++var) {
+        reader.check_magic("begin_variable");
+        string name = reader.read_word();
+        int axiom_layer = reader.read_int();
+        writer.add_variable(name, axiom_layer);
+        int domain_size = reader.read_int();
+        for (int value = 0; value < domain_size; ++value)
+            writer.add_fact(reader.read_line());
+        reader.check_magic("end_variable");
+    }
+
+    int num_mutex_groups = reader.read_int();
+    for (int i = 0; i < num_mutex_groups; ++i) {
+        reader.check_magic("begin_mutex_group");
+        int num_facts = reader.read_int();
+        for (int j = 0; j < num_facts; ++j) {
+            int var = reader.read_int();
+            int value = reader.read_int();
+            writer.add_mutex_fact(var, value);
+        }
+        writer.finish_mutex_group();
+        reader.check_magic("end_mutex_group");
+    }
+
+    reader.check_magic("begin_state");
+    for (int var = 0; var < num_variables; ++var)
+        writer.add_initial_value(reader.read_int());
+    reader.check_magic("end_state");
+
+    reader.check_magic("begin_goal");
+    int num_goals = reader.read_int();
+    for (int i = 0; i < num_goals; ++i) {
+        int var = reader.read_int();
+        int value = reader.read_int();
+        writer.add_goal(var, value);
+    }
+    reader.check_magic("end_goal");
+
+    int num_operators = reader.read_int();
+    for (int op = 0; op < num_operators; ++op) {
+        reader.check_magic("begin_operator");
+        writer.add_operator(reader.read_line());
+        int num_prevail = reader.read_int();
+        for (int i = 0; i < num_prevail; ++i) {
+            int var = reader.read_int();
+            int value = reader.read_int();
+            writer.add_precondition(var, value);
+        }
+        int num_effects = reader.read_int();
+        for (int eff = 0; eff < num_effects; ++eff)
+            read_effect(reader, writer);
+        writer.finish_operator(reader.read_int());
+        reader.check_magic("end_operator");
+    }
+
+    int num_axioms = reader.read_int();
+    for (int axiom = 0; axiom < num_axioms; ++axiom) {
+        reader.check_magic("begin_rule");
+        read_effect(reader, writer);
+        writer.finish_axiom();
+        reader.check_magic("end_rule");
+    }
+}
+}
+
+BinaryTaskWriter::BinaryTaskWriter() {
+    header = Header();
+    mutex_group_offsets.push_back(0);
+    precondition_offsets.push_back(0);
+    effect_offsets.push_back(0);
+    effect_condition_offsets.push_back(0);
+}
+
+void BinaryTaskWriter::set_metric(bool use_metric) {
+    header.use_metric = use_metric;
+}
+
+void BinaryTaskWriter::add_variable(const string &name, int axiom_layer) {
+    variable_names.push_back(name);
+    variables.push_back(0);
+    variables.push_back(axiom_layer);
+    variables.push_back(check_size(fact_names.size()));
+}
+
+void BinaryTaskWriter::add_fact(const string &name) {
+    fact_names.push_back(name);
+    ++variables[variables.size() - 3];
+}
+
+void BinaryTaskWriter::add_mutex_fact(int var, int value) {
+    mutex_facts.push_back(var);
+    mutex_facts.push_back(value);
+}
+
+void BinaryTaskWriter::finish_mutex_group() {
+    mutex_group_offsets.push_back(check_size(mutex_facts.size() / 2));
+}
+
+void BinaryTaskWriter::add_initial_value(int value) {
+    initial_state.push_back(value);
+}
+
+void BinaryTaskWriter::add_goal(int var, int value) {
+    goals.push_back(var);
+    goals.push_back(value);
+}
+
+void BinaryTaskWriter::add_operator(const string &name) {
+    operator_names.push_back(name);
+}
+
+void BinaryTaskWriter::add_precondition(int var, int value) {
+    preconditions.push_back(var);
+    preconditions.push_back(value);
+}
+
+void BinaryTaskWriter::add_effect_condition(int var, int value) {
+    effect_conditions.push_back(var);
+    effect_conditions.push_back(value);
+}
+
+void BinaryTaskWriter::add_effect(int var, int pre, int post) {
+    effect_condition_offsets.push_back(check_size(effect_conditions.size() / 2));
+    if (pre != -1)
+        add_precondition(var, pre);
+    effects.push_back(var);
+    effects.push_back(pre);
+    effects.push_back(post);
+}
+
+void BinaryTaskWriter::finish_action(int cost) {
+    costs.push_back(cost);
+    precondition_offsets.push_back(check_size(preconditions.size() / 2));
+    effect_offsets.push_back(check_size(effects.size() / 3));
+}
+
+void BinaryTaskWriter::finish_operator(int cost) {
+    ++header.num_operators;
+    finish_action(cost);
+}
+
+void BinaryTaskWriter::finish_axiom() {
+    ++header.num_axioms;
+    finish_action(0);
+}
+
+void BinaryTaskWriter::write(ostream &out) {
+    vector<int64_t> string_offsets;
+    string string_data;
+    string_offsets.push_back(0);
+    for (const vector<string> *names : {&variable_names, &fact_names, &operator_names}) {
+        for (const string &name : *names) {
+            string_data += name;
+            string_offsets.push_back(string_data.size());
+        }
+    }
+
+    header.num_variables = check_size(variable_names.size());
+    header.num_facts = check_size(fact_names.size());
+    header.num_goals = check_size(goals.size() / 2);
+    header.num_mutex_groups = check_size(mutex_group_offsets.size() - 1);
+    header.num_effects = check_size(effects.size() / 3);
+
+    SectionData sections[NUM_SECTIONS];
+    sections[STRING_OFFSETS] = get_data(string_offsets);
+    sections[STRING_DATA] = {string_data.data(), string_data.size()};
+    sections[VARIABLES] = get_data(variables);
+    sections[INITIAL_STATE] = get_data(initial_state);
+    sections[GOALS] = get_data(goals);
+    sections[MUTEX_GROUP_OFFSETS] = get_data(mutex_group_offsets);
+    sections[MUTEX_FACTS] = get_data(mutex_facts);
+    sections[COSTS] = get_data(costs);
+    sections[PRECONDITION_OFFSETS] = get_data(precondition_offsets);
+    sections[PRECONDITIONS] = get_data(preconditions);
+    sections[EFFECT_OFFSETS] = get_data(effect_offsets);
+    sections[EFFECTS] = get_data(effects);
+    sections[EFFECT_CONDITION_OFFSETS] = get_data(effect_condition_offsets);
+    sections[EFFECT_CONDITIONS] = get_data(effect_conditions);
+
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    uint64_t position = sizeof(Header);
+    for (int i = 0; i < NUM_SECTIONS; ++i) {
+        position = (position + 7) / 8 * 8;
+        header.sections[i].offset = position;
+        header.sections[i].size = sections[i].size;
+        position += sections[i].size;
+    }
+    header.file_size = position;
+
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    position = sizeof(Header);
+    for (int i = 0; i < NUM_SECTIONS; ++i) {
+        out.write(zeros, header.sections[i].offset - position);
+        out.write(sections[i].data, sections[i].size);
+        position = header.sections[i].offset + sections[i].size;
+    }
+}
+
+bool convert_to_binary_task(istream &in, ostream &out, string &error) {
+    BinaryTaskWriter writer;
+    try {
+        read_text_task(in, writer);
+        writer.write(out);
+    } catch (const InputError &input_error) {
+        error = input_error.message;
+        return false;
+    } catch (const length_error &too_large) {
+        error = too_large.what();
+        return false;
+    }
+    if (!out) {
+        error = "could not write the binary task";
+        return false;
+    }
+    return true;
+}
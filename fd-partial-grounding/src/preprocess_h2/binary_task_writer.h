@@ -0,0 +1,72 @@
+#ifndef BINARY_TASK_WRITER_H
+#define BINARY_TASK_WRITER_H
+
+#include "../search/tasks/binary_task_format.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+  Collects a task in the binary format (see search/tasks/binary_task_format.h)
+  and writes it to a stream. The parts of the task must be added in the order
+  of the text format: variables, mutex groups, initial state, goal, operators
+  and axioms. Within an operator, the prevail conditions must be added before
+  the effects.
+*/
+class BinaryTaskWriter {
+    binary_task_format::Header header;
+    std::vector<std::string> variable_names;
+    std::vector<std::string> fact_names;
+    std::vector<std::string> operator_names;
+    std::vector<int32_t> variables;
+    std::vector<int32_t> initial_state;
+    std::vector<int32_t> goals;
+    std::vector<int32_t> mutex_group_offsets;
+    std::vector<int32_t> mutex_facts;
+    std::vector<int32_t> costs;
+    std::vector<int32_t> precondition_offsets;
+    std::vector<int32_t> preconditions;
+    std::vector<int32_t> effect_offsets;
+    std::vector<int32_t> effects;
+    std::vector<int32_t> effect_condition_offsets;
+    std::vector<int32_t> effect_conditions;
+
+    void finish_action(int cost);
+public:
+    BinaryTaskWriter();
+
+    void set_metric(bool use_metric);
+
+    void add_variable(const std::string &name, int axiom_layer);
+    // Adds a value to the last variable.
+    void add_fact(const std::string &name);
+
+    void add_mutex_fact(int var, int value);
+    void finish_mutex_group();
+
+    void add_initial_value(int value);
+    void add_goal(int var, int value);
+
+    void add_operator(const std::string &name);
+    void add_precondition(int var, int value);
+    void add_effect_condition(int var, int value);
+    // Adds an effect with the effect conditions added since the last effect.
+    void add_effect(int var, int pre, int post);
+    void finish_operator(int cost);
+
+    // An axiom is a single effect whose effect conditions are the body.
+    void finish_axiom();
+
+    // Throws std::length_error if the task does not fit into the format.
+    void write(std::ostream &out);
+};
+
+/*
+  Convert a task in the text format (output.sas) into the binary format.
+  Returns false and sets error if the input is not a valid text task.
+*/
+bool convert_to_binary_task(std::istream &in, std::ostream &out, std::string &error);
+
+#endif
@@ -5,38 +5,126 @@
 //#include "utilities.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iterator>
+#include <thread>
 #include <vector>
 #include <set>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 using namespace std;
 
-Op_h2::Op_h2(const Operator &op,
-             const vector< vector<unsigned>> &p_index,
-             const vector<vector<set<pair<int, int>>>> &inconsistent_facts,
-             bool regression) {
+// Index of the lowest set bit of a non-zero word
+static inline unsigned lowest_bit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Calls f(worker, i) for every i in [0, n), spread over num_threads threads
+static void parallel_for(int num_threads, size_t n, const function<void(int, size_t)> &f) {
+    if (num_threads <= 1 || n <= 1) {
+        for (size_t i = 0; i < n; i++)
+            f(0, i);
+        return;
+    }
+    atomic<size_t> next_task(0);
+    auto work = [&](int worker) {
+        for (size_t i = next_task++; i < n; i = next_task++)
+            f(worker, i);
+    };
+    vector<thread> threads;
+    for (int worker = 1; worker < num_threads && size_t(worker) < n; worker++)
+        threads.emplace_back(work, worker);
+    work(0);
+    for (thread &t : threads)
+        t.join();
+}
+
+void H2Operators::instantiate(const vector<Operator> &operators,
+                              const vector< vector<unsigned>> &p_index,
+                              const vector<vector<set<pair<int, int>>>> &inconsistent_facts,
+                              bool regression) {
+    // clear() keeps the capacity of the previous pass
+    facts.clear();
+    offsets.clear();
+    del_facts.clear();
+    del_offsets.clear();
+    del_lists.clear();
+    triggered.clear();
+    offsets.reserve(2 * operators.size() + 1);
+    del_lists.reserve(operators.size());
+    triggered.reserve(operators.size());
+    prepost_var.assign(inconsistent_facts.size(), false);
+    offsets.push_back(0);
+    del_offsets.push_back(0);
+    for (const Operator &op : operators)
+        push_operator(op, p_index, inconsistent_facts, regression);
+    unordered_multimap<size_t, unsigned>().swap(del_list_ids);
+}
+
+unsigned H2Operators::get_del_list(const vector<unsigned> &del) {
+    size_t hash = del.size();
+    for (unsigned p : del)
+        hash = hash * 31 + p;
+    auto range = del_list_ids.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        size_t begin = del_offsets[it->second];
+        if (del_offsets[it->second + 1] - begin == del.size() &&
+            equal(del.begin(), del.end(), del_facts.begin() + begin))
+            return it->second;
+    }
+    unsigned list = del_offsets.size() - 1;
+    del_facts.insert(del_facts.end(), del.begin(), del.end());
+    del_offsets.push_back(del_facts.size());
+    del_list_ids.emplace(hash, list);
+    return list;
+}
+
+void H2Operators::push_operator(const Operator &op,
+                                const vector< vector<unsigned>> &p_index,
+                                const vector<vector<set<pair<int, int>>>> &inconsistent_facts,
+                                bool regression) {
     // //cout << "New op: " << op.get_name() << endl;
 
     if (op.is_redundant()) {
-        triggered = SPURIOUS;
+        triggered.push_back(SPURIOUS);
     } else {
-        triggered = NOT_REACHED;
+        triggered.push_back(NOT_REACHED);
     }
 
+    op_pre.clear();
+    op_add.clear();
+    op_del.clear();
     if (regression) {
         instantiate_operator_backward(op, p_index, inconsistent_facts);
     } else {
         instantiate_operator_forward(op, p_index, inconsistent_facts);
     }
-
-    sort(pre.begin(), pre.end());
-    sort(add.begin(), add.end());
-    sort(del.begin(), del.end());
-
-    vector<unsigned int> aux;
-    set_difference(del.begin(), del.end(), add.begin(), add.end(), back_inserter(aux));
-    del.swap(aux);
-    sort(del.begin(), del.end());
+    for (const Operator::PrePost &eff : op.get_pre_post())
+        if (eff.var->get_level() >= 0)
+            prepost_var[eff.var->get_level()] = false;
+
+    sort(op_pre.begin(), op_pre.end());
+    sort(op_add.begin(), op_add.end());
+    sort(op_del.begin(), op_del.end());
+
+    op_aux.clear();
+    set_difference(op_del.begin(), op_del.end(), op_add.begin(), op_add.end(), back_inserter(op_aux));
+
+    facts.insert(facts.end(), op_pre.begin(), op_pre.end());
+    offsets.push_back(facts.size());
+    facts.insert(facts.end(), op_add.begin(), op_add.end());
+    offsets.push_back(facts.size());
+    del_lists.push_back(get_del_list(op_aux));
 }
 
 bool compute_h2_mutexes(const vector <Variable *> &variables,
@@ -45,8 +133,9 @@ bool compute_h2_mutexes(const vector <Variable *> &variables,
                         vector<MutexGroup> &mutexes,
                         State &initial_state,
                         const vector<pair<Variable *, int>> &goals,
-                        int limit_seconds, bool disable_bw_h2) {
-    H2Mutexes h2(limit_seconds);
+                        int limit_seconds, bool disable_bw_h2,
+                        bool use_bitsets, int num_threads) {
+    H2Mutexes h2(limit_seconds, use_bitsets, num_threads);
 
     if (!h2.initialize(variables, mutexes)) {
         return true;
@@ -191,13 +280,22 @@ bool H2Mutexes::set_unreachable(int var, int val, const vector <Variable *> &var
 
 
 bool H2Mutexes::remove_spurious_operators(vector<Operator> &operators) {
+    // The disambiguation of each operator only reads the mutexes, so the
+    // operators are processed in parallel
+    vector<char> was_redundant(operators.size());
+    for (size_t i = 0; i < operators.size(); i++)
+        was_redundant[i] = operators[i].is_redundant();
+    parallel_for(num_threads, operators.size(), [&](int, size_t i) {
+        if (!was_redundant[i])
+            operators[i].remove_ambiguity(*this);
+    });
+
     int count = 0, totalCount = 0;
     bool spurious_detected = false;
-    for (Operator &op : operators) {
-        if (!op.is_redundant()) {
+    for (size_t i = 0; i < operators.size(); i++) {
+        if (!was_redundant[i]) {
             totalCount++;
-            op.remove_ambiguity(*this);
-            if (op.is_redundant()) {
+            if (operators[i].is_redundant()) {
                 spurious_detected = true;
                 count++;
             }
@@ -447,11 +545,7 @@ void H2Mutexes::setPropositionNotReached(int prop_index) {
 }
 
 void H2Mutexes::init_h2_operators(const vector<Operator> &operators, const vector<Axiom> &axioms, bool regression) {
-    m_ops.clear();
-    m_ops.reserve(operators.size());
-    for (unsigned i = 0; i < operators.size(); i++) {
-        m_ops.push_back(Op_h2(operators[i], p_index, inconsistent_facts, regression));
-    }
+    m_ops.instantiate(operators, p_index, inconsistent_facts, regression);
 
     //TODO: use axioms
     if (axioms.size()) {
@@ -481,69 +575,9 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
 
     cout << "Computing mutexes..." << endl;
 
-    bool updated;
-    do {
-        // if (time_exceeded())
-        //     return TIMEOUT;
-
-        updated = false;
-        for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
-            if (op_i % 10000 == 0 && time_exceeded())
-                return TIMEOUT;
-
-            // disregard spurious operators
-            if (m_ops[op_i].triggered == SPURIOUS)
-                continue;
-
-            // if the preconditions haven't been met, continue
-            if ((m_ops[op_i].triggered != REACHED) &&
-                ((m_ops[op_i].triggered =
-                      eval_propositions(m_ops[op_i].pre)) != REACHED))
-                continue;
-
-
-            for (unsigned add_i = 0; add_i < m_ops[op_i].add.size(); add_i++) {
-                unsigned p = m_ops[op_i].add[add_i];
-                for (unsigned add_j = 0; add_j < m_ops[op_i].add.size(); add_j++) {
-                    unsigned q = m_ops[op_i].add[add_j];
-                    if (m_values[position(p, q)] == NOT_REACHED) {
-                        m_values[position(p, q)] = m_values[position(q, p)] = REACHED;
-                        updated = true;
-                    }
-                }
-
-
-                for (unsigned prop_i = 0; prop_i < number_props; prop_i++) {
-                    if (m_values[position(prop_i, prop_i)] != REACHED ||
-                        m_values[position(p, prop_i)] != NOT_REACHED)
-                        continue;
-
-                    if (binary_search(m_ops[op_i].add.begin(),
-                                      m_ops[op_i].add.end(),
-                                      prop_i) ||
-                        binary_search(m_ops[op_i].del.begin(),
-                                      m_ops[op_i].del.end(),
-                                      prop_i)) {
-                        continue;
-                    }
-
-                    bool satisfied = true;
-                    for (unsigned pre_i = 0; satisfied && pre_i < m_ops[op_i].pre.size(); pre_i++) {
-                        satisfied = (m_values[position(prop_i, m_ops[op_i].pre[pre_i])] == REACHED);
-                    }
-
-                    if (satisfied) {
-                        // pair<unsigned, unsigned> a = p_index_reverse[prop_i];
-                        // pair<unsigned, unsigned> b = p_index_reverse[p];
-                        // cout << "Action: " << g_operators[op_i].get_name() << " -> ";
-                        // cout << print_fluent(a.first,a.second) << " - " << print_fluent(b.first,b.second) << endl;
-                        m_values[position(p, prop_i)] = m_values[position(prop_i, p)] = REACHED;
-                        updated = true;
-                    }
-                }
-            }
-        }
-    } while (updated);
+    bool finished = use_bitsets ? compute_fixpoint_bitsets() : compute_fixpoint_sweeps();
+    if (!finished)
+        return TIMEOUT;
 
     int countReached = 0, countNotReached = 0, countSpurious = 0;
     for (unsigned i = 0; i < m_values.size(); i++) {
@@ -560,7 +594,7 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
 
     int numSpuriousOps = 0;
     for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
-        if (m_ops[op_i].triggered == NOT_REACHED) {
+        if (m_ops.triggered[op_i] == NOT_REACHED) {
             //cout << operators[op_i].get_name() << " is spurious because was not triggered" << endl;
             numSpuriousOps++;
             operators[op_i].set_spurious();
@@ -622,7 +656,263 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
     return count + countUnreachable;
 }
 
-Reachability H2Mutexes::eval_propositions(const vector<unsigned> &props) {
+// Sweeps over all operators until no pair is reached; returns false on timeout
+bool H2Mutexes::compute_fixpoint_sweeps() {
+    bool updated;
+    do {
+        // if (time_exceeded())
+        //     return TIMEOUT;
+
+        updated = false;
+        for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
+            if (op_i % 10000 == 0 && time_exceeded())
+                return false;
+
+            // disregard spurious operators
+            if (m_ops.triggered[op_i] == SPURIOUS)
+                continue;
+
+            // if the preconditions haven't been met, continue
+            if ((m_ops.triggered[op_i] != REACHED) &&
+                ((m_ops.triggered[op_i] =
+                      eval_propositions(m_ops.pre(op_i))) != REACHED))
+                continue;
+
+            H2Operators::Facts pre = m_ops.pre(op_i);
+            H2Operators::Facts add = m_ops.add(op_i);
+            H2Operators::Facts del = m_ops.del(op_i);
+            for (unsigned add_i = 0; add_i < add.size(); add_i++) {
+                unsigned p = add[add_i];
+                for (unsigned add_j = 0; add_j < add.size(); add_j++) {
+                    unsigned q = add[add_j];
+                    if (m_values[position(p, q)] == NOT_REACHED) {
+                        m_values[position(p, q)] = m_values[position(q, p)] = REACHED;
+                        updated = true;
+                    }
+                }
+
+
+                for (unsigned prop_i = 0; prop_i < number_props; prop_i++) {
+                    if (m_values[position(prop_i, prop_i)] != REACHED ||
+                        m_values[position(p, prop_i)] != NOT_REACHED)
+                        continue;
+
+                    if (binary_search(add.begin(), add.end(), prop_i) ||
+                        binary_search(del.begin(), del.end(), prop_i)) {
+                        continue;
+                    }
+
+                    bool satisfied = true;
+                    for (unsigned pre_i = 0; satisfied && pre_i < pre.size(); pre_i++) {
+                        satisfied = (m_values[position(prop_i, pre[pre_i])] == REACHED);
+                    }
+
+                    if (satisfied) {
+                        // pair<unsigned, unsigned> a = p_index_reverse[prop_i];
+                        // pair<unsigned, unsigned> b = p_index_reverse[p];
+                        // cout << "Action: " << g_operators[op_i].get_name() << " -> ";
+                        // cout << print_fluent(a.first,a.second) << " - " << print_fluent(b.first,b.second) << endl;
+                        m_values[position(p, prop_i)] = m_values[position(prop_i, p)] = REACHED;
+                        updated = true;
+                    }
+                }
+            }
+        }
+    } while (updated);
+    return true;
+}
+
+struct H2Mutexes::BitsetWorker {
+    vector<uint64_t> candidates;
+    vector<unsigned> changed_rows;
+    vector<bool> row_changed;
+    bool singletons_changed;
+    size_t num_processed;
+
+    explicit BitsetWorker(unsigned words_per_row, unsigned number_props)
+        : candidates(words_per_row), row_changed(number_props, false),
+          singletons_changed(false), num_processed(0) {}
+};
+
+void H2Mutexes::set_reached_bit(unsigned p, unsigned q, BitsetWorker &worker) {
+    uint64_t mask = uint64_t(1) << (q % 64);
+    if (!(reached_bits[size_t(p) * words_per_row + q / 64].fetch_or(mask, memory_order_relaxed) & mask) &&
+        !worker.row_changed[p]) {
+        worker.row_changed[p] = true;
+        worker.changed_rows.push_back(p);
+    }
+    if (p == q) {
+        if (!(reached_singletons[p / 64].fetch_or(mask, memory_order_relaxed) & mask))
+            worker.singletons_changed = true;
+    }
+}
+
+/*
+  Processes one operator in compute_fixpoint_bitsets. The reached bits are only
+  ever set, never cleared, so several workers can process operators at the same
+  time: a worker that reads a row while another one extends it only misses
+  pairs that will be found when the operator is revisited.
+*/
+void H2Mutexes::apply_operator_bitsets(unsigned op_i, BitsetWorker &worker) {
+    // disregard spurious operators
+    Reachability &triggered = m_ops.triggered[op_i];
+    if (triggered == SPURIOUS)
+        return;
+
+    // if the preconditions haven't been met, continue
+    if (triggered != REACHED &&
+        (triggered = eval_propositions_bitsets(m_ops.pre(op_i))) != REACHED)
+        return;
+
+    H2Operators::Facts add = m_ops.add(op_i);
+    for (unsigned p : add) {
+        for (unsigned q : add) {
+            if (!is_reached_bit(p, q) && !is_spurious_bit(p, q)) {
+                set_reached_bit(p, q, worker);
+                set_reached_bit(q, p, worker);
+            }
+        }
+    }
+
+    vector<uint64_t> &candidates = worker.candidates;
+    for (unsigned w = 0; w < words_per_row; w++)
+        candidates[w] = reached_singletons[w].load(memory_order_relaxed);
+    for (unsigned pre : m_ops.pre(op_i)) {
+        const atomic<uint64_t> *row = &reached_bits[size_t(pre) * words_per_row];
+        for (unsigned w = 0; w < words_per_row; w++)
+            candidates[w] &= row[w].load(memory_order_relaxed);
+    }
+    for (unsigned q : add)
+        candidates[q / 64] &= ~(uint64_t(1) << (q % 64));
+    for (unsigned q : m_ops.del(op_i))
+        candidates[q / 64] &= ~(uint64_t(1) << (q % 64));
+
+    for (unsigned p : add) {
+        const atomic<uint64_t> *reached_row = &reached_bits[size_t(p) * words_per_row];
+        const uint64_t *spurious_row = &spurious_bits[size_t(p) * words_per_row];
+        for (unsigned w = 0; w < words_per_row; w++) {
+            uint64_t new_pairs = candidates[w] & ~reached_row[w].load(memory_order_relaxed) & ~spurious_row[w];
+            while (new_pairs) {
+                unsigned q = w * 64 + lowest_bit(new_pairs);
+                new_pairs &= new_pairs - 1;
+                set_reached_bit(p, q, worker);
+                set_reached_bit(q, p, worker);
+            }
+        }
+    }
+}
+
+/*
+  Same fixpoint as compute_fixpoint_sweeps, but on bit matrices and with a
+  worklist of operators instead of full sweeps.
+
+  Row p of reached_bits has bit q set iff the pair (p, q) is REACHED (the
+  matrix is symmetric), and likewise for spurious_bits. For an operator whose
+  preconditions are reached, the propositions q that can be reached together
+  with an add effect p are those reached with themselves and with every
+  precondition, minus the adds and deletes of the operator. This is the AND of
+  the rows of the preconditions, computed one word at a time. An operator only
+  needs to be revisited when a row of one of its preconditions changed.
+
+  The worklist is processed in rounds: the operators of a round are split among
+  num_threads threads, and the operators affected by the rows changed in the
+  round form the next one. Since the fixpoint is unique, the result does not
+  depend on the number of threads.
+*/
+bool H2Mutexes::compute_fixpoint_bitsets() {
+    words_per_row = (number_props + 63) / 64;
+    vector<atomic<uint64_t>>(size_t(number_props) * words_per_row).swap(reached_bits);
+    vector<atomic<uint64_t>>(words_per_row).swap(reached_singletons);
+    spurious_bits.assign(size_t(number_props) * words_per_row, 0);
+    for (unsigned p = 0; p < number_props; p++) {
+        for (unsigned q = 0; q < number_props; q++) {
+            uint64_t mask = uint64_t(1) << (q % 64);
+            if (m_values[position(p, q)] == REACHED)
+                reached_bits[size_t(p) * words_per_row + q / 64] |= mask;
+            else if (m_values[position(p, q)] == SPURIOUS)
+                spurious_bits[size_t(p) * words_per_row + q / 64] |= mask;
+        }
+        if (is_reached_bit(p, p))
+            reached_singletons[p / 64] |= uint64_t(1) << (p % 64);
+    }
+
+    vector<vector<unsigned>> ops_with_pre(number_props);
+    vector<unsigned> ops_without_pre;
+    for (unsigned op_i = 0; op_i < m_ops.size(); op_i++) {
+        if (m_ops.pre(op_i).empty())
+            ops_without_pre.push_back(op_i);
+        for (unsigned pre : m_ops.pre(op_i))
+            ops_with_pre[pre].push_back(op_i);
+    }
+
+    vector<BitsetWorker> workers(num_threads, BitsetWorker(words_per_row, number_props));
+    vector<unsigned> round(m_ops.size());
+    for (unsigned op_i = 0; op_i < m_ops.size(); op_i++)
+        round[op_i] = op_i;
+    vector<bool> queued(m_ops.size(), false);
+    vector<unsigned> next_round;
+    atomic<bool> timeout(false);
+
+    while (!round.empty()) {
+        parallel_for(num_threads, round.size(), [&](int w, size_t i) {
+            BitsetWorker &worker = workers[w];
+            // Only the calling thread checks (and reports) the time limit
+            if (w == 0 && worker.num_processed++ % 10000 == 0 && time_exceeded())
+                timeout = true;
+            if (!timeout)
+                apply_operator_bitsets(round[i], worker);
+        });
+        if (timeout)
+            return false;
+
+        next_round.clear();
+        auto enqueue = [&](unsigned op_i) {
+            if (!queued[op_i]) {
+                queued[op_i] = true;
+                next_round.push_back(op_i);
+            }
+        };
+        for (BitsetWorker &worker : workers) {
+            for (unsigned r : worker.changed_rows) {
+                worker.row_changed[r] = false;
+                for (unsigned op_i : ops_with_pre[r])
+                    enqueue(op_i);
+            }
+            worker.changed_rows.clear();
+            // Operators without preconditions only depend on the reached propositions
+            if (worker.singletons_changed) {
+                worker.singletons_changed = false;
+                for (unsigned op_i : ops_without_pre)
+                    enqueue(op_i);
+            }
+        }
+        for (unsigned op_i : next_round)
+            queued[op_i] = false;
+        round.swap(next_round);
+    }
+
+    for (unsigned p = 0; p < number_props; p++) {
+        for (unsigned q = 0; q < number_props; q++) {
+            unsigned &value = m_values[position(p, q)];
+            if (value != SPURIOUS)
+                value = is_reached_bit(p, q) ? REACHED : NOT_REACHED;
+        }
+    }
+    vector<atomic<uint64_t>>().swap(reached_bits);
+    vector<atomic<uint64_t>>().swap(reached_singletons);
+    vector<uint64_t>().swap(spurious_bits);
+    return true;
+}
+
+Reachability H2Mutexes::eval_propositions_bitsets(const H2Operators::Facts &props) const {
+    for (unsigned i = 0; i < props.size(); i++)
+        for (unsigned j = i; j < props.size(); j++)
+            if (!is_reached_bit(props[i], props[j]) && !is_spurious_bit(props[i], props[j]))
+                return NOT_REACHED;
+    return REACHED;
+}
+
+Reachability H2Mutexes::eval_propositions(const H2Operators::Facts &props) {
     if (props.empty())
         return REACHED;
     for (unsigned i = 0; i < props.size(); i++)
@@ -665,11 +955,9 @@ bool H2Mutexes::time_exceeded() {
 }
 
 
-void Op_h2::instantiate_operator_forward(const Operator &op,
+void H2Operators::instantiate_operator_forward(const Operator &op,
                                          const vector< vector<unsigned>> &p_index,
                                          const vector<vector<set<pair<int, int>>>> &inconsistent_facts) {
-    vector<bool> prepost_var(inconsistent_facts.size(), false);
-
     const vector<Operator::Prevail> &prevail = op.get_prevail();
     for (unsigned j = 0; j < prevail.size(); j++)
         push_pre(p_index, prevail[j].var, prevail[j].prev);
@@ -693,12 +981,12 @@ void Op_h2::instantiate_operator_forward(const Operator &op,
         // fluents that belong to the same variable
         for (int k = 0; k < static_cast<int>(p_index[var].size()); k++)
             if (k != prev)
-                del.push_back(p_index[var][k]);
+                op_del.push_back(p_index[var][k]);
 
         // fluents mutex with the prevail
-        const set<pair<int, int>> prev_mutexes = inconsistent_facts[var][prev];
+        const set<pair<int, int>> &prev_mutexes = inconsistent_facts[var][prev];
         for (set<pair<int, int>>::iterator it = prev_mutexes.begin(); it != prev_mutexes.end(); ++it)
-            del.push_back(p_index[it->first][it->second]);
+            op_del.push_back(p_index[it->first][it->second]);
     }
 
 
@@ -724,14 +1012,14 @@ void Op_h2::instantiate_operator_forward(const Operator &op,
         // fluents that belong to the same variable
         for (int k = 0; k < static_cast<int>(p_index[var].size()); k++) {
             if (k != post) {
-                del.push_back(p_index[var][k]);
+                op_del.push_back(p_index[var][k]);
             }
         }
 
         // fluents mutex with the add
-        const set<pair<int, int>> prev_mutexes = inconsistent_facts[var][post];
+        const set<pair<int, int>> &prev_mutexes = inconsistent_facts[var][post];
         for (set<pair<int, int>>::iterator it = prev_mutexes.begin(); it != prev_mutexes.end(); ++it)
-            del.push_back(p_index[it->first][it->second]);
+            op_del.push_back(p_index[it->first][it->second]);
     }
 
     // augmented preconditions from the disambiguation
@@ -740,26 +1028,24 @@ void Op_h2::instantiate_operator_forward(const Operator &op,
     for (unsigned j = 0; j < augmented.size(); j++) {
         int var = augmented[j].first;
         int val = augmented[j].second;
-        pre.push_back(p_index[var][val]);
+        op_pre.push_back(p_index[var][val]);
 
         if (!prepost_var[var]) {
             // add the mutexes as deletes
             int num_p_index = p_index[var].size();
             for (int k = 0; k < num_p_index; k++)
                 if (k != val)
-                    del.push_back(p_index[var][k]);
-            const set<pair<int, int>> augmented_mutexes = inconsistent_facts[var][val];
+                    op_del.push_back(p_index[var][k]);
+            const set<pair<int, int>> &augmented_mutexes = inconsistent_facts[var][val];
             for (set<pair<int, int>>::iterator it = augmented_mutexes.begin(); it != augmented_mutexes.end(); ++it)
-                del.push_back(p_index[it->first][it->second]);
+                op_del.push_back(p_index[it->first][it->second]);
         }
     }
 }
 
-void Op_h2::instantiate_operator_backward(const Operator &op,
+void H2Operators::instantiate_operator_backward(const Operator &op,
                                           const vector< vector<unsigned>> &p_index,
                                           const vector<vector<set<pair<int, int>>>> &inconsistent_facts) {
-    vector<bool> prepost_var(inconsistent_facts.size(), false);
-
     const vector<Operator::Prevail> &prevail = op.get_prevail();
     for (unsigned j = 0; j < prevail.size(); j++)
         push_pre(p_index, prevail[j].var, prevail[j].prev);
@@ -778,7 +1064,7 @@ void Op_h2::instantiate_operator_backward(const Operator &op,
         }
 
         if (pre_post[j].is_conditional_effect) {  // naive support for conditional effects
-            vector<Operator::EffCond> effect_conds = pre_post[j].effect_conds;
+            const vector<Operator::EffCond> &effect_conds = pre_post[j].effect_conds;
             for (unsigned k = 0; k < effect_conds.size(); k++)
                 push_add(p_index, effect_conds[k].var, effect_conds[k].cond);
         }
@@ -795,12 +1081,12 @@ void Op_h2::instantiate_operator_backward(const Operator &op,
         // fluents that belong to the same variable
         for (int k = 0; k < static_cast<int>(p_index[var].size()); k++)
             if (k != prev)
-                del.push_back(p_index[var][k]);
+                op_del.push_back(p_index[var][k]);
 
         // fluents mutex with the prevail
-        const set<pair<int, int>> prev_mutexes = inconsistent_facts[var][prev];
+        const set<pair<int, int>> &prev_mutexes = inconsistent_facts[var][prev];
         for (set<pair<int, int>>::iterator it = prev_mutexes.begin(); it != prev_mutexes.end(); ++it)
-            del.push_back(p_index[it->first][it->second]);
+            op_del.push_back(p_index[it->first][it->second]);
     }
 
     // fluents mutex with pres are e-deleted: add as negative effect
@@ -817,12 +1103,12 @@ void Op_h2::instantiate_operator_backward(const Operator &op,
         int num_p_index = p_index[var].size();
         for (int k = 0; k < num_p_index; k++)
             if (k != pre)
-                del.push_back(p_index[var][k]);
+                op_del.push_back(p_index[var][k]);
 
         // fluents mutex with the add
-        const set<pair<int, int>> pre_mutexes = inconsistent_facts[var][pre];
+        const set<pair<int, int>> &pre_mutexes = inconsistent_facts[var][pre];
         for (set<pair<int, int>>::iterator it = pre_mutexes.begin(); it != pre_mutexes.end(); ++it)
-            del.push_back(p_index[it->first][it->second]);
+            op_del.push_back(p_index[it->first][it->second]);
     }
 
     // augmented preconditions from the disambiguation
@@ -834,16 +1120,16 @@ void Op_h2::instantiate_operator_backward(const Operator &op,
         // add the precondition as an add
         //         cout << "Augmented: " << op.get_name() << " -> " << print_fluent(augmented[j].first, augmented[j].second) << endl;
         if (!prepost_var[var])
-            pre.push_back(p_index[var][val]);
+            op_pre.push_back(p_index[var][val]);
 
         // add the mutexes as deletes
         int num_p_index_var = p_index[var].size();
         for (int k = 0; k < num_p_index_var; k++)
             if (k != augmented[j].second)
-                del.push_back(p_index[var][k]);
-        const set<pair<int, int>> augmented_mutexes = inconsistent_facts[var][val];
+                op_del.push_back(p_index[var][k]);
+        const set<pair<int, int>> &augmented_mutexes = inconsistent_facts[var][val];
         for (set<pair<int, int>>::iterator it = augmented_mutexes.begin(); it != augmented_mutexes.end(); ++it)
-            del.push_back(p_index[it->first][it->second]);
+            op_del.push_back(p_index[it->first][it->second]);
     }
 
     // potential preconditions from the disambiguation
@@ -856,7 +1142,7 @@ void Op_h2::instantiate_operator_backward(const Operator &op,
         int pval = potential[j].second;
 
         // add the precondition as an add
-        add.push_back(p_index[pvar][pval]);
+        op_add.push_back(p_index[pvar][pval]);
 
         //Update the potential deletes
         set<pair<int, int>> potential_deletes_aux =
@@ -880,7 +1166,7 @@ void Op_h2::instantiate_operator_backward(const Operator &op,
          it != potential_deletes.end(); ++it) {
         for (set<pair<int, int>>::iterator it2 = it->second.begin();
              it2 != it->second.end(); ++it2) {
-            del.push_back(p_index[it2->first][it2->second]);
+            op_del.push_back(p_index[it2->first][it2->second]);
         }
     }
 }
@@ -3,10 +3,13 @@
 #ifndef H2_MUTEXES_H
 #define H2_MUTEXES_H
 
+#include <atomic>
+#include <cstdint>
 #include <ctime>
 #include <iostream>
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "variable.h"
@@ -23,28 +26,95 @@ enum Reachability {SPURIOUS, REACHED, NOT_REACHED};
 static const int UNSOLVABLE = -2;
 static const int  TIMEOUT = -1;
 
-class Op_h2 {
+/*
+  The preconditions, adds and deletes of the operators in one direction of the
+  h2 computation, as sorted lists of proposition indices. The preconditions and
+  adds of all operators are stored one after the other in a single pool, so an
+  operator costs two offsets instead of two vectors. The pools are refilled in
+  place for every pass, so the forward and the backward passes share their
+  memory.
+
+  The deletes of an operator are the facts mutex with its prevails and adds,
+  so they are much longer than the other lists and many operators have the
+  same ones (e.g., 3.1M entries but only 110K distinct ones on satellite).
+  Each distinct delete list is stored once, and operators refer to it by index.
+*/
+class H2Operators {
 public:
-    Op_h2(const Operator &op,
-          const vector< vector<unsigned>> &p_index,
-          const std::vector<std::vector<std::set<std::pair<int, int>>>> &inconsistent_facts,
-          bool regression);
+    // A sorted list of propositions inside the pool
+    class Facts {
+        const unsigned *first;
+        const unsigned *last;
+    public:
+        Facts(const unsigned *first, const unsigned *last) : first(first), last(last) {}
+        const unsigned *begin() const {return first; }
+        const unsigned *end() const {return last; }
+        size_t size() const {return last - first; }
+        bool empty() const {return first == last; }
+        unsigned operator[](size_t i) const {return first[i]; }
+    };
+
+    void instantiate(const vector<Operator> &operators,
+                     const vector< vector<unsigned>> &p_index,
+                     const std::vector<std::vector<std::set<std::pair<int, int>>>> &inconsistent_facts,
+                     bool regression);
+
+    size_t size() const {
+        return triggered.size();
+    }
+
+    Facts pre(size_t op) const {
+        return Facts(facts.data() + offsets[2 * op], facts.data() + offsets[2 * op + 1]);
+    }
+
+    Facts add(size_t op) const {
+        return Facts(facts.data() + offsets[2 * op + 1], facts.data() + offsets[2 * op + 2]);
+    }
+
+    Facts del(size_t op) const {
+        unsigned list = del_lists[op];
+        return Facts(del_facts.data() + del_offsets[list], del_facts.data() + del_offsets[list + 1]);
+    }
 
-    vector<unsigned> pre;
-    vector<unsigned> add;
-    vector<unsigned> del;
-    Reachability triggered;
+    vector<Reachability> triggered;
 
 private:
+    vector<unsigned> facts;
+    // offsets[2 * op] and offsets[2 * op + 1] are the starts of the
+    // preconditions and adds of op in facts
+    vector<size_t> offsets;
+
+    // Distinct delete lists: list i is [del_offsets[i], del_offsets[i + 1]) of
+    // del_facts, and del_lists[op] is the list of op
+    vector<unsigned> del_facts;
+    vector<size_t> del_offsets;
+    vector<unsigned> del_lists;
+    // Hash of a delete list -> lists with that hash, only used in instantiate
+    unordered_multimap<size_t, unsigned> del_list_ids;
+
+    // Lists of the operator being instantiated, reused for all operators
+    vector<unsigned> op_pre;
+    vector<unsigned> op_add;
+    vector<unsigned> op_del;
+    vector<unsigned> op_aux;
+    vector<bool> prepost_var;
+
+    unsigned get_del_list(const vector<unsigned> &del);
+
+    void push_operator(const Operator &op,
+                       const vector< vector<unsigned>> &p_index,
+                       const std::vector<std::vector<std::set<std::pair<int, int>>>> &inconsistent_facts,
+                       bool regression);
+
     inline void push_pre(const vector< vector<unsigned>> &p_index, Variable *var, int val) {
         if (var->get_level() >= 0) {
-            pre.push_back(p_index[var->get_level()][val]);
+            op_pre.push_back(p_index[var->get_level()][val]);
         }
     }
 
     inline void push_add(const vector< vector<unsigned>> &p_index, Variable *var, int val) {
         if (var->get_level() >= 0) {
-            add.push_back(p_index[var->get_level()][val]);
+            op_add.push_back(p_index[var->get_level()][val]);
         }
     }
 
@@ -61,7 +131,8 @@ class H2Mutexes {
 
     bool check_goal_state_is_unreachable(const vector<pair<Variable *, int>> &goal) const;
 public:
-    H2Mutexes(int t = -1) : limit_seconds(t) {
+    H2Mutexes(int t = -1, bool use_bitsets = false, int num_threads = 1)
+        : use_bitsets(use_bitsets || num_threads > 1), num_threads(max(1, num_threads)), limit_seconds(t) {
         if (limit_seconds != -1)
             time(&start);
     }
@@ -121,12 +192,38 @@ protected:
 
     unsigned number_props;
     vector<unsigned> m_values;
-    vector<Op_h2> m_ops;
+    H2Operators m_ops;
 
     vector< vector<unsigned>> p_index;
     vector< pair<unsigned, unsigned>> p_index_reverse;
 
-    Reachability eval_propositions(const vector<unsigned> & props);
+    Reachability eval_propositions(const H2Operators::Facts &props);
+
+    // Bit-parallel representation of m_values, only used during compute_fixpoint_bitsets.
+    // Reached bits are atomic so that several threads can set them.
+    bool use_bitsets;
+    int num_threads;
+    unsigned words_per_row;
+    vector<atomic<uint64_t>> reached_bits;
+    vector<uint64_t> spurious_bits;
+    vector<atomic<uint64_t>> reached_singletons;
+
+    struct BitsetWorker;
+
+    inline bool is_reached_bit(unsigned a, unsigned b) const {
+        return (reached_bits[size_t(a) * words_per_row + b / 64].load(memory_order_relaxed) >> (b % 64)) & 1;
+    }
+
+    inline bool is_spurious_bit(unsigned a, unsigned b) const {
+        return (spurious_bits[size_t(a) * words_per_row + b / 64] >> (b % 64)) & 1;
+    }
+
+    Reachability eval_propositions_bitsets(const H2Operators::Facts &props) const;
+    void set_reached_bit(unsigned p, unsigned q, BitsetWorker &worker);
+    void apply_operator_bitsets(unsigned op_i, BitsetWorker &worker);
+
+    bool compute_fixpoint_sweeps();
+    bool compute_fixpoint_bitsets();
 
     inline unsigned position(unsigned a, unsigned b) const {
         return (a * number_props) + b;
@@ -158,7 +255,8 @@ extern bool compute_h2_mutexes(const vector <Variable *> &variables,
                                vector<MutexGroup> &mutexes,
                                State &initial_state,
                                const vector<pair<Variable *, int>> &goal,
-                               int limit_seconds, bool disable_bw_h2);
+                               int limit_seconds, bool disable_bw_h2,
+                               bool use_bitsets = false, int num_threads = 1);
 
 
 
@@ -2,17 +2,21 @@
 #include <iostream>
 #include <fstream>
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <fstream>
 
 #include "helper_functions.h"
+#include "binary_task_writer.h"
 #include "state.h"
 #include "mutex_group.h"
 #include "operator.h"
 #include "axiom.h"
 #include "variable.h"
 
+#include "../search/tasks/binary_task_format.h"
+
 using namespace std;
 
 static const int SAS_FILE_VERSION = 3;
@@ -97,6 +101,7 @@ void read_operators(istream &in, const vector<Variable *> &variables,
                     vector<Operator> &operators) {
     int count;
     in >> count;
+    operators.reserve(count);
     for (int i = 0; i < count; i++)
         operators.push_back(Operator(in, variables));
 }
@@ -109,6 +114,54 @@ void read_axioms(istream &in, const vector<Variable *> &variables,
         axioms.push_back(Axiom(in, variables));
 }
 
+/*
+  Binary tasks are mapped into memory if they are given as a regular file on
+  the standard input, and read into memory otherwise.
+*/
+static void read_binary_problem_description(istream &in,
+                                            bool &metric,
+                                            vector<Variable> &internal_variables,
+                                            vector<Variable *> &variables,
+                                            vector<MutexGroup> &mutexes,
+                                            State &initial_state,
+                                            vector<pair<Variable *, int>> &goals,
+                                            vector<Operator> &operators,
+                                            vector<Axiom> &axioms) {
+    binary_task_format::TaskBuffer buffer;
+    if (!(&in == &cin && buffer.map_file(0)) && !buffer.read_from_stream(in)) {
+        cerr << "Could not read binary task." << endl;
+        exit(1);
+    }
+    binary_task_format::TaskView task = buffer.get_view();
+    string error;
+    if (!task.validate(error)) {
+        cerr << "Invalid binary task: " << error << endl;
+        exit(1);
+    }
+
+    metric = task.use_metric();
+    int num_variables = task.get_num_variables();
+    // Important so that the iterators stored in variables are valid.
+    internal_variables.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        internal_variables.push_back(Variable(task, var));
+        variables.push_back(&internal_variables.back());
+    }
+    for (int group = 0; group < task.get_num_mutex_groups(); ++group)
+        mutexes.push_back(MutexGroup(task, group, variables));
+    initial_state = State(task, variables);
+    const int32_t *goal_facts = task.get_goals();
+    for (int i = 0; i < task.get_num_goals(); ++i)
+        goals.push_back(make_pair(variables[goal_facts[2 * i]], goal_facts[2 * i + 1]));
+    int num_operators = task.get_num_operators();
+    operators.reserve(num_operators);
+    for (int op = 0; op < num_operators; ++op)
+        operators.push_back(Operator(task, op, variables));
+    axioms.reserve(task.get_num_axioms());
+    for (int axiom = 0; axiom < task.get_num_axioms(); ++axiom)
+        axioms.push_back(Axiom(task, num_operators + axiom, variables));
+}
+
 void read_preprocessed_problem_description(istream &in,
                                            bool &metric,
                                            vector<Variable> &internal_variables,
@@ -118,6 +171,11 @@ void read_preprocessed_problem_description(istream &in,
                                            vector<pair<Variable *, int>> &goals,
                                            vector<Operator> &operators,
                                            vector<Axiom> &axioms) {
+    if (binary_task_format::is_binary_task(in.peek())) {
+        read_binary_problem_description(in, metric, internal_variables, variables,
+                                        mutexes, initial_state, goals, operators, axioms);
+        return;
+    }
     read_and_verify_version(in);
     read_metric(in, metric);
     read_variables(in, internal_variables, variables);
@@ -147,16 +205,14 @@ void dump_preprocessed_problem_description(const vector<Variable *> &variables,
         axiom.dump();
 }
 
-void generate_cpp_input(const vector<Variable *> &ordered_vars,
-                        const bool &metric,
-                        const vector<MutexGroup> &mutexes,
-                        const State &initial_state,
-                        const vector<pair<Variable *, int>> &goals,
-                        const vector<Operator> &operators,
-                        const vector<Axiom> &axioms) {
-    ofstream outfile;
-    outfile.open("output.sas", ios::out);
-
+static void write_cpp_input(ostream &outfile,
+                            const vector<Variable *> &ordered_vars,
+                            const bool &metric,
+                            const vector<MutexGroup> &mutexes,
+                            const State &initial_state,
+                            const vector<pair<Variable *, int>> &goals,
+                            const vector<Operator> &operators,
+                            const vector<Axiom> &axioms) {
     outfile << "begin_version" << endl;
     outfile << PRE_FILE_VERSION << endl;
     outfile << "end_version" << endl;
@@ -199,8 +255,69 @@ void generate_cpp_input(const vector<Variable *> &ordered_vars,
     outfile << axioms.size() << endl;
     for (const Axiom &axiom : axioms)
         axiom.generate_cpp_input(outfile);
+}
 
-    outfile.close();
+static void write_binary_input(ostream &outfile,
+                               const vector<Variable *> &ordered_vars,
+                               const bool &metric,
+                               const vector<MutexGroup> &mutexes,
+                               const State &initial_state,
+                               const vector<pair<Variable *, int>> &goals,
+                               const vector<Operator> &operators,
+                               const vector<Axiom> &axioms) {
+    BinaryTaskWriter writer;
+    writer.set_metric(metric);
+    for (Variable *var : ordered_vars)
+        var->generate_binary_input(writer);
+    for (const MutexGroup &mutex : mutexes)
+        mutex.generate_binary_input(writer);
+    for (Variable *var : ordered_vars)
+        writer.add_initial_value(initial_state[var]);
+
+    vector<int> ordered_goal_values(ordered_vars.size(), -1);
+    for (const auto &goal : goals)
+        ordered_goal_values[goal.first->get_level()] = goal.second;
+    for (size_t i = 0; i < ordered_vars.size(); i++)
+        if (ordered_goal_values[i] != -1)
+            writer.add_goal(i, ordered_goal_values[i]);
+
+    for (const Operator &op : operators)
+        op.generate_binary_input(writer);
+    for (const Axiom &axiom : axioms)
+        axiom.generate_binary_input(writer);
+    writer.write(outfile);
+}
+
+void generate_cpp_input(const vector<Variable *> &ordered_vars,
+                        const bool &metric,
+                        const vector<MutexGroup> &mutexes,
+                        const State &initial_state,
+                        const vector<pair<Variable *, int>> &goals,
+                        const vector<Operator> &operators,
+                        const vector<Axiom> &axioms,
+                        bool binary_output) {
+    if (binary_output) {
+        ofstream outfile;
+        outfile.open("output.sas", ios::out | ios::binary);
+        try {
+            write_binary_input(outfile, ordered_vars, metric, mutexes, initial_state,
+                               goals, operators, axioms);
+        } catch (const length_error &too_large) {
+            cerr << "Could not write binary task: " << too_large.what() << endl;
+            exit(1);
+        }
+        if (!outfile) {
+            cerr << "Could not write binary task" << endl;
+            exit(1);
+        }
+        outfile.close();
+    } else {
+        ofstream outfile;
+        outfile.open("output.sas", ios::out);
+        write_cpp_input(outfile, ordered_vars, metric, mutexes, initial_state,
+                        goals, operators, axioms);
+        outfile.close();
+    }
 }
 void generate_unsolvable_cpp_input() {
     ofstream outfile;
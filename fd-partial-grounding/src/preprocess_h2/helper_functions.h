@@ -15,7 +15,7 @@ class MutexGroup;
 class Operator;
 class Axiom;
 
-//void read_everything
+// The task can be in the text or in the binary format (see search/tasks/binary_task_format.h).
 void read_preprocessed_problem_description(istream & in,
                                            bool &metric,
                                            vector<Variable> &internal_variables,
@@ -40,7 +40,8 @@ void generate_cpp_input(const vector<Variable *> &ordered_var,
                         const State &initial_state,
                         const vector<pair<Variable *, int>> &goals,
                         const vector<Operator> &operators,
-                        const vector<Axiom> &axioms);
+                        const vector<Axiom> &axioms,
+                        bool binary_output);
 void check_magic(istream & in, string magic);
 
 #endif
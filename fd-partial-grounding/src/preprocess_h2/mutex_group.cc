@@ -1,8 +1,11 @@
 #include "mutex_group.h"
 
+#include "binary_task_writer.h"
 #include "helper_functions.h"
 #include "variable.h"
 
+#include "../search/tasks/binary_task_format.h"
+
 #include <fstream>
 #include <iostream>
 
@@ -18,6 +21,14 @@ MutexGroup::MutexGroup(istream &in, const vector<Variable *> &variables) : dir(F
     }
     check_magic(in, "end_mutex_group");
 }
+
+MutexGroup::MutexGroup(const binary_task_format::TaskView &task, int group,
+                       const vector<Variable *> &variables) : dir(FW) {
+    const int32_t *offsets = task.get_mutex_group_offsets();
+    const int32_t *mutex_facts = task.get_mutex_facts();
+    for (int i = offsets[group]; i < offsets[group + 1]; ++i)
+        facts.push_back(make_pair(variables[mutex_facts[2 * i]], mutex_facts[2 * i + 1]));
+}
 MutexGroup::MutexGroup(const vector<pair<int, int>> &f,
                        const vector<Variable *> &variables,
                        bool regression) {
@@ -53,7 +64,7 @@ void MutexGroup::dump() const {
     }
 }
 
-void MutexGroup::generate_cpp_input(ofstream &outfile) const {
+void MutexGroup::generate_cpp_input(ostream &outfile) const {
     outfile << "begin_mutex_group" << endl
             << facts.size() << endl;
     for (const auto &fact : facts) {
@@ -63,6 +74,12 @@ void MutexGroup::generate_cpp_input(ofstream &outfile) const {
     outfile << "end_mutex_group" << endl;
 }
 
+void MutexGroup::generate_binary_input(BinaryTaskWriter &writer) const {
+    for (const auto &fact : facts)
+        writer.add_mutex_fact(fact.first->get_level(), fact.second);
+    writer.finish_mutex_group();
+}
+
 void MutexGroup::strip_unimportant_facts() {
     int new_index = 0;
     for (const auto &fact : facts) {
@@ -7,6 +7,11 @@
 #include "state.h"
 using namespace std;
 
+namespace binary_task_format {
+class TaskView;
+}
+
+class BinaryTaskWriter;
 class Variable;
 
 enum Dir {FW, BW};
@@ -19,6 +24,8 @@ class MutexGroup {
     vector<pair<const Variable *, int>> facts;
 public:
     MutexGroup(istream &in, const vector<Variable *> &variables);
+    MutexGroup(const binary_task_format::TaskView &task, int group,
+               const vector<Variable *> &variables);
 
     MutexGroup(const vector<pair<int, int>> &f,
                const vector<Variable *> &variables,
@@ -35,7 +42,8 @@ public:
     int num_facts() const {
         return facts.size();
     }
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(ostream &outfile) const;
+    void generate_binary_input(BinaryTaskWriter &writer) const;
     void dump() const;
     void get_mutex_group(vector<pair<int, int>> &invariant_group) const;
 
@@ -1,11 +1,15 @@
+#include "binary_task_writer.h"
 #include "helper_functions.h"
 #include "operator.h"
 #include "variable.h"
 
 #include "h2_mutexes.h"
+
+#include "../search/tasks/binary_task_format.h"
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include <utility>
 using namespace std;
 
 Operator::Operator(istream &in, const vector<Variable *> &variables) : spurious(false) {
@@ -41,6 +45,36 @@ Operator::Operator(istream &in, const vector<Variable *> &variables) : spurious(
     // TODO: Evtl. effektiver: conditions schon sortiert einlesen?
 }
 
+Operator::Operator(const binary_task_format::TaskView &task, int op,
+                   const vector<Variable *> &variables)
+    : name(task.get_operator_name(op)), cost(task.get_costs()[op]), spurious(false) {
+    const int32_t *effects = task.get_effects();
+    const int32_t *condition_offsets = task.get_effect_condition_offsets();
+    const int32_t *conditions = task.get_effect_conditions();
+    int num_effect_preconditions = 0;
+    for (int eff = task.get_effect_offsets()[op]; eff < task.get_effect_offsets()[op + 1]; ++eff) {
+        Variable *var = variables[effects[3 * eff]];
+        int pre = effects[3 * eff + 1];
+        int post = effects[3 * eff + 2];
+        if (pre != -1)
+            ++num_effect_preconditions;
+        if (condition_offsets[eff] == condition_offsets[eff + 1]) {
+            pre_post.push_back(PrePost(var, pre, post));
+        } else {
+            vector<EffCond> ecs;
+            for (int i = condition_offsets[eff]; i < condition_offsets[eff + 1]; ++i)
+                ecs.push_back(EffCond(variables[conditions[2 * i]], conditions[2 * i + 1]));
+            pre_post.push_back(PrePost(var, ecs, pre, post));
+        }
+    }
+    // The preconditions are the prevail conditions followed by the pre values of the effects.
+    const int32_t *preconditions = task.get_preconditions();
+    int begin = task.get_precondition_offsets()[op];
+    int end = task.get_precondition_offsets()[op + 1] - num_effect_preconditions;
+    for (int i = begin; i < end; ++i)
+        prevail.push_back(Prevail(variables[preconditions[2 * i]], preconditions[2 * i + 1]));
+}
+
 void Operator::dump() const {
     cout << name << ":" << endl;
     cout << "prevail:";
@@ -87,16 +121,21 @@ bool Operator::is_redundant() const {
 void strip_operators(vector<Operator> &operators) {
     int old_count = operators.size();
     int new_index = 0;
-    for (Operator &op : operators) {
+    for (size_t i = 0; i < operators.size(); ++i) {
+        Operator &op = operators[i];
         op.strip_unimportant_effects();
-        if (!op.is_redundant())
-            operators[new_index++] = op;
+        if (!op.is_redundant()) {
+            // Move instead of copying so that no operator is duplicated
+            if (static_cast<int>(i) != new_index)
+                operators[new_index] = move(op);
+            ++new_index;
+        }
     }
     operators.erase(operators.begin() + new_index, operators.end());
     cout << operators.size() << " of " << old_count << " operators necessary." << endl;
 }
 
-void Operator::generate_cpp_input(ofstream &outfile) const {
+void Operator::generate_cpp_input(ostream &outfile) const {
     //TODO: beim Einlesen in search feststellen, ob leerer Operator
     outfile << "begin_operator" << endl;
     outfile << name << endl;
@@ -123,6 +162,22 @@ void Operator::generate_cpp_input(ofstream &outfile) const {
     outfile << "end_operator" << endl;
 }
 
+void Operator::generate_binary_input(BinaryTaskWriter &writer) const {
+    writer.add_operator(name);
+    for (const auto &prev : prevail) {
+        assert(prev.var->get_level() != -1);
+        if (prev.var->get_level() != -1)
+            writer.add_precondition(prev.var->get_level(), prev.prev);
+    }
+    for (const auto &eff : pre_post) {
+        assert(eff.var->get_level() != -1);
+        for (const auto &cond : eff.effect_conds)
+            writer.add_effect_condition(cond.var->get_level(), cond.cond);
+        writer.add_effect(eff.var->get_level(), eff.pre, eff.post);
+    }
+    writer.finish_operator(cost);
+}
+
 // Removes ambiguity in the preconditions,
 // detects whether the operator is spurious
 void Operator::remove_ambiguity(const H2Mutexes &h2) {
@@ -10,6 +10,10 @@
 #include "variable.h"
 using namespace std;
 
+namespace binary_task_format {
+class TaskView;
+}
+class BinaryTaskWriter;
 class H2Mutexes;
 
 class Operator {
@@ -86,13 +90,16 @@ private:
     std::vector<std::pair<Variable *, int>> potential_preconditions_var;
 public:
     Operator(istream &in, const vector<Variable *> &variables);
+    Operator(const binary_task_format::TaskView &task, int op,
+             const vector<Variable *> &variables);
 
     void strip_unimportant_effects();
     bool is_redundant() const;
 
     void dump() const;
     int get_encoding_size() const;
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(ostream &outfile) const;
+    void generate_binary_input(BinaryTaskWriter &writer) const;
     int get_cost() const {return cost; }
     string get_name() const {return name; }
     bool has_conditional_effects() const {
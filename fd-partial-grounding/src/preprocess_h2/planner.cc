@@ -21,6 +21,9 @@ int main(int argc, const char **argv) {
     bool include_augmented_preconditions = false;
     bool expensive_statistics = false;
     bool disable_bw_h2 = false;
+    bool h2_bitsets = false;
+    int h2_threads = 1;
+    bool binary_output = false;
 
     bool metric;
     vector<Variable *> variables;
@@ -55,11 +58,31 @@ int main(int argc, const char **argv) {
             include_augmented_preconditions = true;
         } else if (arg.compare("--no_bw_h2") == 0) {
             disable_bw_h2 = true;
+        } else if (arg.compare("--h2_kernel") == 0) {
+            // "sweep" (default) or "bitset"; takes a value so that it can be
+            // passed through --transform-task-options
+            i++;
+            if (i < argc && (string(argv[i]) == "sweep" || string(argv[i]) == "bitset")) {
+                h2_bitsets = string(argv[i]) == "bitset";
+            } else {
+                cerr << "please specify sweep or bitset after --h2_kernel" << endl;
+                exit(2);
+            }
+        } else if (arg.compare("--threads") == 0) {
+            i++;
+            if (i < argc && atoi(argv[i]) >= 1) {
+                h2_threads = atoi(argv[i]);
+            } else {
+                cerr << "please specify a positive number of threads after --threads" << endl;
+                exit(2);
+            }
+        } else if (arg.compare("--binary_output") == 0) {
+            binary_output = true;
         } else if (arg.compare("--stat") == 0) {
             expensive_statistics = true;
         } else {
             cerr << "unknown option " << arg << endl << endl;
-            cout << "Usage: ./preprocess [--no_rel] [--no_h2]  [--no_bw_h2] [--augmented_pre] [--stat] < output" << endl;
+            cout << "Usage: ./preprocess [--no_rel] [--no_h2]  [--no_bw_h2] [--h2_kernel sweep|bitset] [--threads N] [--augmented_pre] [--binary_output] [--stat] < output" << endl;
             exit(2);
         }
     }
@@ -95,7 +118,7 @@ int main(int argc, const char **argv) {
 
         if (!compute_h2_mutexes(ordering, operators, axioms,
                                 mutexes, initial_state, goals,
-                                h2_mutex_time, disable_bw_h2)) {
+                                h2_mutex_time, disable_bw_h2, h2_bitsets, h2_threads)) {
             // TODO: don't duplicate the code to return an unsolvable task, log and exit here
             cout << "Unsolvable task in preprocessor" << endl;
             generate_unsolvable_cpp_input();
@@ -243,7 +266,7 @@ int main(int argc, const char **argv) {
         generate_unsolvable_cpp_input();
     } else {
         generate_cpp_input(
-            ordering, metric, mutexes, initial_state, goals, operators, axioms);
+            ordering, metric, mutexes, initial_state, goals, operators, axioms, binary_output);
     }
     cout << "done" << endl;
 }
@@ -0,0 +1,35 @@
+/* Converts a translated task (output.sas) into the binary task format that
+ * preprocess-h2 and the search can map into memory instead of parsing it.
+ */
+
+#include "binary_task_writer.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int main(int argc, const char **argv) {
+    if (argc != 3) {
+        cout << "Usage: ./sas-converter INPUT OUTPUT" << endl
+             << "Converts the text task INPUT into the binary task OUTPUT." << endl;
+        exit(2);
+    }
+    ifstream in(argv[1]);
+    if (!in) {
+        cerr << "could not open " << argv[1] << endl;
+        exit(1);
+    }
+    ofstream out(argv[2], ios::binary);
+    if (!out) {
+        cerr << "could not open " << argv[2] << endl;
+        exit(1);
+    }
+    string error;
+    if (!convert_to_binary_task(in, out, error)) {
+        cerr << "could not convert " << argv[1] << ": " << error << endl;
+        exit(1);
+    }
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include "state.h"
 #include "helper_functions.h"
 
+#include "../search/tasks/binary_task_format.h"
+
 class Variable;
 
 State::State(istream &in, const vector<Variable *> &variables) {
@@ -13,6 +15,12 @@ State::State(istream &in, const vector<Variable *> &variables) {
     check_magic(in, "end_state");
 }
 
+State::State(const binary_task_format::TaskView &task, const vector<Variable *> &variables) {
+    const int32_t *initial_state = task.get_initial_state();
+    for (size_t var = 0; var < variables.size(); ++var)
+        values[variables[var]] = initial_state[var];
+}
+
 int State::operator[](Variable *var) const {
     return values.find(var)->second;
 }
@@ -6,6 +6,10 @@
 #include <vector>
 using namespace std;
 
+namespace binary_task_format {
+class TaskView;
+}
+
 class Variable;
 
 class State {
@@ -13,6 +17,7 @@ class State {
 public:
     State() {} // TODO: Entfernen (erfordert kleines Redesign)
     State(istream &in, const vector<Variable *> &variables);
+    State(const binary_task_format::TaskView &task, const vector<Variable *> &variables);
 
     int operator[](Variable *var) const;
     void dump() const;
@@ -1,7 +1,10 @@
 #include "variable.h"
 
+#include "binary_task_writer.h"
 #include "helper_functions.h"
 
+#include "../search/tasks/binary_task_format.h"
+
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -22,6 +25,20 @@ Variable::Variable(istream &in) {
     reachable = vector<bool> (range, true);
 }
 
+Variable::Variable(const binary_task_format::TaskView &task, int var) {
+    const int32_t *variable = task.get_variable(var);
+    int range = variable[0];
+    name = task.get_variable_name(var);
+    layer = variable[1];
+    values.resize(range);
+    for (int i = 0; i < range; ++i)
+        values[i] = task.get_fact_name(var, i);
+    level = -1;
+    necessary = false;
+    reachable_values = range;
+    reachable = vector<bool> (range, true);
+}
+
 void Variable::set_level(int theLevel) {
     level = theLevel;
 }
@@ -60,7 +77,7 @@ void Variable::dump() const {
     cout << "]" << endl;
 }
 
-void Variable::generate_cpp_input(ofstream &outfile) const {
+void Variable::generate_cpp_input(ostream &outfile) const {
     outfile << "begin_variable" << endl
             << name << endl
             << layer << endl
@@ -71,6 +88,13 @@ void Variable::generate_cpp_input(ofstream &outfile) const {
     outfile << "end_variable" << endl;
 }
 
+void Variable::generate_binary_input(BinaryTaskWriter &writer) const {
+    writer.add_variable(name, layer);
+    for (size_t i = 0; i < values.size(); ++i)
+        if (reachable[i])
+            writer.add_fact(values[i]);
+}
+
 void Variable::remove_unreachable_facts() {
     vector<string> new_values;
     for (size_t i = 0; i < values.size(); i++) {
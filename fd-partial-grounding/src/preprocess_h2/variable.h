@@ -5,6 +5,11 @@
 #include <vector>
 using namespace std;
 
+class BinaryTaskWriter;
+namespace binary_task_format {
+class TaskView;
+}
+
 class Variable {
     vector<string> values;
     string name;
@@ -15,6 +20,7 @@ class Variable {
     int reachable_values;
 public:
     Variable(istream &in);
+    Variable(const binary_task_format::TaskView &task, int var);
     void set_level(int level);
     void set_necessary();
     void reset_necessary(){necessary= false;}
@@ -24,7 +30,8 @@ public:
     string get_name() const;
     int get_layer() const {return layer; }
     bool is_derived() const {return layer != -1; }
-    void generate_cpp_input(ofstream &outfile) const;
+    void generate_cpp_input(ostream &outfile) const;
+    void generate_binary_input(BinaryTaskWriter &writer) const;
     void dump() const;
 
     string get_fact_name(int value) const {
@@ -79,7 +79,7 @@ fast_downward_plugin(
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES TREE_TABLE
     CORE_PLUGIN
 )
 
@@ -116,6 +116,7 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/parallel
         utils/rng
         utils/rng_options
         utils/strings
@@ -240,6 +241,15 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME TREE_TABLE
+    HELP "Hash-consed storage of many arrays of the same size"
+    SOURCES
+        algorithms/tree_table
+    DEPENDS INT_HASH_SET SEGMENTED_VECTOR
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SUBSCRIBER
     HELP "Allows object to subscribe to the destructor of other objects"
@@ -382,7 +392,7 @@ fast_downward_plugin(
     HELP "Eager search algorithm"
     SOURCES
         search_engines/eager_search
-    DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR TASK_EXTENSION
     DEPENDENCY_ONLY
 )
 
@@ -577,6 +587,7 @@ fast_downward_plugin(
     NAME CORE_TASKS
     HELP "Core task transformations"
     SOURCES
+        tasks/binary_root_task
         tasks/cost_adapted_task
         tasks/delegating_task
         tasks/root_task
@@ -631,6 +642,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME TASK_EXTENSION
+    HELP "Mapping between a task and a version of it grounded with more operators"
+    SOURCES
+        task_utils/task_extension
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME VARIABLE_ORDER_FINDER
     HELP "Variable order finder"
@@ -292,6 +292,10 @@ public:
         return insert(key, hasher(key));
     }
 
+    std::size_t get_memory_in_bytes() const {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+
     void dump(utils::LogProxy &log) const {
         int num_buckets = capacity();
         log << "[";
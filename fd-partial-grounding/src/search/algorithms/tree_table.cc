@@ -0,0 +1,96 @@
+#include "tree_table.h"
+
+#include "../utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace tree_table {
+static bool is_leaf(int begin, int end) {
+    return end - begin <= 2;
+}
+
+// The left subtree covers [begin, mid) and the right one [mid, end).
+static int get_mid(int begin, int end) {
+    return begin + (end - begin + 1) / 2;
+}
+
+TreeTable::TreeTable(int array_size)
+    : array_size(array_size),
+      node_ids(NodeHash(nodes), NodeEqual(nodes)) {
+    assert(array_size >= 1);
+}
+
+int TreeTable::insert_node(Value left, Value right) {
+    nodes.push_back(make_pair(left, right));
+    pair<int, bool> result = node_ids.insert(nodes.size() - 1);
+    if (!result.second) {
+        nodes.pop_back();
+    }
+    assert(static_cast<int>(nodes.size()) == node_ids.size());
+    return result.first;
+}
+
+int TreeTable::insert_range(const Value *array, int begin, int end) {
+    if (is_leaf(begin, end)) {
+        return insert_node(array[begin], end - begin == 2 ? array[begin + 1] : 0);
+    }
+    int mid = get_mid(begin, end);
+    int left = insert_range(array, begin, mid);
+    int right = insert_range(array, mid, end);
+    return insert_node(left, right);
+}
+
+int TreeTable::insert_range(
+    const Value *array, const Value *old_array, int old_node, int begin, int end) {
+    if (is_leaf(begin, end)) {
+        if (equal(array + begin, array + end, old_array + begin))
+            return old_node;
+        return insert_node(array[begin], end - begin == 2 ? array[begin + 1] : 0);
+    }
+    int mid = get_mid(begin, end);
+    Node old_children = nodes[old_node];
+    int left = insert_range(array, old_array, old_children.first, begin, mid);
+    int right = insert_range(array, old_array, old_children.second, mid, end);
+    if (static_cast<Value>(left) == old_children.first &&
+        static_cast<Value>(right) == old_children.second)
+        return old_node;
+    return insert_node(left, right);
+}
+
+void TreeTable::get_range(int node, Value *array, int begin, int end) const {
+    const Node &values = nodes[node];
+    if (is_leaf(begin, end)) {
+        array[begin] = values.first;
+        if (end - begin == 2)
+            array[begin + 1] = values.second;
+        return;
+    }
+    int mid = get_mid(begin, end);
+    get_range(values.first, array, begin, mid);
+    get_range(values.second, array, mid, end);
+}
+
+int TreeTable::insert(const Value *array) {
+    return insert_range(array, 0, array_size);
+}
+
+int TreeTable::insert(const Value *array, const Value *old_array, int old_root) {
+    return insert_range(array, old_array, old_root, 0, array_size);
+}
+
+void TreeTable::get(int root, Value *array) const {
+    get_range(root, array, 0, array_size);
+}
+
+size_t TreeTable::get_memory_in_bytes() const {
+    return nodes.size() * sizeof(Node) + node_ids.get_memory_in_bytes();
+}
+
+void TreeTable::print_statistics(utils::LogProxy &log) const {
+    log << "Tree table nodes: " << nodes.size() << endl;
+    node_ids.print_statistics(log);
+}
+}
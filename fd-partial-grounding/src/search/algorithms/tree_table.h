@@ -0,0 +1,108 @@
+#ifndef ALGORITHMS_TREE_TABLE_H
+#define ALGORITHMS_TREE_TABLE_H
+
+#include "int_hash_set.h"
+#include "segmented_vector.h"
+
+#include "../utils/hash.h"
+
+#include <cstddef>
+#include <utility>
+
+namespace utils {
+class LogProxy;
+}
+
+namespace tree_table {
+/*
+  Stores many arrays of the same size by hash-consing their sub-arrays
+  ("tree compression", see Laarman, van de Pol and Weber, Parallel Recursive
+  State Compression for Free, SPIN 2011).
+
+  An array is split recursively into halves, which gives a binary tree whose
+  leaves hold one or two array entries. Every tree node is a pair of values
+  (array entries for the leaves, IDs of the children otherwise) and equal
+  nodes are stored only once, so arrays that share sub-arrays share the nodes
+  for them. Two arrays are equal iff they have the same root node, so the
+  root is a compact key for the whole array.
+
+  When an array is inserted together with a similar array that is already
+  stored (for example the parent of a state), only the nodes on the paths to
+  the entries in which the two arrays differ are looked up; all other nodes
+  are taken over from the stored array.
+
+  Node IDs are non-negative ints, so a table holds at most 2^31 - 1 nodes.
+*/
+class TreeTable {
+public:
+    using Value = unsigned int;
+    using Node = std::pair<Value, Value>;
+private:
+    struct NodeHash {
+        const segmented_vector::SegmentedVector<Node> &nodes;
+        explicit NodeHash(const segmented_vector::SegmentedVector<Node> &nodes)
+            : nodes(nodes) {
+        }
+
+        int_hash_set::HashType operator()(int id) const {
+            const Node &node = nodes[id];
+            utils::HashState hash_state;
+            hash_state.feed(node.first);
+            hash_state.feed(node.second);
+            return hash_state.get_hash32();
+        }
+    };
+
+    struct NodeEqual {
+        const segmented_vector::SegmentedVector<Node> &nodes;
+        explicit NodeEqual(const segmented_vector::SegmentedVector<Node> &nodes)
+            : nodes(nodes) {
+        }
+
+        bool operator()(int lhs, int rhs) const {
+            return nodes[lhs] == nodes[rhs];
+        }
+    };
+
+    using NodeIDSet = int_hash_set::IntHashSet<NodeHash, NodeEqual>;
+
+    const int array_size;
+    segmented_vector::SegmentedVector<Node> nodes;
+    NodeIDSet node_ids;
+
+    int insert_node(Value left, Value right);
+    int insert_range(const Value *array, int begin, int end);
+    int insert_range(const Value *array, const Value *old_array, int old_node,
+                     int begin, int end);
+    void get_range(int node, Value *array, int begin, int end) const;
+public:
+    explicit TreeTable(int array_size);
+
+    // Return the root of the given array and store it if necessary.
+    int insert(const Value *array);
+    /*
+      Like insert(array), but old_array must be the array stored with root
+      old_root. Subtrees for ranges in which array and old_array agree are not
+      looked up again.
+    */
+    int insert(const Value *array, const Value *old_array, int old_root);
+
+    // Write the array with the given root to array.
+    void get(int root, Value *array) const;
+
+    int get_array_size() const {
+        return array_size;
+    }
+
+    std::size_t get_num_nodes() const {
+        return nodes.size();
+    }
+
+    // Memory used by the nodes and the hash set over them.
+    std::size_t get_memory_in_bytes() const;
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+}
+
+#endif
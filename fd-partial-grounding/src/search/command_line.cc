@@ -41,11 +41,22 @@ static int parse_int_arg(const string &name, const string &value) {
     }
 }
 
+static double parse_double_arg(const string &name, const string &value) {
+    try {
+        return stod(value);
+    } catch (invalid_argument &) {
+        throw ArgError("argument for " + name + " must be a number");
+    } catch (out_of_range &) {
+        throw ArgError("argument for " + name + " is out of range");
+    }
+}
+
 static shared_ptr<SearchEngine> parse_cmd_line_aux(
     const vector<string> &args, options::Registry &registry, bool dry_run) {
     string plan_filename = "sas_plan";
     int num_previously_generated_plans = 0;
     bool is_part_of_anytime_portfolio = false;
+    double persistent_search_time_limit = -1;
     options::Predefinitions predefinitions;
 
     shared_ptr<SearchEngine> engine;
@@ -105,6 +116,13 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
             num_previously_generated_plans = parse_int_arg(arg, args[i]);
             if (num_previously_generated_plans < 0)
                 throw ArgError("argument for --internal-previous-portfolio-plans must be positive");
+        } else if (arg == "--internal-persistent-search") {
+            if (is_last)
+                throw ArgError("missing argument after --internal-persistent-search");
+            ++i;
+            persistent_search_time_limit = parse_double_arg(arg, args[i]);
+            if (persistent_search_time_limit <= 0)
+                throw ArgError("argument for --internal-persistent-search must be positive");
         } else if (utils::startswith(arg, "--") &&
                    registry.is_predefinition(arg.substr(2))) {
             if (is_last)
@@ -123,6 +141,8 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
         plan_manager.set_plan_filename(plan_filename);
         plan_manager.set_num_previously_generated_plans(num_previously_generated_plans);
         plan_manager.set_is_part_of_anytime_portfolio(is_part_of_anytime_portfolio);
+        if (persistent_search_time_limit > 0)
+            engine->set_max_time(persistent_search_time_limit);
     }
     return engine;
 }
@@ -149,6 +169,13 @@ shared_ptr<SearchEngine> parse_cmd_line(
     return parse_cmd_line_aux(args, registry, dry_run);
 }
 
+bool is_persistent_search(int argc, const char **argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (sanitize_arg_string(argv[i]) == "--internal-persistent-search")
+            return true;
+    }
+    return false;
+}
 
 string usage(const string &progname) {
     return "usage: \n" +
@@ -171,5 +198,9 @@ string usage(const string &progname) {
            "    This planner call is part of a portfolio which already created\n"
            "    plan files FILENAME.1 up to FILENAME.COUNTER.\n"
            "    Start enumerating plan files with COUNTER+1, i.e. FILENAME.COUNTER+1\n\n"
+           "--internal-persistent-search MAX_TIME\n"
+           "    If the search fails, wait for a larger grounding of the task on\n"
+           "    the standard input and resume the search on it. Each search is\n"
+           "    limited to MAX_TIME seconds.\n\n"
            "See https://www.fast-downward.org for details.";
 }
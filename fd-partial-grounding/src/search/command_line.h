@@ -24,6 +24,9 @@ extern std::shared_ptr<SearchEngine> parse_cmd_line(
     int argc, const char **argv, options::Registry &registry, bool dry_run,
     bool is_unit_cost);
 
+// True if the planner is asked to search successive groundings of the task.
+extern bool is_persistent_search(int argc, const char **argv);
+
 extern std::string usage(const std::string &progname);
 
 #endif
@@ -55,6 +55,31 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+void EvaluationContext::compute_sibling_results(
+    Evaluator *evaluator, const State &parent_state,
+    const vector<EvaluationContext *> &eval_contexts) {
+    vector<EvaluationContext *> missing;
+    for (EvaluationContext *eval_context : eval_contexts) {
+        if (eval_context->cache[evaluator].is_uninitialized())
+            missing.push_back(eval_context);
+    }
+    if (missing.empty())
+        return;
+    vector<EvaluationResult> results;
+    results.reserve(missing.size());
+    evaluator->compute_results(parent_state, missing, results);
+    assert(results.size() == missing.size());
+    for (size_t i = 0; i < missing.size(); ++i) {
+        EvaluationContext &eval_context = *missing[i];
+        eval_context.cache[evaluator] = move(results[i]);
+        if (eval_context.statistics &&
+            evaluator->is_used_for_counting_evaluations() &&
+            eval_context.cache[evaluator].get_count_evaluation()) {
+            eval_context.statistics->inc_evaluations();
+        }
+    }
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
@@ -7,6 +7,7 @@
 #include "task_proxy.h"
 
 #include <unordered_map>
+#include <vector>
 
 class Evaluator;
 class SearchStatistics;
@@ -89,6 +90,14 @@ public:
         SearchStatistics *statistics = nullptr, bool calculate_preferred = false);
 
     const EvaluationResult &get_result(Evaluator *eval);
+    /*
+      Compute the results of eval for several successors of parent_state at
+      once (see Evaluator::compute_results) and cache them in their contexts.
+      Contexts that already contain a result for eval are skipped.
+    */
+    static void compute_sibling_results(
+        Evaluator *eval, const State &parent_state,
+        const std::vector<EvaluationContext *> &eval_contexts);
     const EvaluatorCache &get_cache() const;
     const State &get_state() const;
     int get_g_value() const;
@@ -6,6 +6,7 @@
 #include "../utils/logging.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
@@ -84,6 +85,22 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results computes the results for the evaluation contexts of
+      several successors of parent_state at once (e.g., siblings that are
+      evaluated in one batch by lazy search) and appends them to results in
+      the same order. Evaluators can override it to share work between the
+      siblings. The default implementation calls compute_result for every
+      context.
+
+      As for compute_result, the results should not be added to the
+      evaluation contexts.
+    */
+    virtual void compute_results(
+        const State &parent_state,
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<EvaluationResult> &results);
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
@@ -4,23 +4,74 @@
 #include "../plugin.h"
 
 #include "../task_utils/task_properties.h"
+#include "../utils/language.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <vector>
 
 using namespace std;
 
 namespace additive_heuristic {
 const int AdditiveHeuristic::MAX_COST_VALUE;
+constexpr double AdditiveHeuristic::MAX_REPAIR_FRACTION;
+const int AdditiveHeuristic::MAX_REPAIR_BACKOFF;
 
 // construction and destruction
 AdditiveHeuristic::AdditiveHeuristic(const Options &opts)
     : RelaxationHeuristic(opts),
-      did_write_overflow_warning(false) {
+      did_write_overflow_warning(false),
+      incremental(opts.get<bool>("incremental")),
+      positive_costs(true),
+      repair_backoff(0),
+      num_skipped_repairs(0),
+      num_computations(0),
+      num_repair_attempts(0) {
     if (log.is_at_least_normal()) {
         log << "Initializing additive heuristic..." << endl;
     }
+    for (const UnaryOperator &op : unary_operators) {
+        if (op.base_cost == 0) {
+            positive_costs = false;
+            break;
+        }
+    }
+    if (incremental && !positive_costs) {
+        if (log.is_warning()) {
+            log << "WARNING: incremental h^add computation needs positive "
+                << "operator costs, computing it from scratch" << endl;
+        }
+        incremental = false;
+    }
+    if (incremental)
+        build_achievers();
+    repair_costs = incremental;
+}
+
+void AdditiveHeuristic::add_options_to_parser(OptionParser &parser) {
+    Heuristic::add_options_to_parser(parser);
+    parser.add_option<bool>(
+        "incremental",
+        "repair the costs of the previously evaluated state from the facts "
+        "that changed instead of recomputing them from scratch. The h^add "
+        "values are unchanged, but ties are broken differently, which can "
+        "change the relaxed plans and the preferred operators.",
+        "false");
+}
+
+void AdditiveHeuristic::build_achievers() {
+    assert(positive_costs);
+    vector<vector<OpID>> achievers_by_prop(propositions.size());
+    for (size_t op_id = 0; op_id < unary_operators.size(); ++op_id)
+        achievers_by_prop[unary_operators[op_id].effect].push_back(op_id);
+    achievers.reserve(propositions.size());
+    num_achievers.reserve(propositions.size());
+    for (const vector<OpID> &prop_achievers : achievers_by_prop) {
+        achievers.push_back(achievers_pool.append(prop_achievers));
+        num_achievers.push_back(prop_achievers.size());
+    }
 }
 
 void AdditiveHeuristic::write_overflow_warning() {
@@ -75,7 +126,8 @@ void AdditiveHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        // Repairs need the costs of all propositions.
+        if (prop->is_goal && --unsolved_goals == 0 && !repair_costs)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
@@ -116,10 +168,172 @@ void AdditiveHeuristic::mark_preferred_operators(
     }
 }
 
+int AdditiveHeuristic::compute_operator_cost(OpID op_id) {
+    UnaryOperator *unary_op = get_operator(op_id);
+    int cost = unary_op->base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_proposition(precond)->cost;
+        if (precond_cost == -1)
+            return -1;
+        increase_cost(cost, precond_cost);
+    }
+    unary_op->cost = cost;
+    return cost;
+}
+
+// Costs of -1 (unreachable) are larger than all other costs in the repair.
+static int cost_or_infinity(int cost) {
+    return cost == -1 ? numeric_limits<int>::max() : cost;
+}
+
+void AdditiveHeuristic::enqueue_if_inconsistent(PropID prop_id) {
+    int cost = get_proposition(prop_id)->cost;
+    if (cost != rhs[prop_id]) {
+        queue.push(min(cost_or_infinity(cost), cost_or_infinity(rhs[prop_id])),
+                   prop_id);
+    }
+}
+
+void AdditiveHeuristic::update_rhs(PropID prop_id) {
+    Proposition *prop = get_proposition(prop_id);
+    int best_cost = -1;
+    OpID best_op = NO_OP;
+    if (in_state[prop_id]) {
+        best_cost = 0;
+    } else {
+        for (OpID op_id : achievers_pool.get_slice(
+                 achievers[prop_id], num_achievers[prop_id])) {
+            int cost = compute_operator_cost(op_id);
+            if (cost != -1 && (best_cost == -1 || cost < best_cost)) {
+                best_cost = cost;
+                best_op = op_id;
+            }
+        }
+    }
+    rhs[prop_id] = best_cost;
+    prop->reached_by = best_op;
+    enqueue_if_inconsistent(prop_id);
+}
+
+/*
+  Repairs the costs computed for last_state_values for the given state.
+  Propositions are processed in the order of min(cost, rhs): if the cost is
+  too high, it is lowered to rhs and the rhs values of the effects of the
+  operators using the proposition can decrease. If it is too low, the cost is
+  set to unreachable, and rhs is recomputed for the proposition and for the
+  effects that were reached with it. When no proposition is inconsistent,
+  the costs are the same as those of a full computation.
+
+  Returns false if too many propositions need to be processed. The costs
+  must then be computed from scratch.
+*/
+bool AdditiveHeuristic::repair_exploration(const State &state) {
+    assert(!last_state_values.empty());
+    queue.clear();
+    vector<PropID> changed_props;
+    for (FactProxy fact : state) {
+        int var = fact.get_variable().get_id();
+        int old_value = last_state_values[var];
+        if (fact.get_value() != old_value) {
+            PropID old_prop = get_prop_id(var, old_value);
+            PropID new_prop = get_prop_id(fact);
+            in_state[old_prop] = false;
+            in_state[new_prop] = true;
+            changed_props.push_back(old_prop);
+            changed_props.push_back(new_prop);
+        }
+    }
+    for (PropID prop_id : changed_props)
+        update_rhs(prop_id);
+
+    int max_processed = MAX_REPAIR_FRACTION * propositions.size();
+    int num_processed = 0;
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int key = top_pair.first;
+        PropID prop_id = top_pair.second;
+        Proposition *prop = get_proposition(prop_id);
+        int cost = cost_or_infinity(prop->cost);
+        int new_cost = cost_or_infinity(rhs[prop_id]);
+        if (cost == new_cost || min(cost, new_cost) != key)
+            continue;
+        if (++num_processed > max_processed)
+            return false;
+        if (cost > new_cost) {
+            prop->cost = rhs[prop_id];
+            for (OpID op_id : precondition_of_pool.get_slice(
+                     prop->precondition_of, prop->num_precondition_occurences)) {
+                PropID effect = get_operator(op_id)->effect;
+                if (in_state[effect])
+                    continue;
+                int op_cost = compute_operator_cost(op_id);
+                if (op_cost != -1 && (rhs[effect] == -1 || op_cost < rhs[effect])) {
+                    rhs[effect] = op_cost;
+                    get_proposition(effect)->reached_by = op_id;
+                    enqueue_if_inconsistent(effect);
+                }
+            }
+        } else {
+            prop->cost = -1;
+            update_rhs(prop_id);
+            for (OpID op_id : precondition_of_pool.get_slice(
+                     prop->precondition_of, prop->num_precondition_occurences)) {
+                PropID effect = get_operator(op_id)->effect;
+                if (get_proposition(effect)->reached_by == op_id)
+                    update_rhs(effect);
+            }
+        }
+    }
+
+    for (Proposition &prop : propositions)
+        prop.marked = false;
+    return true;
+}
+
+bool AdditiveHeuristic::try_repair_exploration(const State &state) {
+    // Without stored costs there is nothing to repair, which is no failed repair.
+    if (last_state_values.empty())
+        return false;
+    if (num_skipped_repairs < repair_backoff) {
+        ++num_skipped_repairs;
+        return false;
+    }
+    num_skipped_repairs = 0;
+    ++num_repair_attempts;
+    if (repair_exploration(state)) {
+        repair_backoff = 0;
+        return true;
+    }
+    repair_backoff = min(max(1, 2 * repair_backoff), MAX_REPAIR_BACKOFF);
+    return false;
+}
+
+void AdditiveHeuristic::reset_repair() {
+    last_state_values.clear();
+    repair_backoff = 0;
+    num_skipped_repairs = 0;
+}
+
 int AdditiveHeuristic::compute_add_and_ff(const State &state) {
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+    ++num_computations;
+    if (!repair_costs || !try_repair_exploration(state)) {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+        if (repair_costs) {
+            rhs.resize(propositions.size());
+            for (size_t prop_id = 0; prop_id < propositions.size(); ++prop_id)
+                rhs[prop_id] = propositions[prop_id].cost;
+            in_state.assign(propositions.size(), false);
+            for (FactProxy fact : state)
+                in_state[get_prop_id(fact)] = true;
+        }
+    }
+    if (repair_costs) {
+        last_state_values.resize(state.size());
+        for (FactProxy fact : state)
+            last_state_values[fact.get_variable().get_id()] = fact.get_value();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -142,6 +356,32 @@ int AdditiveHeuristic::compute_heuristic(const State &ancestor_state) {
     return h;
 }
 
+void AdditiveHeuristic::compute_results(
+    const State &parent_state, const vector<EvaluationContext *> &eval_contexts,
+    vector<EvaluationResult> &results) {
+    if (incremental || !positive_costs || eval_contexts.size() < 2) {
+        Heuristic::compute_results(parent_state, eval_contexts, results);
+        return;
+    }
+    if (achievers.empty())
+        build_achievers();
+    // The stored costs are only valid within the batch.
+    reset_repair();
+    repair_costs = true;
+    int computations_before = num_computations;
+    int repair_attempts_before = num_repair_attempts;
+    Heuristic::compute_results(parent_state, eval_contexts, results);
+    repair_costs = false;
+    /*
+      Only the first computed sibling starts from scratch (cached siblings
+      are not computed), so every batch with two computed siblings repairs.
+    */
+    assert(num_computations - computations_before < 2 ||
+           num_repair_attempts > repair_attempts_before);
+    utils::unused_variable(computations_before);
+    utils::unused_variable(repair_attempts_before);
+}
+
 void AdditiveHeuristic::compute_heuristic_for_cegar(const State &state) {
     compute_heuristic(state);
 }
@@ -160,7 +400,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes for tasks without axioms");
     parser.document_property("preferred operators", "yes");
 
-    Heuristic::add_options_to_parser(parser);
+    AdditiveHeuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
@@ -7,6 +7,7 @@
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <vector>
 
 class State;
 
@@ -29,12 +30,70 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
      */
     static const int MAX_COST_VALUE = 100000000;
 
+    /*
+      If repair_exploration has to process more than this fraction of the
+      propositions, it gives up and the costs are computed from scratch.
+    */
+    static constexpr double MAX_REPAIR_FRACTION = 0.25;
+    /*
+      After a failed repair, the next repair_backoff states are computed from
+      scratch. The backoff doubles with every failed repair (up to
+      MAX_REPAIR_BACKOFF) and is reset by a successful one, so that tasks
+      where most repairs fail cost little more than full computations.
+    */
+    static const int MAX_REPAIR_BACKOFF = 64;
+
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
+    /*
+      With incremental=true, the exploration does not stop when all goals are
+      reached, so that the costs of all propositions are exact. The next
+      computation then repairs these costs from the facts in which the new
+      state differs from the previous one instead of starting from scratch.
+      The repair is the DynamicSWSF-FP algorithm of Ramalingam and Reps, as
+      used for h^add by Liu, Koenig and Furcy (AAAI 2002): rhs[prop_id] is the
+      cost of prop_id according to the costs of the preconditions of its
+      achievers, and only propositions with cost != rhs are processed. It
+      needs positive costs for all unary operators.
+
+      The h^add values are the same as for a full computation, but ties
+      between achievers can be broken differently, which can change the
+      relaxed plans of h^FF and the preferred operators.
+
+      Without incremental=true, compute_results still repairs the costs from
+      one sibling to the next, since siblings differ in few facts. Only the
+      first sibling of a batch is computed from scratch.
+    */
+    bool incremental;
+    bool positive_costs;
+    // True while the costs are repaired (incremental=true or in compute_results)
+    bool repair_costs;
+    // Values of the state whose costs are stored (empty before the first computation)
+    std::vector<int> last_state_values;
+    std::vector<bool> in_state;
+    std::vector<int> rhs;
+    int repair_backoff;
+    int num_skipped_repairs;
+    // Counted for the check that sibling batches go through the repair
+    int num_computations;
+    int num_repair_attempts;
+    // achievers[prop_id]: unary operators with effect prop_id
+    array_pool::ArrayPool achievers_pool;
+    std::vector<array_pool::ArrayPoolIndex> achievers;
+    std::vector<int> num_achievers;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
+
+    void build_achievers();
+    void reset_repair();
+    int compute_operator_cost(OpID op_id);
+    void enqueue_if_inconsistent(PropID prop_id);
+    void update_rhs(PropID prop_id);
+    bool repair_exploration(const State &state);
+    bool try_repair_exploration(const State &state);
     void mark_preferred_operators(const State &state, PropID goal_id);
 
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
@@ -67,6 +126,13 @@ protected:
 public:
     explicit AdditiveHeuristic(const options::Options &opts);
 
+    virtual void compute_results(
+        const State &parent_state,
+        const std::vector<EvaluationContext *> &eval_contexts,
+        std::vector<EvaluationResult> &results) override;
+
+    static void add_options_to_parser(options::OptionParser &parser);
+
     /*
       TODO: The two methods below are temporarily needed for the CEGAR
       heuristic. In the long run it might be better to split the
@@ -76,7 +76,13 @@ LandmarkCountHeuristic::LandmarkCountHeuristic(const options::Options &opts)
         }
     }
 
-    lgraph = lm_graph_factory->compute_lm_graph(task);
+    /*
+      The landmark generation does not depend on the operator costs, so the
+      graph is computed for the root task. This way, heuristics with different
+      cost transformations can share one predefined landmark factory (see the
+      LAMA configurations) and the graph is only generated once.
+    */
+    lgraph = lm_graph_factory->compute_lm_graph(tasks::g_root_task);
     assert(lm_graph_factory->achievers_are_calculated());
     if (log.is_at_least_normal()) {
         log << "Landmark graph generation time: " << lm_graph_timer << endl;
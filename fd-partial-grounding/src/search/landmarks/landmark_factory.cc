@@ -305,6 +305,25 @@ void add_only_causal_landmarks_option_to_parser(
                             "false");
 }
 
+void add_threads_option_to_parser(OptionParser &parser) {
+    parser.add_option<int>(
+        "threads",
+        "number of threads used for generating landmarks. The generated "
+        "landmark graph does not depend on the number of threads.",
+        "1",
+        Bounds("1", "infinity"));
+}
+
+void add_max_time_option_to_parser(OptionParser &parser) {
+    parser.add_option<double>(
+        "max_time",
+        "maximum time in seconds for generating landmarks. If the limit is "
+        "reached, the factory stops and only returns landmarks that are "
+        "known to be correct at that point.",
+        "infinity",
+        Bounds("0.0", "infinity"));
+}
+
 
 static PluginTypePlugin<LandmarkFactory> _type_plugin(
     "LandmarkFactory",
@@ -81,6 +81,8 @@ private:
 extern void add_landmark_factory_options_to_parser(options::OptionParser &parser);
 extern void add_use_orders_option_to_parser(options::OptionParser &parser);
 extern void add_only_causal_landmarks_option_to_parser(options::OptionParser &parser);
+extern void add_threads_option_to_parser(options::OptionParser &parser);
+extern void add_max_time_option_to_parser(options::OptionParser &parser);
 }
 
 #endif
@@ -9,18 +9,29 @@
 
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
+#include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
+#include <atomic>
+
 using namespace std;
 using utils::ExitCode;
 
 namespace landmarks {
-// alist = alist \cup other
-template<typename T>
-void union_with(list<T> &alist, const list<T> &other) {
+/*
+  Chunks of triggered operators are processed in parallel. A chunk is
+  complete once it contains this many landmark sets of operators and
+  conditional noops. The chunks must not depend on the number of threads.
+*/
+static const int PM_OP_CHUNK_SIZE = 4096;
+
+// alist = alist \cup other (other is a sorted list or vector)
+template<typename T, typename Container>
+void union_with(list<T> &alist, const Container &other) {
     typename list<T>::iterator it1 = alist.begin();
-    typename list<T>::const_iterator it2 = other.begin();
+    typename Container::const_iterator it2 = other.begin();
 
     while ((it1 != alist.end()) && (it2 != other.end())) {
         if (*it1 < *it2) {
@@ -36,11 +47,11 @@ void union_with(list<T> &alist, const list<T> &other) {
     alist.insert(it1, it2, other.end());
 }
 
-// alist = alist \cap other
-template<typename T>
-void intersect_with(list<T> &alist, const list<T> &other) {
+// alist = alist \cap other (other is a sorted list or vector)
+template<typename T, typename Container>
+void intersect_with(list<T> &alist, const Container &other) {
     typename list<T>::iterator it1 = alist.begin(), tmp;
-    typename list<T>::const_iterator it2 = other.begin();
+    typename Container::const_iterator it2 = other.begin();
 
     while ((it1 != alist.end()) && (it2 != other.end())) {
         if (*it1 < *it2) {
@@ -98,8 +109,8 @@ void insert_into(list<T> &alist, const T &val) {
 }
 
 template<typename T>
-static bool contains(list<T> &alist, const T &val) {
-    return find(alist.begin(), alist.end(), val) != alist.end();
+static bool contains(const vector<T> &sorted_vector, const T &val) {
+    return binary_search(sorted_vector.begin(), sorted_vector.end(), val);
 }
 
 
@@ -452,114 +463,135 @@ bool LandmarkFactoryHM::possible_noop_set(const VariablesProxy &variables,
 }
 
 
-// make the operators of the P_m problem
-void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
+// make the operator of the P_m problem for op
+// (its preconditions are registered in h_m_table_ by build_pm_ops)
+void LandmarkFactoryHM::build_pm_op(const VariablesProxy &variables,
+                                    const OperatorProxy &op) {
     FluentSet pc, eff;
     vector<FluentSet> pc_subsets, eff_subsets, noop_pc_subsets, noop_eff_subsets;
 
-    static int op_count = 0;
-    int set_index, noop_index;
-
-    OperatorsProxy operators = task_proxy.get_operators();
-    pm_ops_.resize(operators.size());
+    PMOp &pm_op = pm_ops_[op.get_id()];
 
-    // set unsatisfied precondition counts, used in fixpoint calculation
-    unsat_pc_count_.resize(operators.size());
+    // preconditions of P_m op are all subsets of original pc
+    pc = get_operator_precondition(op);
+    get_m_sets(variables, m_, pc_subsets, pc);
+    pm_op.pc.reserve(pc_subsets.size());
 
-    VariablesProxy variables = task_proxy.get_variables();
+    // set unsatisfied pc count for op
+    unsat_pc_count_[op.get_id()].first = pc_subsets.size();
 
-    // transfer ops from original problem
-    // represent noops as "conditional" effects
-    for (OperatorProxy op : operators) {
-        PMOp &pm_op = pm_ops_[op.get_id()];
-        pm_op.index = op_count++;
-
-        pc_subsets.clear();
-        eff_subsets.clear();
-
-        // preconditions of P_m op are all subsets of original pc
-        pc = get_operator_precondition(op);
-        get_m_sets(variables, m_, pc_subsets, pc);
-        pm_op.pc.reserve(pc_subsets.size());
+    for (const FluentSet &pc_subset : pc_subsets) {
+        assert(set_indices_.find(pc_subset) != set_indices_.end());
+        pm_op.pc.push_back(set_indices_.at(pc_subset));
+    }
 
-        // set unsatisfied pc count for op
-        unsat_pc_count_[op.get_id()].first = pc_subsets.size();
+    // same for effects
+    eff = get_operator_postcondition(variables.size(), op);
+    get_m_sets(variables, m_, eff_subsets, eff);
+    pm_op.eff.reserve(eff_subsets.size());
 
-        for (const FluentSet &pc_subset : pc_subsets) {
-            assert(set_indices_.find(pc_subset) != set_indices_.end());
-            set_index = set_indices_[pc_subset];
-            pm_op.pc.push_back(set_index);
-            h_m_table_[set_index].pc_for.emplace_back(op.get_id(), -1);
-        }
+    for (const FluentSet &eff_subset : eff_subsets) {
+        assert(set_indices_.find(eff_subset) != set_indices_.end());
+        pm_op.eff.push_back(set_indices_.at(eff_subset));
+    }
 
-        // same for effects
-        eff = get_operator_postcondition(variables.size(), op);
-        get_m_sets(variables, m_, eff_subsets, eff);
-        pm_op.eff.reserve(eff_subsets.size());
+    // For all subsets used in the problem with size *<* m, check whether
+    // they conflict with the effect of the operator (no need to check pc
+    // because mvvs appearing in pc also appear in effect
 
-        for (const FluentSet &eff_subset : eff_subsets) {
-            assert(set_indices_.find(eff_subset) != set_indices_.end());
-            set_index = set_indices_[eff_subset];
-            pm_op.eff.push_back(set_index);
-        }
+    FluentSetToIntMap::const_iterator it = set_indices_.begin();
+    while (static_cast<int>(it->first.size()) < m_
+           && it != set_indices_.end()) {
+        if (possible_noop_set(variables, eff, it->first)) {
+            // for each such set, add a "conditional effect" to the operator
+            pm_op.cond_noops.resize(pm_op.cond_noops.size() + 1);
 
-        noop_index = 0;
+            vector<int> &this_cond_noop = pm_op.cond_noops.back();
 
-        // For all subsets used in the problem with size *<* m, check whether
-        // they conflict with the effect of the operator (no need to check pc
-        // because mvvs appearing in pc also appear in effect
+            noop_pc_subsets.clear();
+            noop_eff_subsets.clear();
 
-        FluentSetToIntMap::const_iterator it = set_indices_.begin();
-        while (static_cast<int>(it->first.size()) < m_
-               && it != set_indices_.end()) {
-            if (possible_noop_set(variables, eff, it->first)) {
-                // for each such set, add a "conditional effect" to the operator
-                pm_op.cond_noops.resize(pm_op.cond_noops.size() + 1);
+            // get the subsets that have >= 1 element in the pc (unless pc is empty)
+            // and >= 1 element in the other set
 
-                vector<int> &this_cond_noop = pm_op.cond_noops.back();
+            get_split_m_sets(variables, m_, noop_pc_subsets, pc, it->first);
+            get_split_m_sets(variables, m_, noop_eff_subsets, eff, it->first);
 
-                noop_pc_subsets.clear();
-                noop_eff_subsets.clear();
+            this_cond_noop.reserve(noop_pc_subsets.size() + noop_eff_subsets.size() + 1);
 
-                // get the subsets that have >= 1 element in the pc (unless pc is empty)
-                // and >= 1 element in the other set
+            unsat_pc_count_[op.get_id()].second.push_back(noop_pc_subsets.size());
 
-                get_split_m_sets(variables, m_, noop_pc_subsets, pc, it->first);
-                get_split_m_sets(variables, m_, noop_eff_subsets, eff, it->first);
+            // push back all noop preconditions
+            for (size_t j = 0; j < noop_pc_subsets.size(); ++j) {
+                assert(static_cast<int>(noop_pc_subsets[j].size()) <= m_);
+                assert(set_indices_.find(noop_pc_subsets[j]) != set_indices_.end());
+                this_cond_noop.push_back(set_indices_.at(noop_pc_subsets[j]));
+            }
 
-                this_cond_noop.reserve(noop_pc_subsets.size() + noop_eff_subsets.size() + 1);
+            // separator
+            this_cond_noop.push_back(-1);
 
-                unsat_pc_count_[op.get_id()].second.push_back(noop_pc_subsets.size());
+            // and the noop effects
+            for (size_t j = 0; j < noop_eff_subsets.size(); ++j) {
+                assert(static_cast<int>(noop_eff_subsets[j].size()) <= m_);
+                assert(set_indices_.find(noop_eff_subsets[j]) != set_indices_.end());
+                this_cond_noop.push_back(set_indices_.at(noop_eff_subsets[j]));
+            }
+        }
+        ++it;
+    }
+}
 
-                // push back all noop preconditions
-                for (size_t j = 0; j < noop_pc_subsets.size(); ++j) {
-                    assert(static_cast<int>(noop_pc_subsets[j].size()) <= m_);
-                    assert(set_indices_.find(noop_pc_subsets[j]) != set_indices_.end());
+// make the operators of the P_m problem
+bool LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy,
+                                     const utils::CountdownTimer &timer) {
+    static int op_count = 0;
 
-                    set_index = set_indices_[noop_pc_subsets[j]];
-                    this_cond_noop.push_back(set_index);
-                    // these facts are "conditional pcs" for this action
-                    h_m_table_[set_index].pc_for.emplace_back(op.get_id(), noop_index);
-                }
+    OperatorsProxy operators = task_proxy.get_operators();
+    pm_ops_.resize(operators.size());
 
-                // separator
-                this_cond_noop.push_back(-1);
+    // set unsatisfied precondition counts, used in fixpoint calculation
+    unsat_pc_count_.resize(operators.size());
 
-                // and the noop effects
-                for (size_t j = 0; j < noop_eff_subsets.size(); ++j) {
-                    assert(static_cast<int>(noop_eff_subsets[j].size()) <= m_);
-                    assert(set_indices_.find(noop_eff_subsets[j]) != set_indices_.end());
+    VariablesProxy variables = task_proxy.get_variables();
 
-                    set_index = set_indices_[noop_eff_subsets[j]];
-                    this_cond_noop.push_back(set_index);
-                }
+    // transfer ops from original problem
+    // represent noops as "conditional" effects
+    atomic<bool> time_limit_reached(false);
+    utils::parallel_for(
+        num_threads, operators.size(),
+        [&](int op_id, int) {
+            if (time_limit_reached)
+                return;
+            if (timer.is_expired()) {
+                time_limit_reached = true;
+                return;
+            }
+            build_pm_op(variables, operators[op_id]);
+        });
+    if (time_limit_reached)
+        return false;
 
-                ++noop_index;
+    // Register the preconditions in the order of the operators, so that the
+    // pc_for lists do not depend on the number of threads.
+    for (OperatorProxy op : operators) {
+        PMOp &pm_op = pm_ops_[op.get_id()];
+        pm_op.index = op_count++;
+        for (int set_index : pm_op.pc) {
+            h_m_table_[set_index].pc_for.emplace_back(op.get_id(), -1);
+        }
+        for (size_t noop_index = 0; noop_index < pm_op.cond_noops.size();
+             ++noop_index) {
+            // these facts are "conditional pcs" for this action
+            for (int set_index : pm_op.cond_noops[noop_index]) {
+                if (set_index == -1)
+                    break;
+                h_m_table_[set_index].pc_for.emplace_back(op.get_id(), noop_index);
             }
-            ++it;
         }
         print_pm_op(variables, pm_op);
     }
+    return true;
 }
 
 bool LandmarkFactoryHM::interesting(const VariablesProxy &variables,
@@ -573,10 +605,13 @@ LandmarkFactoryHM::LandmarkFactoryHM(const options::Options &opts)
     : LandmarkFactory(opts),
       m_(opts.get<int>("m")),
       conjunctive_landmarks(opts.get<bool>("conjunctive_landmarks")),
-      use_orders(opts.get<bool>("use_orders")) {
+      use_orders(opts.get<bool>("use_orders")),
+      num_threads(opts.get<int>("threads")),
+      max_time(opts.get<double>("max_time")) {
 }
 
-void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
+bool LandmarkFactoryHM::initialize(const TaskProxy &task_proxy,
+                                   const utils::CountdownTimer &timer) {
     if (log.is_at_least_normal()) {
         log << "h^m landmarks m=" << m_ << endl;
     }
@@ -598,7 +633,7 @@ void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
         log << "Using " << h_m_table_.size() << " P^m fluents." << endl;
     }
 
-    build_pm_ops(task_proxy);
+    return build_pm_ops(task_proxy, timer);
 }
 
 void LandmarkFactoryHM::postprocess(const TaskProxy &task_proxy) {
@@ -731,7 +766,154 @@ void LandmarkFactoryHM::propagate_pm_fact(int factindex, bool newly_discovered,
     }
 }
 
-void LandmarkFactoryHM::compute_h_m_landmarks(const TaskProxy &task_proxy) {
+void LandmarkFactoryHM::compute_triggered_pm_op_landmarks(
+    int op_index, const set<int> &triggered_noops,
+    TriggeredPMOp &result) const {
+    const PMOp &action = pm_ops_[op_index];
+    const pair<int, vector<int>> &unsat_pc_count = unsat_pc_count_[op_index];
+    result.op_index = op_index;
+
+    // landmarks changed for action itself, have to recompute
+    // landmarks for all noop effects
+    if (triggered_noops.empty()) {
+        for (size_t i = 0; i < action.cond_noops.size(); ++i) {
+            // actions pcs are satisfied, but cond. effects may still have
+            // unsatisfied pcs
+            if (unsat_pc_count.second[i] == 0) {
+                result.noops.push_back(i);
+            }
+        }
+    }
+    // only recompute landmarks for conditions whose
+    // landmarks have changed
+    else {
+        for (int noop_index : triggered_noops) {
+            assert(unsat_pc_count.second[noop_index] == 0);
+            result.noops.push_back(noop_index);
+        }
+    }
+    result.landmarks.reserve(result.noops.size() + 1);
+    result.necessary.reserve(result.noops.size() + 1);
+
+    // gather landmarks for pcs
+    // in the set of landmarks for each fact, the fact itself is not stored
+    // (only landmarks preceding it)
+    list<int> local_landmarks;
+    list<int> local_necessary;
+    for (int pc : action.pc) {
+        union_with(local_landmarks, h_m_table_[pc].landmarks);
+        insert_into(local_landmarks, pc);
+
+        if (use_orders) {
+            insert_into(local_necessary, pc);
+        }
+    }
+    result.landmarks.emplace_back(local_landmarks.begin(), local_landmarks.end());
+    result.necessary.emplace_back(local_necessary.begin(), local_necessary.end());
+
+    for (int noop_index : result.noops) {
+        list<int> cn_landmarks = local_landmarks;
+        list<int> cn_necessary;
+        if (use_orders) {
+            cn_necessary = local_necessary;
+        }
+        int pm_fluent;
+        for (size_t i = 0; (pm_fluent = action.cond_noops[noop_index][i]) != -1; ++i) {
+            union_with(cn_landmarks, h_m_table_[pm_fluent].landmarks);
+            insert_into(cn_landmarks, pm_fluent);
+
+            if (use_orders) {
+                insert_into(cn_necessary, pm_fluent);
+            }
+        }
+        result.landmarks.emplace_back(cn_landmarks.begin(), cn_landmarks.end());
+        result.necessary.emplace_back(cn_necessary.begin(), cn_necessary.end());
+    }
+}
+
+LandmarkFactoryHM::PMFactUpdate LandmarkFactoryHM::update_pm_fact(
+    int factindex, const vector<int> &landmarks, const vector<int> &necessary,
+    int op_index, int level) {
+    HMEntry &entry = h_m_table_[factindex];
+    if (entry.level != -1) {
+        size_t prev_size = entry.landmarks.size();
+        intersect_with(entry.landmarks, landmarks);
+
+        // if the add effect appears in landmarks,
+        // fact is being achieved for >1st time
+        // no need to intersect for gn orderings
+        // or add op to first achievers
+        if (!contains(landmarks, factindex)) {
+            insert_into(entry.first_achievers, op_index);
+            if (use_orders) {
+                intersect_with(entry.necessary, necessary);
+            }
+        }
+
+        if (entry.landmarks.size() != prev_size)
+            return PMFactUpdate::CHANGED;
+        return PMFactUpdate::UNCHANGED;
+    } else {
+        entry.level = level;
+        entry.landmarks.assign(landmarks.begin(), landmarks.end());
+        if (use_orders) {
+            entry.necessary.assign(necessary.begin(), necessary.end());
+        }
+        insert_into(entry.first_achievers, op_index);
+        return PMFactUpdate::DISCOVERED;
+    }
+}
+
+/*
+  Update the effects of the operator and its noops whose index is in the
+  given partition. The first update of each fact is recorded in updates and
+  updated_facts.
+*/
+void LandmarkFactoryHM::update_triggered_pm_op_effects(
+    const TriggeredPMOp &triggered_op, int level, int partition,
+    int num_partitions, vector<PMFactUpdate> &updates,
+    vector<int> &updated_facts) {
+    auto update = [&](int pm_fluent, int landmarks_index) {
+        if (pm_fluent % num_partitions != partition)
+            return;
+        PMFactUpdate result = update_pm_fact(
+            pm_fluent, triggered_op.landmarks[landmarks_index],
+            triggered_op.necessary[landmarks_index], triggered_op.op_index,
+            level);
+        if (result != PMFactUpdate::UNCHANGED &&
+            updates[pm_fluent] == PMFactUpdate::UNCHANGED) {
+            updates[pm_fluent] = result;
+            updated_facts.push_back(pm_fluent);
+        }
+    };
+
+    const PMOp &action = pm_ops_[triggered_op.op_index];
+    for (int pm_fluent : action.eff) {
+        update(pm_fluent, 0);
+    }
+    for (size_t i = 0; i < triggered_op.noops.size(); ++i) {
+        const vector<int> &pc_eff_pair = action.cond_noops[triggered_op.noops[i]];
+        // skip the preconditions and the separator
+        size_t j = find(pc_eff_pair.begin(), pc_eff_pair.end(), -1) -
+            pc_eff_pair.begin() + 1;
+        for (; j < pc_eff_pair.size(); ++j) {
+            update(pc_eff_pair[j], i + 1);
+        }
+    }
+}
+
+/*
+  Compute the landmarks level by level. The operators triggered in a level
+  are processed in chunks (in the order of their indices). For all operators
+  of a chunk, the landmarks of their preconditions are gathered in parallel
+  from the landmarks at the start of the chunk. Then their effects are
+  updated in parallel, where each thread updates the facts of one partition
+  in the order of the operators, and finally the changed facts trigger the
+  operators for the next level. Therefore, the result does not depend on the
+  number of threads.
+*/
+bool LandmarkFactoryHM::compute_h_m_landmarks(
+    const TaskProxy &task_proxy, const utils::CountdownTimer &timer) {
     // get subsets of initial state
     vector<FluentSet> init_subsets;
     get_m_sets(task_proxy.get_variables(), m_, init_subsets, task_proxy.get_initial_state());
@@ -755,96 +937,68 @@ void LandmarkFactoryHM::compute_h_m_landmarks(const TaskProxy &task_proxy) {
         }
     }
 
-    vector<int>::iterator it;
-    TriggerSet::iterator op_it;
-
-    list<int> local_landmarks;
-    list<int> local_necessary;
-
-    size_t prev_size;
+    vector<pair<int, set<int>>> triggered_ops;
+    vector<TriggeredPMOp> chunk;
+    vector<PMFactUpdate> updates(h_m_table_.size(), PMFactUpdate::UNCHANGED);
+    vector<vector<int>> updated_facts(num_threads);
+    vector<int> changed_facts;
 
     int level = 1;
 
     // while we have actions to apply
     while (!current_trigger.empty()) {
-        for (op_it = current_trigger.begin(); op_it != current_trigger.end(); ++op_it) {
-            local_landmarks.clear();
-            local_necessary.clear();
-
-            int op_index = op_it->first;
-            PMOp &action = pm_ops_[op_index];
-
-            // gather landmarks for pcs
-            // in the set of landmarks for each fact, the fact itself is not stored
-            // (only landmarks preceding it)
-            for (it = action.pc.begin(); it != action.pc.end(); ++it) {
-                union_with(local_landmarks, h_m_table_[*it].landmarks);
-                insert_into(local_landmarks, *it);
-
-                if (use_orders) {
-                    insert_into(local_necessary, *it);
-                }
+        triggered_ops.assign(make_move_iterator(current_trigger.begin()),
+                             make_move_iterator(current_trigger.end()));
+        current_trigger.clear();
+        sort(triggered_ops.begin(), triggered_ops.end());
+
+        size_t chunk_end = 0;
+        while (chunk_end < triggered_ops.size()) {
+            if (timer.is_expired())
+                return false;
+            size_t chunk_begin = chunk_end;
+            int chunk_size = 0;
+            while (chunk_end < triggered_ops.size() && chunk_size < PM_OP_CHUNK_SIZE) {
+                const pair<int, set<int>> &triggered_op = triggered_ops[chunk_end];
+                chunk_size += 1 + (triggered_op.second.empty()
+                                   ? pm_ops_[triggered_op.first].cond_noops.size()
+                                   : triggered_op.second.size());
+                ++chunk_end;
             }
 
-            for (it = action.eff.begin(); it != action.eff.end(); ++it) {
-                if (h_m_table_[*it].level != -1) {
-                    prev_size = h_m_table_[*it].landmarks.size();
-                    intersect_with(h_m_table_[*it].landmarks, local_landmarks);
-
-                    // if the add effect appears in local landmarks,
-                    // fact is being achieved for >1st time
-                    // no need to intersect for gn orderings
-                    // or add op to first achievers
-                    if (!contains(local_landmarks, *it)) {
-                        insert_into(h_m_table_[*it].first_achievers, op_index);
-                        if (use_orders) {
-                            intersect_with(h_m_table_[*it].necessary, local_necessary);
-                        }
+            chunk.assign(chunk_end - chunk_begin, TriggeredPMOp());
+            utils::parallel_for(
+                num_threads, chunk.size(),
+                [&](int i, int) {
+                    const pair<int, set<int>> &triggered_op =
+                        triggered_ops[chunk_begin + i];
+                    compute_triggered_pm_op_landmarks(
+                        triggered_op.first, triggered_op.second, chunk[i]);
+                });
+
+            utils::parallel_for(
+                num_threads, num_threads,
+                [&](int partition, int) {
+                    for (const TriggeredPMOp &triggered_op : chunk) {
+                        update_triggered_pm_op_effects(
+                            triggered_op, level, partition, num_threads,
+                            updates, updated_facts[partition]);
                     }
+                });
 
-                    if (h_m_table_[*it].landmarks.size() != prev_size)
-                        propagate_pm_fact(*it, false, next_trigger);
-                } else {
-                    h_m_table_[*it].level = level;
-                    h_m_table_[*it].landmarks = local_landmarks;
-                    if (use_orders) {
-                        h_m_table_[*it].necessary = local_necessary;
-                    }
-                    insert_into(h_m_table_[*it].first_achievers, op_index);
-                    propagate_pm_fact(*it, true, next_trigger);
-                }
-            }
-
-            // landmarks changed for action itself, have to recompute
-            // landmarks for all noop effects
-            if (op_it->second.empty()) {
-                for (size_t i = 0; i < action.cond_noops.size(); ++i) {
-                    // actions pcs are satisfied, but cond. effects may still have
-                    // unsatisfied pcs
-                    if (unsat_pc_count_[op_index].second[i] == 0) {
-                        compute_noop_landmarks(op_index, i,
-                                               local_landmarks,
-                                               local_necessary,
-                                               level, next_trigger);
-                    }
-                }
+            for (vector<int> &facts : updated_facts) {
+                changed_facts.insert(changed_facts.end(), facts.begin(), facts.end());
+                facts.clear();
             }
-            // only recompute landmarks for conditions whose
-            // landmarks have changed
-            else {
-                for (set<int>::iterator noop_it = op_it->second.begin();
-                     noop_it != op_it->second.end(); ++noop_it) {
-                    assert(unsat_pc_count_[op_index].second[*noop_it] == 0);
-
-                    compute_noop_landmarks(op_index, *noop_it,
-                                           local_landmarks,
-                                           local_necessary,
-                                           level, next_trigger);
-                }
+            sort(changed_facts.begin(), changed_facts.end());
+            for (int fact : changed_facts) {
+                propagate_pm_fact(fact, updates[fact] == PMFactUpdate::DISCOVERED,
+                                  next_trigger);
+                updates[fact] = PMFactUpdate::UNCHANGED;
             }
+            changed_facts.clear();
         }
         current_trigger.swap(next_trigger);
-        next_trigger.clear();
 
         if (log.is_at_least_verbose()) {
             log << "Level " << level << " completed." << endl;
@@ -854,72 +1008,7 @@ void LandmarkFactoryHM::compute_h_m_landmarks(const TaskProxy &task_proxy) {
     if (log.is_at_least_normal()) {
         log << "h^m landmarks computed." << endl;
     }
-}
-
-void LandmarkFactoryHM::compute_noop_landmarks(
-    int op_index, int noop_index,
-    list<int> const &local_landmarks,
-    list<int> const &local_necessary,
-    int level,
-    TriggerSet &next_trigger) {
-    list<int> cn_necessary, cn_landmarks;
-    size_t prev_size;
-    int pm_fluent;
-
-    PMOp &action = pm_ops_[op_index];
-    vector<int> &pc_eff_pair = action.cond_noops[noop_index];
-
-    cn_landmarks.clear();
-
-    cn_landmarks = local_landmarks;
-
-    if (use_orders) {
-        cn_necessary.clear();
-        cn_necessary = local_necessary;
-    }
-
-    size_t i;
-    for (i = 0; (pm_fluent = pc_eff_pair[i]) != -1; ++i) {
-        union_with(cn_landmarks, h_m_table_[pm_fluent].landmarks);
-        insert_into(cn_landmarks, pm_fluent);
-
-        if (use_orders) {
-            insert_into(cn_necessary, pm_fluent);
-        }
-    }
-
-    // go to the beginning of the effects section
-    ++i;
-
-    for (; i < pc_eff_pair.size(); ++i) {
-        pm_fluent = pc_eff_pair[i];
-        if (h_m_table_[pm_fluent].level != -1) {
-            prev_size = h_m_table_[pm_fluent].landmarks.size();
-            intersect_with(h_m_table_[pm_fluent].landmarks, cn_landmarks);
-
-            // if the add effect appears in cn_landmarks,
-            // fact is being achieved for >1st time
-            // no need to intersect for gn orderings
-            // or add op to first achievers
-            if (!contains(cn_landmarks, pm_fluent)) {
-                insert_into(h_m_table_[pm_fluent].first_achievers, op_index);
-                if (use_orders) {
-                    intersect_with(h_m_table_[pm_fluent].necessary, cn_necessary);
-                }
-            }
-
-            if (h_m_table_[pm_fluent].landmarks.size() != prev_size)
-                propagate_pm_fact(pm_fluent, false, next_trigger);
-        } else {
-            h_m_table_[pm_fluent].level = level;
-            h_m_table_[pm_fluent].landmarks = cn_landmarks;
-            if (use_orders) {
-                h_m_table_[pm_fluent].necessary = cn_necessary;
-            }
-            insert_into(h_m_table_[pm_fluent].first_achievers, op_index);
-            propagate_pm_fact(pm_fluent, true, next_trigger);
-        }
-    }
+    return true;
 }
 
 void LandmarkFactoryHM::add_lm_node(int set_index, bool goal) {
@@ -939,8 +1028,12 @@ void LandmarkFactoryHM::add_lm_node(int set_index, bool goal) {
 void LandmarkFactoryHM::generate_landmarks(
     const shared_ptr<AbstractTask> &task) {
     TaskProxy task_proxy(*task);
-    initialize(task_proxy);
-    compute_h_m_landmarks(task_proxy);
+    utils::CountdownTimer timer(max_time);
+    if (!initialize(task_proxy, timer) ||
+        !compute_h_m_landmarks(task_proxy, timer)) {
+        add_goal_landmarks_only(task_proxy);
+        return;
+    }
     // now construct landmarks graph
     vector<FluentSet> goal_subsets;
     FluentSet goals = task_properties::get_fact_pairs(task_proxy.get_goals());
@@ -1010,6 +1103,28 @@ void LandmarkFactoryHM::generate_landmarks(
     postprocess(task_proxy);
 }
 
+/*
+  Landmarks and first achievers of an unfinished h^m computation can be
+  wrong, so if the time limit is reached, we only use the goal facts as
+  landmarks and every achiever as a possible first achiever.
+*/
+void LandmarkFactoryHM::add_goal_landmarks_only(const TaskProxy &task_proxy) {
+    if (log.is_at_least_normal()) {
+        log << "Landmark generation time limit reached, "
+            << "using only the goals as landmarks." << endl;
+    }
+    free_unneeded_memory();
+    for (FactProxy goal : task_proxy.get_goals()) {
+        Landmark landmark({goal.get_pair()}, false, false, true);
+        lm_graph->add_landmark(move(landmark));
+    }
+    postprocess(task_proxy);
+    for (auto &lm_node : lm_graph->get_nodes()) {
+        Landmark &landmark = lm_node->get_landmark();
+        landmark.first_achievers = landmark.possible_achievers;
+    }
+}
+
 bool LandmarkFactoryHM::computes_reasonable_orders() const {
     return false;
 }
@@ -1031,6 +1146,8 @@ static shared_ptr<LandmarkFactory> _parse(OptionParser &parser) {
         "true");
     add_landmark_factory_options_to_parser(parser);
     add_use_orders_option_to_parser(parser);
+    add_threads_option_to_parser(parser);
+    add_max_time_option_to_parser(parser);
     Options opts = parser.parse();
     if (parser.help_mode())
         return nullptr;
@@ -3,6 +3,10 @@
 
 #include "landmark_factory.h"
 
+namespace utils {
+class CountdownTimer;
+}
+
 namespace landmarks {
 using FluentSet = std::vector<FactPair>;
 
@@ -59,14 +63,41 @@ using FluentSetToIntMap = std::map<FluentSet, int, FluentSetComparer>;
 class LandmarkFactoryHM : public LandmarkFactory {
     using TriggerSet = std::unordered_map<int, std::set<int>>;
 
+    /*
+      Landmarks (and greedy necessary landmarks) of the preconditions of a
+      triggered operator and of its triggered conditional noops. They are
+      computed for a chunk of operators in parallel and then used to update
+      the effects of the operators (see compute_h_m_landmarks).
+    */
+    struct TriggeredPMOp {
+        int op_index;
+        std::vector<int> noops;
+        // Index 0 belongs to the operator, index i + 1 to noops[i].
+        std::vector<std::vector<int>> landmarks;
+        std::vector<std::vector<int>> necessary;
+    };
+
+    enum class PMFactUpdate {
+        UNCHANGED,
+        CHANGED,
+        DISCOVERED
+    };
+
     virtual void generate_landmarks(const std::shared_ptr<AbstractTask> &task) override;
 
-    void compute_h_m_landmarks(const TaskProxy &task_proxy);
-    void compute_noop_landmarks(int op_index, int noop_index,
-                                std::list<int> const &local_landmarks,
-                                std::list<int> const &local_necessary,
-                                int level,
-                                TriggerSet &next_trigger);
+    bool compute_h_m_landmarks(const TaskProxy &task_proxy,
+                               const utils::CountdownTimer &timer);
+    void compute_triggered_pm_op_landmarks(
+        int op_index, const std::set<int> &triggered_noops,
+        TriggeredPMOp &result) const;
+    void update_triggered_pm_op_effects(
+        const TriggeredPMOp &triggered_op, int level, int partition,
+        int num_partitions, std::vector<PMFactUpdate> &updates,
+        std::vector<int> &updated_facts);
+    PMFactUpdate update_pm_fact(int factindex,
+                                const std::vector<int> &landmarks,
+                                const std::vector<int> &necessary,
+                                int op_index, int level);
 
     void propagate_pm_fact(int factindex, bool newly_discovered,
                            TriggerSet &trigger);
@@ -74,7 +105,9 @@ class LandmarkFactoryHM : public LandmarkFactory {
     bool possible_noop_set(const VariablesProxy &variables,
                            const FluentSet &fs1,
                            const FluentSet &fs2);
-    void build_pm_ops(const TaskProxy &task_proxy);
+    void build_pm_op(const VariablesProxy &variables, const OperatorProxy &op);
+    bool build_pm_ops(const TaskProxy &task_proxy,
+                      const utils::CountdownTimer &timer);
     bool interesting(const VariablesProxy &variables,
                      const FactPair &fact1,
                      const FactPair &fact2) const;
@@ -87,7 +120,9 @@ class LandmarkFactoryHM : public LandmarkFactory {
 
     void add_lm_node(int set_index, bool goal = false);
 
-    void initialize(const TaskProxy &task_proxy);
+    bool initialize(const TaskProxy &task_proxy,
+                    const utils::CountdownTimer &timer);
+    void add_goal_landmarks_only(const TaskProxy &task_proxy);
     void free_unneeded_memory();
 
     void print_fluentset(const VariablesProxy &variables, const FluentSet &fs) const;
@@ -96,6 +131,8 @@ class LandmarkFactoryHM : public LandmarkFactory {
     const int m_;
     const bool conjunctive_landmarks;
     const bool use_orders;
+    const int num_threads;
+    const double max_time;
 
     std::map<int, LandmarkNode *> lm_node_table_;
 
@@ -1,5 +1,6 @@
 #include "landmark_factory_rpg_sasp.h"
 
+#include "exploration.h"
 #include "landmark.h"
 #include "landmark_graph.h"
 #include "util.h"
@@ -8,9 +9,13 @@
 #include "../plugin.h"
 #include "../task_proxy.h"
 
+#include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -22,7 +27,9 @@ LandmarkFactoryRpgSasp::LandmarkFactoryRpgSasp(const Options &opts)
     : LandmarkFactoryRelaxation(opts),
       disjunctive_landmarks(opts.get<bool>("disjunctive_landmarks")),
       use_orders(opts.get<bool>("use_orders")),
-      only_causal_landmarks(opts.get<bool>("only_causal_landmarks")) {
+      only_causal_landmarks(opts.get<bool>("only_causal_landmarks")),
+      num_threads(opts.get<int>("threads")),
+      max_time(opts.get<double>("max_time")) {
 }
 
 void LandmarkFactoryRpgSasp::build_dtg_successors(const TaskProxy &task_proxy) {
@@ -170,6 +177,8 @@ void LandmarkFactoryRpgSasp::found_simple_lm_and_order(
         if (it != open_landmarks.end()) {
             open_landmarks.erase(it);
         }
+        replace(backchaining_landmarks.begin(), backchaining_landmarks.end(),
+                disj_lm, static_cast<LandmarkNode *>(nullptr));
         forward_orders.erase(disj_lm);
 
         // Retrieve incoming edges from disj_lm
@@ -237,31 +246,25 @@ void LandmarkFactoryRpgSasp::found_disj_lm_and_order(
     edge_add(*new_lm_node, b, t);
 }
 
-void LandmarkFactoryRpgSasp::compute_shared_preconditions(
-    const TaskProxy &task_proxy, unordered_map<int, int> &shared_pre,
-    vector<vector<bool>> &reached, const Landmark &landmark) {
+void LandmarkFactoryRpgSasp::compute_achiever_preconditions(
+    const TaskProxy &task_proxy, const vector<vector<bool>> &reached,
+    const Landmark &landmark,
+    vector<unordered_map<int, int>> &achiever_preconditions) const {
     /*
-      Compute the shared preconditions of all operators that can potentially
-      achieve landmark bp, given the reachability in the relaxed planning graph.
+      Compute the greedy preconditions of all operators that can potentially
+      achieve the landmark, given the reachability in the relaxed planning
+      graph. An operator that achieves several facts of a disjunctive
+      landmark occurs once per fact.
     */
-    bool init = true;
     for (const FactPair &lm_fact : landmark.facts) {
         const vector<int> &op_ids = get_operators_including_eff(lm_fact);
 
         for (int op_or_axiom_id : op_ids) {
             OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axiom_id);
-            if (!init && shared_pre.empty())
-                break;
-
             if (possibly_reaches_lm(op, reached, landmark)) {
-                unordered_map<int, int> next_pre;
-                get_greedy_preconditions_for_lm(task_proxy, landmark,
-                                                op, next_pre);
-                if (init) {
-                    init = false;
-                    shared_pre = next_pre;
-                } else
-                    shared_pre = _intersect(shared_pre, next_pre);
+                achiever_preconditions.emplace_back();
+                get_greedy_preconditions_for_lm(task_proxy, landmark, op,
+                                                achiever_preconditions.back());
             }
         }
     }
@@ -334,8 +337,8 @@ void LandmarkFactoryRpgSasp::build_disjunction_classes(const TaskProxy &task_pro
 }
 
 void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
-    const TaskProxy &task_proxy, vector<set<FactPair>> &disjunctive_pre,
-    vector<vector<bool>> &reached, const Landmark &landmark) {
+    const vector<unordered_map<int, int>> &achiever_preconditions,
+    vector<set<FactPair>> &disjunctive_pre) const {
     /*
       Compute disjunctive preconditions from all operators than can potentially
       achieve landmark bp, given the reachability in the relaxed planning graph.
@@ -344,38 +347,26 @@ void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
       each fact in the set stems from the same PDDL predicate.
     */
 
-    vector<int> op_or_axiom_ids;
-    for (const FactPair &lm_fact : landmark.facts) {
-        const vector<int> &tmp_op_or_axiom_ids = get_operators_including_eff(lm_fact);
-        for (int op_or_axiom_id : tmp_op_or_axiom_ids)
-            op_or_axiom_ids.push_back(op_or_axiom_id);
-    }
-    int num_ops = 0;
+    int num_ops = achiever_preconditions.size();
     unordered_map<int, vector<FactPair>> preconditions;   // maps from
     // pddl_proposition_indeces to props
     unordered_map<int, set<int>> used_operators;  // tells for each
     // proposition which operators use it
-    for (size_t i = 0; i < op_or_axiom_ids.size(); ++i) {
-        OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axiom_ids[i]);
-        if (possibly_reaches_lm(op, reached, landmark)) {
-            ++num_ops;
-            unordered_map<int, int> next_pre;
-            get_greedy_preconditions_for_lm(task_proxy, landmark, op, next_pre);
-            for (const auto &pre : next_pre) {
-                int disj_class = disjunction_classes[pre.first][pre.second];
-                if (disj_class == -1) {
-                    // This fact may not participate in any disjunctive LMs
-                    // since it has no associated predicate.
-                    continue;
-                }
+    for (int i = 0; i < num_ops; ++i) {
+        for (const auto &pre : achiever_preconditions[i]) {
+            int disj_class = disjunction_classes[pre.first][pre.second];
+            if (disj_class == -1) {
+                // This fact may not participate in any disjunctive LMs
+                // since it has no associated predicate.
+                continue;
+            }
 
-                // Only deal with propositions that are not shared preconditions
-                // (those have been found already and are simple landmarks).
-                const FactPair pre_fact(pre.first, pre.second);
-                if (!lm_graph->contains_simple_landmark(pre_fact)) {
-                    preconditions[disj_class].push_back(pre_fact);
-                    used_operators[disj_class].insert(i);
-                }
+            // Only deal with propositions that are not shared preconditions
+            // (those have been found already and are simple landmarks).
+            const FactPair pre_fact(pre.first, pre.second);
+            if (!lm_graph->contains_simple_landmark(pre_fact)) {
+                preconditions[disj_class].push_back(pre_fact);
+                used_operators[disj_class].insert(i);
             }
         }
     }
@@ -390,6 +381,68 @@ void LandmarkFactoryRpgSasp::compute_disjunctive_preconditions(
     }
 }
 
+void LandmarkFactoryRpgSasp::backchain(
+    const TaskProxy &task_proxy, Exploration &exploration,
+    const Landmark &landmark, BackchainingResult &result) const {
+    /*
+      Firstly, collect which propositions can be reached without achieving
+      the landmark.
+    */
+    vector<vector<bool>> reached =
+        compute_relaxed_reachability(exploration, landmark);
+    /*
+      Use this information to determine all operators that can possibly
+      achieve *landmark* for the first time, and collect any precondition
+      propositions that all such operators share (if there are any).
+    */
+    compute_achiever_preconditions(task_proxy, reached, landmark,
+                                   result.achiever_preconditions);
+    for (size_t i = 0; i < result.achiever_preconditions.size(); ++i) {
+        if (i == 0)
+            result.shared_pre = result.achiever_preconditions[i];
+        else
+            result.shared_pre = _intersect(
+                result.shared_pre, result.achiever_preconditions[i]);
+        if (result.shared_pre.empty())
+            break;
+    }
+    // Extract additional orders from the relaxed planning graph and DTG.
+    find_forward_orders(task_proxy.get_variables(), reached, landmark,
+                        result.forward_orders);
+    approximate_lookahead_orders(task_proxy, reached, landmark,
+                                 result.lookahead_landmarks);
+}
+
+void LandmarkFactoryRpgSasp::add_backchaining_result(
+    LandmarkNode *lm_node, BackchainingResult &result,
+    const TaskProxy &task_proxy) {
+    /*
+      All shared preconditions are landmarks, and greedy necessary
+      predecessors of *landmark*.
+    */
+    for (const auto &pre : result.shared_pre) {
+        found_simple_lm_and_order(
+            FactPair(pre.first, pre.second), *lm_node,
+            EdgeType::GREEDY_NECESSARY);
+    }
+    forward_orders[lm_node] = move(result.forward_orders);
+    for (const FactPair &lm_fact : result.lookahead_landmarks) {
+        found_simple_lm_and_order(lm_fact, *lm_node, EdgeType::NATURAL);
+    }
+
+    // Process achieving operators again to find disjunctive LMs
+    vector<set<FactPair>> disjunctive_pre;
+    compute_disjunctive_preconditions(
+        result.achiever_preconditions, disjunctive_pre);
+    for (const auto &preconditions : disjunctive_pre)
+        // We don't want disjunctive LMs to get too big.
+        if (preconditions.size() < 5) {
+            found_disj_lm_and_order(
+                task_proxy, preconditions, *lm_node,
+                EdgeType::GREEDY_NECESSARY);
+        }
+}
+
 void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
     const shared_ptr<AbstractTask> &task, Exploration &exploration) {
     TaskProxy task_proxy(*task);
@@ -405,55 +458,63 @@ void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
         open_landmarks.push_back(&lm_node);
     }
 
+    /*
+      Backchain from the open landmarks in batches. The results of a batch
+      are computed in parallel (each thread uses its own exploration) and
+      then added to the graph in the order of the open list, which gives the
+      same graph as processing the landmarks one by one. A landmark of the
+      batch that is replaced by a simple landmark before its results are
+      added is skipped, as it would have been removed from the open list.
+    */
+    vector<unique_ptr<Exploration>> thread_explorations(num_threads);
+    int batch_size = num_threads == 1 ? 1 : 16 * num_threads;
+    vector<BackchainingResult> results;
+    utils::CountdownTimer timer(max_time);
     State initial_state = task_proxy.get_initial_state();
     while (!open_landmarks.empty()) {
-        LandmarkNode *lm_node = open_landmarks.front();
-        Landmark &landmark = lm_node->get_landmark();
-        open_landmarks.pop_front();
-        assert(forward_orders[lm_node].empty());
-
-        if (!landmark.is_true_in_state(initial_state)) {
-            /*
-              Backchain from *landmark* and compute greedy necessary
-              predecessors.
-              Firstly, collect which propositions can be reached without
-              achieving the landmark.
-            */
-            vector<vector<bool>> reached =
-                compute_relaxed_reachability(exploration, landmark);
-            /*
-              Use this information to determine all operators that can
-              possibly achieve *landmark* for the first time, and collect
-              any precondition propositions that all such operators share
-              (if there are any).
-            */
-            unordered_map<int, int> shared_pre;
-            compute_shared_preconditions(task_proxy, shared_pre,
-                                         reached, landmark);
-            /*
-              All such shared preconditions are landmarks, and greedy
-              necessary predecessors of *landmark*.
-            */
-            for (const auto &pre : shared_pre) {
-                found_simple_lm_and_order(
-                    FactPair(pre.first, pre.second), *lm_node,
-                    EdgeType::GREEDY_NECESSARY);
+        if (timer.is_expired()) {
+            if (log.is_at_least_normal()) {
+                log << "Landmark generation time limit reached, "
+                    << open_landmarks.size() << " landmarks remain "
+                    << "without predecessors." << endl;
             }
-            // Extract additional orders from the relaxed planning graph and DTG.
-            approximate_lookahead_orders(task_proxy, reached, lm_node);
-
-            // Process achieving operators again to find disjunctive LMs
-            vector<set<FactPair>> disjunctive_pre;
-            compute_disjunctive_preconditions(
-                task_proxy, disjunctive_pre, reached, landmark);
-            for (const auto &preconditions : disjunctive_pre)
-                // We don't want disjunctive LMs to get too big.
-                if (preconditions.size() < 5) {
-                    found_disj_lm_and_order(
-                        task_proxy, preconditions, *lm_node,
-                        EdgeType::GREEDY_NECESSARY);
+            open_landmarks.clear();
+            break;
+        }
+        assert(backchaining_landmarks.empty());
+        while (!open_landmarks.empty() &&
+               static_cast<int>(backchaining_landmarks.size()) < batch_size) {
+            LandmarkNode *lm_node = open_landmarks.front();
+            open_landmarks.pop_front();
+            assert(forward_orders[lm_node].empty());
+            if (!lm_node->get_landmark().is_true_in_state(initial_state))
+                backchaining_landmarks.push_back(lm_node);
+        }
+        int num_results = backchaining_landmarks.size();
+        results.assign(num_results, BackchainingResult());
+        utils::parallel_for(
+            num_threads, num_results,
+            [&](int i, int thread) {
+                Exploration *thread_exploration = &exploration;
+                if (thread > 0) {
+                    if (!thread_explorations[thread]) {
+                        utils::LogProxy silent_log = utils::get_silent_log();
+                        thread_explorations[thread] =
+                            utils::make_unique_ptr<Exploration>(
+                                task_proxy, silent_log);
+                    }
+                    thread_exploration = thread_explorations[thread].get();
                 }
+                backchain(task_proxy, *thread_exploration,
+                          backchaining_landmarks[i]->get_landmark(),
+                          results[i]);
+            });
+        for (int i = 0; i < num_results; ++i) {
+            if (backchaining_landmarks[i])
+                add_backchaining_result(backchaining_landmarks[i], results[i],
+                                        task_proxy);
         }
+        backchaining_landmarks.clear();
     }
     add_lm_forward_orders();
 
@@ -471,22 +532,14 @@ void LandmarkFactoryRpgSasp::generate_relaxed_landmarks(
 }
 
 void LandmarkFactoryRpgSasp::approximate_lookahead_orders(
-    const TaskProxy &task_proxy, const vector<vector<bool>> &reached, LandmarkNode *lmp) {
-    /*
-      Find all var-val pairs that can only be reached after the landmark
-      (according to relaxed plan graph as captured in reached).
-      The result is saved in the node member variable forward_orders, and
-      will be used later, when the phase of finding LMs has ended (because
-      at the moment we don't know which of these var-val pairs will be LMs).
-    */
-    VariablesProxy variables = task_proxy.get_variables();
-    find_forward_orders(variables, reached, lmp);
-
+    const TaskProxy &task_proxy, const vector<vector<bool>> &reached,
+    const Landmark &landmark, vector<FactPair> &result) const {
     /*
       Use domain transition graphs to find further orders. Only possible
-      if lmp is a simple landmark.
+      if the landmark is a simple landmark. The found facts are landmarks
+      that are naturally ordered before the landmark.
     */
-    const Landmark &landmark = lmp->get_landmark();
+    VariablesProxy variables = task_proxy.get_variables();
     if (landmark.disjunctive)
         return;
     const FactPair &lm_fact = landmark.facts[0];
@@ -516,13 +569,13 @@ void LandmarkFactoryRpgSasp::approximate_lookahead_orders(
               initial state, we have found a new landmark.
             */
             if (!domain_connectivity(initial_state, lm_fact, exclude))
-                found_simple_lm_and_order(FactPair(lm_fact.var, value), *lmp, EdgeType::NATURAL);
+                result.emplace_back(lm_fact.var, value);
         }
 }
 
 bool LandmarkFactoryRpgSasp::domain_connectivity(const State &initial_state,
                                                  const FactPair &landmark,
-                                                 const unordered_set<int> &exclude) {
+                                                 const unordered_set<int> &exclude) const {
     /*
       Tests whether in the domain transition graph of the LM variable, there is
       a path from the initial state value to the LM value, without passing through
@@ -559,11 +612,14 @@ bool LandmarkFactoryRpgSasp::domain_connectivity(const State &initial_state,
 
 void LandmarkFactoryRpgSasp::find_forward_orders(const VariablesProxy &variables,
                                                  const vector<vector<bool>> &reached,
-                                                 LandmarkNode *lm_node) {
+                                                 const Landmark &landmark,
+                                                 utils::HashSet<FactPair> &result) const {
     /*
-      lm_node is ordered before any var-val pair that cannot be reached before
-      lm_node according to relaxed planning graph (as captured in reached).
-      These orders are saved in the node member variable "forward_orders".
+      The landmark is ordered before any var-val pair that cannot be reached
+      before it according to relaxed planning graph (as captured in reached).
+      These orders are saved in the member variable "forward_orders" and
+      will be used later, when the phase of finding LMs has ended (because
+      at the moment we don't know which of these var-val pairs will be LMs).
     */
     for (VariableProxy var : variables)
         for (int value = 0; value < var.get_domain_size(); ++value) {
@@ -572,7 +628,7 @@ void LandmarkFactoryRpgSasp::find_forward_orders(const VariablesProxy &variables
             const FactPair fact(var.get_id(), value);
 
             bool insert = true;
-            for (const FactPair &lm_fact : lm_node->get_landmark().facts) {
+            for (const FactPair &lm_fact : landmark.facts) {
                 if (fact != lm_fact) {
                     // Make sure there is no operator that reaches both lm and (var, value) at the same time
                     bool intersection_empty = true;
@@ -596,7 +652,7 @@ void LandmarkFactoryRpgSasp::find_forward_orders(const VariablesProxy &variables
                 }
             }
             if (insert)
-                forward_orders[lm_node].insert(fact);
+                result.insert(fact);
         }
 }
 
@@ -648,6 +704,8 @@ static shared_ptr<LandmarkFactory> _parse(OptionParser &parser) {
     add_landmark_factory_options_to_parser(parser);
     add_use_orders_option_to_parser(parser);
     add_only_causal_landmarks_option_to_parser(parser);
+    add_threads_option_to_parser(parser);
+    add_max_time_option_to_parser(parser);
 
     Options opts = parser.parse();
 
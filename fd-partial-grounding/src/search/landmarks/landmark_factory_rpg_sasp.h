@@ -9,10 +9,30 @@
 
 namespace landmarks {
 class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
+    /*
+      Everything that processing a landmark derives from the relaxed
+      reachability without the landmark. It only depends on the landmark and
+      not on the landmark graph, so it is computed for several open
+      landmarks in parallel and added to the graph afterwards in the order
+      of the open list.
+    */
+    struct BackchainingResult {
+        // Greedy preconditions of each operator that may achieve the landmark first.
+        std::vector<std::unordered_map<int, int>> achiever_preconditions;
+        std::unordered_map<int, int> shared_pre;
+        utils::HashSet<FactPair> forward_orders;
+        // Facts found by approximate_lookahead_orders.
+        std::vector<FactPair> lookahead_landmarks;
+    };
+
     const bool disjunctive_landmarks;
     const bool use_orders;
     const bool only_causal_landmarks;
+    const int num_threads;
+    const double max_time;
     std::list<LandmarkNode *> open_landmarks;
+    // Landmarks taken from open_landmarks whose results are not added yet.
+    std::vector<LandmarkNode *> backchaining_landmarks;
     std::vector<std::vector<int>> disjunction_classes;
 
     std::unordered_map<LandmarkNode *, utils::HashSet<FactPair>> forward_orders;
@@ -25,26 +45,31 @@ class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
     void add_dtg_successor(int var_id, int pre, int post);
     void find_forward_orders(const VariablesProxy &variables,
                              const std::vector<std::vector<bool>> &reached,
-                             LandmarkNode *lm_node);
+                             const Landmark &landmark,
+                             utils::HashSet<FactPair> &result) const;
     void add_lm_forward_orders();
 
     void get_greedy_preconditions_for_lm(
         const TaskProxy &task_proxy, const Landmark &landmark,
         const OperatorProxy &op,
         std::unordered_map<int, int> &result) const;
-    void compute_shared_preconditions(
+    void compute_achiever_preconditions(
         const TaskProxy &task_proxy,
-        std::unordered_map<int, int> &shared_pre,
-        std::vector<std::vector<bool>> &reached, const Landmark &landmark);
+        const std::vector<std::vector<bool>> &reached,
+        const Landmark &landmark,
+        std::vector<std::unordered_map<int, int>> &achiever_preconditions) const;
     void compute_disjunctive_preconditions(
-        const TaskProxy &task_proxy,
-        std::vector<std::set<FactPair>> &disjunctive_pre,
-        std::vector<std::vector<bool>> &reached,
-        const Landmark &landmark);
+        const std::vector<std::unordered_map<int, int>> &achiever_preconditions,
+        std::vector<std::set<FactPair>> &disjunctive_pre) const;
 
     virtual void generate_relaxed_landmarks(
         const std::shared_ptr<AbstractTask> &task,
         Exploration &exploration) override;
+    void backchain(const TaskProxy &task_proxy, Exploration &exploration,
+                   const Landmark &landmark, BackchainingResult &result) const;
+    void add_backchaining_result(LandmarkNode *lm_node,
+                                 BackchainingResult &result,
+                                 const TaskProxy &task_proxy);
     void found_simple_lm_and_order(const FactPair &a, LandmarkNode &b,
                                    EdgeType t);
     void found_disj_lm_and_order(const TaskProxy &task_proxy,
@@ -53,10 +78,11 @@ class LandmarkFactoryRpgSasp : public LandmarkFactoryRelaxation {
                                  EdgeType t);
     void approximate_lookahead_orders(const TaskProxy &task_proxy,
                                       const std::vector<std::vector<bool>> &reached,
-                                      LandmarkNode *lmp);
+                                      const Landmark &landmark,
+                                      std::vector<FactPair> &result) const;
     bool domain_connectivity(const State &initial_state,
                              const FactPair &landmark,
-                             const std::unordered_set<int> &exclude);
+                             const std::unordered_set<int> &exclude) const;
 
     void build_disjunction_classes(const TaskProxy &task_proxy);
 
@@ -67,6 +67,12 @@ public:
         return any_cast<std::function<T(OptionParser &)>>(plugin_factories.at(type).at(key));
     }
 
+    template<typename T>
+    bool has_factory(const std::string &key) const {
+        auto it = plugin_factories.find(std::type_index(typeid(T)));
+        return it != plugin_factories.end() && it->second.count(key);
+    }
+
     bool is_predefinition(const std::string &key) const;
     void handle_predefinition(const std::string &key, const std::string &arg,
                               Predefinitions &predefinitions, bool dry_run);
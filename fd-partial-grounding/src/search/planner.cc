@@ -32,11 +32,11 @@ int main(int argc, const char **argv) {
     }
 
     shared_ptr<SearchEngine> engine;
+    options::Registry registry(*options::RawRegistry::instance());
 
     // The command line is parsed twice: once in dry-run mode, to
     // check for simple input errors, and then in normal mode.
     try {
-        options::Registry registry(*options::RawRegistry::instance());
         parse_cmd_line(argc, argv, registry, true, unit_cost);
         engine = parse_cmd_line(argc, argv, registry, false, unit_cost);
     } catch (const ArgError &error) {
@@ -54,6 +54,29 @@ int main(int argc, const char **argv) {
 
     utils::Timer search_timer;
     engine->search();
+
+    /*
+      In a persistent search, the driver sends a larger grounding of the task
+      after every unsuccessful search (see driver/incremental_grounding.py).
+      The new search continues the previous one if the engine supports it.
+    */
+    if (is_persistent_search(argc, argv)) {
+        while (!engine->found_solution()) {
+            engine->print_statistics();
+            utils::g_log << "Persistent search: no plan found, waiting for the next task." << endl;
+            if (!tasks::read_next_root_task(cin))
+                break;
+            utils::g_log << "done reading input!" << endl;
+            unit_cost = task_properties::is_unit_cost(TaskProxy(*tasks::g_root_task));
+            shared_ptr<SearchEngine> previous_engine = move(engine);
+            engine = parse_cmd_line(argc, argv, registry, false, unit_cost);
+            if (!engine->resume(*previous_engine)) {
+                utils::g_log << "Starting the search from scratch." << endl;
+            }
+            previous_engine = nullptr;
+            engine->search();
+        }
+    }
     search_timer.stop();
     utils::g_timer.stop();
 
@@ -24,11 +24,15 @@ using utils::ExitCode;
 class PruningMethod;
 
 successor_generator::SuccessorGenerator &get_successor_generator(
-    const TaskProxy &task_proxy, utils::LogProxy &log) {
+    const TaskProxy &task_proxy,
+    successor_generator::SuccessorGeneratorLayout layout,
+    utils::LogProxy &log) {
     log << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator &successor_generator =
+        layout == successor_generator::SuccessorGeneratorLayout::TREE ?
+        successor_generator::g_tree_successor_generators[task_proxy] :
         successor_generator::g_successor_generators[task_proxy];
     successor_generator_timer.stop();
     log << "done!" << endl;
@@ -47,8 +51,12 @@ SearchEngine::SearchEngine(const Options &opts)
       task(tasks::g_root_task),
       task_proxy(*task),
       log(utils::get_log_from_options(opts)),
-      state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy, log)),
+      state_registry(task_proxy, opts.get<StateStorage>("state_storage")),
+      successor_generator(get_successor_generator(
+                              task_proxy,
+                              opts.get<successor_generator::SuccessorGeneratorLayout>(
+                                  "successor_generator"),
+                              log)),
       search_space(state_registry, log),
       statistics(log),
       cost_type(opts.get<OperatorCost>("cost_type")),
@@ -96,6 +104,11 @@ void SearchEngine::search() {
     }
     // TODO: Revise when and which search times are logged.
     log << "Actual search time: " << timer.get_elapsed_time() << endl;
+    statistics.set_bytes_per_state(state_registry.get_bytes_per_state());
+}
+
+bool SearchEngine::resume(SearchEngine &) {
+    return false;
 }
 
 bool SearchEngine::check_goal_and_set_plan(const State &state) {
@@ -148,6 +161,24 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_enum_option<StateStorage>(
+        "state_storage",
+        {"PACKED", "TREE"},
+        "how the registered states are stored",
+        "PACKED",
+        {"every state as an array of packed variable values",
+         "hash-consed trees over the packed values, so that states share the "
+         "memory for the parts in which they agree. This needs much less "
+         "memory for tasks with many variables, but looking up a state is "
+         "slower."});
+    parser.add_enum_option<successor_generator::SuccessorGeneratorLayout>(
+        "successor_generator",
+        {"TREE", "FLAT"},
+        "memory layout of the successor generator. Both layouts generate the "
+        "same operators in the same order.",
+        "FLAT",
+        {"decision tree of nodes allocated separately on the heap",
+         "the same decision tree encoded in a single array"});
     utils::add_log_options_to_parser(parser);
 }
 
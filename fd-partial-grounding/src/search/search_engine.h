@@ -70,6 +70,16 @@ public:
     const SearchStatistics &get_statistics() const {return statistics;}
     void set_bound(int b) {bound = b;}
     int get_bound() {return bound;}
+    void set_max_time(double t) {max_time = t;}
+
+    /*
+      Take over the search space and the open nodes of previous, a search
+      engine of the same kind on a smaller version of this task (e.g. the
+      previous increment of incremental grounding), instead of starting from
+      the initial state. Must be called before search(). Returns false if this
+      is not supported, in which case the search starts from scratch.
+    */
+    virtual bool resume(SearchEngine &previous);
     PlanManager &get_plan_manager() {return plan_manager;}
 
     /* The following three methods should become functions as they
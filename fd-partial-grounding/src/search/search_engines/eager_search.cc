@@ -7,10 +7,16 @@
 #include "../pruning_method.h"
 
 #include "../algorithms/ordered_set.h"
+#include "../pruning/null_pruning_method.h"
 #include "../task_utils/successor_generator.h"
+#include "../task_utils/task_extension.h"
 
+#include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -28,20 +34,15 @@ EagerSearch::EagerSearch(const Options &opts)
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      resumed(false) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
 }
 
-void EagerSearch::initialize() {
-    log << "Conducting best first search"
-        << (reopen_closed_nodes ? " with" : " without")
-        << " reopening closed nodes, (real) bound = " << bound
-        << endl;
-    assert(open_list);
-
+set<Evaluator *> EagerSearch::collect_path_dependent_evaluators() const {
     set<Evaluator *> evals;
     open_list->get_path_dependent_evaluators(evals);
 
@@ -69,9 +70,24 @@ void EagerSearch::initialize() {
     if (lazy_evaluator) {
         lazy_evaluator->get_path_dependent_evaluators(evals);
     }
+    return evals;
+}
+
+void EagerSearch::initialize() {
+    log << "Conducting best first search"
+        << (reopen_closed_nodes ? " with" : " without")
+        << " reopening closed nodes, (real) bound = " << bound
+        << endl;
+    assert(open_list);
 
+    set<Evaluator *> evals = collect_path_dependent_evaluators();
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    if (resumed) {
+        pruning_method->initialize(task);
+        return;
+    }
+
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -108,7 +124,125 @@ void EagerSearch::print_statistics() const {
     pruning_method->print_statistics();
 }
 
+bool EagerSearch::resume(SearchEngine &previous_engine) {
+    EagerSearch *previous = dynamic_cast<EagerSearch *>(&previous_engine);
+    if (!previous) {
+        log << "Cannot resume a search of a different kind." << endl;
+        return false;
+    }
+    /*
+      Path-dependent evaluators (e.g. landmark count) store information along
+      the paths of the previous search that we cannot convert.
+    */
+    if (!collect_path_dependent_evaluators().empty()) {
+        log << "Cannot resume a search with path-dependent evaluators." << endl;
+        return false;
+    }
+    task_extension::TaskExtension extension(previous->task_proxy, task_proxy);
+    if (!extension.is_valid()) {
+        log << "Cannot resume the previous search: " << extension.get_reason() << endl;
+        return false;
+    }
+
+    utils::Timer timer;
+    vector<int> values;
+    // Check all states first, so that we do not return false with a half-filled registry.
+    for (StateID id : previous->state_registry) {
+        if (!extension.convert_state(previous->state_registry.lookup_state(id), values)) {
+            log << "Cannot resume the previous search: state "
+                << id << " cannot be converted." << endl;
+            return false;
+        }
+    }
+
+    auto convert_operator = [&](OperatorID op_id) {
+            return extension.convert_operator(op_id);
+        };
+    int num_open_states = 0;
+    int num_dead_ends = 0;
+    for (StateID id : previous->state_registry) {
+        State previous_state = previous->state_registry.lookup_state(id);
+        extension.convert_state(previous_state, values);
+        /*
+          The states are inserted in the same order, so they keep their IDs
+          and the parent pointers remain valid. Different states of the
+          previous task differ in some atom, so they cannot be converted into
+          the same state.
+        */
+        State state = state_registry.insert_state(move(values));
+        if (state.get_id() != id) {
+            ABORT("State IDs changed while resuming the search.");
+        }
+
+        SearchNode previous_node = previous->search_space.get_node(previous_state);
+        if (previous_node.is_new()) {
+            continue;
+        } else if (previous_node.is_dead_end()) {
+            // Dead ends might not be dead ends with the new operators.
+            ++num_dead_ends;
+            continue;
+        }
+        search_space.copy_node(previous->search_space, previous_state, state, convert_operator);
+        if (previous_node.is_closed()) {
+            resumed_closed_states.push_back(id);
+            continue;
+        }
+
+        SearchNode node = search_space.get_node(state);
+        EvaluationContext eval_context(state, node.get_g(), false, &statistics);
+        statistics.inc_evaluated_states();
+        if (open_list->is_dead_end(eval_context)) {
+            node.mark_as_dead_end();
+            statistics.inc_dead_ends();
+        } else {
+            open_list->insert(eval_context, id);
+            ++num_open_states;
+        }
+    }
+    reverse(resumed_closed_states.begin(), resumed_closed_states.end());
+    /*
+      The successors of the closed states with the old operators are already
+      in the search space, so only the new operators need to be applied. This
+      does not hold if there were dead ends, which are evaluated again when
+      they are generated from their parents, or with pruning, because the old
+      and the new task might prune different operators.
+    */
+    if (num_dead_ends == 0 &&
+        dynamic_cast<null_pruning_method::NullPruningMethod *>(pruning_method.get())) {
+        resumed_operators.resize(task_proxy.get_operators().size());
+        for (OperatorProxy op : task_proxy.get_operators()) {
+            resumed_operators[op.get_id()] = extension.is_new_operator(OperatorID(op.get_id()));
+        }
+    }
+    resumed = true;
+
+    log << "Resumed previous search with " << extension.get_num_new_operators()
+        << " new operators: " << state_registry.size() << " states, "
+        << resumed_closed_states.size() << " to expand again, "
+        << num_open_states << " open"
+        << (resumed_operators.empty() ? " (with all operators)" : " (with the new operators)")
+        << " [" << timer << "]" << endl;
+    return true;
+}
+
 SearchStatus EagerSearch::step() {
+    if (!resumed_closed_states.empty()) {
+        State s = state_registry.lookup_state(resumed_closed_states.back());
+        resumed_closed_states.pop_back();
+        statistics.inc_expanded();
+        /*
+          Computing preferred operators would require evaluating the state
+          again, while its successors in the previous task are already
+          evaluated.
+        */
+        expand(search_space.get_node(s), false, true);
+        if (resumed_closed_states.empty()) {
+            utils::release_vector_memory(resumed_closed_states);
+            utils::release_vector_memory(resumed_operators);
+        }
+        return IN_PROGRESS;
+    }
+
     tl::optional<SearchNode> node;
     while (true) {
         if (open_list->empty()) {
@@ -172,8 +306,23 @@ SearchStatus EagerSearch::step() {
     if (check_goal_and_set_plan(s))
         return SOLVED;
 
+    expand(*node, true, false);
+    return IN_PROGRESS;
+}
+
+void EagerSearch::expand(const SearchNode &node, bool use_preferred_operators,
+                         bool only_resumed_operators) {
+    const State &s = node.get_state();
     vector<OperatorID> applicable_ops;
     successor_generator.generate_applicable_ops(s, applicable_ops);
+    if (only_resumed_operators && !resumed_operators.empty()) {
+        applicable_ops.erase(
+            remove_if(applicable_ops.begin(), applicable_ops.end(),
+                      [&](OperatorID op_id) {
+                          return !resumed_operators[op_id.get_index()];
+                      }),
+            applicable_ops.end());
+    }
 
     /*
       TODO: When preferred operators are in use, a preferred operator will be
@@ -181,18 +330,20 @@ SearchStatus EagerSearch::step() {
     */
     pruning_method->prune_operators(s, applicable_ops);
 
-    // This evaluates the expanded state (again) to get preferred ops
-    EvaluationContext eval_context(s, node->get_g(), false, &statistics, true);
     ordered_set::OrderedSet<OperatorID> preferred_operators;
-    for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
-        collect_preferred_operators(eval_context,
-                                    preferred_operator_evaluator.get(),
-                                    preferred_operators);
+    if (use_preferred_operators) {
+        // This evaluates the expanded state (again) to get preferred ops
+        EvaluationContext eval_context(s, node.get_g(), false, &statistics, true);
+        for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
+            collect_preferred_operators(eval_context,
+                                        preferred_operator_evaluator.get(),
+                                        preferred_operators);
+        }
     }
 
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        if ((node->get_real_g() + op.get_cost()) >= bound)
+        if ((node.get_real_g() + op.get_cost()) >= bound)
             continue;
 
         State succ_state = state_registry.get_successor_state(s, op);
@@ -216,7 +367,7 @@ SearchStatus EagerSearch::step() {
             // Careful: succ_node.get_g() is not available here yet,
             // hence the stupid computation of succ_g.
             // TODO: Make this less fragile.
-            int succ_g = node->get_g() + get_adjusted_cost(op);
+            int succ_g = node.get_g() + get_adjusted_cost(op);
 
             EvaluationContext succ_eval_context(
                 succ_state, succ_g, is_preferred, &statistics);
@@ -227,14 +378,14 @@ SearchStatus EagerSearch::step() {
                 statistics.inc_dead_ends();
                 continue;
             }
-            succ_node.open(*node, op, get_adjusted_cost(op));
+            succ_node.open(node, op, get_adjusted_cost(op));
 
             open_list->insert(succ_eval_context, succ_state.get_id());
             if (search_progress.check_progress(succ_eval_context)) {
                 statistics.print_checkpoint_line(succ_node.get_g());
                 reward_progress();
             }
-        } else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
+        } else if (succ_node.get_g() > node.get_g() + get_adjusted_cost(op)) {
             // We found a new cheapest path to an open or closed state.
             if (reopen_closed_nodes) {
                 if (succ_node.is_closed()) {
@@ -247,7 +398,7 @@ SearchStatus EagerSearch::step() {
                     */
                     statistics.inc_reopened();
                 }
-                succ_node.reopen(*node, op, get_adjusted_cost(op));
+                succ_node.reopen(node, op, get_adjusted_cost(op));
 
                 EvaluationContext succ_eval_context(
                     succ_state, succ_node.get_g(), is_preferred, &statistics);
@@ -274,12 +425,10 @@ SearchStatus EagerSearch::step() {
                 // If we do not reopen closed nodes, we just update the parent pointers.
                 // Note that this could cause an incompatibility between
                 // the g-value and the actual path that is traced back.
-                succ_node.update_parent(*node, op, get_adjusted_cost(op));
+                succ_node.update_parent(node, op, get_adjusted_cost(op));
             }
         }
     }
-
-    return IN_PROGRESS;
 }
 
 void EagerSearch::reward_progress() {
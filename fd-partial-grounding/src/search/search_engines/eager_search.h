@@ -5,6 +5,7 @@
 #include "../search_engine.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 
 class Evaluator;
@@ -28,6 +29,17 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    // States closed by the search this one resumed (see resume()). They are
+    // expanded again before any other state to apply the new operators.
+    bool resumed;
+    std::vector<StateID> resumed_closed_states;
+    // Operators applied when expanding them again (empty for all operators).
+    std::vector<bool> resumed_operators;
+
+    std::set<Evaluator *> collect_path_dependent_evaluators() const;
+    void expand(const SearchNode &node, bool use_preferred_operators,
+                bool only_resumed_operators);
+
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
@@ -42,6 +54,8 @@ public:
 
     virtual void print_statistics() const override;
 
+    virtual bool resume(SearchEngine &previous) override;
+
     void dump_search_space() const;
 };
 
@@ -1,5 +1,6 @@
 #include "iterated_search.h"
 
+#include "../evaluator.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
@@ -20,15 +21,49 @@ IteratedSearch::IteratedSearch(const Options &opts, options::Registry &registry,
       repeat_last_phase(opts.get<bool>("repeat_last")),
       continue_on_fail(opts.get<bool>("continue_on_fail")),
       continue_on_solve(opts.get<bool>("continue_on_solve")),
+      share_evaluators(opts.get<bool>("share_evaluators")),
       phase(0),
       last_phase_found_solution(false),
       best_bound(bound),
       iterated_found_solution(false) {
 }
 
+/*
+  Replace the outermost evaluators in config by predefinitions, so that
+  evaluators with the same configuration are only created once and then
+  used in all phases, as if they had been predefined with --evaluator.
+*/
+void IteratedSearch::replace_evaluators_by_shared_ones(ParseTree &config) {
+    for (auto it = config.begin(); it != config.end(); ++it) {
+        if (!registry.has_factory<shared_ptr<Evaluator>>(it->value))
+            continue;
+        ParseTree evaluator_config = subtree(config, ParseTree::sibling_iterator(it));
+        evaluator_config.begin()->key = "";
+        ostringstream stream;
+        kptree::print_tree_bracketed(evaluator_config, stream);
+        string evaluator_key = stream.str();
+
+        auto shared = shared_evaluator_keys.find(evaluator_key);
+        if (shared == shared_evaluator_keys.end()) {
+            string key = "iterated_shared_evaluator_" +
+                to_string(shared_evaluator_keys.size());
+            OptionParser parser(evaluator_config, registry, predefinitions, false);
+            predefinitions.predefine(
+                key, parser.start_parsing<shared_ptr<Evaluator>>());
+            shared = shared_evaluator_keys.emplace(evaluator_key, key).first;
+        }
+        config.erase_children(it);
+        it->value = shared->second;
+        it.skip_children();
+    }
+}
+
 shared_ptr<SearchEngine> IteratedSearch::get_search_engine(
     int engine_configs_index) {
-    OptionParser parser(engine_configs[engine_configs_index], registry, predefinitions, false);
+    ParseTree config = engine_configs[engine_configs_index];
+    if (share_evaluators)
+        replace_evaluators_by_shared_ones(config);
+    OptionParser parser(config, registry, predefinitions, false);
     shared_ptr<SearchEngine> engine(parser.start_parsing<shared_ptr<SearchEngine>>());
 
     ostringstream stream;
@@ -138,14 +173,15 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         " heuristic values will be computed multiple times.");
     parser.document_note(
         "Note 2",
-        "The configuration\n```\n"
+        "With share_evaluators=false, the configuration\n```\n"
         "--search \"iterated([lazy_wastar(merge_and_shrink(),w=10), "
         "lazy_wastar(merge_and_shrink(),w=5), lazy_wastar(merge_and_shrink(),w=3), "
         "lazy_wastar(merge_and_shrink(),w=2), lazy_wastar(merge_and_shrink(),w=1)])\"\n"
         "```\nwould perform the preprocessing phase of the merge and shrink heuristic "
-        "5 times (once before each iteration).\n\n"
-        "To avoid this, use heuristic predefinition, which avoids duplicate "
-        "preprocessing, as follows:\n```\n"
+        "5 times (once before each iteration). With share_evaluators=true "
+        "(the default), evaluators with the same configuration are created "
+        "only once and used in all iterations, which is equivalent to "
+        "heuristic predefinition:\n```\n"
         "--evaluator \"h=merge_and_shrink()\" --search "
         "\"iterated([lazy_wastar(h,w=10), lazy_wastar(h,w=5), lazy_wastar(h,w=3), "
         "lazy_wastar(h,w=2), lazy_wastar(h,w=1)])\"\n"
@@ -172,6 +208,11 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.add_option<bool>("continue_on_solve",
                             "continue search after solution found",
                             "true");
+    parser.add_option<bool>(
+        "share_evaluators",
+        "create evaluators that have the same configuration in several "
+        "search engines only once (see Note 2)",
+        "true");
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
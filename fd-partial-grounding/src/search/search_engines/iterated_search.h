@@ -7,6 +7,9 @@
 #include "../options/registries.h"
 #include "../options/predefinitions.h"
 
+#include <string>
+#include <unordered_map>
+
 namespace options {
 class Options;
 }
@@ -24,12 +27,16 @@ class IteratedSearch : public SearchEngine {
     bool repeat_last_phase;
     bool continue_on_fail;
     bool continue_on_solve;
+    bool share_evaluators;
+    // Configurations of shared evaluators and the predefinitions for them.
+    std::unordered_map<std::string, std::string> shared_evaluator_keys;
 
     int phase;
     bool last_phase_found_solution;
     int best_bound;
     bool iterated_found_solution;
 
+    void replace_evaluators_by_shared_ones(options::ParseTree &config);
     std::shared_ptr<SearchEngine> get_search_engine(int engine_configs_index);
     std::shared_ptr<SearchEngine> create_current_phase();
     SearchStatus step_return_value();
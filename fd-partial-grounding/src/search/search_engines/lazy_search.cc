@@ -25,12 +25,17 @@ LazySearch::LazySearch(const Options &opts)
       randomize_successors(opts.get<bool>("randomize_successors")),
       preferred_successors_first(opts.get<bool>("preferred_successors_first")),
       rng(utils::parse_rng_from_options(opts)),
+      batch_size(opts.get<int>("batch_size")),
+      num_batches(0),
+      num_batched_states(0),
       current_state(state_registry.get_initial_state()),
       current_predecessor_id(StateID::no_state),
       current_operator_id(OperatorID::no_operator),
       current_g(0),
       current_real_g(0),
-      current_eval_context(current_state, 0, true, &statistics) {
+      current_eval_context(current_state, 0, true, &statistics),
+      current_transition_notified(false),
+      search_timer(false) {
     /*
       We initialize current_eval_context in such a way that the initial node
       counts as "preferred".
@@ -42,8 +47,27 @@ void LazySearch::set_preferred_operator_evaluators(
     preferred_operator_evaluators = evaluators;
 }
 
+void LazySearch::set_batch_evaluators(
+    vector<shared_ptr<Evaluator>> &evaluators) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        batch_evaluators.push_back(evaluator.get());
+}
+
+void LazySearch::add_batch_options_to_parser(OptionParser &parser) {
+    parser.add_option<int>(
+        "batch_size",
+        "remove up to this many entries from the open list at once and "
+        "evaluate the successors of the same parent together. With values "
+        "larger than 1, the entries of a batch are expanded before the "
+        "successors generated in between, so the expansion order can differ "
+        "from the unbatched search.",
+        "1",
+        Bounds("1", "infinity"));
+}
+
 void LazySearch::initialize() {
     log << "Conducting lazy best first search, (real) bound = " << bound << endl;
+    search_timer.resume();
 
     assert(open_list);
     set<Evaluator *> evals;
@@ -56,6 +80,17 @@ void LazySearch::initialize() {
     }
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
+
+    if (batch_size > 1) {
+        // Preferred operator evaluators are evaluated for every expanded node.
+        for (const shared_ptr<Evaluator> &evaluator : preferred_operator_evaluators) {
+            if (find(batch_evaluators.begin(), batch_evaluators.end(),
+                     evaluator.get()) == batch_evaluators.end())
+                batch_evaluators.push_back(evaluator.get());
+        }
+        log << "Evaluating batches of up to " << batch_size << " states with "
+            << batch_evaluators.size() << " evaluators" << endl;
+    }
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -115,7 +150,107 @@ void LazySearch::generate_successors() {
     }
 }
 
+void LazySearch::notify_state_transition(
+    StateID predecessor_id, OperatorID op_id, const State &state) {
+    if (!path_dependent_evaluators.empty()) {
+        State parent_state = state_registry.lookup_state(predecessor_id);
+        for (Evaluator *evaluator : path_dependent_evaluators)
+            evaluator->notify_state_transition(parent_state, op_id, state);
+    }
+}
+
+/*
+  Evaluates the successors of one parent state together. Only successors
+  that step() will open are evaluated: at this point, their transitions are
+  notified as step() would do before evaluating them.
+*/
+void LazySearch::evaluate_siblings(
+    vector<BatchEntry *> &siblings, vector<StateID> &evaluated_states) {
+    if (batch_evaluators.empty())
+        return;
+    vector<EvaluationContext *> eval_contexts;
+    for (BatchEntry *entry : siblings) {
+        SearchNode node = search_space.get_node(entry->state);
+        bool reopen = reopen_closed_nodes && !node.is_new() &&
+            !node.is_dead_end() && (entry->g < node.get_g());
+        // Duplicates in the batch are left to step(), which will usually skip them
+        StateID id = entry->state.get_id();
+        if ((!node.is_new() && !reopen) ||
+            find(evaluated_states.begin(), evaluated_states.end(), id) != evaluated_states.end())
+            continue;
+        evaluated_states.push_back(id);
+        notify_state_transition(entry->predecessor_id, entry->operator_id, entry->state);
+        entry->transition_notified = true;
+        eval_contexts.push_back(&entry->eval_context);
+    }
+    if (eval_contexts.empty())
+        return;
+    State parent_state = state_registry.lookup_state(siblings.front()->predecessor_id);
+    for (Evaluator *evaluator : batch_evaluators)
+        EvaluationContext::compute_sibling_results(evaluator, parent_state, eval_contexts);
+    ++num_batches;
+    num_batched_states += eval_contexts.size();
+}
+
+void LazySearch::fetch_batch() {
+    assert(batch.empty());
+    while (static_cast<int>(batch.size()) < batch_size && !open_list->empty()) {
+        EdgeOpenListEntry next = open_list->remove_min();
+        State predecessor = state_registry.lookup_state(next.first);
+        OperatorProxy op = task_proxy.get_operators()[next.second];
+        assert(task_properties::is_applicable(op, predecessor));
+        State state = state_registry.get_successor_state(predecessor, op);
+        SearchNode pred_node = search_space.get_node(predecessor);
+        int g = pred_node.get_g() + get_adjusted_cost(op);
+        int real_g = pred_node.get_real_g() + op.get_cost();
+        EvaluationContext eval_context(state, g, true, &statistics);
+        batch.push_back({next.first, next.second, state, g, real_g,
+                         eval_context, false});
+    }
+
+    /*
+      Group the entries by their parent. Alternation open lists interleave
+      the entries of different expansions, so siblings are not necessarily
+      removed one after the other. The order of the groups does not matter
+      because the evaluations of different states are independent.
+    */
+    vector<vector<BatchEntry *>> sibling_groups;
+    for (BatchEntry &entry : batch) {
+        auto group = find_if(
+            sibling_groups.begin(), sibling_groups.end(),
+            [&](const vector<BatchEntry *> &siblings) {
+                return siblings.front()->predecessor_id == entry.predecessor_id;
+            });
+        if (group == sibling_groups.end())
+            sibling_groups.push_back({&entry});
+        else
+            group->push_back(&entry);
+    }
+    vector<StateID> evaluated_states;
+    for (vector<BatchEntry *> &siblings : sibling_groups)
+        evaluate_siblings(siblings, evaluated_states);
+}
+
 SearchStatus LazySearch::fetch_next_state() {
+    if (batch_size > 1) {
+        if (batch.empty())
+            fetch_batch();
+        if (batch.empty()) {
+            log << "Completely explored state space -- no solution!" << endl;
+            return FAILED;
+        }
+        BatchEntry &entry = batch.front();
+        current_predecessor_id = entry.predecessor_id;
+        current_operator_id = entry.operator_id;
+        current_state = entry.state;
+        current_g = entry.g;
+        current_real_g = entry.real_g;
+        current_eval_context = entry.eval_context;
+        current_transition_notified = entry.transition_notified;
+        batch.pop_front();
+        return IN_PROGRESS;
+    }
+
     if (open_list->empty()) {
         log << "Completely explored state space -- no solution!" << endl;
         return FAILED;
@@ -161,14 +296,11 @@ SearchStatus LazySearch::step() {
         !node.is_dead_end() && (current_g < node.get_g());
 
     if (node.is_new() || reopen) {
-        if (current_operator_id != OperatorID::no_operator) {
+        if (current_operator_id != OperatorID::no_operator &&
+            !current_transition_notified) {
             assert(current_predecessor_id != StateID::no_state);
-            if (!path_dependent_evaluators.empty()) {
-                State parent_state = state_registry.lookup_state(current_predecessor_id);
-                for (Evaluator *evaluator : path_dependent_evaluators)
-                    evaluator->notify_state_transition(
-                        parent_state, current_operator_id, current_state);
-            }
+            notify_state_transition(
+                current_predecessor_id, current_operator_id, current_state);
         }
         statistics.inc_evaluated_states();
         if (!open_list->is_dead_end(current_eval_context)) {
@@ -215,5 +347,14 @@ void LazySearch::reward_progress() {
 void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+    if (batch_size > 1) {
+        log << "Batched evaluations: " << num_batched_states << " states in "
+            << num_batches << " sibling groups" << endl;
+        double time = search_timer();
+        if (time > 0) {
+            log << "Evaluated states per second: "
+                << statistics.get_evaluated_states() / time << endl;
+        }
+    }
 }
 }
@@ -10,11 +10,14 @@
 #include "../search_space.h"
 
 #include "../utils/rng.h"
+#include "../utils/timer.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
 namespace options {
+class OptionParser;
 class Options;
 }
 
@@ -32,18 +35,49 @@ protected:
     std::vector<Evaluator *> path_dependent_evaluators;
     std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
 
+    /*
+      With batch_size > 1, up to batch_size entries are removed from the open
+      list at once, and the evaluators in batch_evaluators compute the values
+      of the entries with the same parent together (see
+      Evaluator::compute_results). The entries are then expanded in the order
+      in which they were removed, so nodes generated in between cannot
+      overtake them. With batch_size = 1, the search is unchanged.
+    */
+    struct BatchEntry {
+        StateID predecessor_id;
+        OperatorID operator_id;
+        State state;
+        int g;
+        int real_g;
+        EvaluationContext eval_context;
+        bool transition_notified;
+    };
+    int batch_size;
+    std::vector<Evaluator *> batch_evaluators;
+    std::deque<BatchEntry> batch;
+    int num_batches;
+    int num_batched_states;
+
     State current_state;
     StateID current_predecessor_id;
     OperatorID current_operator_id;
     int current_g;
     int current_real_g;
     EvaluationContext current_eval_context;
+    bool current_transition_notified;
+    // Measures the time since initialize() to report the throughput of batches
+    utils::Timer search_timer;
 
     virtual void initialize() override;
     virtual SearchStatus step() override;
 
     void generate_successors();
     SearchStatus fetch_next_state();
+    void fetch_batch();
+    void evaluate_siblings(
+        std::vector<BatchEntry *> &siblings, std::vector<StateID> &evaluated_states);
+    void notify_state_transition(
+        StateID predecessor_id, OperatorID op_id, const State &state);
 
     void reward_progress();
 
@@ -55,6 +89,9 @@ public:
     virtual ~LazySearch() = default;
 
     void set_preferred_operator_evaluators(std::vector<std::shared_ptr<Evaluator>> &evaluators);
+    void set_batch_evaluators(std::vector<std::shared_ptr<Evaluator>> &evaluators);
+
+    static void add_batch_options_to_parser(options::OptionParser &parser);
 
     virtual void print_statistics() const override;
 };
@@ -15,6 +15,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "preferred",
         "use preferred operators of these evaluators", "[]");
     SearchEngine::add_succ_order_options(parser);
+    lazy_search::LazySearch::add_batch_options_to_parser(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -58,6 +58,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "to preferred operator nodes",
         DEFAULT_LAZY_BOOST);
     SearchEngine::add_succ_order_options(parser);
+    lazy_search::LazySearch::add_batch_options_to_parser(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
@@ -68,6 +69,8 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         // TODO: The following two lines look fishy. See similar comment in _parse.
         vector<shared_ptr<Evaluator>> preferred_list = opts.get_list<shared_ptr<Evaluator>>("preferred");
         engine->set_preferred_operator_evaluators(preferred_list);
+        vector<shared_ptr<Evaluator>> evals = opts.get_list<shared_ptr<Evaluator>>("evals");
+        engine->set_batch_evaluators(evals);
     }
     return engine;
 }
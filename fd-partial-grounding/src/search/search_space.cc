@@ -125,6 +125,16 @@ SearchNode SearchSpace::get_node(const State &state) {
     return SearchNode(state, search_node_infos[state]);
 }
 
+void SearchSpace::copy_node(const SearchSpace &other, const State &other_state,
+                            const State &state,
+                            const function<OperatorID(OperatorID)> &convert_operator) {
+    SearchNodeInfo &info = search_node_infos[state];
+    info = other.search_node_infos[other_state];
+    if (info.creating_operator != OperatorID::no_operator) {
+        info.creating_operator = convert_operator(info.creating_operator);
+    }
+}
+
 void SearchSpace::trace_path(const State &goal_state,
                              vector<OperatorID> &path) const {
     State current_state = goal_state;
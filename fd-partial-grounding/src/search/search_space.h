@@ -5,6 +5,7 @@
 #include "per_state_information.h"
 #include "search_node_info.h"
 
+#include <functional>
 #include <vector>
 
 class OperatorProxy;
@@ -57,6 +58,16 @@ public:
     SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
 
     SearchNode get_node(const State &state);
+
+    /*
+      Copy the search node of other_state, a state of the search space other,
+      to state. The creating operator is converted to an operator of this task
+      with convert_operator. The parent state is copied as is, so the states of
+      both registries must have the same IDs.
+    */
+    void copy_node(const SearchSpace &other, const State &other_state,
+                   const State &state,
+                   const std::function<OperatorID(OperatorID)> &convert_operator);
     void trace_path(const State &goal_state,
                     std::vector<OperatorID> &path) const;
 
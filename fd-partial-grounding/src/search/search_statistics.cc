@@ -25,6 +25,8 @@ SearchStatistics::SearchStatistics(utils::LogProxy &log)
     lastjump_generated_states = 0;
 
     lastjump_f_value = -1;
+
+    bytes_per_state = -1;
 }
 
 void SearchStatistics::report_f_value_progress(int f) {
@@ -70,6 +72,10 @@ void SearchStatistics::print_detailed_statistics() const {
     log << "Evaluations: " << evaluations << endl;
     log << "Generated " << generated_states << " state(s)." << endl;
     log << "Dead ends: " << dead_end_states << " state(s)." << endl;
+    if (bytes_per_state >= 0) {
+        log << "Registered state data: " << bytes_per_state
+            << " bytes per state" << endl;
+    }
 
     if (lastjump_f_value >= 0) {
         log << "Expanded until last jump: "
@@ -33,6 +33,9 @@ class SearchStatistics {
     int lastjump_evaluated_states;
     int lastjump_generated_states;
 
+    // Memory for the registered states (-1 if not set)
+    double bytes_per_state;
+
     void print_f_line() const;
 public:
     explicit SearchStatistics(utils::LogProxy &log);
@@ -46,6 +49,7 @@ public:
     void inc_generated_ops(int inc = 1) {generated_ops += inc;}
     void inc_evaluations(int inc = 1) {evaluations += inc;}
     void inc_dead_ends(int inc = 1) {dead_end_states += inc;}
+    void set_bytes_per_state(double bytes) {bytes_per_state = bytes;}
 
     // Methods that access statistics.
     int get_expanded() const {return expanded_states;}
@@ -8,15 +8,22 @@
 
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(const TaskProxy &task_proxy, StateStorage storage)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      state_tree(storage == StateStorage::TREE ?
+                 utils::make_unique_ptr<tree_table::TreeTable>(get_bins_per_state()) :
+                 nullptr),
+      state_data_pool(get_state_data_size()),
       registered_states(
-          StateIDSemanticHash(state_data_pool, get_bins_per_state()),
-          StateIDSemanticEqual(state_data_pool, get_bins_per_state())) {
+          StateIDSemanticHash(state_data_pool, get_state_data_size()),
+          StateIDSemanticEqual(state_data_pool, get_state_data_size())) {
+    if (state_tree) {
+        tree_buffer.resize(get_bins_per_state());
+        tree_parent_buffer.resize(get_bins_per_state());
+    }
 }
 
 StateID StateRegistry::insert_id_or_pop_state() {
@@ -36,8 +43,26 @@ StateID StateRegistry::insert_id_or_pop_state() {
     return StateID(result.first);
 }
 
+StateID StateRegistry::insert_packed_state(const PackedStateBin *buffer) {
+    if (state_tree) {
+        PackedStateBin root = state_tree->insert(buffer);
+        state_data_pool.push_back(&root);
+    } else {
+        state_data_pool.push_back(buffer);
+    }
+    return insert_id_or_pop_state();
+}
+
 State StateRegistry::lookup_state(StateID id) const {
     const PackedStateBin *buffer = state_data_pool[id.value];
+    if (state_tree) {
+        state_tree->get(buffer[0], tree_buffer.data());
+        vector<int> values(num_variables);
+        for (int var = 0; var < num_variables; ++var) {
+            values[var] = state_packer.get(tree_buffer.data(), var);
+        }
+        return task_proxy.create_state(*this, id, nullptr, move(values));
+    }
     return task_proxy.create_state(*this, id, buffer);
 }
 
@@ -52,8 +77,7 @@ const State &StateRegistry::get_initial_state() {
         for (size_t i = 0; i < initial_state.size(); ++i) {
             state_packer.set(buffer.get(), i, initial_state[i].get_value());
         }
-        state_data_pool.push_back(buffer.get());
-        StateID id = insert_id_or_pop_state();
+        StateID id = insert_packed_state(buffer.get());
         cached_initial_state = utils::make_unique_ptr<State>(lookup_state(id));
     }
     return *cached_initial_state;
@@ -64,6 +88,8 @@ const State &StateRegistry::get_initial_state() {
 //     operating on state buffers (PackedStateBin *).
 State StateRegistry::get_successor_state(const State &predecessor, const OperatorProxy &op) {
     assert(!op.is_axiom());
+    if (state_tree)
+        return get_successor_state_from_tree(predecessor, op);
     state_data_pool.push_back(predecessor.get_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
     /* Experiments for issue348 showed that for tasks with axioms it's faster
@@ -95,15 +121,83 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
     }
 }
 
+/*
+  The successor is packed into a copy of the packed data of the predecessor,
+  so that the tree table only has to look up the subtrees in which the two
+  states differ.
+*/
+State StateRegistry::get_successor_state_from_tree(
+    const State &predecessor, const OperatorProxy &op) {
+    assert(predecessor.get_registry() == this);
+    predecessor.unpack();
+    const vector<int> &values = predecessor.get_unpacked_values();
+    vector<int> new_values = values;
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, predecessor)) {
+            FactPair effect_pair = effect.get_fact().get_pair();
+            new_values[effect_pair.var] = effect_pair.value;
+        }
+    }
+    if (task_properties::has_axioms(task_proxy)) {
+        axiom_evaluator.evaluate(new_values);
+    }
+
+    int parent_root = state_data_pool[predecessor.get_id().value][0];
+    state_tree->get(parent_root, tree_parent_buffer.data());
+    tree_buffer = tree_parent_buffer;
+    for (int var = 0; var < num_variables; ++var) {
+        if (new_values[var] != values[var]) {
+            state_packer.set(tree_buffer.data(), var, new_values[var]);
+        }
+    }
+    PackedStateBin root = state_tree->insert(
+        tree_buffer.data(), tree_parent_buffer.data(), parent_root);
+    state_data_pool.push_back(&root);
+    StateID id = insert_id_or_pop_state();
+    return task_proxy.create_state(*this, id, nullptr, move(new_values));
+}
+
+State StateRegistry::insert_state(vector<int> &&values) {
+    assert(values.size() == static_cast<size_t>(num_variables));
+    int num_bins = get_bins_per_state();
+    unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
+    // Avoid garbage values in half-full bins.
+    fill_n(buffer.get(), num_bins, 0);
+
+    axiom_evaluator.evaluate(values);
+    for (size_t i = 0; i < values.size(); ++i) {
+        state_packer.set(buffer.get(), i, values[i]);
+    }
+    StateID id = insert_packed_state(buffer.get());
+    return lookup_state(id);
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
 
+int StateRegistry::get_state_data_size() const {
+    return state_tree ? 1 : get_bins_per_state();
+}
+
 int StateRegistry::get_state_size_in_bytes() const {
     return get_bins_per_state() * sizeof(PackedStateBin);
 }
 
+double StateRegistry::get_bytes_per_state() const {
+    if (size() == 0)
+        return 0;
+    size_t bytes = state_data_pool.size() * get_state_data_size() *
+        sizeof(PackedStateBin);
+    if (state_tree)
+        bytes += state_tree->get_memory_in_bytes();
+    return static_cast<double>(bytes) / size();
+}
+
 void StateRegistry::print_statistics(utils::LogProxy &log) const {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
+    if (state_tree) {
+        state_tree->print_statistics(log);
+    }
 }
@@ -9,9 +9,12 @@
 #include "algorithms/int_packer.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
+#include "algorithms/tree_table.h"
 #include "utils/hash.h"
 
+#include <memory>
 #include <set>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -59,6 +62,13 @@
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
 
+  TreeTable (only with StateStorage::TREE)
+    Stores the packed state data as hash-consed binary trees (see
+    algorithms/tree_table.h). States that share parts of their packed data
+    share the memory for these parts. The SegmentedArrayVector then holds only
+    the root node of each state, and the states returned by the registry
+    contain only unpacked data.
+
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
     Can be thought of as a very compactly implemented map from State to T.
@@ -111,6 +121,18 @@ class IntPacker;
 
 using PackedStateBin = int_packer::IntPacker::Bin;
 
+/*
+  How the StateRegistry stores the registered states:
+  PACKED stores every state as a fixed-size array of packed bins.
+  TREE stores the packed bins in a tree table, which needs much less memory
+  for tasks with many variables of which each operator changes only a few,
+  at the cost of decompressing the data whenever a state is looked up.
+*/
+enum class StateStorage {
+    PACKED,
+    TREE
+};
+
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
@@ -162,15 +184,29 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
+    /*
+      With StateStorage::TREE, state_data_pool contains the root of each state
+      in state_tree and the hash set compares the roots.
+    */
+    std::unique_ptr<tree_table::TreeTable> state_tree;
     segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
     StateIDSet registered_states;
+    // Buffers for packing and unpacking the states stored in state_tree.
+    mutable std::vector<PackedStateBin> tree_buffer;
+    std::vector<PackedStateBin> tree_parent_buffer;
 
     std::unique_ptr<State> cached_initial_state;
 
     StateID insert_id_or_pop_state();
+    StateID insert_packed_state(const PackedStateBin *buffer);
+    State get_successor_state_from_tree(
+        const State &predecessor, const OperatorProxy &op);
     int get_bins_per_state() const;
+    int get_state_data_size() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    explicit StateRegistry(
+        const TaskProxy &task_proxy,
+        StateStorage storage = StateStorage::PACKED);
 
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
@@ -203,6 +239,14 @@ public:
     */
     State get_successor_state(const State &predecessor, const OperatorProxy &op);
 
+    /*
+      Returns the state with the given values for the non-derived variables
+      and registers it if this was not done before. The derived variables are
+      computed with the axioms. This is used to take over the states of
+      another task (see task_extension::TaskExtension).
+    */
+    State insert_state(std::vector<int> &&values);
+
     /*
       Returns the number of states registered so far.
     */
@@ -212,6 +256,13 @@ public:
 
     int get_state_size_in_bytes() const;
 
+    /*
+      Returns the memory used for the data of the registered states divided by
+      their number (without the hash set used for duplicate detection, which
+      is the same for all storages).
+    */
+    double get_bytes_per_state() const;
+
     void print_statistics(utils::LogProxy &log) const;
 
     class const_iterator : public std::iterator<
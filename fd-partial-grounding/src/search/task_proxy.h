@@ -587,7 +587,11 @@ public:
     // Construct a registered state with only packed data.
     State(const AbstractTask &task, const StateRegistry &registry, StateID id,
           const PackedStateBin *buffer);
-    // Construct a registered state with packed and unpacked data.
+    /*
+      Construct a registered state with unpacked data and packed data. The
+      buffer is nullptr if the registry does not store the packed data of its
+      states in a contiguous array (see StateStorage).
+    */
     State(const AbstractTask &task, const StateRegistry &registry, StateID id,
           const PackedStateBin *buffer, std::vector<int> &&values);
     // Construct a state with only unpacked data.
@@ -619,7 +623,8 @@ public:
     const std::vector<int> &get_unpacked_values() const;
 
     /* Access the packed values. Accessing packed values on states that do
-       not have them (unregistered states) is an error. */
+       not have them (unregistered states and states of registries with
+       StateStorage::TREE) is an error. */
     const PackedStateBin *get_buffer() const;
 
     /*
@@ -835,8 +840,8 @@ inline const PackedStateBin *State::get_buffer() const {
       not costly, but the 'cerr <<' stuff might prevent inlining.
     */
     if (!buffer) {
-        std::cerr << "Accessing the packed values of an unregistered state is "
-                  << "treated as an error."
+        std::cerr << "Accessing the packed values of a state without packed "
+                  << "values is treated as an error."
                   << std::endl;
         utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
     }
@@ -5,11 +5,14 @@
 
 #include "../abstract_task.h"
 
+#include "../utils/memory.h"
+
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create()) {
+SuccessorGenerator::SuccessorGenerator(
+    const TaskProxy &task_proxy, SuccessorGeneratorLayout layout)
+    : root(SuccessorGeneratorFactory(task_proxy).create(layout)) {
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
@@ -21,4 +24,10 @@ void SuccessorGenerator::generate_applicable_ops(
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+PerTaskInformation<SuccessorGenerator> g_tree_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<SuccessorGenerator>(
+            task_proxy, SuccessorGeneratorLayout::TREE);
+    }
+    );
 }
@@ -13,11 +13,22 @@ class TaskProxy;
 namespace successor_generator {
 class GeneratorBase;
 
+/*
+  TREE: decision tree of polymorphic nodes on the heap.
+  FLAT: the same decision tree encoded in one vector (see GeneratorFlat).
+*/
+enum class SuccessorGeneratorLayout {
+    TREE,
+    FLAT
+};
+
 class SuccessorGenerator {
     std::unique_ptr<GeneratorBase> root;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy,
+        SuccessorGeneratorLayout layout = SuccessorGeneratorLayout::FLAT);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -30,6 +41,8 @@ public:
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+// Successor generators with SuccessorGeneratorLayout::TREE.
+extern PerTaskInformation<SuccessorGenerator> g_tree_successor_generators;
 }
 
 #endif
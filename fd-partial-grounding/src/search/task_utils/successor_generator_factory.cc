@@ -1,5 +1,6 @@
 #include "successor_generator_factory.h"
 
+#include "successor_generator.h"
 #include "successor_generator_internals.h"
 
 #include "../task_proxy.h"
@@ -280,7 +281,7 @@ static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
     return precond;
 }
 
-GeneratorPtr SuccessorGeneratorFactory::create() {
+GeneratorPtr SuccessorGeneratorFactory::create(SuccessorGeneratorLayout layout) {
     OperatorsProxy operators = task_proxy.get_operators();
     operator_infos.reserve(operators.size());
     for (OperatorProxy op : operators) {
@@ -294,6 +295,9 @@ GeneratorPtr SuccessorGeneratorFactory::create() {
     OperatorRange full_range(0, operator_infos.size());
     GeneratorPtr root = construct_recursive(0, full_range);
     operator_infos.clear();
+    if (layout == SuccessorGeneratorLayout::FLAT) {
+        return utils::make_unique_ptr<GeneratorFlat>(*root);
+    }
     return root;
 }
 }
@@ -13,6 +13,7 @@ using GeneratorPtr = std::unique_ptr<GeneratorBase>;
 
 struct OperatorRange;
 class OperatorInfo;
+enum class SuccessorGeneratorLayout;
 
 
 class SuccessorGeneratorFactory {
@@ -30,7 +31,7 @@ public:
     explicit SuccessorGeneratorFactory(const TaskProxy &task_proxy);
     // Destructor cannot be implicit because OperatorInfo is forward-declared.
     ~SuccessorGeneratorFactory();
-    GeneratorPtr create();
+    GeneratorPtr create(SuccessorGeneratorLayout layout);
 };
 }
 
@@ -2,6 +2,9 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/system.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -21,7 +24,9 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. GeneratorFlat
+    implements a variant of this (with sorted instead of hash
+    switches), the remarks below describe further compactions.
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -68,6 +73,26 @@ using namespace std;
 */
 
 namespace successor_generator {
+// Node tags of GeneratorFlat.
+enum FlatNodeType {
+    FORK,
+    SWITCH_VECTOR,
+    SWITCH_SORTED,
+    SWITCH_SINGLE,
+    LEAF
+};
+
+static const int NO_CHILD = -1;
+
+static int get_operator_reference(OperatorID op) {
+    return -2 - op.get_index();
+}
+
+static OperatorID get_referenced_operator(int reference) {
+    assert(reference < NO_CHILD);
+    return OperatorID(-2 - reference);
+}
+
 GeneratorForkBinary::GeneratorForkBinary(
     unique_ptr<GeneratorBase> generator1,
     unique_ptr<GeneratorBase> generator2)
@@ -86,6 +111,16 @@ void GeneratorForkBinary::generate_applicable_ops(
     generator2->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkBinary::append_to_code(vector<int> &code) const {
+    int pos = code.size();
+    code.insert(code.end(), {FORK, 2, NO_CHILD, NO_CHILD});
+    int child1 = generator1->append_to_code(code);
+    code[pos + 2] = child1;
+    int child2 = generator2->append_to_code(code);
+    code[pos + 3] = child2;
+    return pos;
+}
+
 GeneratorForkMulti::GeneratorForkMulti(vector<unique_ptr<GeneratorBase>> children)
     : children(move(children)) {
     /* Note that we permit 0-ary forks as a way to define empty
@@ -101,6 +136,18 @@ void GeneratorForkMulti::generate_applicable_ops(
         generator->generate_applicable_ops(state, applicable_ops);
 }
 
+int GeneratorForkMulti::append_to_code(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(FORK);
+    code.push_back(children.size());
+    code.resize(code.size() + children.size(), NO_CHILD);
+    for (size_t i = 0; i < children.size(); ++i) {
+        int child = children[i]->append_to_code(code);
+        code[pos + 2 + i] = child;
+    }
+    return pos;
+}
+
 GeneratorSwitchVector::GeneratorSwitchVector(
     int switch_var_id, vector<unique_ptr<GeneratorBase>> &&generator_for_value)
     : switch_var_id(switch_var_id),
@@ -116,6 +163,21 @@ void GeneratorSwitchVector::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchVector::append_to_code(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(SWITCH_VECTOR);
+    code.push_back(switch_var_id);
+    code.push_back(generator_for_value.size());
+    code.resize(code.size() + generator_for_value.size(), NO_CHILD);
+    for (size_t value = 0; value < generator_for_value.size(); ++value) {
+        if (generator_for_value[value]) {
+            int child = generator_for_value[value]->append_to_code(code);
+            code[pos + 3 + value] = child;
+        }
+    }
+    return pos;
+}
+
 GeneratorSwitchHash::GeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<GeneratorBase>> &&generator_for_value)
@@ -133,6 +195,25 @@ void GeneratorSwitchHash::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchHash::append_to_code(vector<int> &code) const {
+    vector<int> values;
+    values.reserve(generator_for_value.size());
+    for (const auto &item : generator_for_value)
+        values.push_back(item.first);
+    sort(values.begin(), values.end());
+    int pos = code.size();
+    code.push_back(SWITCH_SORTED);
+    code.push_back(switch_var_id);
+    code.push_back(values.size());
+    code.insert(code.end(), values.begin(), values.end());
+    code.insert(code.end(), values.size(), NO_CHILD);
+    for (size_t i = 0; i < values.size(); ++i) {
+        int child = generator_for_value.at(values[i])->append_to_code(code);
+        code[pos + 3 + values.size() + i] = child;
+    }
+    return pos;
+}
+
 GeneratorSwitchSingle::GeneratorSwitchSingle(
     int switch_var_id, int value, unique_ptr<GeneratorBase> generator_for_value)
     : switch_var_id(switch_var_id),
@@ -147,6 +228,14 @@ void GeneratorSwitchSingle::generate_applicable_ops(
     }
 }
 
+int GeneratorSwitchSingle::append_to_code(vector<int> &code) const {
+    int pos = code.size();
+    code.insert(code.end(), {SWITCH_SINGLE, switch_var_id, value, NO_CHILD});
+    int child = generator_for_value->append_to_code(code);
+    code[pos + 3] = child;
+    return pos;
+}
+
 GeneratorLeafVector::GeneratorLeafVector(vector<OperatorID> &&applicable_operators)
     : applicable_operators(move(applicable_operators)) {
 }
@@ -165,6 +254,15 @@ void GeneratorLeafVector::generate_applicable_ops(
     }
 }
 
+int GeneratorLeafVector::append_to_code(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(LEAF);
+    code.push_back(applicable_operators.size());
+    for (OperatorID id : applicable_operators)
+        code.push_back(id.get_index());
+    return pos;
+}
+
 GeneratorLeafSingle::GeneratorLeafSingle(OperatorID applicable_operator)
     : applicable_operator(applicable_operator) {
 }
@@ -173,4 +271,73 @@ void GeneratorLeafSingle::generate_applicable_ops(
     const vector<int> &, vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+int GeneratorLeafSingle::append_to_code(vector<int> &) const {
+    return get_operator_reference(applicable_operator);
+}
+
+GeneratorFlat::GeneratorFlat(const GeneratorBase &generator) {
+    root = generator.append_to_code(code);
+    code.shrink_to_fit();
+}
+
+/*
+  Follow the last child of forks and the selected child of switches in a
+  loop, so that only forks with several children recurse.
+*/
+void GeneratorFlat::generate_applicable_ops(
+    int node, const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    while (true) {
+        if (node < 0) {
+            if (node != NO_CHILD)
+                applicable_ops.push_back(get_referenced_operator(node));
+            return;
+        }
+        const int *data = &code[node];
+        switch (data[0]) {
+        case FORK: {
+            int num_children = data[1];
+            if (num_children == 0)
+                return;
+            for (int i = 0; i < num_children - 1; ++i)
+                generate_applicable_ops(data[2 + i], state, applicable_ops);
+            node = data[1 + num_children];
+            break;
+        }
+        case SWITCH_VECTOR:
+            node = data[3 + state[data[1]]];
+            break;
+        case SWITCH_SORTED: {
+            int val = state[data[1]];
+            const int *values = data + 3;
+            const int *values_end = values + data[2];
+            const int *it = lower_bound(values, values_end, val);
+            if (it == values_end || *it != val)
+                return;
+            node = it[data[2]];
+            break;
+        }
+        case SWITCH_SINGLE:
+            if (state[data[1]] != data[2])
+                return;
+            node = data[3];
+            break;
+        case LEAF:
+            for (int i = 0; i < data[1]; ++i)
+                applicable_ops.emplace_back(data[2 + i]);
+            return;
+        default:
+            ABORT("Unknown node type in flat successor generator.");
+        }
+    }
+}
+
+void GeneratorFlat::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    generate_applicable_ops(root, state, applicable_ops);
+}
+
+int GeneratorFlat::append_to_code(vector<int> &) const {
+    ABORT("Flat successor generators cannot be encoded again.");
+}
 }
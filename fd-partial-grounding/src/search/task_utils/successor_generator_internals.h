@@ -16,6 +16,12 @@ public:
 
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const = 0;
+
+    /*
+      Append the encoding of this node and its descendants to code (see
+      GeneratorFlat) and return the reference to this node.
+    */
+    virtual int append_to_code(std::vector<int> &code) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -27,6 +33,7 @@ public:
         std::unique_ptr<GeneratorBase> generator2);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -35,6 +42,7 @@ public:
     GeneratorForkMulti(std::vector<std::unique_ptr<GeneratorBase>> children);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
@@ -46,6 +54,7 @@ public:
         std::vector<std::unique_ptr<GeneratorBase>> &&generator_for_value);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
@@ -57,6 +66,7 @@ public:
         std::unordered_map<int, std::unique_ptr<GeneratorBase>> &&generator_for_value);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
@@ -69,6 +79,7 @@ public:
         std::unique_ptr<GeneratorBase> generator_for_value);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -77,6 +88,7 @@ public:
     GeneratorLeafVector(std::vector<OperatorID> &&applicable_operators);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -85,6 +97,41 @@ public:
     GeneratorLeafSingle(OperatorID applicable_operator);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
+};
+
+/*
+  The decision tree of another generator encoded in a single vector of ints,
+  so that generating the applicable operators does not chase pointers to
+  nodes scattered across the heap or make virtual calls.
+
+  Every node starts with a tag, followed by its payload. Nodes are stored in
+  preorder and refer to their children by position in the code. Leaves with
+  a single operator are not stored: a reference -2 - op_id denotes the
+  operator op_id, and -1 (NO_CHILD) denotes an empty child.
+
+  - fork: [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, var_id, k, child_0, ..., child_{k-1}]
+  - sorted switch: [SWITCH_SORTED, var_id, k, value_1, ..., value_k,
+    child_1, ..., child_k] with value_1 < ... < value_k (replaces hash
+    switches; the values are contiguous for binary search)
+  - single switch: [SWITCH_SINGLE, var_id, value, child]
+  - leaf: [LEAF, n, op_id_1, ..., op_id_n]
+
+  The operators are generated in the same order as by the encoded generator.
+*/
+class GeneratorFlat : public GeneratorBase {
+    std::vector<int> code;
+    int root;
+
+    void generate_applicable_ops(
+        int node, const std::vector<int> &state,
+        std::vector<OperatorID> &applicable_ops) const;
+public:
+    explicit GeneratorFlat(const GeneratorBase &generator);
+    virtual void generate_applicable_ops(
+        const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_to_code(std::vector<int> &code) const override;
 };
 }
 
@@ -0,0 +1,143 @@
+#include "task_extension.h"
+
+#include "../utils/strings.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+namespace task_extension {
+static bool is_atom(const string &fact_name) {
+    return utils::startswith(fact_name, "Atom ");
+}
+
+TaskExtension::TaskExtension(
+    const TaskProxy &old_task_proxy, const TaskProxy &new_task_proxy)
+    : old_task_proxy(old_task_proxy),
+      new_task_proxy(new_task_proxy),
+      valid(true) {
+    match_facts();
+    if (valid)
+        match_operators();
+    if (valid)
+        check_initial_state();
+}
+
+void TaskExtension::match_facts() {
+    unordered_map<string, FactPair> new_atoms;
+    VariablesProxy new_variables = new_task_proxy.get_variables();
+    default_value.assign(new_variables.size(), -1);
+    for (VariableProxy var : new_variables) {
+        if (var.is_derived())
+            continue;
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            FactProxy fact = var.get_fact(value);
+            string name = fact.get_name();
+            if (is_atom(name)) {
+                new_atoms.emplace(move(name), fact.get_pair());
+            } else {
+                // "NegatedAtom ..." or "<none of those>"
+                default_value[var.get_id()] = value;
+            }
+        }
+    }
+
+    VariablesProxy old_variables = old_task_proxy.get_variables();
+    old_to_new_fact.resize(old_variables.size());
+    for (VariableProxy var : old_variables) {
+        old_to_new_fact[var.get_id()].assign(var.get_domain_size(), FactPair::no_fact);
+        if (var.is_derived())
+            continue;
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            string name = var.get_fact(value).get_name();
+            if (!is_atom(name))
+                continue;
+            auto it = new_atoms.find(name);
+            if (it == new_atoms.end()) {
+                valid = false;
+                reason = "fact " + name + " is missing in the new task";
+                return;
+            }
+            old_to_new_fact[var.get_id()][value] = it->second;
+        }
+    }
+}
+
+void TaskExtension::match_operators() {
+    OperatorsProxy new_operators = new_task_proxy.get_operators();
+    unordered_map<string, int> new_operator_ids;
+    for (OperatorProxy op : new_operators) {
+        new_operator_ids.emplace(op.get_name(), op.get_id());
+    }
+
+    is_old_operator.assign(new_operators.size(), false);
+    OperatorsProxy old_operators = old_task_proxy.get_operators();
+    old_to_new_operator.reserve(old_operators.size());
+    for (OperatorProxy op : old_operators) {
+        auto it = new_operator_ids.find(op.get_name());
+        if (it == new_operator_ids.end()) {
+            valid = false;
+            reason = "operator " + op.get_name() + " is missing in the new task";
+            return;
+        }
+        old_to_new_operator.push_back(it->second);
+        is_old_operator[it->second] = true;
+    }
+}
+
+void TaskExtension::check_initial_state() {
+    State old_initial_state = old_task_proxy.get_initial_state();
+    State new_initial_state = new_task_proxy.get_initial_state();
+    vector<int> values;
+    if (!convert_state(old_initial_state, values)) {
+        valid = false;
+        reason = "the initial state cannot be converted";
+        return;
+    }
+    for (VariableProxy var : new_task_proxy.get_variables()) {
+        if (!var.is_derived() &&
+            values[var.get_id()] != new_initial_state[var].get_value()) {
+            valid = false;
+            reason = "the initial states differ";
+            return;
+        }
+    }
+}
+
+bool TaskExtension::convert_state(
+    const State &old_state, vector<int> &new_values) const {
+    VariablesProxy new_variables = new_task_proxy.get_variables();
+    new_values.resize(new_variables.size());
+    for (VariableProxy var : new_variables) {
+        new_values[var.get_id()] = var.is_derived() ?
+            var.get_default_axiom_value() : -1;
+    }
+
+    old_state.unpack();
+    const vector<int> &old_values = old_state.get_unpacked_values();
+    for (size_t var = 0; var < old_values.size(); ++var) {
+        const FactPair &fact = old_to_new_fact[var][old_values[var]];
+        if (fact == FactPair::no_fact)
+            continue;
+        if (new_values[fact.var] != -1) {
+            // Two atoms of the old state are mutex in the new task.
+            return false;
+        }
+        new_values[fact.var] = fact.value;
+    }
+
+    for (size_t var = 0; var < new_values.size(); ++var) {
+        if (new_values[var] == -1) {
+            if (default_value[var] == -1)
+                return false;
+            new_values[var] = default_value[var];
+        }
+    }
+    return true;
+}
+
+int TaskExtension::get_num_new_operators() const {
+    return count(is_old_operator.begin(), is_old_operator.end(), false);
+}
+}
@@ -0,0 +1,74 @@
+#ifndef TASK_UTILS_TASK_EXTENSION_H
+#define TASK_UTILS_TASK_EXTENSION_H
+
+#include "../operator_id.h"
+#include "../task_proxy.h"
+
+#include <string>
+#include <vector>
+
+namespace task_extension {
+/*
+  Relates a task to an extension of it, i.e., a task of the same problem that
+  has been grounded with more operators (e.g. the next increment of incremental
+  grounding). Both tasks are produced by separate translator runs, so their
+  variables may be grouped and ordered differently and the operators are
+  renumbered. Facts and operators are therefore matched by name.
+
+  The extension is valid if every atom and operator of the old task exists in
+  the new task and both have the same initial state. Then every state of the old
+  task can be converted into a state of the new task, and every operator of the
+  old task into an operator of the new task.
+
+  NOTE: TaskExtension keeps copies of the task proxies passed to the
+  constructor, so the tasks must outlive it.
+*/
+class TaskExtension {
+    TaskProxy old_task_proxy;
+    TaskProxy new_task_proxy;
+    bool valid;
+    std::string reason;
+
+    // Fact of the new task for each atom of the old task, no_fact otherwise.
+    std::vector<std::vector<FactPair>> old_to_new_fact;
+    // Value of each non-derived variable of the new task if none of its atoms hold.
+    std::vector<int> default_value;
+    std::vector<int> old_to_new_operator;
+    std::vector<bool> is_old_operator;
+
+    void match_facts();
+    void match_operators();
+    void check_initial_state();
+public:
+    TaskExtension(const TaskProxy &old_task_proxy, const TaskProxy &new_task_proxy);
+
+    bool is_valid() const {
+        return valid;
+    }
+
+    // Why the extension is not valid.
+    const std::string &get_reason() const {
+        return reason;
+    }
+
+    /*
+      Convert a state of the old task into the values of the new task. Derived
+      variables are set to their default value. Returns false if the state
+      cannot be represented in the new task.
+    */
+    bool convert_state(const State &old_state, std::vector<int> &new_values) const;
+
+    OperatorID convert_operator(OperatorID old_op) const {
+        return OperatorID(old_to_new_operator[old_op.get_index()]);
+    }
+
+    // True for the operators of the new task that are not in the old task.
+    bool is_new_operator(OperatorID new_op) const {
+        return !is_old_operator[new_op.get_index()];
+    }
+
+    int get_num_new_operators() const;
+};
+}
+
+#endif
@@ -0,0 +1,373 @@
+#include "binary_root_task.h"
+
+#include "binary_task_format.h"
+
+#include "../state_registry.h"
+
+#include "../utils/collections.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+using utils::ExitCode;
+
+namespace tasks {
+/*
+  Task that reads its variables, operators and axioms directly from the arrays
+  of a binary task. Only the initial state and (on demand) the mutexes are
+  copied.
+*/
+class BinaryRootTask : public AbstractTask {
+    unique_ptr<binary_task_format::TaskBuffer> buffer;
+    binary_task_format::TaskView view;
+    const int32_t *variables;
+    const int32_t *costs;
+    const int32_t *precondition_offsets;
+    const int32_t *preconditions;
+    const int32_t *effect_offsets;
+    const int32_t *effects;
+    const int32_t *effect_condition_offsets;
+    const int32_t *effect_conditions;
+    const int32_t *goals;
+    int num_operators;
+    bool use_metric;
+    vector<int> initial_state_values;
+
+    /*
+      The facts that are mutex with each fact, sorted. Most searches never
+      ask for mutexes, so we only compute them on the first request. The
+      computation is guarded by a once_flag, so that the const queries of the
+      task stay safe to call concurrently, like those of RootTask.
+    */
+    mutable vector<vector<FactPair>> mutexes;
+    mutable once_flag mutexes_computed;
+
+    void check_facts(const int32_t *facts, int count) const;
+    void check_task() const;
+    void compute_mutexes() const;
+
+    int get_action_index(int index, bool is_axiom) const {
+        assert(index >= 0);
+        assert(index < (is_axiom ? view.get_num_axioms() : num_operators));
+        return is_axiom ? num_operators + index : index;
+    }
+
+    int get_effect_index(int op_index, int eff_index, bool is_axiom) const {
+        int action = get_action_index(op_index, is_axiom);
+        assert(eff_index >= 0 &&
+               eff_index < effect_offsets[action + 1] - effect_offsets[action]);
+        return effect_offsets[action] + eff_index;
+    }
+
+    int get_fact_id(const FactPair &fact) const {
+        return variables[3 * fact.var + 2] + fact.value;
+    }
+
+public:
+    explicit BinaryRootTask(unique_ptr<binary_task_format::TaskBuffer> buffer);
+
+    virtual int get_num_variables() const override;
+    virtual string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual string get_operator_name(
+        int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual vector<int> get_initial_state_values() const override;
+    virtual void convert_ancestor_state_values(
+        vector<int> &values,
+        const AbstractTask *ancestor_task) const override;
+};
+
+
+BinaryRootTask::BinaryRootTask(unique_ptr<binary_task_format::TaskBuffer> buffer_)
+    : buffer(move(buffer_)),
+      view(buffer->get_view()) {
+    string error;
+    if (!view.validate(error)) {
+        cerr << "Invalid binary task: " << error << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (view.get_num_goals() == 0) {
+        cerr << "Task has no goal condition!" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    variables = view.get_variable(0);
+    costs = view.get_costs();
+    precondition_offsets = view.get_precondition_offsets();
+    preconditions = view.get_preconditions();
+    effect_offsets = view.get_effect_offsets();
+    effects = view.get_effects();
+    effect_condition_offsets = view.get_effect_condition_offsets();
+    effect_conditions = view.get_effect_conditions();
+    goals = view.get_goals();
+    num_operators = view.get_num_operators();
+    use_metric = view.use_metric();
+
+    check_task();
+
+    const int32_t *initial_state = view.get_initial_state();
+    initial_state_values.assign(initial_state, initial_state + view.get_num_variables());
+    /*
+      HACK: We use a TaskProxy to access g_axiom_evaluators here which assumes
+      that this task is completely constructed.
+    */
+    AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[TaskProxy(*this)];
+    axiom_evaluator.evaluate(initial_state_values);
+}
+
+void BinaryRootTask::check_facts(const int32_t *facts, int count) const {
+    int num_variables = view.get_num_variables();
+    for (int i = 0; i < count; ++i) {
+        int var = facts[2 * i];
+        int value = facts[2 * i + 1];
+        if (var < 0 || var >= num_variables) {
+            cerr << "Invalid variable id: " << var << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        if (value < 0 || value >= variables[3 * var]) {
+            cerr << "Invalid value for variable " << var << ": " << value << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
+}
+
+/*
+  The same checks as for text tasks. This is a single pass over the arrays,
+  which is cheap compared to parsing.
+*/
+void BinaryRootTask::check_task() const {
+    int num_variables = view.get_num_variables();
+    int num_facts = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        if (variables[3 * var] <= 0 || variables[3 * var + 2] != num_facts) {
+            cerr << "Invalid domain of variable " << var << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        num_facts += variables[3 * var];
+    }
+    if (num_facts != view.get_num_facts()) {
+        cerr << "Invalid number of facts: " << view.get_num_facts() << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    const int32_t *initial_state = view.get_initial_state();
+    for (int var = 0; var < num_variables; ++var) {
+        if (initial_state[var] < 0 || initial_state[var] >= variables[3 * var]) {
+            cerr << "Invalid value for variable " << var << ": "
+                 << initial_state[var] << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
+    check_facts(goals, view.get_num_goals());
+    int num_actions = num_operators + view.get_num_axioms();
+    check_facts(preconditions, precondition_offsets[num_actions]);
+    check_facts(effect_conditions, effect_condition_offsets[view.get_header().num_effects]);
+    for (int eff = 0; eff < view.get_header().num_effects; ++eff) {
+        // Only check the effect (var, post), the pre value is a precondition.
+        int32_t fact[2] = {effects[3 * eff], effects[3 * eff + 2]};
+        check_facts(fact, 1);
+    }
+    check_facts(view.get_mutex_facts(), view.get_mutex_group_offsets()[view.get_num_mutex_groups()]);
+}
+
+void BinaryRootTask::compute_mutexes() const {
+    mutexes.resize(view.get_num_facts());
+    const int32_t *group_offsets = view.get_mutex_group_offsets();
+    const int32_t *mutex_facts = view.get_mutex_facts();
+    for (int group = 0; group < view.get_num_mutex_groups(); ++group) {
+        for (int i = group_offsets[group]; i < group_offsets[group + 1]; ++i) {
+            FactPair fact1(mutex_facts[2 * i], mutex_facts[2 * i + 1]);
+            for (int j = group_offsets[group]; j < group_offsets[group + 1]; ++j) {
+                FactPair fact2(mutex_facts[2 * j], mutex_facts[2 * j + 1]);
+                // See read_mutexes in root_task.cc.
+                if (fact1.var != fact2.var) {
+                    mutexes[get_fact_id(fact1)].push_back(fact2);
+                }
+            }
+        }
+    }
+    for (vector<FactPair> &mutex_facts_of_fact : mutexes) {
+        utils::sort_unique(mutex_facts_of_fact);
+        mutex_facts_of_fact.shrink_to_fit();
+    }
+}
+
+int BinaryRootTask::get_num_variables() const {
+    return view.get_num_variables();
+}
+
+string BinaryRootTask::get_variable_name(int var) const {
+    assert(var >= 0 && var < get_num_variables());
+    return view.get_variable_name(var);
+}
+
+int BinaryRootTask::get_variable_domain_size(int var) const {
+    assert(var >= 0 && var < get_num_variables());
+    return variables[3 * var];
+}
+
+int BinaryRootTask::get_variable_axiom_layer(int var) const {
+    assert(var >= 0 && var < get_num_variables());
+    return variables[3 * var + 1];
+}
+
+int BinaryRootTask::get_variable_default_axiom_value(int var) const {
+    assert(var >= 0 && var < get_num_variables());
+    return view.get_initial_state()[var];
+}
+
+string BinaryRootTask::get_fact_name(const FactPair &fact) const {
+    assert(fact.value >= 0 && fact.value < get_variable_domain_size(fact.var));
+    return view.get_fact_name(fact.var, fact.value);
+}
+
+bool BinaryRootTask::are_facts_mutex(const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    call_once(mutexes_computed, &BinaryRootTask::compute_mutexes, this);
+    const vector<FactPair> &mutex_facts = mutexes[get_fact_id(fact1)];
+    return binary_search(mutex_facts.begin(), mutex_facts.end(), fact2);
+}
+
+int BinaryRootTask::get_operator_cost(int index, bool is_axiom) const {
+    int action = get_action_index(index, is_axiom);
+    if (is_axiom)
+        return 0;
+    return use_metric ? costs[action] : 1;
+}
+
+string BinaryRootTask::get_operator_name(int index, bool is_axiom) const {
+    int action = get_action_index(index, is_axiom);
+    if (is_axiom)
+        return "<axiom>";
+    return view.get_operator_name(action);
+}
+
+int BinaryRootTask::get_num_operators() const {
+    return num_operators;
+}
+
+int BinaryRootTask::get_num_operator_preconditions(int index, bool is_axiom) const {
+    int action = get_action_index(index, is_axiom);
+    return precondition_offsets[action + 1] - precondition_offsets[action];
+}
+
+FactPair BinaryRootTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    int action = get_action_index(op_index, is_axiom);
+    assert(fact_index >= 0 &&
+           fact_index < precondition_offsets[action + 1] - precondition_offsets[action]);
+    const int32_t *fact = preconditions + 2 * (precondition_offsets[action] + fact_index);
+    return FactPair(fact[0], fact[1]);
+}
+
+int BinaryRootTask::get_num_operator_effects(int op_index, bool is_axiom) const {
+    int action = get_action_index(op_index, is_axiom);
+    return effect_offsets[action + 1] - effect_offsets[action];
+}
+
+int BinaryRootTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    int effect = get_effect_index(op_index, eff_index, is_axiom);
+    return effect_condition_offsets[effect + 1] - effect_condition_offsets[effect];
+}
+
+FactPair BinaryRootTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    int effect = get_effect_index(op_index, eff_index, is_axiom);
+    assert(cond_index >= 0 &&
+           cond_index < effect_condition_offsets[effect + 1] - effect_condition_offsets[effect]);
+    const int32_t *fact = effect_conditions + 2 * (effect_condition_offsets[effect] + cond_index);
+    return FactPair(fact[0], fact[1]);
+}
+
+FactPair BinaryRootTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    const int32_t *effect = effects + 3 * get_effect_index(op_index, eff_index, is_axiom);
+    return FactPair(effect[0], effect[2]);
+}
+
+int BinaryRootTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int BinaryRootTask::get_num_axioms() const {
+    return view.get_num_axioms();
+}
+
+int BinaryRootTask::get_num_goals() const {
+    return view.get_num_goals();
+}
+
+FactPair BinaryRootTask::get_goal_fact(int index) const {
+    assert(index >= 0 && index < get_num_goals());
+    return FactPair(goals[2 * index], goals[2 * index + 1]);
+}
+
+vector<int> BinaryRootTask::get_initial_state_values() const {
+    return initial_state_values;
+}
+
+void BinaryRootTask::convert_ancestor_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+
+shared_ptr<AbstractTask> read_binary_root_task(istream &in) {
+    unique_ptr<binary_task_format::TaskBuffer> buffer =
+        utils::make_unique_ptr<binary_task_format::TaskBuffer>();
+    /*
+      Mapping the standard input only works if it is a regular file that
+      contains a single task. The stream stays at its beginning in this case,
+      so we mark it as consumed.
+    */
+    if (&in == &cin && buffer->map_file(0)) {
+        in.setstate(ios::eofbit);
+    } else if (!buffer->read_from_stream(in)) {
+        cerr << "Could not read binary task." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    return make_shared<BinaryRootTask>(move(buffer));
+}
+}
@@ -0,0 +1,16 @@
+#ifndef TASKS_BINARY_ROOT_TASK_H
+#define TASKS_BINARY_ROOT_TASK_H
+
+#include "../abstract_task.h"
+
+namespace tasks {
+/*
+  Read a task in the binary format (see binary_task_format.h) from the stream.
+  If the stream is std::cin and the standard input is a regular file, the file
+  is mapped into memory and the task accesses the arrays in place; otherwise
+  the task is read into memory first.
+*/
+extern std::shared_ptr<AbstractTask> read_binary_root_task(std::istream &in);
+}
+
+#endif
@@ -0,0 +1,383 @@
+#ifndef TASKS_BINARY_TASK_FORMAT_H
+#define TASKS_BINARY_TASK_FORMAT_H
+
+/*
+  Binary representation of a translated task (output.sas).
+
+  Parsing the text format token by token dominates the loading time of
+  partially grounded tasks with millions of operators. The binary format
+  stores the same information in flat arrays, so that the search and
+  preprocess-h2 can map the file into memory and access the arrays in place.
+  Text files are still accepted everywhere; binary files are recognized by
+  their first byte, which cannot start a text file.
+
+  The file starts with a Header, followed by the sections listed in Section.
+  Every section starts at an offset that is a multiple of 8 and is an array of
+  int32_t, except for STRING_OFFSETS (int64_t) and STRING_DATA (char). Numbers
+  are stored in the byte order of the machine that wrote the file. Facts are
+  stored as pairs (var, value).
+
+  Operators and axioms share the arrays COSTS, PRECONDITION_OFFSETS and
+  EFFECT_OFFSETS: entries [0, num_operators) are the operators and the
+  following num_axioms entries are the axioms. The preconditions of an
+  operator are its prevail conditions followed by the "pre" values of its
+  effects that are not -1, i.e., the preconditions the search uses. Effects
+  are triples (var, pre, post), so that the prevail conditions of the text
+  format are the first preconditions of an operator that do not come from an
+  effect.
+
+  Strings: variable names [0, num_variables), fact names (in the order of the
+  facts, see VARIABLES) and operator names. Each string i consists of the
+  characters [STRING_OFFSETS[i], STRING_OFFSETS[i + 1]) of STRING_DATA.
+
+  NOTE: This header is shared with preprocess-h2, which is compiled as C++11.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace binary_task_format {
+static const char MAGIC[8] = {'\x7f', 'S', 'A', 'S', 'B', 'I', 'N', '\0'};
+static const int32_t VERSION = 1;
+// Version of the text format with the same contents.
+static const int32_t SAS_FILE_VERSION = 3;
+
+enum Section {
+    STRING_OFFSETS,
+    STRING_DATA,
+    // Triples (domain size, axiom layer, index of the first fact).
+    VARIABLES,
+    INITIAL_STATE,
+    GOALS,
+    MUTEX_GROUP_OFFSETS,
+    MUTEX_FACTS,
+    COSTS,
+    PRECONDITION_OFFSETS,
+    PRECONDITIONS,
+    EFFECT_OFFSETS,
+    // Triples (var, pre, post).
+    EFFECTS,
+    EFFECT_CONDITION_OFFSETS,
+    EFFECT_CONDITIONS,
+    NUM_SECTIONS
+};
+
+struct SectionInfo {
+    uint64_t offset;
+    // In bytes.
+    uint64_t size;
+};
+
+struct Header {
+    char magic[8];
+    int32_t version;
+    int32_t use_metric;
+    int32_t num_variables;
+    int32_t num_facts;
+    int32_t num_operators;
+    int32_t num_axioms;
+    int32_t num_goals;
+    int32_t num_mutex_groups;
+    int32_t num_effects;
+    int32_t padding;
+    uint64_t file_size;
+    SectionInfo sections[NUM_SECTIONS];
+};
+
+inline bool is_binary_task(int first_character) {
+    return first_character == static_cast<unsigned char>(MAGIC[0]);
+}
+
+/*
+  Read-only view of a binary task stored in memory. The view does not own the
+  memory; see TaskBuffer.
+*/
+class TaskView {
+    const char *data;
+    std::size_t size;
+
+    template<typename T>
+    const T *get_section(Section section) const {
+        return reinterpret_cast<const T *>(data + get_header().sections[section].offset);
+    }
+
+    template<typename T>
+    std::size_t get_section_length(Section section) const {
+        return get_header().sections[section].size / sizeof(T);
+    }
+public:
+    TaskView(const char *data, std::size_t size)
+        : data(data), size(size) {
+    }
+
+    const Header &get_header() const {
+        return *reinterpret_cast<const Header *>(data);
+    }
+
+    /*
+      Check that the header and the sizes of the sections are consistent.
+      The contents of the sections (e.g. the range of the facts) are not
+      checked.
+    */
+    bool validate(std::string &error) const {
+        if (size < sizeof(Header) || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+            error = "not a binary task";
+            return false;
+        }
+        const Header &header = get_header();
+        if (header.version != VERSION) {
+            error = "expected binary task version " + std::to_string(VERSION) +
+                ", got " + std::to_string(header.version);
+            return false;
+        }
+        if (header.file_size != size) {
+            error = "truncated binary task";
+            return false;
+        }
+        for (int i = 0; i < NUM_SECTIONS; ++i) {
+            const SectionInfo &section = header.sections[i];
+            if (section.offset % 8 != 0 || section.offset > size ||
+                section.size > size - section.offset) {
+                error = "invalid section " + std::to_string(i);
+                return false;
+            }
+        }
+        std::size_t num_actions = header.num_operators + header.num_axioms;
+        std::size_t num_strings = header.num_variables + header.num_facts + header.num_operators;
+        const int64_t *string_offsets = get_section<int64_t>(STRING_OFFSETS);
+        if (get_section_length<int64_t>(STRING_OFFSETS) != num_strings + 1 ||
+            static_cast<uint64_t>(string_offsets[num_strings]) > header.sections[STRING_DATA].size ||
+            get_section_length<int32_t>(VARIABLES) != 3 * static_cast<std::size_t>(header.num_variables) ||
+            get_section_length<int32_t>(INITIAL_STATE) != static_cast<std::size_t>(header.num_variables) ||
+            get_section_length<int32_t>(GOALS) != 2 * static_cast<std::size_t>(header.num_goals) ||
+            get_section_length<int32_t>(MUTEX_GROUP_OFFSETS) != header.num_mutex_groups + 1u ||
+            get_section_length<int32_t>(COSTS) != num_actions ||
+            get_section_length<int32_t>(PRECONDITION_OFFSETS) != num_actions + 1 ||
+            get_section_length<int32_t>(EFFECT_OFFSETS) != num_actions + 1 ||
+            get_section_length<int32_t>(EFFECTS) != 3 * static_cast<std::size_t>(header.num_effects) ||
+            get_section_length<int32_t>(EFFECT_CONDITION_OFFSETS) != header.num_effects + 1u) {
+            error = "inconsistent section sizes";
+            return false;
+        }
+        struct OffsetArray {
+            Section offsets;
+            Section elements;
+            std::size_t element_size;
+        };
+        const OffsetArray offset_arrays[] = {
+            {MUTEX_GROUP_OFFSETS, MUTEX_FACTS, 2},
+            {PRECONDITION_OFFSETS, PRECONDITIONS, 2},
+            {EFFECT_OFFSETS, EFFECTS, 3},
+            {EFFECT_CONDITION_OFFSETS, EFFECT_CONDITIONS, 2}};
+        for (const OffsetArray &array : offset_arrays) {
+            const int32_t *offsets = get_section<int32_t>(array.offsets);
+            std::size_t length = get_section_length<int32_t>(array.offsets);
+            for (std::size_t i = 0; i + 1 < length; ++i) {
+                if (offsets[i] < 0 || offsets[i] > offsets[i + 1]) {
+                    error = "invalid offsets in section " + std::to_string(array.offsets);
+                    return false;
+                }
+            }
+            if (offsets[0] != 0 || static_cast<std::size_t>(offsets[length - 1]) * array.element_size !=
+                get_section_length<int32_t>(array.elements)) {
+                error = "invalid offsets in section " + std::to_string(array.offsets);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int get_num_variables() const {
+        return get_header().num_variables;
+    }
+
+    int get_num_facts() const {
+        return get_header().num_facts;
+    }
+
+    int get_num_operators() const {
+        return get_header().num_operators;
+    }
+
+    int get_num_axioms() const {
+        return get_header().num_axioms;
+    }
+
+    int get_num_goals() const {
+        return get_header().num_goals;
+    }
+
+    int get_num_mutex_groups() const {
+        return get_header().num_mutex_groups;
+    }
+
+    bool use_metric() const {
+        return get_header().use_metric != 0;
+    }
+
+    const char *get_string(int index, std::size_t &length) const {
+        const int64_t *offsets = get_section<int64_t>(STRING_OFFSETS);
+        length = offsets[index + 1] - offsets[index];
+        return get_section<char>(STRING_DATA) + offsets[index];
+    }
+
+    std::string get_string(int index) const {
+        std::size_t length;
+        const char *str = get_string(index, length);
+        return std::string(str, length);
+    }
+
+    // Variables and facts
+    const int32_t *get_variable(int var) const {
+        return get_section<int32_t>(VARIABLES) + 3 * var;
+    }
+
+    std::string get_variable_name(int var) const {
+        return get_string(var);
+    }
+
+    std::string get_fact_name(int var, int value) const {
+        return get_string(get_num_variables() + get_variable(var)[2] + value);
+    }
+
+    const int32_t *get_initial_state() const {
+        return get_section<int32_t>(INITIAL_STATE);
+    }
+
+    const int32_t *get_goals() const {
+        return get_section<int32_t>(GOALS);
+    }
+
+    const int32_t *get_mutex_group_offsets() const {
+        return get_section<int32_t>(MUTEX_GROUP_OFFSETS);
+    }
+
+    const int32_t *get_mutex_facts() const {
+        return get_section<int32_t>(MUTEX_FACTS);
+    }
+
+    // Operators (index < num_operators) and axioms (the following indices)
+    std::string get_operator_name(int op) const {
+        return get_string(get_num_variables() + get_num_facts() + op);
+    }
+
+    const int32_t *get_costs() const {
+        return get_section<int32_t>(COSTS);
+    }
+
+    const int32_t *get_precondition_offsets() const {
+        return get_section<int32_t>(PRECONDITION_OFFSETS);
+    }
+
+    const int32_t *get_preconditions() const {
+        return get_section<int32_t>(PRECONDITIONS);
+    }
+
+    const int32_t *get_effect_offsets() const {
+        return get_section<int32_t>(EFFECT_OFFSETS);
+    }
+
+    const int32_t *get_effects() const {
+        return get_section<int32_t>(EFFECTS);
+    }
+
+    const int32_t *get_effect_condition_offsets() const {
+        return get_section<int32_t>(EFFECT_CONDITION_OFFSETS);
+    }
+
+    const int32_t *get_effect_conditions() const {
+        return get_section<int32_t>(EFFECT_CONDITIONS);
+    }
+};
+
+/*
+  Memory holding a binary task: either a read-only mapping of a file or a
+  buffer filled from a stream.
+*/
+class TaskBuffer {
+    const char *data;
+    std::size_t size;
+    void *mapping;
+    std::vector<char> buffer;
+
+    TaskBuffer(const TaskBuffer &) = delete;
+    TaskBuffer &operator=(const TaskBuffer &) = delete;
+public:
+    TaskBuffer()
+        : data(nullptr), size(0), mapping(nullptr) {
+    }
+
+    ~TaskBuffer() {
+#ifndef _WIN32
+        if (mapping)
+            munmap(mapping, size);
+#endif
+    }
+
+    /*
+      Map the file open as file descriptor fd if it is a regular file that
+      contains exactly one binary task. Returns false otherwise (e.g. if fd is
+      a pipe), in which case the task should be read with read_from_stream.
+    */
+    bool map_file(int fd) {
+#ifndef _WIN32
+        struct stat file_info;
+        if (fstat(fd, &file_info) != 0 || !S_ISREG(file_info.st_mode) ||
+            file_info.st_size < static_cast<off_t>(sizeof(Header)))
+            return false;
+        std::size_t file_size = file_info.st_size;
+        void *address = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+            return false;
+        const Header *header = static_cast<const Header *>(address);
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header->file_size != file_size) {
+            munmap(address, file_size);
+            return false;
+        }
+        mapping = address;
+        data = static_cast<const char *>(address);
+        size = file_size;
+        return true;
+#else
+        (void)fd;
+        return false;
+#endif
+    }
+
+    // Read the next binary task from the stream. Returns false on errors.
+    bool read_from_stream(std::istream &in) {
+        Header header;
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(Header)) ||
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header.file_size < sizeof(Header))
+            return false;
+        buffer.resize(header.file_size);
+        std::memcpy(buffer.data(), &header, sizeof(Header));
+        if (!in.read(buffer.data() + sizeof(Header), header.file_size - sizeof(Header)))
+            return false;
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+    }
+
+    bool is_mapped() const {
+        return mapping != nullptr;
+    }
+
+    TaskView get_view() const {
+        return TaskView(data, size);
+    }
+};
+}
+
+#endif
@@ -1,5 +1,8 @@
 #include "root_task.h"
 
+#include "binary_root_task.h"
+#include "binary_task_format.h"
+
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../state_registry.h"
@@ -493,9 +496,23 @@ void RootTask::convert_ancestor_state_values(
     }
 }
 
+static shared_ptr<AbstractTask> read_task(istream &in) {
+    if (binary_task_format::is_binary_task(in.peek()))
+        return read_binary_root_task(in);
+    return make_shared<RootTask>(in);
+}
+
 void read_root_task(istream &in) {
     assert(!g_root_task);
-    g_root_task = make_shared<RootTask>(in);
+    g_root_task = read_task(in);
+}
+
+bool read_next_root_task(istream &in) {
+    in >> ws;
+    if (in.eof())
+        return false;
+    g_root_task = read_task(in);
+    return true;
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
@@ -5,6 +5,15 @@
 
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
+/*
+  Read the root task in the text format or in the binary format (see
+  binary_task_format.h).
+*/
 extern void read_root_task(std::istream &in);
+/*
+  Replace the root task by the next task in the stream. Returns false if there
+  are no more tasks. Objects created for the previous root task keep it alive.
+*/
+extern bool read_next_root_task(std::istream &in);
 }
 #endif
@@ -0,0 +1,35 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+void parallel_for(
+    int num_threads, int num_items,
+    const function<void(int item, int thread)> &func) {
+    assert(num_threads >= 1);
+    num_threads = min(num_threads, num_items);
+    if (num_threads <= 1) {
+        for (int item = 0; item < num_items; ++item)
+            func(item, 0);
+        return;
+    }
+    atomic<int> next_item(0);
+    auto work = [&](int thread) {
+        for (int item = next_item++; item < num_items; item = next_item++)
+            func(item, thread);
+    };
+    vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int thread = 1; thread < num_threads; ++thread)
+        threads.emplace_back(work, thread);
+    work(0);
+    for (std::thread &thread : threads)
+        thread.join();
+}
+}
@@ -0,0 +1,19 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+
+namespace utils {
+/*
+  Call func(item, thread) for every item in [0, num_items) using up to
+  num_threads threads (including the calling one), which are numbered from 0.
+  Items are handed out dynamically, so func must not depend on the thread
+  that processes an item except for using per-thread scratch data. With one
+  thread, the items are processed in order in the calling thread.
+*/
+extern void parallel_for(
+    int num_threads, int num_items,
+    const std::function<void(int item, int thread)> &func);
+}
+
+#endif
@@ -4,6 +4,7 @@
 from collections import defaultdict
 
 import build_model
+import options
 import pddl_to_prolog
 import pddl
 import timers
@@ -102,7 +103,153 @@ def instantiate(task, model):
             sorted(instantiated_axioms), reachable_action_parameters)
 
 
+class FluentPredicateFacts:
+    """All atoms of the fluent predicates, as a set that only supports "in"."""
+    def __init__(self, fluent_predicates):
+        self.fluent_predicates = fluent_predicates
+    def __contains__(self, atom):
+        return atom.predicate in self.fluent_predicates
+
+def read_actions_file(task, filename):
+    """Return the (action, arguments) pairs of the actions in the file, or
+    None if an action does not match a schema of the task."""
+    actions_by_name = defaultdict(list)
+    for action in task.actions:
+        actions_by_name[action.name].append(action)
+    result = []
+    with open(filename) as actions_file:
+        for line in actions_file:
+            if line.startswith(";"):
+                # this is probably the "; cost = X (unit cost)" part of a plan file
+                continue
+            parts = line.replace("(", " ").replace(")", " ").split()
+            if not parts:
+                continue
+            name, args = parts[0], tuple(parts[1:])
+            matching = [action for action in actions_by_name[name]
+                        if len(action.parameters) == len(args)]
+            if not matching:
+                print("Action (%s) of the actions file does not match a schema "
+                      "of the task." % " ".join(parts))
+                return None
+            for action in matching:
+                result.append((action, args))
+    return result
+
+def instantiate_from_actions_file(task, actions):
+    """Instantiate the given (action, arguments) pairs without computing the
+    relaxed reachable model. The fluent facts are the fluent facts of the
+    initial state and the add effects of the actions that are relaxed
+    reachable from them, using only these actions."""
+    init_facts = set()
+    init_assignments = {}
+    for element in task.init:
+        if isinstance(element, pddl.Assign):
+            init_assignments[element.fluent] = element.expression
+        else:
+            init_facts.add(element)
+    type_to_objects = get_objects_by_type(task.objects, task.types)
+
+    def is_reached(condition, reached):
+        return all(literal in reached for literal in condition
+                   if not literal.negated)
+
+    def restrict_to_reached(condition, reached):
+        return [literal for literal in condition
+                if not literal.negated or literal.positive() in reached]
+
+    # Instantiate the actions once, keeping the fluent parts of all
+    # conditions, to compute the reachable facts.
+    fluent_predicates = {effect.literal.predicate
+                         for action in task.actions
+                         for effect in action.effects}
+    all_fluent_facts = FluentPredicateFacts(fluent_predicates)
+    relaxed_actions = []
+    for action, args in actions:
+        variable_mapping = {par.name: arg
+                            for par, arg in zip(action.parameters, args)}
+        inst_action = action.instantiate(
+            variable_mapping, init_facts, init_assignments,
+            all_fluent_facts, type_to_objects, task.use_min_cost_metric)
+        if inst_action:
+            relaxed_actions.append((action, args, inst_action))
+
+    # The actions are usually listed in the order in which they become
+    # reachable, so a single pass reaches almost all facts. Later passes only
+    # look at the actions with unreached conditions.
+    reached = {fact for fact in init_facts if fact in all_fluent_facts}
+    pending = [inst_action for _, _, inst_action in relaxed_actions]
+    changed = True
+    while pending and changed:
+        changed = False
+        still_pending = []
+        for inst_action in pending:
+            if not is_reached(inst_action.precondition, reached):
+                still_pending.append(inst_action)
+                continue
+            has_unreached_effects = False
+            for condition, atom in inst_action.add_effects:
+                if atom not in reached:
+                    if is_reached(condition, reached):
+                        reached.add(atom)
+                        changed = True
+                    else:
+                        has_unreached_effects = True
+            if has_unreached_effects:
+                still_pending.append(inst_action)
+        pending = still_pending
+
+    # Remove what an instantiation with the reached facts as fluent facts
+    # would not have produced: unreachable actions and effects, and
+    # unreachable negated conditions (which are always true).
+    instantiated_actions = []
+    reachable_action_parameters = defaultdict(list)
+    for action, args, inst_action in relaxed_actions:
+        if not is_reached(inst_action.precondition, reached):
+            continue
+        reachable_action_parameters[action].append(args)
+        if (all(literal.positive() in reached
+                for literal in inst_action.precondition) and
+                all(atom in reached and
+                    all(literal.positive() in reached for literal in condition)
+                    for condition, atom in inst_action.del_effects) and
+                all(not condition for condition, _ in inst_action.add_effects)):
+            instantiated_actions.append(inst_action)
+            continue
+        effects = []
+        for condition, atom in inst_action.add_effects:
+            if is_reached(condition, reached):
+                effects.append((restrict_to_reached(condition, reached), atom))
+        for condition, atom in inst_action.del_effects:
+            if atom in reached and is_reached(condition, reached):
+                effects.append((restrict_to_reached(condition, reached),
+                                atom.negate()))
+        if effects:
+            instantiated_actions.append(pddl.PropositionalAction(
+                inst_action.name,
+                restrict_to_reached(inst_action.precondition, reached),
+                effects, inst_action.cost))
+        else:
+            reachable_action_parameters[action].pop()
+    print("%d actions instantiated" % len(instantiated_actions))
+
+    instantiated_goal = instantiate_goal(task.goal, init_facts, reached)
+    relaxed_reachable = instantiated_goal is not None
+    return (relaxed_reachable, reached,
+            instantiated_actions, instantiated_goal,
+            [], reachable_action_parameters)
+
+
 def explore(task):
+    if options.skip_exploration and options.actions_file:
+        if task.axioms:
+            print("The task has axioms, computing the model to instantiate "
+                  "the actions file.")
+        else:
+            actions = read_actions_file(task, options.actions_file[0])
+            if actions is not None:
+                with timers.timing("Instantiating actions file"):
+                    return instantiate_from_actions_file(task, actions)
     prog = pddl_to_prolog.translate(task)
     model = build_model.compute_model(prog, task)
     with timers.timing("Completing instantiation"):
@@ -75,6 +75,13 @@ def parse_args():
     argparser.add_argument(
         "--actions-file", type=str, nargs=1,
         help="file that contains (line by line) the actions that should be grounded.")
+    argparser.add_argument(
+        "--skip-exploration", action="store_true",
+        help="Only has an effect in combination with --actions-file. Instantiate the actions of the file directly "
+             "instead of computing the relaxed reachable model first. The file must list every action with all its "
+             "parameters in an order in which it becomes relaxed reachable, as written by the partial grounding of "
+             "powerlifted (powerlifted.py --partial-grounding). If an action does not match a schema of the task, "
+             "the model is computed as without this option.")
     argparser.add_argument(
         "--reachable-actions-output-file", type=str, nargs=1,
         help="file to write the actions to that were reachable during grounding.")
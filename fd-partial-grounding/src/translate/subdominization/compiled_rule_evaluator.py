@@ -0,0 +1,147 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Evaluates the good/bad rules with the C++ rule evaluator of powerlifted
+# (src/powerlifted/src/search/partial_grounding/rule_evaluator.h), which
+# compiles every rule into a join over the initial state and goal when it is
+# loaded, so that evaluating an action is a hash lookup. The evaluator is
+# loaded from the shared library built together with powerlifted.
+
+import ctypes
+import os
+
+import pddl
+
+LIBRARY_NAME = "librule_evaluator.so"
+LIBRARY_ENV_VARIABLE = "RULE_EVALUATOR_LIBRARY"
+
+INIT, GOAL = 0, 1
+
+_library = None
+
+
+def find_library():
+    if LIBRARY_ENV_VARIABLE in os.environ:
+        return os.environ[LIBRARY_ENV_VARIABLE]
+    directory = os.path.dirname(os.path.abspath(__file__))
+    while True:
+        for build in ["powerlifted-release", "powerlifted-debug"]:
+            path = os.path.join(directory, "builds", build, "bin", "search", LIBRARY_NAME)
+            if os.path.isfile(path):
+                return path
+        parent = os.path.dirname(directory)
+        if parent == directory:
+            return None
+        directory = parent
+
+
+def load_library():
+    global _library
+    if _library is None:
+        path = find_library()
+        if path is None:
+            return None
+        lib = ctypes.CDLL(path)
+        int_p = ctypes.POINTER(ctypes.c_int)
+        str_p = ctypes.POINTER(ctypes.c_char_p)
+        lib.rule_evaluator_create_fact_base.restype = ctypes.c_void_p
+        lib.rule_evaluator_create_fact_base.argtypes = []
+        lib.rule_evaluator_destroy_fact_base.argtypes = [ctypes.c_void_p]
+        lib.rule_evaluator_add_object.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        lib.rule_evaluator_add_predicate.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        lib.rule_evaluator_add_fact.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, int_p, ctypes.c_int]
+        lib.rule_evaluator_create.restype = ctypes.c_void_p
+        lib.rule_evaluator_create.argtypes = [str_p, int_p, ctypes.c_int]
+        lib.rule_evaluator_destroy.argtypes = [ctypes.c_void_p]
+        lib.rule_evaluator_load_rules.argtypes = [ctypes.c_void_p, ctypes.c_void_p, str_p, ctypes.c_int]
+        lib.rule_evaluator_has_rules.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        lib.rule_evaluator_evaluate_batch.argtypes = [ctypes.c_void_p, ctypes.c_int, int_p, ctypes.c_int, int_p]
+        _library = lib
+    return _library
+
+
+def is_supported(rule_text):
+    # Rules on the relaxed plan are only supported by the Python evaluator
+    return "split:" not in rule_text and "relaxed_fact:" not in rule_text
+
+
+class RuleFactBase:
+    """
+    Atoms of the initial state and the goal, as seen by the Python rule
+    evaluator (see evaluate_inigoal_rule in rule_evaluator.py).
+    """
+    def __init__(self, task, lib):
+        self.lib = lib
+        self.fact_base = lib.rule_evaluator_create_fact_base()
+        self.object_ids = {}
+        self.predicate_ids = {}
+        for obj in task.objects:
+            self.get_object(obj.name)
+        for fact in task.init:
+            if type(fact) != pddl.Assign:
+                self.add_fact(INIT, fact)
+        for fact in task.goal.parts:
+            self.add_fact(GOAL, fact)
+
+    def __del__(self):
+        self.lib.rule_evaluator_destroy_fact_base(self.fact_base)
+
+    def get_object(self, name):
+        if name not in self.object_ids:
+            self.object_ids[name] = self.lib.rule_evaluator_add_object(self.fact_base, name.encode())
+        return self.object_ids[name]
+
+    def add_fact(self, source, fact):
+        if fact.predicate not in self.predicate_ids:
+            self.predicate_ids[fact.predicate] = self.lib.rule_evaluator_add_predicate(
+                self.fact_base, fact.predicate.encode())
+        args = [self.get_object(a) for a in fact.args]
+        self.lib.rule_evaluator_add_fact(self.fact_base, source, self.predicate_ids[fact.predicate],
+                                         (ctypes.c_int * len(args))(*args), len(args))
+
+
+class CompiledRulesEvaluator:
+    """
+    Same interface as RulesEvaluator, but evaluate returns a single value for
+    all rules of the schema: [1] if some rule fires and [0] otherwise.
+    """
+    def __init__(self, rule_text, task, fact_base):
+        self.lib = fact_base.lib
+        self.fact_base = fact_base
+        self.schema_ids = {a.name: i for i, a in enumerate(task.actions)}
+        names = (ctypes.c_char_p * len(task.actions))(*[a.name.encode() for a in task.actions])
+        arities = (ctypes.c_int * len(task.actions))(*[len(a.parameters) for a in task.actions])
+        self.evaluator = self.lib.rule_evaluator_create(names, arities, len(task.actions))
+
+        rules = [l for l in rule_text if l.strip()]
+        self.rules = [l.replace('\n', '') for l in rules]
+        self.rule_schemas = list(dict.fromkeys(l.split("(")[0].strip() for l in rules))
+        self.lib.rule_evaluator_load_rules(self.evaluator, fact_base.fact_base,
+                                           (ctypes.c_char_p * len(rules))(*[l.encode() for l in rules]),
+                                           len(rules))
+
+    def __del__(self):
+        self.lib.rule_evaluator_destroy(self.evaluator)
+
+    def get_action_schemas(self):
+        return self.rule_schemas
+
+    def evaluate(self, action):
+        return self.evaluate_batch(action.predicate.name, [action])
+
+    def evaluate_batch(self, schema, actions):
+        """
+        Evaluate actions of the same schema in a single call.
+        """
+        schema_id = self.schema_ids.get(schema)
+        if schema_id is None or not self.lib.rule_evaluator_has_rules(self.evaluator, schema_id):
+            return [0] * len(actions)
+        object_ids = self.fact_base.object_ids
+        args = [object_ids.get(a, -1) for action in actions for a in action.args]
+        result = (ctypes.c_int * len(actions))()
+        self.lib.rule_evaluator_evaluate_batch(self.evaluator, schema_id, (ctypes.c_int * len(args))(*args),
+                                               len(actions), result)
+        return list(result)
+
+    def get_all_rules(self):
+        return self.rules
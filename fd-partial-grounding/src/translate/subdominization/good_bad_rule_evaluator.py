@@ -4,19 +4,53 @@
 from collections import defaultdict
 import os.path
 
+from . import compiled_rule_evaluator
 from .rule_evaluator import RulesEvaluator
 
 
+def get_compiled_evaluator_class(task, rules):
+    """
+    Constructor of CompiledRulesEvaluator objects that share the facts of the
+    task, or RulesEvaluator if the compiled evaluator cannot be used.
+    """
+    if not all(compiled_rule_evaluator.is_supported(rule) for rule in rules):
+        print("Rules on the relaxed plan are not supported by the compiled rule evaluator, "
+              "using the Python rule evaluator.")
+        return RulesEvaluator
+    lib = compiled_rule_evaluator.load_library()
+    if lib is None:
+        print(f"Could not find {compiled_rule_evaluator.LIBRARY_NAME}, using the Python rule evaluator. "
+              f"Build powerlifted or set {compiled_rule_evaluator.LIBRARY_ENV_VARIABLE} to use the compiled one.")
+        return RulesEvaluator
+    print("Using the compiled rule evaluator.")
+    fact_base = compiled_rule_evaluator.RuleFactBase(task, lib)
+    return lambda rule_text, task: compiled_rule_evaluator.CompiledRulesEvaluator(rule_text, task, fact_base)
+
+
+def read_rules(path):
+    if os.path.isfile(path):
+        with open(path) as rules_file:
+            return rules_file.readlines()
+    return None
+
+
 class GodBadRuleEvaluator:
+    GOOD, NEUTRAL, BAD = 0, 1, 2
+
     def __init__(self, task, args):
         self.good_rule_evaluator = None
         self.bad_rule_evaluator = None
-        if os.path.isfile(os.path.join(args.trained_model_folder, "good_rules.rules")):
-            with open(os.path.join(args.trained_model_folder, "good_rules.rules")) as rules_file:
-                self.good_rule_evaluator = RulesEvaluator(rules_file.readlines(), task)
-        if os.path.isfile(os.path.join(args.trained_model_folder, "bad_rules.rules")):
-            with open(os.path.join(args.trained_model_folder, "bad_rules.rules")) as rules_file:
-                self.bad_rule_evaluator = RulesEvaluator(rules_file.readlines(), task)
+        good_rules = read_rules(os.path.join(args.trained_model_folder, "good_rules.rules"))
+        bad_rules = read_rules(os.path.join(args.trained_model_folder, "bad_rules.rules"))
+
+        evaluator_class = RulesEvaluator
+        if args.batch_evaluation:
+            evaluator_class = get_compiled_evaluator_class(task, (good_rules or []) + (bad_rules or []))
+
+        if good_rules is not None:
+            self.good_rule_evaluator = evaluator_class(good_rules, task)
+        if bad_rules is not None:
+            self.bad_rule_evaluator = evaluator_class(bad_rules, task)
 
         self.num_good_actions = defaultdict(int)
         self.num_bad_actions = defaultdict(int)
@@ -47,6 +81,31 @@ class GodBadRuleEvaluator:
         else:
             return False
 
+    def classify_actions(self, actions):
+        """
+        Return GOOD, NEUTRAL or BAD for each action, evaluating the actions of
+        each schema together if the rule evaluators support it.
+        """
+        classes = [self.NEUTRAL] * len(actions)
+        by_schema = defaultdict(list)
+        for i, action in enumerate(actions):
+            by_schema[action.predicate.name].append(i)
+        for schema, indices in by_schema.items():
+            for evaluator, label, counter in [(self.good_rule_evaluator, self.GOOD, self.num_good_actions),
+                                              (self.bad_rule_evaluator, self.BAD, self.num_bad_actions)]:
+                indices = [i for i in indices if classes[i] == self.NEUTRAL]
+                if not evaluator or not indices:
+                    continue
+                if hasattr(evaluator, "evaluate_batch"):
+                    values = evaluator.evaluate_batch(schema, [actions[i] for i in indices])
+                else:
+                    values = [any(e == 1 for e in evaluator.evaluate(actions[i])) for i in indices]
+                for i, value in zip(indices, values):
+                    if value:
+                        classes[i] = label
+                        counter[schema] += 1
+        return classes
+
     def print_stats(self):
         for schema, num in self.num_good_actions.items():
             print(f"Detected {num} good operators of action schema {schema}.")
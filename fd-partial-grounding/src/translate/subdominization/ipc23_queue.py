@@ -35,10 +35,13 @@ class IPC23SingleQueue(PriorityQueue):
         if not self.model.get_trained_schemas() and not self.good_bad_rule_evaluator.get_action_schemas():
             # nothing to evaluate
             self.batch_eval = False
+        # with batch evaluation, the rules are evaluated on all pushed actions when popping
+        self.non_classified_actions = []
 
         self.ignore_bad_actions = args.ignore_bad_actions
 
     def __bool__(self):
+        self._classify_actions()
         return bool(self.queue) or \
             (self.batch_eval and any(bool(actions) for actions in self.non_evaluated_actions.values()))
     __nonzero__ = __bool__
@@ -64,12 +67,13 @@ class IPC23SingleQueue(PriorityQueue):
         raise
 
     def has_good_actions(self):
+        self._classify_actions()
         return bool(self.good_actions)
 
-    def push(self, action):
-        if self.good_bad_rule_evaluator.is_good_action(action):
+    def _push_classified(self, action, action_class):
+        if action_class == GodBadRuleEvaluator.GOOD:
             self.good_actions.append(action)
-        elif self.good_bad_rule_evaluator.is_bad_action(action):
+        elif action_class == GodBadRuleEvaluator.BAD:
             if not self.ignore_bad_actions:
                 self.queue.push(action, -inf)
         else:
@@ -82,7 +86,25 @@ class IPC23SingleQueue(PriorityQueue):
                     estimate = 1.0
                 self.queue.push(action, estimate)
 
+    def _classify_actions(self):
+        if self.non_classified_actions:
+            classes = self.good_bad_rule_evaluator.classify_actions(self.non_classified_actions)
+            for action, action_class in zip(self.non_classified_actions, classes):
+                self._push_classified(action, action_class)
+            self.non_classified_actions = []
+
+    def push(self, action):
+        if self.batch_eval:
+            self.non_classified_actions.append(action)
+        elif self.good_bad_rule_evaluator.is_good_action(action):
+            self._push_classified(action, GodBadRuleEvaluator.GOOD)
+        elif self.good_bad_rule_evaluator.is_bad_action(action):
+            self._push_classified(action, GodBadRuleEvaluator.BAD)
+        else:
+            self._push_classified(action, GodBadRuleEvaluator.NEUTRAL)
+
     def pop(self):
+        self._classify_actions()
         if self.good_actions:
             action = self.good_actions.pop()
             self.closed.append(action)
@@ -16,6 +16,7 @@
 
 #include "sym_test.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -32,6 +33,8 @@ namespace symbolic {
 	map<int, BDD>().swap(closedUpTo);
 	map <int, vector<BDD>>().swap(zeroCostClosed);
 	map<int, BDD>().swap(closed);
+	map<int, vector<TRNode>>().swap(tr_tree);
+	map<int, vector<int>>().swap(tr_tree_roots);
 	closedTotal = mgr->zeroBDD();
 	hNotClosed = 0;
 	fNotClosed = 0;
@@ -45,6 +48,8 @@ namespace symbolic {
 	map<int, BDD>().swap(closedUpTo);
 	map <int, vector<BDD>>().swap(zeroCostClosed);
 	map<int, BDD>().swap(closed);
+	map<int, vector<TRNode>>().swap(tr_tree);
+	map<int, vector<int>>().swap(tr_tree_roots);
 	closedTotal = mgr->zeroBDD();
 	hNotClosed = 0;
 	fNotClosed = 0;
@@ -417,6 +422,115 @@ namespace symbolic {
 
 
 
+    void ClosedList::build_tr_tree(int max_tr_size) const {
+	for (const auto & key : mgr->getIndividualTRs()) {
+	    vector<TRNode> & nodes = tr_tree[key.first];
+	    vector<int> & roots = tr_tree_roots[key.first];
+	    vector<int> level;
+	    for (const TransitionRelation &tr : key.second) {
+		level.push_back(nodes.size());
+		nodes.push_back(TRNode {tr, {}});
+	    }
+
+	    while (level.size() > 1) {
+		vector<int> next_level;
+		for (size_t i = 1; i < level.size(); i += 2) {
+		    try {
+			TransitionRelation merged = mergeTR(nodes[level[i - 1]].tr, nodes[level[i]].tr, max_tr_size);
+			next_level.push_back(nodes.size());
+			nodes.push_back(TRNode {merged, {level[i - 1], level[i]}});
+		    } catch (BDDError e) {
+			roots.push_back(level[i - 1]);
+			roots.push_back(level[i]);
+		    }
+		}
+		if (level.size() % 2 == 1) {
+		    next_level.push_back(level.back());
+		}
+		level.swap(next_level);
+	    }
+	    roots.insert(roots.end(), level.begin(), level.end());
+	}
+    }
+
+    void ClosedList::collect_optimal_operators(const vector<TRNode> &nodes, int node,
+					       const BDD &cut, const BDD &target, bool fw,
+					       std::set <const GlobalOperator *> &opt_operators,
+					       int &relational_products) const {
+	const TransitionRelation &tr = nodes[node].tr;
+	if (all_of(tr.getOps().begin(), tr.getOps().end(),
+		   [&](const GlobalOperator *op) {return opt_operators.count(op) > 0;})) {
+	    return;
+	}
+
+	if (nodes[node].children.empty()) {
+	    opt_operators.insert(tr.getOps().begin(), tr.getOps().end());
+	    return;
+	}
+
+	// The states reached by the children are a subset of those reached by the parent
+	for (int child : nodes[node].children) {
+	    const TransitionRelation &child_tr = nodes[child].tr;
+	    BDD succ = fw ? child_tr.preimage(cut) : child_tr.image(cut);
+	    relational_products++;
+	    BDD intersection = succ * target;
+	    if (!intersection.IsZero()) {
+		collect_optimal_operators(nodes, child, cut, intersection, fw, opt_operators, relational_products);
+	    }
+	}
+    }
+
+    void ClosedList::extract_optimal_operators_batched (const BDD &c, int h, bool fw, int max_tr_size,
+							std::set <const GlobalOperator *> & opt_operators) const {
+	if (tr_tree.empty()) {
+	    build_tr_tree(max_tr_size);
+	}
+
+	map<int, Bucket> cuts_with_cost;
+	if (h > 0) {
+	    cuts_with_cost[h].push_back(c);
+	}
+
+	int layers = 0, relational_products = 0;
+	while (!cuts_with_cost.empty()) {
+	    auto p = cuts_with_cost.rbegin();
+	    h = p->first;
+	    auto cut = p->second;
+	    cuts_with_cost.erase(h);
+	    layers++;
+
+	    mgr->mergeBucket(cut, 10000, 1000000);
+
+	    for (const auto & key : tr_tree_roots) {
+		int newH = h - key.first;
+		if (key.first == 0 || closed.count(newH) == 0)
+		    continue;
+
+		const vector<TRNode> &nodes = tr_tree.at(key.first);
+		for (int root : key.second) {
+		    const TransitionRelation &tr = nodes[root].tr;
+		    for (const auto & cu : cut) {
+			BDD succ = fw ? tr.preimage(cu) : tr.image(cu);
+			relational_products++;
+
+			BDD intersection = succ * closed.at(newH);
+			if (!intersection.IsZero()) {
+			    cuts_with_cost[newH].push_back(intersection);
+			    collect_optimal_operators(nodes, root, cu, intersection, fw,
+						      opt_operators, relational_products);
+			}
+		    }
+		}
+	    }
+	}
+
+	cout << "Optimal operators: " << opt_operators.size() << " after " << layers
+	     << " layers and " << relational_products << " relational products, "
+	     << utils::g_timer() << "s" << endl;
+    }
+
+
+
     SymSolution ClosedList::checkCut(UnidirectionalSearch * search, const BDD &states, int g, bool fw) const {
 	BDD cut_candidate = states * closedTotal;
 	if (cut_candidate.IsZero()) {
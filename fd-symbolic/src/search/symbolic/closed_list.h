@@ -2,6 +2,7 @@
 #define SYMBOLIC_CLOSED_LIST_H
 
 #include "sym_variables.h"
+#include "transition_relation.h"
 #include "unidirectional_search.h"
 
 #include <vector>
@@ -33,8 +34,25 @@ private:
     std::map<int, BDD> closedUpTo;  // Disjunction of BDDs in closed  (auxiliar useful to take the maximum between several BDDs)
     std::set<int> h_values; //Set of h_values of the heuristic
 
+    // Binary tree of merged TRs over the individual TRs of each cost, used to
+    // extract the optimal operators in batch. Inner nodes are the merge of
+    // their children; TRs that exceed the size limit remain as separate roots.
+    struct TRNode {
+        TransitionRelation tr;
+        std::vector<int> children;
+    };
+    mutable std::map<int, std::vector<TRNode>> tr_tree;
+    mutable std::map<int, std::vector<int>> tr_tree_roots;
+
     void newHValue(int h_value);
 
+    void build_tr_tree(int max_tr_size) const;
+
+    void collect_optimal_operators(const std::vector<TRNode> &nodes, int node,
+                                   const BDD &cut, const BDD &target, bool fw,
+                                   std::set <const GlobalOperator *> &opt_operators,
+                                   int &relational_products) const;
+
 public:
     ClosedList();
     void init(SymStateSpaceManager *manager, UnidirectionalSearch * search);
@@ -62,6 +80,12 @@ public:
     void extract_optimal_operators_non_zero_cost (const BDD &c, int h, bool fw,
                                                   std::set <const GlobalOperator *> & opt_operators) const;
 
+    // Same result as the two methods above, but each cut is only
+    // multiplied by the merged TRs. The individual TRs are only used to
+    // identify operators that have not been found yet.
+    void extract_optimal_operators_batched (const BDD &c, int h, bool fw, int max_tr_size,
+                                            std::set <const GlobalOperator *> & opt_operators) const;
+
 
     inline BDD getClosed() const {
         return closedTotal;
@@ -32,7 +32,11 @@ OriginalStateSpace::OriginalStateSpace(SymVariables *v,
     }
 
 
-    init_transitions(indTRs);
+    if (p.tr_partitioning == TRPartitioning::CONJUNCTIVE) {
+        init_conjunctive_transitions(indTRs);
+    } else {
+        init_transitions(indTRs);
+    }
 }
 
 void OriginalStateSpace::init_mutex(const std::vector<MutexGroup> &mutex_groups) {
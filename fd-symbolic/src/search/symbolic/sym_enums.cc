@@ -69,6 +69,18 @@ std::ostream &operator<<(std::ostream &os, const MutexType &m) {
     }
 }
 
+std::ostream &operator<<(std::ostream &os, const TRPartitioning &t) {
+    switch (t) {
+    case TRPartitioning::MONOLITHIC:
+        return os << "monolithic";
+    case TRPartitioning::CONJUNCTIVE:
+        return os << "conjunctive";
+    default:
+        std::cerr << "Name of TRPartitioning not known";
+        utils::exit_with(utils::ExitCode::UNSUPPORTED);
+    }
+}
+
 std::ostream &operator<<(std::ostream &os, const AbsTRsStrategy &a) {
     switch (a) {
     case AbsTRsStrategy::TR_SHRINK:
@@ -136,6 +148,10 @@ const std::vector<std::string> LinearPDBStrategyValues {
     "LEVEL", "REVERSE", "BINARY"
 };
 
+const std::vector<std::string> TRPartitioningValues {
+    "MONOLITHIC", "CONJUNCTIVE"
+};
+
 const std::vector<std::string>   AbsTRsStrategyValues {
     "TR_SHRINK", "IND_TR_SHRINK", "REBUILD_TRS", "SHRINK_AFTER_IMG"
 };
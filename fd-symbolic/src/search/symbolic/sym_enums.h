@@ -18,6 +18,10 @@ enum class MutexType {
 std::ostream &operator<<(std::ostream &os, const MutexType &m);
 extern const std::vector<std::string> MutexTypeValues;
 
+enum class TRPartitioning {MONOLITHIC, CONJUNCTIVE};
+std::ostream &operator<<(std::ostream &os, const TRPartitioning &t);
+extern const std::vector<std::string> TRPartitioningValues;
+
 enum class AbsTRsStrategy {TR_SHRINK, IND_TR_SHRINK, REBUILD_TRS, SHRINK_AFTER_IMG};
 std::ostream &operator<<(std::ostream &os, const AbsTRsStrategy &a);
 extern const std::vector<std::string> AbsTRsStrategyValues;
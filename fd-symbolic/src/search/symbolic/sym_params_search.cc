@@ -29,7 +29,9 @@ SymParamsSearch::SymParamsSearch(const Options &opts) :
     ratioAllotedNodes(opts.get<double>("ratio_alloted_nodes")),
     ratioAfterRelax(opts.get<double>("ratio_after_relax")),
     non_stop(opts.get<bool>("non_stop")),
-    debug(opts.get<bool>("debug")) {
+    debug(opts.get<bool>("debug")),
+    batched_operator_extraction(opts.get<bool>("batched_operator_extraction")),
+    max_extraction_tr_size(opts.get<int>("max_extraction_tr_size")) {
 }
 
 void SymParamsSearch::print_options() const {
@@ -109,6 +111,16 @@ void SymParamsSearch::add_options_to_parser(OptionParser &parser, int maxStepTim
     parser.add_option<bool>("debug",
                             "print debug trace",
                             "false");
+
+    parser.add_option<bool>("batched_operator_extraction",
+                            "Extract the operators in optimal plans (store_operators_in_optimal_plan) "
+                            "with the merged TRs, and only use the individual TRs to identify "
+                            "operators that have not been found yet.",
+                            "false");
+
+    parser.add_option<int>("max_extraction_tr_size",
+                           "maximum size of the merged TRs used by batched_operator_extraction",
+                           "100000");
 }
 
 int SymParamsSearch::getMaxStepNodes() const {
@@ -41,6 +41,11 @@ public:
 
     bool debug;
 
+    // Extract the operators of optimal plans with the merged TRs
+    bool batched_operator_extraction;
+    // Maximum size of the merged TRs used by the batched extraction
+    int max_extraction_tr_size;
+
     SymParamsSearch(const options::Options &opts);
 
     static void add_options_to_parser(options::OptionParser &parser, int maxStepTime, int maxStepNodes);
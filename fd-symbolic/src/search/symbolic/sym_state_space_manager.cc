@@ -5,6 +5,7 @@
 #include <queue>
 #include <limits>
 #include <algorithm>
+#include <iterator>
 
 #include "sym_util.h"
 #include "../globals.h"
@@ -236,7 +237,8 @@ void SymStateSpaceManager::shrinkBucket(Bucket &bucket, int maxNodes) {
     }
 }
 
-void SymStateSpaceManager::init_transitions(const map<int, vector <TransitionRelation>> & (indTRs)) {
+void SymStateSpaceManager::setup_transitions(const map<int, vector <TransitionRelation>> & (indTRs),
+                                             const function<void(vector<TransitionRelation> &)> &merge_trs) {
     transitions = indTRs; //Copy
     if(transitions.empty()) {
 	hasTR0 = false; 
@@ -244,23 +246,48 @@ void SymStateSpaceManager::init_transitions(const map<int, vector <TransitionRel
 	return;
     }
 
-    for (map<int, vector<TransitionRelation>>::iterator it = transitions.begin();
-         it != transitions.end(); ++it) {
-        merge(vars, it->second, mergeTR, p.max_tr_time, p.max_tr_size);
+    for (auto &trs : transitions) {
+        merge_trs(trs.second);
     }
 
     min_transition_cost = transitions.begin()->first;
     if (min_transition_cost == 0) {
 	hasTR0 = true;
 	if(transitions.size() > 1) {
-	    min_transition_cost = (transitions.begin() ++)->first;
+	    min_transition_cost = next(transitions.begin())->first;
 	}
     }
 }
 
+void SymStateSpaceManager::init_transitions(const map<int, vector <TransitionRelation>> & (indTRs)) {
+    setup_transitions(indTRs, [this] (vector<TransitionRelation> &trs) {
+            merge(vars, trs, mergeTR, p.max_tr_time, p.max_tr_size);
+        });
+}
+
+void SymStateSpaceManager::init_conjunctive_transitions(const map<int, vector <TransitionRelation>> & (indTRs)) {
+    setup_transitions(indTRs, [this] (vector<TransitionRelation> &trs) {
+            //Operators affecting the same variables are placed together, so
+            //that the pairwise merge combines TRs that share more factors
+            stable_sort(trs.begin(), trs.end(),
+                        [] (const TransitionRelation &tr1, const TransitionRelation &tr2) {
+                            return tr1.getEffVars() < tr2.getEffVars();
+                        });
+            merge(vars, trs, mergeConjunctiveTR, p.max_tr_time, p.max_tr_size);
+
+            //Not subject to the time limit: the TRs are only correct once
+            //their factors have been partitioned
+            for (auto &tr : trs) {
+                tr.partition(p.max_partition_size);
+            }
+        });
+}
+
 SymParamsMgr::SymParamsMgr(const options::Options &opts) :
     max_tr_size(opts.get<int>("max_tr_size")),
     max_tr_time(opts.get<int>("max_tr_time")),
+    tr_partitioning(TRPartitioning(opts.get_enum("tr_partitioning"))),
+    max_partition_size(opts.get<int>("max_partition_size")),
     mutex_type(MutexType(opts.get_enum("mutex_type"))),
     max_mutex_size(opts.get<int>("max_mutex_size")),
     max_mutex_time(opts.get<int>("max_mutex_time")),
@@ -276,6 +303,8 @@ SymParamsMgr::SymParamsMgr(const options::Options &opts) :
 SymParamsMgr::SymParamsMgr() :
     max_tr_size(100000),
     max_tr_time(60000),
+    tr_partitioning(TRPartitioning::MONOLITHIC),
+    max_partition_size(10000),
     mutex_type(MutexType::MUTEX_EDELETION),
     max_mutex_size(100000),
     max_mutex_time(60000),
@@ -288,7 +317,11 @@ SymParamsMgr::SymParamsMgr() :
 }
 
 void SymParamsMgr::print_options() const {
-    cout << "TR(time=" << max_tr_time << ", nodes=" << max_tr_size << ")" << endl;
+    cout << "TR(time=" << max_tr_time << ", nodes=" << max_tr_size << ", partitioning=" << tr_partitioning;
+    if (tr_partitioning == TRPartitioning::CONJUNCTIVE) {
+        cout << ", partition nodes=" << max_partition_size;
+    }
+    cout << ")" << endl;
     cout << "Mutex(time=" << max_mutex_time << ", nodes=" << max_mutex_size << ", type=" << mutex_type << ")" << endl;
     cout << "Aux(time=" << max_aux_time << ", nodes=" << max_aux_nodes << ")" << endl;
 }
@@ -299,6 +332,16 @@ void SymParamsMgr::add_options_to_parser(options::OptionParser &parser) {
     parser.add_option<int> ("max_tr_time",
                             "maximum time (ms) to generate TR BDDs", "60000");
 
+    parser.add_enum_option("tr_partitioning", TRPartitioningValues,
+                           "MONOLITHIC: disjunctive merge of the operator TRs. "
+                           "CONJUNCTIVE: operators are clustered by the variables they "
+                           "affect and the factors shared by all operators of a TR are "
+                           "kept apart and applied with early quantification",
+                           "MONOLITHIC");
+
+    parser.add_option<int> ("max_partition_size",
+                            "maximum size of each conjunct of CONJUNCTIVE TRs", "10000");
+
     parser.add_enum_option("mutex_type", MutexTypeValues,
                            "mutex type", "MUTEX_EDELETION");
 
@@ -13,6 +13,7 @@
 #include <map>
 #include <memory>
 #include <cassert>
+#include <functional>
 
 namespace options {
     class OptionParser;
@@ -31,6 +32,8 @@ class SymParamsMgr {
 public:
     //Parameters to generate the TRs
     int max_tr_size, max_tr_time;
+    TRPartitioning tr_partitioning;
+    int max_partition_size;
 
     //Parameters to generate the mutex BDDs
     MutexType mutex_type;
@@ -82,7 +85,12 @@ protected:
 
     virtual std::string tag() const = 0;
 
+    //Copies the TRs, merges the TRs of each cost with merge_trs and sets
+    //min_transition_cost and hasTR0
+    void setup_transitions(const std::map<int, std::vector <TransitionRelation>> & (indTRs),
+                           const std::function<void(std::vector<TransitionRelation> &)> &merge_trs);
     void init_transitions(const std::map<int, std::vector <TransitionRelation>> & (indTRs));
+    void init_conjunctive_transitions(const std::map<int, std::vector <TransitionRelation>> & (indTRs));
     bool is_relevant_op(const GlobalOperator & op) const;
 
 public:
@@ -6,6 +6,10 @@ TransitionRelation mergeTR(TransitionRelation tr, const TransitionRelation &tr2,
     tr.merge(tr2, maxSize);
     return tr;
 }
+TransitionRelation mergeConjunctiveTR(TransitionRelation tr, const TransitionRelation &tr2, int maxSize) {
+    tr.merge_conjunctive(tr2, maxSize);
+    return tr;
+}
 BDD mergeAndBDD(const BDD &bdd, const BDD &bdd2, int maxSize) {
     return bdd.And(bdd2, maxSize);
 }
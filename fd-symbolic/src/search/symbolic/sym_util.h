@@ -125,6 +125,7 @@ void merge(std::vector<T> &elems, FunctionMerge f, int maxSize) {
 
 
 TransitionRelation mergeTR(TransitionRelation tr, const TransitionRelation &tr2, int maxSize);
+TransitionRelation mergeConjunctiveTR(TransitionRelation tr, const TransitionRelation &tr2, int maxSize);
 BDD mergeAndBDD(const BDD &bdd, const BDD &bdd2, int maxSize);
 BDD mergeOrBDD(const BDD &bdd, const BDD &bdd2, int maxSize);
 
@@ -22,6 +22,7 @@ TransitionRelation::TransitionRelation(SymVariables *sVars,
     for (size_t i = 0; i < op->get_preconditions().size(); i++) { //Put precondition of label
         const GlobalCondition &prevail = op->get_preconditions()[i];
         tBDD *= sV->preBDD(prevail.var, prevail.val);
+        factors.push_back(sV->preBDD(prevail.var, prevail.val));
     }
 
     map<int, BDD> effect_conditions;
@@ -62,6 +63,7 @@ TransitionRelation::TransitionRelation(SymVariables *sVars,
             effectBDD += (effect_conditions[var] * sV->biimp(var));
         }
         tBDD *= effectBDD;
+        factors.push_back(effectBDD);
     }
     if (tBDD.IsZero()) {
         cerr << "ERROR, DESAMBIGUACION: " << op->get_name() << endl;
@@ -87,7 +89,9 @@ TransitionRelation::TransitionRelation(SymVariables *sVars,
 }
 
 void TransitionRelation::shrink(const SymStateSpaceManager &abs, int maxNodes) {
+    assert(!isConjunctive());
     tBDD = abs.shrinkTBDD(tBDD, maxNodes);
+    factors.assign(1, tBDD);
 
     // effVars
     vector <int> newEffVars;
@@ -99,12 +103,23 @@ void TransitionRelation::shrink(const SymStateSpaceManager &abs, int maxNodes) {
     newEffVars.swap(effVars);
 }
 
+//Relational product of bdd with a conjunctive TR following the
+//quantification schedule (maxNodes = 0 means no limit)
+static BDD and_abstract(const vector<pair<BDD, BDD>> &schedule,
+                        BDD bdd, int maxNodes) {
+    for (const auto &step : schedule) {
+        bdd = step.first.AndAbstract(bdd, step.second, maxNodes);
+    }
+    return bdd;
+}
+
 BDD TransitionRelation::image(const BDD &from) const {
     BDD aux = from;
     if (!swapVarsA.empty()) {
         aux = from.SwapVariables(swapVarsA, swapVarsAp);
     }
-    BDD tmp = tBDD.AndAbstract(aux, existsVars);
+    BDD tmp = isConjunctive() ? and_abstract(fwSchedule, aux, 0) :
+              tBDD.AndAbstract(aux, existsVars);
     BDD res = tmp.SwapVariables(swapVarsS, swapVarsSp);
     if (absAfterImage) {
         //TODO: HACK: PARAMETER FIXED
@@ -114,14 +129,15 @@ BDD TransitionRelation::image(const BDD &from) const {
 }
 
 BDD TransitionRelation::image(const BDD &from, int maxNodes) const {
-    DEBUG_MSG(cout << "Image cost " << cost << " from " << from.nodeCount() << " with " << tBDD.nodeCount();
+    DEBUG_MSG(cout << "Image cost " << cost << " from " << from.nodeCount() << " with " << nodeCount();
               );
     BDD aux = from;
     if (!swapVarsA.empty()) {
         aux = from.SwapVariables(swapVarsA, swapVarsAp);
     }
     utils::Timer t;
-    BDD tmp = tBDD.AndAbstract(aux, existsVars, maxNodes);
+    BDD tmp = isConjunctive() ? and_abstract(fwSchedule, aux, maxNodes) :
+              tBDD.AndAbstract(aux, existsVars, maxNodes);
     DEBUG_MSG(cout << " tmp " << tmp.nodeCount() << " in " << t();
               );
     BDD res = tmp.SwapVariables(swapVarsS, swapVarsSp);
@@ -140,7 +156,8 @@ BDD TransitionRelation::image(const BDD &from, int maxNodes) const {
 
 BDD TransitionRelation::preimage(const BDD &from) const {
     BDD tmp = from.SwapVariables(swapVarsS, swapVarsSp);
-    BDD res = tBDD.AndAbstract(tmp, existsBwVars);
+    BDD res = isConjunctive() ? and_abstract(bwSchedule, tmp, 0) :
+              tBDD.AndAbstract(tmp, existsBwVars);
     if (!swapVarsA.empty()) {
         res = res.SwapVariables(swapVarsA, swapVarsAp);
     }
@@ -152,12 +169,13 @@ BDD TransitionRelation::preimage(const BDD &from) const {
 
 BDD TransitionRelation::preimage(const BDD &from, int maxNodes) const {
     utils::Timer t;
-    DEBUG_MSG(cout << "Image cost " << cost << " from " << from.nodeCount() << " with " << tBDD.nodeCount() << flush;
+    DEBUG_MSG(cout << "Image cost " << cost << " from " << from.nodeCount() << " with " << nodeCount() << flush;
               );
     BDD tmp = from.SwapVariables(swapVarsS, swapVarsSp);
     DEBUG_MSG(cout << " tmp " << tmp.nodeCount() << " in " << t() << flush;
               );
-    BDD res = tBDD.AndAbstract(tmp, existsBwVars, maxNodes);
+    BDD res = isConjunctive() ? and_abstract(bwSchedule, tmp, maxNodes) :
+              tBDD.AndAbstract(tmp, existsBwVars, maxNodes);
     if (!swapVarsA.empty()) {
         res = res.SwapVariables(swapVarsA, swapVarsAp);
     }
@@ -219,8 +237,74 @@ void TransitionRelation::merge(const TransitionRelation &t2,
     }
 
     tBDD = newTBDD;
+    factors.assign(1, tBDD);
 
     effVars.swap(newEffVars);
+    merge_vars(t2);
+}
+
+void TransitionRelation::merge_conjunctive(const TransitionRelation &t2,
+                                           int maxNodes) {
+    assert(cost == t2.cost);
+    assert(!isConjunctive() && !t2.isConjunctive());
+    if (cost != t2.cost) {
+        cout << "Error: merging transitions with different cost: " << cost << " " << t2.cost << endl;
+        utils::exit_with(utils::ExitCode::CRITICAL_ERROR);
+    }
+
+    //The factors of both TRs are canonical BDDs, so that shared
+    //factors can be detected by comparing them
+    vector<BDD> sharedFactors;
+    BDD newTBDD = sV->oneBDD();
+    for (const BDD &factor : factors) {
+        if (find(t2.factors.begin(), t2.factors.end(), factor) != t2.factors.end()) {
+            sharedFactors.push_back(factor);
+        } else {
+            newTBDD *= factor;
+        }
+    }
+    BDD newTBDD2 = sV->oneBDD();
+    for (const BDD &factor : t2.factors) {
+        if (find(sharedFactors.begin(), sharedFactors.end(), factor) == sharedFactors.end()) {
+            newTBDD2 *= factor;
+        }
+    }
+
+    //Variables modified by only one of the TRs are preserved by the other
+    for (int var : t2.effVars) {
+        if (!binary_search(effVars.begin(), effVars.end(), var)) {
+            newTBDD *= sV->biimp(var);
+        }
+    }
+    for (int var : effVars) {
+        if (!binary_search(t2.effVars.begin(), t2.effVars.end(), var)) {
+            newTBDD2 *= sV->biimp(var);
+        }
+    }
+    newTBDD = newTBDD.Or(newTBDD2, maxNodes);
+
+    if (newTBDD.nodeCount() > maxNodes) {
+        DEBUG_MSG(cout << "TR size exceeded: " << newTBDD.nodeCount() <<
+                  ">" << maxNodes << endl;
+                  );
+        throw BDDError(); //We could not sucessfully merge
+    }
+
+    tBDD = newTBDD;
+    factors.swap(sharedFactors);
+    if (!tBDD.IsOne()) {
+        factors.push_back(tBDD);
+    }
+
+    vector <int> newEffVars;
+    set_union(effVars.begin(), effVars.end(),
+              t2.effVars.begin(), t2.effVars.end(),
+              back_inserter(newEffVars));
+    effVars.swap(newEffVars);
+    merge_vars(t2);
+}
+
+void TransitionRelation::merge_vars(const TransitionRelation &t2) {
     existsVars *= t2.existsVars;
     existsBwVars *= t2.existsBwVars;
 
@@ -235,6 +319,143 @@ void TransitionRelation::merge(const TransitionRelation &t2,
     ops.insert(t2.ops.begin(), t2.ops.end());
 }
 
+void TransitionRelation::partition(int maxNodes) {
+    assert(!isConjunctive());
+    vector<BDD> clusters;
+    vector<vector<unsigned int>> supports;
+    for (const BDD &factor : factors) {
+        if (!factor.IsOne()) {
+            clusters.push_back(factor);
+            supports.push_back(factor.SupportIndices());
+            sort(supports.back().begin(), supports.back().end());
+        }
+    }
+
+    //Greedily conjoin the pair of clusters with the largest ratio of
+    //shared variables, as long as the result does not exceed maxNodes
+    vector<vector<bool>> failed(clusters.size(), vector<bool>(clusters.size(), false));
+    while (clusters.size() > 1) {
+        double bestAffinity = 0;
+        size_t best1 = 0, best2 = 0;
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            for (size_t j = i + 1; j < clusters.size(); ++j) {
+                if (failed[i][j]) {
+                    continue;
+                }
+                vector<unsigned int> shared;
+                set_intersection(supports[i].begin(), supports[i].end(),
+                                 supports[j].begin(), supports[j].end(),
+                                 back_inserter(shared));
+                double affinity = double(shared.size()) /
+                                  (supports[i].size() + supports[j].size() - shared.size());
+                if (affinity > bestAffinity) {
+                    bestAffinity = affinity;
+                    best1 = i;
+                    best2 = j;
+                }
+            }
+        }
+        if (bestAffinity == 0) {
+            break;
+        }
+
+        BDD cluster = sV->zeroBDD();
+        try{
+            cluster = clusters[best1].And(clusters[best2], maxNodes);
+        }catch (BDDError e) {
+        }
+        if (cluster.IsZero() || cluster.nodeCount() > maxNodes) {
+            failed[best1][best2] = true;
+            continue;
+        }
+
+        clusters[best1] = cluster;
+        vector<unsigned int> support;
+        set_union(supports[best1].begin(), supports[best1].end(),
+                  supports[best2].begin(), supports[best2].end(),
+                  back_inserter(support));
+        supports[best1].swap(support);
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            failed[best1][i] = failed[i][best1] = false;
+        }
+        for (auto &row : failed) {
+            row.erase(row.begin() + best2);
+        }
+        failed.erase(failed.begin() + best2);
+        clusters.erase(clusters.begin() + best2);
+        supports.erase(supports.begin() + best2);
+    }
+
+    DEBUG_MSG(cout << "Partitioned TR with " << factors.size() << " factors into "
+                   << clusters.size() << " clusters" << endl;);
+    factors = clusters;
+    if (clusters.empty()) {
+        tBDD = sV->oneBDD();
+        return;
+    }
+    fwSchedule = quantification_schedule(clusters, supports, existsVars);
+    bwSchedule = quantification_schedule(clusters, supports, existsBwVars);
+}
+
+vector<pair<BDD, BDD>> TransitionRelation::quantification_schedule(
+    const vector<BDD> &clusters, const vector<vector<unsigned int>> &supports,
+    const BDD &exists) const {
+    //Number of clusters not scheduled yet that depend on each variable
+    map<unsigned int, int> pending;
+    for (unsigned int var : exists.SupportIndices()) {
+        pending[var] = 0;
+    }
+    for (const auto &support : supports) {
+        for (unsigned int var : support) {
+            if (pending.count(var)) {
+                pending[var]++;
+            }
+        }
+    }
+
+    //Variables that no cluster depends on are existentialized right away
+    BDD cube = sV->oneBDD();
+    for (const auto &entry : pending) {
+        if (entry.second == 0) {
+            cube *= sV->bddVar(entry.first);
+        }
+    }
+
+    //Schedule first the clusters that allow to existentialize more
+    //variables, preferring those with smaller support
+    vector<pair<BDD, BDD>> schedule;
+    vector<bool> scheduled(clusters.size(), false);
+    for (size_t step = 0; step < clusters.size(); ++step) {
+        int best = -1, bestQuantified = -1;
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            if (scheduled[i]) {
+                continue;
+            }
+            int quantified = 0;
+            for (unsigned int var : supports[i]) {
+                if (pending.count(var) && pending[var] == 1) {
+                    quantified++;
+                }
+            }
+            if (quantified > bestQuantified ||
+                (quantified == bestQuantified &&
+                 supports[i].size() < supports[best].size())) {
+                best = i;
+                bestQuantified = quantified;
+            }
+        }
+        scheduled[best] = true;
+        for (unsigned int var : supports[best]) {
+            if (pending.count(var) && --pending[var] == 0) {
+                cube *= sV->bddVar(var);
+            }
+        }
+        schedule.emplace_back(clusters[best], cube);
+        cube = sV->oneBDD();
+    }
+    return schedule;
+}
+
     
     //For each op, include relevant mutexes
     void TransitionRelation::edeletion(const std::vector<std::vector<BDD>> & notMutexBDDsByFluentFw, 
@@ -261,29 +482,38 @@ void TransitionRelation::merge(const TransitionRelation &t2,
                 //That means that every previous value is possible
                 //for each value of the variable
                 for (int val = 0; val < g_variable_domain[pp.var]; val++) {
-                    tBDD *= notMutexBDDsByFluentBw[pp.var][val];
+                    add_factor(notMutexBDDsByFluentBw[pp.var][val]);
                 }
             } else {
                 //In regression, we are making true pp.pre
                 //So we must negate everything of these.
-                tBDD *= notMutexBDDsByFluentBw[pp.var] [pre->val];
+                add_factor(notMutexBDDsByFluentBw[pp.var] [pre->val]);
             }
             //edeletion fw
-            tBDD *= notMutexBDDsByFluentFw[pp.var][pp.val].SwapVariables(swapVarsS, swapVarsSp);
+            add_factor(notMutexBDDsByFluentFw[pp.var][pp.val].SwapVariables(swapVarsS, swapVarsSp));
 
             //edeletion invariants
-            tBDD *= exactlyOneBDDsByFluent[pp.var][pp.val];
+            add_factor(exactlyOneBDDsByFluent[pp.var][pp.val]);
         }
     }
 }
 
+void TransitionRelation::add_factor(const BDD &factor) {
+    assert(!isConjunctive());
+    tBDD *= factor;
+    if (!factor.IsOne() &&
+        find(factors.begin(), factors.end(), factor) == factors.end()) {
+        factors.push_back(factor);
+    }
+}
+
 
 ostream &operator<<(std::ostream &os, const TransitionRelation &tr) {
     os << "TR(";
     for (auto op : tr.ops) {
         os << op->get_name() << ", ";
     }
-    return os << "): " << tr.tBDD.nodeCount() << endl;
+    return os << "): " << tr.nodeCount() << endl;
 }
 
 }
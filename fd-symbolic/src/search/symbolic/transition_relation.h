@@ -4,6 +4,7 @@
 #include "sym_variables.h"
 
 #include <set>
+#include <utility>
 #include <vector>
 
 class GlobalOperator;
@@ -25,7 +26,17 @@ class DominanceRelation;
 class TransitionRelation {
     SymVariables *sV; //To call basic BDD creation methods
     int cost; // transition cost
-    BDD tBDD; // bdd for making the relprod
+    BDD tBDD; // bdd for making the relprod (see factors for conjunctive TRs)
+
+    // Conjunctive decomposition of the TR. In monolithic TRs, tBDD is
+    // the conjunction of all factors. In conjunctive TRs, the factors
+    // are not multiplied and tBDD only contains the part that is not
+    // shared by all the operators of the TR.
+    std::vector<BDD> factors;
+    // Quantification schedule of conjunctive TRs (empty in monolithic
+    // TRs): each step conjoins a factor and existentializes the
+    // variables that do not appear in any of the following steps.
+    std::vector<std::pair<BDD, BDD>> fwSchedule, bwSchedule;
 
     std::vector<int> effVars; //FD Index of eff variables. Must be sorted!!
     BDD existsVars, existsBwVars;   // Cube with variables to existentialize
@@ -35,6 +46,13 @@ class TransitionRelation {
     std::set<const GlobalOperator *> ops; //List of operators represented by the TR
 
     const SymStateSpaceManager *absAfterImage;
+
+    void add_factor(const BDD &factor);
+    void merge_vars(const TransitionRelation &t2);
+    std::vector<std::pair<BDD, BDD>> quantification_schedule(
+        const std::vector<BDD> &clusters,
+        const std::vector<std::vector<unsigned int>> &supports,
+        const BDD &exists) const;
 public:
     //Constructor for abstraction transitions
     TransitionRelation(SymStateSpaceManager *mgr,
@@ -59,6 +77,19 @@ public:
     void merge(const TransitionRelation &t2,
                int maxNodes);
 
+    //Merges the TRs keeping the factors shared by both of them apart,
+    //so that only the rest of the TR has to be disjunctively merged
+    void merge_conjunctive(const TransitionRelation &t2,
+                           int maxNodes);
+
+    //Clusters the factors by variable affinity up to maxNodes and
+    //computes the quantification schedule for the image and preimage
+    void partition(int maxNodes);
+
+    inline bool isConjunctive() const {
+        return !fwSchedule.empty();
+    }
+
     //shrinks the transition to another abstract state space (useful to preserve edeletion)
     void shrink(const SymStateSpaceManager &abs, int maxNodes);
 
@@ -77,6 +108,13 @@ public:
         cost = cost_;
     }
     inline int nodeCount() const {
+        if (isConjunctive()) {
+            int res = 0;
+            for (const BDD &factor : factors) {
+                res += factor.nodeCount();
+            }
+            return res;
+        }
         return tBDD.nodeCount();
     }
     inline const std::set<const GlobalOperator *> &getOps() const {
@@ -96,6 +134,10 @@ public:
         return tBDD;
     }
 
+    inline const std::vector<int> &getEffVars() const {
+        return effVars;
+    }
+
     friend std::ostream &operator<<(std::ostream &os, const TransitionRelation &tr);
 };
 }
@@ -388,7 +388,10 @@ namespace symbolic {
 
     void UniformCostSearch::getOperatorsOptimalPlans(const BDD &cut, int g,
 						     std::set <const GlobalOperator *> &opt_operators) const {
-        if (mgr->is_unit_cost()) {
+        if (p.batched_operator_extraction) {
+            closed->extract_optimal_operators_batched (cut, g, fw, p.max_extraction_tr_size,
+                                                       opt_operators);
+        } else if (mgr->is_unit_cost()) {
             closed->extract_optimal_operators_unit_cost (cut, g, fw, opt_operators);
         } else{
             closed->extract_optimal_operators_non_zero_cost (cut, g, fw, opt_operators);
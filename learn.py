@@ -171,7 +171,7 @@ def main():
     SUITE_GOOD_OPERATORS = suites.build_suite(TRAINING_DIR, [f'instances:{name}.pddl' for name in instances_to_run_good_operators])
     if not os.path.exists(f'{TRAINING_DIR}/good-operators-unit'):
         logging.info("Running good operators with unit cost on %d traning instances (remaining time %s)", len(instances_to_run_good_operators), timer)
-        RUN.run_good_operators(f'{TRAINING_DIR}/good-operators-unit', REPO_GOOD_OPERATORS, ['--search', "sbd(store_operators_in_optimal_plan=true, cost_type=1)"], ENV, SUITE_GOOD_OPERATORS)
+        RUN.run_good_operators(f'{TRAINING_DIR}/good-operators-unit', REPO_GOOD_OPERATORS, ['--search', "sbd(store_operators_in_optimal_plan=true, batched_operator_extraction=true, cost_type=1)"], ENV, SUITE_GOOD_OPERATORS)
     else:
         assert args.resume
     instances_manager.add_training_data(f'{TRAINING_DIR}/good-operators-unit')
@@ -189,7 +189,7 @@ def main():
         if not os.path.exists(f'{TRAINING_DIR}/good-operators-cost'):
             logging.info("Running good operators with unit cost on %d traning instances (remaining time %s)", len(instances_to_run_good_operators), timer)
 
-            RUN.run_good_operators(f'{TRAINING_DIR}/good-operators-cost', REPO_GOOD_OPERATORS, ['--search', "sbd(store_operators_in_optimal_plan=true)"], ENV, SUITE_GOOD_OPERATORS)
+            RUN.run_good_operators(f'{TRAINING_DIR}/good-operators-cost', REPO_GOOD_OPERATORS, ['--search', "sbd(store_operators_in_optimal_plan=true, batched_operator_extraction=true)"], ENV, SUITE_GOOD_OPERATORS)
         else:
             assert args.resume
 
@@ -57,6 +57,11 @@ def parse_args():
                         help="If provided, an IPC23 queue is used, and a bad_rules.rules file is given,"
                              "all actions evaluated as bad according to the rules will not be grounded.")
 
+    parser.add_argument("--powerlifted-partial-grounding", action="store_true",
+                        help="If provided, the actions are selected by the partial grounding of powerlifted "
+                             "(with the good and bad rules of the domain knowledge) and the translator only "
+                             "instantiates them.")
+
     return parser.parse_args()
 
 
@@ -84,6 +89,9 @@ def main():
         if args.ignore_bad_actions:
             translate_options += ["--ignore-bad-actions"]
 
+    if args.powerlifted_partial_grounding:
+        driver_options += ["--powerlifted-partial-grounding"]
+
     if args.incremental_grounding:
         driver_options += ["--incremental-grounding",
                            "--incremental-grounding-search-time-limit", str(args.incremental_grounding_search_time_limit),
@@ -39,11 +39,12 @@ def get_lama(bound):
                          lazy_wastar([hff,hlm],preferred=[hff,hlm],w=1),
                          ],repeat_last=true,continue_on_fail=true, bound={bound})""",
         "--if-non-unit-cost",
+        "--landmarks", "lmg=lm_reasonable_orders_hps(lm_rhw())",
         "--evaluator",
-        "hlm1=lmcount(lm_reasonable_orders_hps(lm_rhw()),transform=adapt_costs(one),pref=false)",
+        "hlm1=lmcount(lmg,transform=adapt_costs(one),pref=false)",
         "--evaluator", "hff1=ff(transform=adapt_costs(one))",
         "--evaluator",
-        "hlm2=lmcount(lm_reasonable_orders_hps(lm_rhw()),transform=adapt_costs(plusone),pref=false)",
+        "hlm2=lmcount(lmg,transform=adapt_costs(plusone),pref=false)",
         "--evaluator", "hff2=ff(transform=adapt_costs(plusone))",
         "--search", f"""iterated([
                          lazy_greedy([hff1,hlm1],preferred=[hff1,hlm1],
@@ -73,10 +74,17 @@ def get_options(config_file):
     if "ignore-bad-actions" in config_dict and config_dict["ignore-bad-actions"].lower().strip() == "true":
         config += ["--ignore-bad-actions"]
 
+    powerlifted_partial_grounding = ("powerlifted-partial-grounding" in config_dict and
+                                     config_dict["powerlifted-partial-grounding"].lower().strip() == "true")
+    if powerlifted_partial_grounding:
+        # The actions are grounded once by powerlifted, not incrementally.
+        config += ["--powerlifted-partial-grounding"]
+
     if "termination-condition" in config_dict:
         config += ["--termination-condition", config_dict["termination-condition"]]
 
-    if "termination-condition" not in config_dict or config_dict["termination-condition"] != "full":
+    if not powerlifted_partial_grounding and \
+            ("termination-condition" not in config_dict or config_dict["termination-condition"] != "full"):
         # TODO add incremental grounding options to config file and include them here
         config += ["--incremental-grounding"]
 